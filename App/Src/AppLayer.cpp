@@ -14,16 +14,18 @@ void AppLayer::OnEvent(SDL_Event &event) {}
 void AppLayer::OnUpdate(float ts) {}
 
 void AppLayer::OnRender() {
-    auto commandBuffer = SDL_AcquireGPUCommandBuffer(
-        brnCore::Application::Get().GetGpuDevice()->GetHandle());
+    brnCore::Application &app = brnCore::Application::Get();
+    auto commandBuffer =
+        SDL_AcquireGPUCommandBuffer(app.GetGpuDevice()->GetHandle());
 
+    // Headless, there is no swapchain; the frame is still submitted.
     SDL_GPUTexture *swapchainTexture{};
-    if (!SDL_WaitAndAcquireGPUSwapchainTexture(
-            commandBuffer,
-            brnCore::Application::Get().GetWindow()->GetHandle(),
-            &swapchainTexture,
-            nullptr,
-            nullptr)) {
+    if (!app.IsHeadless() &&
+        !SDL_WaitAndAcquireGPUSwapchainTexture(commandBuffer,
+                                               app.GetWindow()->GetHandle(),
+                                               &swapchainTexture,
+                                               nullptr,
+                                               nullptr)) {
         SDL_LogError(brnCore::Application::APP_LOG_CATEGORY_GENERIC,
                      "Failed to acquire swapchain texture: %s",
                      SDL_GetError());
@@ -44,10 +46,16 @@ void AppLayer::OnRender() {
         SDL_EndGPURenderPass(renderPass);
     }
 
-    if (!SDL_SubmitGPUCommandBuffer(commandBuffer)) {
+    // This submission presents: its fence tells the latency tracker when
+    // the frame is done.
+    SDL_GPUFence *fence =
+        SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    if (!fence) {
         SDL_LogError(brnCore::Application::APP_LOG_CATEGORY_GENERIC,
                      "Failed to submit command buffer: %s",
                      SDL_GetError());
         exit(1);
     }
+    app.GetLatencyTracker()->TrackPresent(app.GetGpuDevice()->GetHandle(),
+                                          fence);
 }
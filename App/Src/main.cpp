@@ -2,8 +2,15 @@
 
 #include "Engine/Core/Window.h"
 #include "Engine/Core/Application.h"
+#include "Engine/Core/CVar.h"
 
 int main(int argc, char **argv) {
+    // Settings without a rebuild: the config, then "+name=value"
+    // arguments over it.
+    brnCore::CVarRegistry &cvars = brnCore::CVarRegistry::Get();
+    cvars.LoadConfig("Brain.cfg");
+    cvars.ParseCommandLine(argc, argv);
+
     brnCore::WindowSpecification windowSpec;
     windowSpec.Title  = "Brain";
     windowSpec.Width  = 1280;
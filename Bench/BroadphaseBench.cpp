@@ -0,0 +1,126 @@
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Physics/SpatialHash.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Spatial hash scaling curve: N moving 2D boxes at constant density, one
+ * frame = Move() every body + FindPairs(). The 60 Hz budget is 16.6 ms for
+ * the whole frame, so the 50k row should stay well below that. The first
+ * row is cross-checked against brute force.
+ */
+
+namespace {
+constexpr size_t kBodyCounts[] = {1'000, 5'000, 10'000, 25'000, 50'000,
+                                  100'000};
+constexpr float  kDensity      = 0.02f; // bodies per square unit
+constexpr int    kFrames       = 30;
+
+struct Body {
+    glm::vec3 Position;
+    glm::vec3 Velocity;
+    float     HalfSize;
+};
+
+double MillisecondsSince(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1e3 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+brnCore::Aabb GetBounds(const Body &body) {
+    return brnCore::Aabb::FromCenter(
+        body.Position, glm::vec3(body.HalfSize, body.HalfSize, 0.0f));
+}
+
+size_t CountBruteForce(const std::vector<Body> &bodies) {
+    size_t count = 0;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        const brnCore::Aabb a = GetBounds(bodies[i]);
+        for (size_t j = i + 1; j < bodies.size(); j++) {
+            count += a.Overlaps(GetBounds(bodies[j]));
+        }
+    }
+    return count;
+}
+
+// Median frame time in ms; `pairs` receives the last frame's pair count.
+double RunFrames(size_t              bodyCount,
+                 brnCore::JobSystem *jobs,
+                 size_t             &pairs,
+                 bool                verify) {
+    const float worldSize = std::sqrt(bodyCount / kDensity);
+
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> position(0.0f, worldSize);
+    std::uniform_real_distribution<float> velocity(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+    std::vector<Body> bodies(bodyCount);
+    for (Body &body : bodies) {
+        body.Position = glm::vec3(position(rng), position(rng), 0.0f);
+        body.Velocity = glm::vec3(velocity(rng), velocity(rng), 0.0f);
+        body.HalfSize = size(rng);
+    }
+
+    brnCore::SpatialHash          hash;
+    std::vector<brnCore::ProxyId> proxies;
+    proxies.reserve(bodyCount);
+    for (const Body &body : bodies) {
+        proxies.push_back(hash.Insert(GetBounds(body)));
+    }
+
+    std::vector<brnCore::ProxyPair> out;
+    std::vector<double>             samples;
+    constexpr float                 dt = 1.0f / 60.0f;
+    for (int frame = 0; frame < kFrames; frame++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (size_t i = 0; i < bodyCount; i++) {
+            Body &body = bodies[i];
+            body.Position += body.Velocity * dt;
+            hash.Move(proxies[i], GetBounds(body));
+        }
+        hash.FindPairs(out, jobs);
+        samples.push_back(MillisecondsSince(start));
+    }
+    pairs = out.size();
+
+    if (verify) {
+        const size_t expected = CountBruteForce(bodies);
+        SDL_Log("verify   %zu bodies: %zu pairs, brute force %zu: %s",
+                bodyCount,
+                out.size(),
+                expected,
+                out.size() == expected ? "ok" : "MISMATCH");
+    }
+
+    std::ranges::sort(samples);
+    return samples[samples.size() / 2];
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    brnCore::JobSystem jobs;
+    SDL_Log("%8s %10s %12s %12s", "bodies", "pairs", "1 thread", "jobs");
+
+    bool verify = true;
+    for (size_t bodyCount : kBodyCounts) {
+        size_t       pairs    = 0;
+        const double serial   = RunFrames(bodyCount, nullptr, pairs, verify);
+        const double parallel = RunFrames(bodyCount, &jobs, pairs, false);
+        SDL_Log("%8zu %10zu %9.3f ms %9.3f ms",
+                bodyCount,
+                pairs,
+                serial,
+                parallel);
+        verify = false;
+    }
+    SDL_Log("(%u threads, budget at 60 Hz: 16.6 ms)", jobs.GetThreadCount());
+
+    return 0;
+}
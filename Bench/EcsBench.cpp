@@ -0,0 +1,129 @@
+#include "Engine/ECS/CommandBuffer.h"
+#include "Engine/ECS/World.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <vector>
+
+/*
+ * Iterates 1M entities with three components, the standard "pos += vel"
+ * integration benchmark that EnTT and flecs publish numbers for. On a
+ * current desktop core those land around 1-2 ns per entity for a cached
+ * view/query, which is the target here.
+ */
+
+namespace {
+struct Position {
+    float x, y, z;
+};
+struct Velocity {
+    float x, y, z;
+};
+struct Acceleration {
+    float x, y, z;
+};
+struct Sleeping {};
+
+constexpr size_t kEntityCount    = 1'000'000;
+constexpr int    kIterations     = 100;
+constexpr double kTargetNsEntity = 2.0;
+
+double SecondsSince(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+template <typename Fn>
+double MedianNsPerEntity(Fn &&fn) {
+    std::vector<double> samples;
+    samples.reserve(kIterations);
+    for (int i = 0; i < kIterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        fn();
+        samples.push_back(SecondsSince(start) * 1e9 / kEntityCount);
+    }
+    std::ranges::sort(samples);
+    return samples[samples.size() / 2];
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    brnCore::World world;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (size_t i = 0; i < kEntityCount; i++) {
+        const float f = static_cast<float>(i);
+        world.CreateEntity(Position{f, f, f},
+                           Velocity{1.0f, 0.0f, 0.0f},
+                           Acceleration{0.0f, -9.8f, 0.0f});
+    }
+    SDL_Log("create   %zu entities: %8.2f ms",
+            kEntityCount,
+            SecondsSince(start) * 1e3);
+
+    constexpr float dt = 1.0f / 60.0f;
+
+    auto query = world.CreateQuery<Position, Velocity, const Acceleration>();
+
+    const double each = MedianNsPerEntity([&] {
+        query.Each([](Position &p, Velocity &v, const Acceleration &a) {
+            v.x += a.x * dt;
+            v.y += a.y * dt;
+            v.z += a.z * dt;
+            p.x += v.x * dt;
+            p.y += v.y * dt;
+            p.z += v.z * dt;
+        });
+    });
+    SDL_Log("Each      3 components: %6.3f ns/entity", each);
+
+    const double chunked = MedianNsPerEntity([&] {
+        query.EachChunk([](const auto &chunk) {
+            Position           *p     = chunk.template Get<0>();
+            Velocity           *v     = chunk.template Get<1>();
+            const Acceleration *a     = chunk.template Get<2>();
+            const uint32_t      count = chunk.GetCount();
+            for (uint32_t i = 0; i < count; i++) {
+                v[i].x += a[i].x * dt;
+                v[i].y += a[i].y * dt;
+                v[i].z += a[i].z * dt;
+                p[i].x += v[i].x * dt;
+                p[i].y += v[i].y * dt;
+                p[i].z += v[i].z * dt;
+            }
+        });
+    });
+    SDL_Log("EachChunk 3 components: %6.3f ns/entity", chunked);
+
+    // Structural churn: tag 10% of the entities through a command buffer
+    // while iterating, then untag them again.
+    brnCore::CommandBuffer commands(world);
+    start = SDL_GetPerformanceCounter();
+    world.CreateQuery<Position>().Each(
+        [&](brnCore::Entity entity, Position &) {
+            if (entity.Index % 10 == 0) {
+                commands.AddComponent<Sleeping>(entity);
+            }
+        });
+    commands.Flush();
+    world.CreateQuery<Position>().Each(
+        [&](brnCore::Entity entity, Position &) {
+            if (entity.Index % 10 == 0) {
+                commands.RemoveComponent<Sleeping>(entity);
+            }
+        });
+    commands.Flush();
+    SDL_Log("churn    %zu add+remove: %8.2f ms (%zu archetypes)",
+            kEntityCount / 5,
+            SecondsSince(start) * 1e3,
+            world.GetArchetypeCount());
+
+    const double best = std::min(each, chunked);
+    SDL_Log("target   <= %.1f ns/entity: %s",
+            kTargetNsEntity,
+            best <= kTargetNsEntity ? "met" : "MISSED");
+
+    return 0;
+}
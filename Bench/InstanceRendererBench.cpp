@@ -0,0 +1,315 @@
+#include "Engine/Assets/FileSystem.h"
+#include "Engine/Physics/Frustum.h"
+#include "Engine/Renderer/InstanceRenderer.h"
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_init.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*
+ * GPU-driven instancing into an offscreen target, without a window, so
+ * it runs headless on a software Vulkan driver, e.g.
+ *
+ *   VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json \
+ *       ./InstanceRendererBench
+ *
+ * Cubes and pyramids are scattered through a box the camera sees part
+ * of, and the camera turns every frame. Reports the CPU time to record
+ * and submit a frame, which should stay flat from 1k to 1M instances,
+ * and the whole frame time (on a software driver that is mostly the
+ * rasterizer). The visible counts the cull wrote are checked against
+ * the CPU frustum test.
+ */
+
+using brnCore::InstanceRenderer;
+
+namespace {
+constexpr uint32_t kInstanceCounts[] = {1'000, 10'000, 100'000, 1'000'000};
+constexpr uint32_t kMeshCount        = 2;
+constexpr int      kFrames           = 30;
+constexpr uint32_t kTargetSize       = 512;
+constexpr float    kWorldSize        = 200.0f; // side of the box
+
+double MillisecondsSince(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1e3 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+// Appends a convex face, wound counterclockwise as seen from outside a
+// mesh centered on the origin.
+void AddFace(std::vector<brnCore::MeshVertex> &vertices,
+             std::vector<uint32_t>            &indices,
+             std::vector<glm::vec3>            corners) {
+    glm::vec3 normal = glm::normalize(
+        glm::cross(corners[1] - corners[0], corners[2] - corners[0]));
+    if (glm::dot(normal, corners[0] + corners[1] + corners[2]) < 0.0f) {
+        std::ranges::reverse(corners);
+        normal = -normal;
+    }
+
+    const auto first = static_cast<uint32_t>(vertices.size());
+    for (const glm::vec3 &corner : corners) {
+        vertices.push_back(
+            {corner, brnCore::PackSnorm8x4(glm::vec4(normal, 0.0f))});
+    }
+    for (uint32_t i = 2; i < corners.size(); i++) {
+        indices.insert(indices.end(), {first, first + i - 1, first + i});
+    }
+}
+
+uint32_t AddCube(InstanceRenderer &renderer) {
+    std::vector<brnCore::MeshVertex> vertices;
+    std::vector<uint32_t>            indices;
+    for (int axis = 0; axis < 3; axis++) {
+        for (const float side : {-0.5f, 0.5f}) {
+            glm::vec3 u(0.0f), v(0.0f), n(0.0f);
+            n[axis]           = side;
+            u[(axis + 1) % 3] = 0.5f;
+            v[(axis + 2) % 3] = 0.5f;
+            AddFace(vertices,
+                    indices,
+                    {n - u - v, n + u - v, n + u + v, n - u + v});
+        }
+    }
+    return renderer.AddMesh(vertices, indices);
+}
+
+uint32_t AddPyramid(InstanceRenderer &renderer) {
+    std::vector<brnCore::MeshVertex> vertices;
+    std::vector<uint32_t>            indices;
+    const glm::vec3                  apex(0.0f, 0.5f, 0.0f);
+    const glm::vec3                  base[] = {{-0.5f, -0.5f, -0.5f},
+                                               {0.5f, -0.5f, -0.5f},
+                                               {0.5f, -0.5f, 0.5f},
+                                               {-0.5f, -0.5f, 0.5f}};
+    AddFace(vertices, indices, {base[0], base[1], base[2], base[3]});
+    for (int i = 0; i < 4; i++) {
+        AddFace(vertices, indices, {base[i], base[(i + 1) % 4], apex});
+    }
+    return renderer.AddMesh(vertices, indices);
+}
+
+struct TestInstance {
+    uint32_t  Mesh;
+    glm::mat4 Transform;
+};
+
+glm::mat4 GetViewProjection(int frame) {
+    const float     angle = 0.05f * static_cast<float>(frame);
+    const glm::vec3 eye(
+        std::sin(angle) * 40.0f, 10.0f, std::cos(angle) * 40.0f);
+    return glm::perspectiveRH_ZO(glm::radians(60.0f), 1.0f, 0.1f, 400.0f) *
+           glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+// What the cull should keep of each mesh: the same world boxes and test.
+void CountVisible(const std::vector<TestInstance> &instances,
+                  const glm::mat4                 &viewProjection,
+                  uint32_t                        *counts) {
+    const brnCore::Frustum frustum =
+        brnCore::Frustum::FromMatrix(viewProjection);
+    for (const TestInstance &instance : instances) {
+        // Both meshes have a unit box around the origin.
+        const glm::mat4 &m = instance.Transform;
+        const glm::vec3  center(m[3]);
+        const glm::vec3  extent =
+            (glm::abs(glm::vec3(m[0])) + glm::abs(glm::vec3(m[1])) +
+             glm::abs(glm::vec3(m[2]))) *
+            0.5f;
+        if (frustum.Intersects(brnCore::Aabb::FromCenter(center, extent))) {
+            counts[instance.Mesh]++;
+        }
+    }
+}
+
+// The instance counts of the indirect draws the last cull wrote.
+bool ReadVisible(SDL_GPUDevice *device,
+                 SDL_GPUBuffer *draws,
+                 uint32_t      *counts) {
+    constexpr Uint32 kBytes =
+        kMeshCount * sizeof(SDL_GPUIndexedIndirectDrawCommand);
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD,
+        .size  = kBytes,
+    };
+    SDL_GPUTransferBuffer *readback =
+        SDL_CreateGPUTransferBuffer(device, &transferInfo);
+    SDL_GPUCommandBuffer *commandBuffer = SDL_AcquireGPUCommandBuffer(device);
+    SDL_GPUCopyPass      *copyPass      = SDL_BeginGPUCopyPass(commandBuffer);
+    const SDL_GPUBufferRegion           source{.buffer = draws, .size = kBytes};
+    const SDL_GPUTransferBufferLocation destination{.transfer_buffer =
+                                                        readback};
+    SDL_DownloadFromGPUBuffer(copyPass, &source, &destination);
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_GPUFence *fence =
+        SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    SDL_WaitForGPUFences(device, true, &fence, 1);
+    SDL_ReleaseGPUFence(device, fence);
+
+    const auto *commands =
+        static_cast<const SDL_GPUIndexedIndirectDrawCommand *>(
+            SDL_MapGPUTransferBuffer(device, readback, false));
+    if (commands) {
+        for (uint32_t mesh = 0; mesh < kMeshCount; mesh++) {
+            counts[mesh] = commands[mesh].num_instances;
+        }
+        SDL_UnmapGPUTransferBuffer(device, readback);
+    }
+    SDL_ReleaseGPUTransferBuffer(device, readback);
+    return commands != nullptr;
+}
+
+SDL_GPUTexture *CreateTarget(SDL_GPUDevice           *device,
+                             SDL_GPUTextureFormat     format,
+                             SDL_GPUTextureUsageFlags usage) {
+    const SDL_GPUTextureCreateInfo textureInfo{
+        .type                 = SDL_GPU_TEXTURETYPE_2D,
+        .format               = format,
+        .usage                = usage,
+        .width                = kTargetSize,
+        .height               = kTargetSize,
+        .layer_count_or_depth = 1,
+        .num_levels           = 1,
+    };
+    return SDL_CreateGPUTexture(device, &textureInfo);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    SDL_GPUDevice *device =
+        SDL_CreateGPUDevice(SDL_GPU_SHADERFORMAT_SPIRV, false, nullptr);
+    if (!device) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "No GPU device: %s",
+                     SDL_GetError());
+        return 1;
+    }
+    SDL_Log("driver %s", SDL_GetGPUDeviceDriver(device));
+
+    auto fileSystem = std::make_shared<brnCore::VirtualFileSystem>();
+    fileSystem->MountDirectory("");
+#if defined(BRAIN_SHADER_ROOT)
+    fileSystem->MountDirectory(BRAIN_SHADER_ROOT);
+#endif
+
+    constexpr SDL_GPUTextureFormat kColorFormat =
+        SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+    constexpr SDL_GPUTextureFormat kDepthFormat =
+        SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
+    SDL_GPUTexture *color = CreateTarget(
+        device, kColorFormat, SDL_GPU_TEXTUREUSAGE_COLOR_TARGET);
+    SDL_GPUTexture *depth = CreateTarget(
+        device, kDepthFormat, SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET);
+
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> position(-0.5f * kWorldSize,
+                                                   0.5f * kWorldSize);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    bool ok = color && depth;
+    SDL_Log("%9s %10s %10s %9s %6s", "instances", "cpu ms", "frame ms",
+            "visible", "draws");
+    for (const uint32_t count : kInstanceCounts) {
+        InstanceRenderer renderer(device,
+                                  fileSystem,
+                                  {.TargetFormat = kColorFormat,
+                                   .DepthFormat  = kDepthFormat,
+                                   .MaxInstances = count});
+        const uint32_t meshes[] = {AddCube(renderer), AddPyramid(renderer)};
+
+        std::vector<TestInstance> instances;
+        instances.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            const glm::vec3 at(position(rng), position(rng), position(rng));
+            const glm::mat4 transform = glm::rotate(
+                glm::translate(glm::mat4(1.0f), at),
+                unit(rng) * 6.2831853f,
+                glm::normalize(glm::vec3(unit(rng), 1.0f, unit(rng))));
+            const SDL_Color tint{static_cast<Uint8>(rng()),
+                                 static_cast<Uint8>(rng()),
+                                 static_cast<Uint8>(rng()),
+                                 255};
+            const uint32_t  mesh = i % kMeshCount;
+            renderer.AddInstance(meshes[mesh], transform, tint);
+            instances.push_back({mesh, transform});
+        }
+
+        // Frame 0 uploads everything; the timed ones change nothing but
+        // the camera.
+        std::vector<double> cpu, frame;
+        for (int i = 0; i <= kFrames; i++) {
+            const Uint64          start = SDL_GetPerformanceCounter();
+            SDL_GPUCommandBuffer *commandBuffer =
+                SDL_AcquireGPUCommandBuffer(device);
+            renderer.Prepare(commandBuffer, GetViewProjection(i));
+
+            const SDL_GPUColorTargetInfo colorTarget{
+                .texture     = color,
+                .clear_color = {0.1f, 0.1f, 0.1f, 1.0f},
+                .load_op     = SDL_GPU_LOADOP_CLEAR,
+                .store_op    = SDL_GPU_STOREOP_STORE,
+            };
+            const SDL_GPUDepthStencilTargetInfo depthTarget{
+                .texture     = depth,
+                .clear_depth = 1.0f,
+                .load_op     = SDL_GPU_LOADOP_CLEAR,
+                .store_op    = SDL_GPU_STOREOP_DONT_CARE,
+            };
+            SDL_GPURenderPass *renderPass = SDL_BeginGPURenderPass(
+                commandBuffer, &colorTarget, 1, &depthTarget);
+            renderer.Render(commandBuffer, renderPass);
+            SDL_EndGPURenderPass(renderPass);
+            SDL_GPUFence *fence =
+                SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+            const double recorded = MillisecondsSince(start);
+
+            SDL_WaitForGPUFences(device, true, &fence, 1);
+            SDL_ReleaseGPUFence(device, fence);
+            if (i > 0) {
+                cpu.push_back(recorded);
+                frame.push_back(MillisecondsSince(start));
+            }
+        }
+        std::ranges::sort(cpu);
+        std::ranges::sort(frame);
+
+        uint32_t gpuCounts[kMeshCount] = {};
+        uint32_t cpuCounts[kMeshCount] = {};
+        const bool read =
+            ReadVisible(device, renderer.GetDrawBuffer(), gpuCounts);
+        CountVisible(instances, GetViewProjection(kFrames), cpuCounts);
+
+        // Floating point may round a box touching a plane either way.
+        bool match = read;
+        for (uint32_t mesh = 0; mesh < kMeshCount; mesh++) {
+            const uint32_t difference =
+                std::max(gpuCounts[mesh], cpuCounts[mesh]) -
+                std::min(gpuCounts[mesh], cpuCounts[mesh]);
+            match = match && difference <= cpuCounts[mesh] / 10'000 + 1;
+        }
+        SDL_Log("%9u %10.3f %10.3f %9u %6u  (cpu %u): %s",
+                count,
+                cpu[cpu.size() / 2],
+                frame[frame.size() / 2],
+                gpuCounts[0] + gpuCounts[1],
+                renderer.GetDrawCount(),
+                cpuCounts[0] + cpuCounts[1],
+                match ? "ok" : "MISMATCH");
+        ok = ok && match;
+    }
+
+    SDL_ReleaseGPUTexture(device, depth);
+    SDL_ReleaseGPUTexture(device, color);
+    SDL_DestroyGPUDevice(device);
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
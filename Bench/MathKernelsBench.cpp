@@ -0,0 +1,412 @@
+#include "Engine/Core/MathKernels.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+/*
+ * Batched math kernels, every variant this CPU runs. Each is first
+ * checked against glm on random inputs, with counts that leave tails,
+ * zero quaternions and slerp ends that are equal or opposite; then every
+ * kernel is timed next to the same work as a glm loop over structs.
+ * Exits with 1 when a variant disagrees with glm.
+ */
+
+namespace {
+constexpr uint32_t kCheckCount = 1'021; // a multiple of no vector width
+constexpr uint32_t kCheckRuns  = 20;
+constexpr uint32_t kCount      = 16'384;
+constexpr int      kIterations = 200;
+constexpr float    kTolerance  = 1e-5f;
+
+using brnCore::MathKernels;
+
+double MillisecondsSince(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1e3 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+// Median nanoseconds per element of `fn` over kCount elements.
+template <typename Fn>
+double MedianNs(Fn &&fn) {
+    std::vector<double> samples;
+    samples.reserve(kIterations);
+    for (int i = 0; i < kIterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        fn();
+        samples.push_back(MillisecondsSince(start));
+    }
+    std::ranges::sort(samples);
+    return samples[samples.size() / 2] * 1e6 / kCount;
+}
+
+// The arrays behind a Vec4Arrays, or the first three of a Vec3Arrays.
+struct Soa {
+    std::vector<float> Data[4];
+
+    explicit Soa(uint32_t count) {
+        for (std::vector<float> &data : Data) {
+            data.resize(count);
+        }
+    }
+
+    brnCore::Vec4Arrays Vec4() {
+        return {Data[0].data(), Data[1].data(), Data[2].data(), Data[3].data()};
+    }
+    brnCore::Vec3Arrays Vec3() {
+        return {Data[0].data(), Data[1].data(), Data[2].data()};
+    }
+
+    void Set(uint32_t i, const glm::vec4 &v) {
+        for (int c = 0; c < 4; c++) {
+            Data[c][i] = v[c];
+        }
+    }
+    glm::vec4 Get(uint32_t i) const {
+        return {Data[0][i], Data[1][i], Data[2][i], Data[3][i]};
+    }
+    void SetQuat(uint32_t i, const glm::quat &q) {
+        Set(i, {q.x, q.y, q.z, q.w});
+    }
+    glm::quat GetQuat(uint32_t i) const {
+        return {Data[3][i], Data[0][i], Data[1][i], Data[2][i]};
+    }
+};
+
+glm::mat4 RandomTransform(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+    std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+    std::normal_distribution<float>       gauss;
+
+    const glm::vec3 axis =
+        glm::normalize(glm::vec3(gauss(rng), gauss(rng), gauss(rng)));
+    const glm::vec3 offset(position(rng), position(rng), position(rng));
+    const glm::mat4 m = glm::rotate(
+        glm::translate(glm::mat4(1.0f), offset), angle(rng), axis);
+    return glm::scale(m, glm::vec3(scale(rng), scale(rng), scale(rng)));
+}
+
+glm::quat RandomQuat(std::mt19937 &rng) {
+    std::normal_distribution<float> gauss;
+    return glm::normalize(
+        glm::quat(gauss(rng), gauss(rng), gauss(rng), gauss(rng)));
+}
+
+// The upper 3x3 with every element made positive, for extents.
+glm::mat3 AbsoluteRotation(const glm::mat4 &m) {
+    glm::mat3 absolute(m);
+    for (int c = 0; c < 3; c++) {
+        absolute[c] = glm::abs(absolute[c]);
+    }
+    return absolute;
+}
+
+// Largest component difference, relative for values above 1.
+float Error(const glm::vec4 &actual, const glm::vec4 &expected) {
+    const glm::vec4 difference = glm::abs(actual - expected) /
+                                 glm::max(glm::abs(expected), 1.0f);
+    return std::max(std::max(difference.x, difference.y),
+                    std::max(difference.z, difference.w));
+}
+
+float Error(const glm::quat &actual, const glm::quat &expected) {
+    return Error(glm::vec4(actual.x, actual.y, actual.z, actual.w),
+                 glm::vec4(expected.x, expected.y, expected.z, expected.w));
+}
+
+// Vectors, or points (null W arrays) when `points` is set.
+float CheckTransformVec4(const MathKernels &kernels,
+                         std::mt19937      &rng,
+                         bool               points) {
+    std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+    float                                 error = 0.0f;
+    for (uint32_t run = 0; run < kCheckRuns; run++) {
+        const glm::mat4 m = RandomTransform(rng);
+        Soa             input(kCheckCount);
+        Soa             output(kCheckCount);
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            input.Set(i, {value(rng), value(rng), value(rng), value(rng)});
+            output.Data[3][i] = -1.0f;
+        }
+
+        brnCore::Vec4Arrays source = input.Vec4();
+        brnCore::Vec4Arrays target = output.Vec4();
+        if (points) {
+            source.W = target.W = nullptr;
+        }
+        kernels.TransformVec4(glm::value_ptr(m), source, target, kCheckCount);
+
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            glm::vec4 v = input.Get(i);
+            if (points) {
+                v.w = 1.0f;
+            }
+            glm::vec4 expected = m * v;
+            if (points) {
+                expected.w = -1.0f; // never written
+            }
+            error = std::max(error, Error(output.Get(i), expected));
+        }
+    }
+    return error;
+}
+
+float CheckTransformAabbs(const MathKernels &kernels, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.0f, 10.0f);
+    float                                 error = 0.0f;
+    for (uint32_t run = 0; run < kCheckRuns; run++) {
+        const glm::mat4 m        = RandomTransform(rng);
+        const glm::mat3 absolute = AbsoluteRotation(m);
+
+        Soa centers(kCheckCount);
+        Soa extents(kCheckCount);
+        Soa outputCenters(kCheckCount);
+        Soa outputExtents(kCheckCount);
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            centers.Set(i, {value(rng), value(rng), value(rng), 0.0f});
+            extents.Set(i, {size(rng), size(rng), size(rng), 0.0f});
+        }
+        kernels.TransformAabbs(glm::value_ptr(m),
+                               centers.Vec3(),
+                               extents.Vec3(),
+                               outputCenters.Vec3(),
+                               outputExtents.Vec3(),
+                               kCheckCount);
+
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            const glm::vec4 center =
+                m * glm::vec4(glm::vec3(centers.Get(i)), 1.0f);
+            const glm::vec3 extent = absolute * glm::vec3(extents.Get(i));
+            error = std::max({error,
+                              Error(outputCenters.Get(i),
+                                    glm::vec4(glm::vec3(center), 0.0f)),
+                              Error(outputExtents.Get(i),
+                                    glm::vec4(extent, 0.0f))});
+        }
+    }
+    return error;
+}
+
+float CheckNormalizeQuats(const MathKernels &kernels, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> value(-5.0f, 5.0f);
+    float                                 error = 0.0f;
+    for (uint32_t run = 0; run < kCheckRuns; run++) {
+        Soa quats(kCheckCount);
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            // Every seventh one zero, which becomes the identity.
+            const float k = i % 7 == 0 ? 0.0f : 1.0f;
+            quats.SetQuat(i,
+                          glm::quat(k * value(rng),
+                                    k * value(rng),
+                                    k * value(rng),
+                                    k * value(rng)));
+        }
+        const Soa input = quats;
+        kernels.NormalizeQuats(quats.Vec4(), kCheckCount);
+
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            error = std::max(error,
+                             Error(quats.GetQuat(i),
+                                   glm::normalize(input.GetQuat(i))));
+        }
+    }
+    return error;
+}
+
+float CheckSlerpQuats(const MathKernels &kernels, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> fraction(0.0f, 1.0f);
+    float                                 error = 0.0f;
+    for (uint32_t run = 0; run < kCheckRuns; run++) {
+        Soa                from(kCheckCount);
+        Soa                to(kCheckCount);
+        Soa                output(kCheckCount);
+        std::vector<float> t(kCheckCount);
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            const glm::quat a = RandomQuat(rng);
+            glm::quat       b = RandomQuat(rng);
+            // Some equal and some opposite ends, which take other paths.
+            if (i % 11 == 0) {
+                b = a;
+            } else if (i % 11 == 1) {
+                b = -a;
+            }
+            from.SetQuat(i, a);
+            to.SetQuat(i, b);
+            t[i] = fraction(rng);
+        }
+        kernels.SlerpQuats(
+            from.Vec4(), to.Vec4(), t.data(), output.Vec4(), kCheckCount);
+
+        for (uint32_t i = 0; i < kCheckCount; i++) {
+            const glm::quat expected =
+                glm::slerp(from.GetQuat(i), to.GetQuat(i), t[i]);
+            error = std::max(error, Error(output.GetQuat(i), expected));
+        }
+    }
+    return error;
+}
+
+// Timing inputs, as arrays for the kernels and as structs for glm.
+struct Workload {
+    glm::mat4 Matrix;
+    Soa       Vectors{kCount};
+    Soa       Extents{kCount};
+    Soa       From{kCount};
+    Soa       To{kCount};
+    Soa       Output{kCount};
+    Soa       OutputExtents{kCount};
+
+    std::vector<float>     T;
+    std::vector<glm::vec4> VectorStructs;
+    std::vector<glm::vec3> ExtentStructs;
+    std::vector<glm::quat> FromStructs;
+    std::vector<glm::quat> ToStructs;
+    std::vector<glm::vec4> OutputStructs;
+    std::vector<glm::vec3> OutputExtentStructs;
+    std::vector<glm::quat> OutputQuats;
+
+    explicit Workload(std::mt19937 &rng) : Matrix(RandomTransform(rng)) {
+        std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> fraction(0.0f, 1.0f);
+        for (uint32_t i = 0; i < kCount; i++) {
+            const glm::vec4 v(value(rng), value(rng), value(rng), 1.0f);
+            const glm::vec3 e = glm::abs(glm::vec3(v)) * 0.1f;
+            const glm::quat a = RandomQuat(rng);
+            const glm::quat b = RandomQuat(rng);
+            Vectors.Set(i, v);
+            Extents.Set(i, glm::vec4(e, 0.0f));
+            From.SetQuat(i, a);
+            To.SetQuat(i, b);
+            T.push_back(fraction(rng));
+            VectorStructs.push_back(v);
+            ExtentStructs.push_back(e);
+            FromStructs.push_back(a);
+            ToStructs.push_back(b);
+        }
+        OutputStructs.resize(kCount);
+        OutputExtentStructs.resize(kCount);
+        OutputQuats.resize(kCount);
+    }
+};
+
+struct Timings {
+    double Vec4;
+    double Aabbs;
+    double Normalize;
+    double Slerp;
+};
+
+Timings Time(const MathKernels &kernels, Workload &work) {
+    const float *m = glm::value_ptr(work.Matrix);
+    Timings      timings;
+    timings.Vec4 = MedianNs([&] {
+        kernels.TransformVec4(
+            m, work.Vectors.Vec4(), work.Output.Vec4(), kCount);
+    });
+    timings.Aabbs = MedianNs([&] {
+        kernels.TransformAabbs(m,
+                               work.Vectors.Vec3(),
+                               work.Extents.Vec3(),
+                               work.Output.Vec3(),
+                               work.OutputExtents.Vec3(),
+                               kCount);
+    });
+    timings.Normalize = MedianNs([&] {
+        work.Output = work.From;
+        kernels.NormalizeQuats(work.Output.Vec4(), kCount);
+    });
+    timings.Slerp = MedianNs([&] {
+        kernels.SlerpQuats(work.From.Vec4(),
+                           work.To.Vec4(),
+                           work.T.data(),
+                           work.Output.Vec4(),
+                           kCount);
+    });
+    return timings;
+}
+
+Timings TimeGlm(Workload &work) {
+    const glm::mat4 &m = work.Matrix;
+    const glm::mat3  absolute = AbsoluteRotation(m);
+    Timings          timings;
+    timings.Vec4 = MedianNs([&] {
+        for (uint32_t i = 0; i < kCount; i++) {
+            work.OutputStructs[i] = m * work.VectorStructs[i];
+        }
+    });
+    timings.Aabbs = MedianNs([&] {
+        for (uint32_t i = 0; i < kCount; i++) {
+            work.OutputStructs[i]       = m * work.VectorStructs[i];
+            work.OutputExtentStructs[i] = absolute * work.ExtentStructs[i];
+        }
+    });
+    timings.Normalize = MedianNs([&] {
+        work.OutputQuats = work.FromStructs;
+        for (glm::quat &q : work.OutputQuats) {
+            q = glm::normalize(q);
+        }
+    });
+    timings.Slerp = MedianNs([&] {
+        for (uint32_t i = 0; i < kCount; i++) {
+            work.OutputQuats[i] = glm::slerp(
+                work.FromStructs[i], work.ToStructs[i], work.T[i]);
+        }
+    });
+    return timings;
+}
+
+void LogTimings(const char *name, const Timings &timings) {
+    SDL_Log("%-8s %9.3f %9.3f %9.3f %9.3f",
+            name,
+            timings.Vec4,
+            timings.Aabbs,
+            timings.Normalize,
+            timings.Slerp);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    std::mt19937 rng(5);
+
+    bool ok = true;
+    for (const MathKernels &kernels : brnCore::GetSupportedMathKernels()) {
+        const float errors[] = {CheckTransformVec4(kernels, rng, false),
+                                CheckTransformVec4(kernels, rng, true),
+                                CheckTransformAabbs(kernels, rng),
+                                CheckNormalizeQuats(kernels, rng),
+                                CheckSlerpQuats(kernels, rng)};
+        const bool   match   = std::ranges::all_of(
+            errors, [](float error) { return error < kTolerance; });
+        SDL_Log("verify   %-8s vec4 %.1e points %.1e aabbs %.1e "
+                "normalize %.1e slerp %.1e: %s",
+                kernels.Name,
+                errors[0],
+                errors[1],
+                errors[2],
+                errors[3],
+                errors[4],
+                match ? "ok" : "MISMATCH");
+        ok = ok && match;
+    }
+
+    Workload work(rng);
+    SDL_Log("ns per element, %u elements:", kCount);
+    SDL_Log("%-8s %9s %9s %9s %9s", "", "vec4", "aabbs", "normalize", "slerp");
+    for (const MathKernels &kernels : brnCore::GetSupportedMathKernels()) {
+        LogTimings(kernels.Name, Time(kernels, work));
+    }
+    LogTimings("glm", TimeGlm(work));
+    SDL_Log("(%s chosen for this CPU)", brnCore::GetMathKernels().Name);
+
+    return ok ? 0 : 1;
+}
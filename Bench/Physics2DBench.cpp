@@ -0,0 +1,138 @@
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Physics/PhysicsWorld2D.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/*
+ * 20k boxes and circles dropped into twenty bins, stepped at 60 Hz with one
+ * thread and with the job system. Reports the median step while the piles
+ * are moving, how long they take to fall asleep and the step cost once
+ * they are (which should be close to the broadphase alone).
+ */
+
+namespace {
+constexpr int   kBinCount     = 20;
+constexpr int   kColumns      = 40; // per bin
+constexpr int   kRows         = 25;
+constexpr float kDt           = 1.0f / 60.0f;
+constexpr int   kMovingFrames = 240;
+constexpr int   kMaxFrames    = 2400;
+constexpr int   kIdleFrames   = 60;
+
+struct Result {
+    double                  MovingMs   = 0.0;
+    double                  IdleMs     = 0.0;
+    int                     SleepFrame = -1;
+    brnCore::PhysicsStats2D MovingStats;
+};
+
+double Median(std::vector<double> &samples) {
+    std::ranges::sort(samples);
+    return samples[samples.size() / 2];
+}
+
+void BuildScene(brnCore::PhysicsWorld2D &world) {
+    std::mt19937                          rng(3);
+    std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+
+    brnCore::BodySpecification2D wall;
+    wall.Type = brnCore::BodyType2D::Static;
+
+    // One floor under all bins, walls between them.
+    const float binWidth       = kColumns * 1.2f;
+    const float floorHalfWidth = kBinCount * (binWidth + 1.0f);
+    wall.Shape    = brnCore::Shape2D::MakeBox({floorHalfWidth, 1.0f});
+    wall.Position = glm::vec2(0.0f, -1.0f);
+    world.CreateBody(wall);
+
+    wall.Shape = brnCore::Shape2D::MakeBox({0.5f, kRows * 1.2f});
+    for (int bin = 0; bin <= kBinCount; bin++) {
+        wall.Position =
+            glm::vec2(bin * (binWidth + 1.0f) - 0.5f, kRows * 1.2f);
+        world.CreateBody(wall);
+    }
+
+    brnCore::BodySpecification2D body;
+    for (int bin = 0; bin < kBinCount; bin++) {
+        const float left = bin * (binWidth + 1.0f) + 0.6f;
+        for (int row = 0; row < kRows; row++) {
+            for (int column = 0; column < kColumns; column++) {
+                body.Shape = (row + column) % 3 == 0
+                                 ? brnCore::Shape2D::MakeCircle(0.45f)
+                                 : brnCore::Shape2D::MakeBox({0.45f, 0.45f});
+                body.Position =
+                    glm::vec2(left + column * 1.2f + jitter(rng),
+                              1.0f + row * 1.2f);
+                body.Angle = jitter(rng);
+                world.CreateBody(body);
+            }
+        }
+    }
+}
+
+Result RunScene(brnCore::JobSystem *jobs) {
+    brnCore::PhysicsWorld2D world;
+    BuildScene(world);
+
+    Result              result;
+    std::vector<double> samples;
+    for (int frame = 0; frame < kMaxFrames; frame++) {
+        world.Step(kDt, jobs);
+        const brnCore::PhysicsStats2D &stats = world.GetStats();
+
+        samples.push_back(stats.StepMs);
+        if (frame + 1 == kMovingFrames) {
+            result.MovingMs    = Median(samples);
+            result.MovingStats = stats;
+        }
+        if (result.SleepFrame < 0 && stats.AwakeBodyCount == 0) {
+            result.SleepFrame = frame;
+        }
+        if (result.SleepFrame >= 0 &&
+            frame >= result.SleepFrame + kIdleFrames) {
+            break;
+        }
+    }
+
+    samples.erase(samples.begin(), samples.end() - kIdleFrames);
+    result.IdleMs = Median(samples);
+    return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    brnCore::JobSystem jobs;
+
+    const Result serial   = RunScene(nullptr);
+    const Result parallel = RunScene(&jobs);
+
+    const brnCore::PhysicsStats2D &stats = parallel.MovingStats;
+    SDL_Log("%u bodies, %u contacts (%u solved), %u colors, %u overflow, "
+            "%u islands",
+            stats.BodyCount,
+            stats.ContactCount,
+            stats.SolvedContacts,
+            stats.ColorCount,
+            stats.OverflowCount,
+            stats.IslandCount);
+    SDL_Log("%-24s %12s %12s", "", "1 thread", "jobs");
+    SDL_Log("%-24s %9.3f ms %9.3f ms",
+            "moving (median step)",
+            serial.MovingMs,
+            parallel.MovingMs);
+    SDL_Log("%-24s %9.3f ms %9.3f ms",
+            "asleep (median step)",
+            serial.IdleMs,
+            parallel.IdleMs);
+    SDL_Log("%-24s %12d %12d",
+            "frames until asleep",
+            serial.SleepFrame,
+            parallel.SleepFrame);
+    SDL_Log("(%u threads, budget at 60 Hz: 16.6 ms)", jobs.GetThreadCount());
+
+    return 0;
+}
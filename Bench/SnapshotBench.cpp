@@ -0,0 +1,164 @@
+#include "Engine/ECS/Snapshot.h"
+#include "Engine/ECS/World.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+/*
+ * Saves a 2M entity world (~100 MB), restores it and writes a delta after
+ * touching 1% of it. Restore is a memcpy per chunk out of the mapped file,
+ * so it should run close to memory bandwidth once the file is in the page
+ * cache, and the delta should be about the size of the touched pages.
+ * A copy of the delta cut short must fail to restore and leave the world
+ * as it was.
+ */
+
+namespace {
+struct Position {
+    float x, y, z;
+};
+struct Velocity {
+    float x, y, z;
+};
+struct Health {
+    float   Value;
+    int32_t Team;
+};
+struct Target {
+    brnCore::Entity Entity;
+};
+
+constexpr size_t kEntityCount  = 2'000'000;
+constexpr size_t kChangedEvery = 100;
+
+const char *const kBasePath  = "SnapshotBench.base";
+const char *const kDeltaPath = "SnapshotBench.delta";
+const char *const kCutPath   = "SnapshotBench.cut";
+
+double MillisecondsSince(Uint64 start) {
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1e3 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+double MegabytesPerSecond(size_t bytes, double milliseconds) {
+    return static_cast<double>(bytes) / (1 << 20) / (milliseconds / 1e3);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    brnCore::World world;
+    for (size_t i = 0; i < kEntityCount; i++) {
+        const float f = static_cast<float>(i);
+        if (i % 4 == 0) {
+            world.CreateEntity(Position{f, f, f}, Health{100.0f, 1});
+        } else {
+            world.CreateEntity(Position{f, f, f},
+                               Velocity{1.0f, 0.0f, 0.0f},
+                               Health{100.0f, 0},
+                               Target{{static_cast<uint32_t>(i / 2), 0}});
+        }
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (!brnCore::Snapshot::Write(world, kBasePath)) {
+        return 1;
+    }
+    const double writeMs = MillisecondsSince(start);
+
+    brnCore::Snapshot base;
+    start = SDL_GetPerformanceCounter();
+    base.Open(kBasePath);
+    const double openMs = MillisecondsSince(start);
+    const size_t size   = base.GetFileSize();
+
+    // Read a column in place, straight from the mapping.
+    start      = SDL_GetPerformanceCounter();
+    double sum = 0.0;
+    for (uint32_t a = 0; a < base.GetArchetypeCount(); a++) {
+        const auto *positions = static_cast<const Position *>(base.GetColumn(
+            a, brnCore::ComponentRegistry::GetId<Position>()));
+        const size_t count = base.GetEntities(a).size();
+        for (size_t i = 0; positions && i < count; i++) {
+            sum += positions[i].x;
+        }
+    }
+    const double inPlaceMs = MillisecondsSince(start);
+
+    brnCore::World restored;
+    start = SDL_GetPerformanceCounter();
+    base.Restore(restored);
+    const double restoreMs = MillisecondsSince(start);
+
+    // Autosave: 1% of the positions moved since the base was written.
+    restored.Each<Position>([](brnCore::Entity entity, Position &position) {
+        if (entity.Index % kChangedEvery == 0) {
+            position.y += 1.0f;
+        }
+    });
+    start = SDL_GetPerformanceCounter();
+    brnCore::Snapshot::Write(restored, kDeltaPath, &base);
+    const double deltaWriteMs = MillisecondsSince(start);
+
+    brnCore::Snapshot delta;
+    delta.Open(kDeltaPath);
+    brnCore::World rolledBack;
+    start = SDL_GetPerformanceCounter();
+    const bool ok = delta.Restore(rolledBack, &base);
+    const double deltaRestoreMs = MillisecondsSince(start);
+
+    const brnCore::Entity probe{kChangedEvery, 0};
+    const Position *check = rolledBack.GetComponent<Position>(probe);
+    const bool      rolledBackOk =
+        ok && check && check->y == kChangedEvery + 1.0f;
+
+    // Drop the tail of the last block's pages.
+    bool   cutRejected = false;
+    size_t deltaSize   = 0;
+    if (void *bytes = SDL_LoadFile(kDeltaPath, &deltaSize)) {
+        SDL_SaveFile(kCutPath, bytes, deltaSize - 64);
+        SDL_free(bytes);
+
+        brnCore::Snapshot cut;
+        const size_t      count = rolledBack.GetEntityCount();
+        cutRejected =
+            !(cut.Open(kCutPath) && cut.Restore(rolledBack, &base)) &&
+            rolledBack.GetEntityCount() == count &&
+            rolledBack.GetComponent<Position>(probe) == check &&
+            check->y == kChangedEvery + 1.0f;
+        cut.Close();
+        SDL_RemovePath(kCutPath);
+    }
+
+    SDL_Log("%zu entities, %.1f MB snapshot (checksum %.0f)",
+            rolledBack.GetEntityCount(),
+            static_cast<double>(size) / (1 << 20),
+            sum);
+    SDL_Log("write          %9.2f ms  %8.0f MB/s",
+            writeMs,
+            MegabytesPerSecond(size, writeMs));
+    SDL_Log("open           %9.3f ms", openMs);
+    SDL_Log("read in place  %9.2f ms  %8.0f MB/s",
+            inPlaceMs,
+            MegabytesPerSecond(size, inPlaceMs));
+    SDL_Log("restore        %9.2f ms  %8.0f MB/s",
+            restoreMs,
+            MegabytesPerSecond(size, restoreMs));
+    SDL_Log("delta write    %9.2f ms  %8.2f MB stored (%.1f%%)",
+            deltaWriteMs,
+            static_cast<double>(delta.GetStoredBytes()) / (1 << 20),
+            100.0 * static_cast<double>(delta.GetStoredBytes()) /
+                static_cast<double>(base.GetStoredBytes()));
+    SDL_Log("delta restore  %9.2f ms  %s",
+            deltaRestoreMs,
+            rolledBackOk ? "ok" : "MISMATCH");
+    SDL_Log("cut delta      %s", cutRejected ? "rejected" : "ACCEPTED");
+
+    base.Close();
+    delta.Close();
+    SDL_RemovePath(kBasePath);
+    SDL_RemovePath(kDeltaPath);
+    return rolledBackOk && cutRejected ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include "Archive.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/StringId.h"
+
+namespace brnCore {
+
+bool Archive::Open(const char *path) {
+    Close();
+    if (!m_File.Open(path)) {
+        return false;
+    }
+
+    auto fail = [&](const char *reason) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Archive: %s: %s", path, reason);
+        Close();
+        return false;
+    };
+
+    if (m_File.GetSize() < sizeof(Header)) {
+        return fail("truncated header");
+    }
+    const Header &header = GetHeader();
+    if (header.Magic != kMagic) {
+        return fail("not an archive");
+    }
+    if (header.Version != kVersion) {
+        return fail("unsupported version");
+    }
+    if (header.BucketBits > 31 ||
+        header.TocOffset + header.TocSize > m_File.GetSize()) {
+        return fail("truncated table of contents");
+    }
+
+    const size_t bucketCount = (size_t(1) << header.BucketBits) + 1;
+    const size_t tocSize     = header.EntryCount * sizeof(Entry) +
+                           bucketCount * sizeof(uint32_t) +
+                           header.BlockCount * sizeof(uint32_t) +
+                           header.NamesSize;
+    const std::byte *toc = m_File.GetData() + header.TocOffset;
+    if (tocSize != header.TocSize || header.TocOffset % alignof(Entry) ||
+        HashBytes(toc, tocSize) != header.TocHash) {
+        return fail("corrupt table of contents");
+    }
+
+    m_Entries    = reinterpret_cast<const Entry *>(toc);
+    m_Buckets    = reinterpret_cast<const uint32_t *>(m_Entries +
+                                                   header.EntryCount);
+    m_BlockSizes = m_Buckets + bucketCount;
+    m_Names = reinterpret_cast<const char *>(m_BlockSizes + header.BlockCount);
+
+    // Only the table is checked here; entry data is paged in by use.
+    for (uint32_t i = 0; i < header.EntryCount; i++) {
+        const Entry &entry = m_Entries[i];
+        if (entry.Offset + entry.StoredSize > header.TocOffset ||
+            entry.FirstBlock + uint64_t(entry.BlockCount) >
+                header.BlockCount ||
+            entry.NameOffset + uint64_t(entry.NameLength) >
+                header.NamesSize) {
+            return fail("entry out of range");
+        }
+        // Read() copies Size bytes of a stored entry.
+        if (!(entry.Flags & kCompressed) && entry.Size != entry.StoredSize) {
+            return fail("entry size mismatch");
+        }
+    }
+    // Find() walks [m_Buckets[b], m_Buckets[b + 1]) of the entries.
+    for (size_t i = 0; i < bucketCount; i++) {
+        if (m_Buckets[i] > header.EntryCount ||
+            (i > 0 && m_Buckets[i] < m_Buckets[i - 1])) {
+            return fail("corrupt bucket index");
+        }
+    }
+    if (m_Buckets[bucketCount - 1] != header.EntryCount) {
+        return fail("corrupt bucket index");
+    }
+    return true;
+}
+
+void Archive::Close() {
+    m_File.Close();
+    m_Entries    = nullptr;
+    m_Buckets    = nullptr;
+    m_BlockSizes = nullptr;
+    m_Names      = nullptr;
+}
+
+uint32_t Archive::Find(std::string_view path) const {
+    if (!IsOpen()) {
+        return kNotFound;
+    }
+
+    // Sorted by hash, so a bucket of the top hash bits is one range.
+    const Header  &header = GetHeader();
+    const uint64_t hash   = HashFnv1a(path);
+    const uint64_t bucket =
+        header.BucketBits ? hash >> (64 - header.BucketBits) : 0;
+    for (uint32_t i = m_Buckets[bucket]; i < m_Buckets[bucket + 1]; i++) {
+        if (m_Entries[i].PathHash == hash && GetName(i) == path) {
+            return i;
+        }
+    }
+    return kNotFound;
+}
+
+uint32_t Archive::GetEntryCount() const {
+    return IsOpen() ? GetHeader().EntryCount : 0;
+}
+
+std::string_view Archive::GetName(uint32_t entry) const {
+    return {m_Names + GetEntry(entry).NameOffset, GetEntry(entry).NameLength};
+}
+
+uint64_t Archive::GetSize(uint32_t entry) const {
+    return GetEntry(entry).Size;
+}
+
+uint64_t Archive::GetContentHash(uint32_t entry) const {
+    return GetEntry(entry).ContentHash;
+}
+
+uint32_t Archive::GetFlags(uint32_t entry) const {
+    return GetEntry(entry).Flags;
+}
+
+std::span<const std::byte> Archive::GetView(uint32_t entry) const {
+    if (IsCompressed(entry)) {
+        return {};
+    }
+    return GetStoredBytes(entry);
+}
+
+std::span<const std::byte> Archive::GetStoredBytes(uint32_t entry) const {
+    const Entry &record = GetEntry(entry);
+    return {m_File.GetData() + record.Offset, record.StoredSize};
+}
+
+std::span<const uint32_t> Archive::GetBlockSizes(uint32_t entry) const {
+    const Entry &record = GetEntry(entry);
+    return {m_BlockSizes + record.FirstBlock, record.BlockCount};
+}
+
+bool Archive::Read(uint32_t entry, std::span<std::byte> out) const {
+    const Entry &record = GetEntry(entry);
+    if (out.size() < record.Size) {
+        return false;
+    }
+    if (!IsCompressed(entry)) {
+        std::memcpy(out.data(), m_File.GetData() + record.Offset, record.Size);
+        return true;
+    }
+
+    // A block that didn't shrink is stored raw, at its full size.
+    const std::byte *source = m_File.GetData() + record.Offset;
+    const std::byte *end    = source + record.StoredSize;
+    size_t           offset = 0;
+    for (uint32_t storedSize : GetBlockSizes(entry)) {
+        // More blocks than the entry's size takes.
+        if (offset == record.Size) {
+            return false;
+        }
+        const size_t blockSize = std::min(kBlockSize, record.Size - offset);
+        if (source + storedSize > end) {
+            return false;
+        }
+        if (storedSize == blockSize) {
+            std::memcpy(out.data() + offset, source, blockSize);
+        } else if (LZ4_decompress_safe(
+                       reinterpret_cast<const char *>(source),
+                       reinterpret_cast<char *>(out.data() + offset),
+                       static_cast<int>(storedSize),
+                       static_cast<int>(blockSize)) !=
+                   static_cast<int>(blockSize)) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "Archive: corrupt block in %.*s",
+                         static_cast<int>(record.NameLength),
+                         m_Names + record.NameOffset);
+            return false;
+        }
+        source += storedSize;
+        offset += blockSize;
+    }
+    return offset == record.Size;
+}
+
+const Archive::Header &Archive::GetHeader() const {
+    return *reinterpret_cast<const Header *>(m_File.GetData());
+}
+
+const Archive::Entry &Archive::GetEntry(uint32_t entry) const {
+    return m_Entries[entry];
+}
+
+} // namespace brnCore
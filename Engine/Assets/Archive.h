@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "Engine/Core/MappedFile.h"
+
+namespace brnCore {
+
+/*
+ * Read-only packed asset archive (.brn), written by ArchiveWriter /
+ * BrainPack.
+ *
+ * Entries start on 4 KB boundaries and are either stored as-is or split
+ * into 64 KB blocks that are LZ4 compressed independently. The table of
+ * contents is sorted by path hash and indexed by the top bits of the
+ * hash, so Find() looks at one bucket of about one entry; no syscall is
+ * made per file. The whole archive is mapped, so stored entries are
+ * returned as views into the mapping without a copy.
+ */
+class Archive {
+  public:
+    static constexpr uint32_t kMagic     = 0x414e5242; // "BRNA"
+    static constexpr uint16_t kVersion   = 1;
+    static constexpr size_t   kAlignment = 4096;
+    static constexpr size_t   kBlockSize = 64 << 10;
+    static constexpr uint32_t kNotFound  = ~0u;
+
+    struct Header;
+    struct Entry;
+
+    // Entry flags.
+    static constexpr uint32_t kCompressed        = 1 << 0; // LZ4 blocks
+    static constexpr uint32_t kCompressRequested = 1 << 1; // even if stored
+
+    Archive() = default;
+
+    // Maps the file and validates the header and table of contents.
+    bool Open(const char *path);
+    void Close();
+    bool IsOpen() const { return m_File.IsOpen(); }
+
+    uint32_t Find(std::string_view path) const;
+
+    uint32_t         GetEntryCount() const;
+    std::string_view GetName(uint32_t entry) const;
+    uint64_t         GetSize(uint32_t entry) const;
+    uint64_t         GetContentHash(uint32_t entry) const;
+    uint32_t         GetFlags(uint32_t entry) const;
+    bool             IsCompressed(uint32_t entry) const {
+        return GetFlags(entry) & kCompressed;
+    }
+
+    // The entry's bytes in the mapping; empty if it is compressed.
+    std::span<const std::byte> GetView(uint32_t entry) const;
+    // The entry as stored in the file, for copying it to a new archive.
+    std::span<const std::byte> GetStoredBytes(uint32_t entry) const;
+    std::span<const uint32_t>  GetBlockSizes(uint32_t entry) const;
+
+    // Decompresses (or copies) an entry into `out`, sized GetSize().
+    bool Read(uint32_t entry, std::span<std::byte> out) const;
+
+  private:
+    const Header &GetHeader() const;
+    const Entry  &GetEntry(uint32_t entry) const;
+
+    MappedFile      m_File;
+    const Entry    *m_Entries    = nullptr;
+    const uint32_t *m_Buckets    = nullptr;
+    const uint32_t *m_BlockSizes = nullptr;
+    const char     *m_Names      = nullptr;
+};
+
+struct Archive::Header {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Reserved;
+    uint32_t EntryCount;
+    uint32_t BucketBits; // Buckets has (1 << BucketBits) + 1 entries
+    uint32_t BlockCount;
+    uint32_t NamesSize;
+    uint64_t TocOffset; // entries, buckets, block sizes, names
+    uint64_t TocSize;
+    uint64_t TocHash;
+};
+
+struct Archive::Entry {
+    uint64_t PathHash;    // HashFnv1a of the path, the sort key
+    uint64_t ContentHash; // HashBytes of the uncompressed bytes
+    uint64_t Offset;
+    uint64_t Size; // uncompressed
+    uint64_t StoredSize;
+    uint32_t FirstBlock; // into the block size table
+    uint32_t BlockCount; // 0 unless compressed
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t Flags;
+    uint32_t Reserved;
+};
+
+} // namespace brnCore
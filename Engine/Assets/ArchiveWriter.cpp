@@ -0,0 +1,321 @@
+#include "ArchiveWriter.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+#include "Engine/Core/FileWriter.h"
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/StringId.h"
+
+namespace brnCore {
+
+ArchiveWriter::ArchiveWriter(const ArchiveWriterSpecification &specification)
+    : m_Specification(specification) {}
+
+void ArchiveWriter::AddFile(std::string name,
+                            std::string sourcePath,
+                            bool        compress) {
+    Source &source  = m_Sources.emplace_back();
+    source.Name     = std::move(name);
+    source.Path     = std::move(sourcePath);
+    source.Compress = compress;
+}
+
+void ArchiveWriter::AddBytes(std::string            name,
+                             std::vector<std::byte> bytes,
+                             bool                   compress) {
+    Source &source  = m_Sources.emplace_back();
+    source.Name     = std::move(name);
+    source.Bytes    = std::move(bytes);
+    source.Compress = compress;
+}
+
+bool ArchiveWriter::Write(const char *path,
+                          JobSystem  *jobSystem,
+                          Archive    *previous) {
+    m_Stats         = {};
+    const auto size = static_cast<uint32_t>(m_Sources.size());
+
+    auto parallelFor = [&](uint32_t begin, uint32_t end, auto &&fn) {
+        auto range = [&](uint32_t first, uint32_t last) {
+            for (uint32_t i = begin + first; i < begin + last; i++) {
+                fn(m_Sources[i]);
+            }
+        };
+        if (jobSystem) {
+            jobSystem->ParallelFor(end - begin, 1, range);
+        } else {
+            range(0, end - begin);
+        }
+    };
+
+    // The table is sorted by path hash; equal names end up side by side.
+    std::vector<uint64_t> pathHashes(size);
+    std::vector<uint32_t> order(size);
+    std::iota(order.begin(), order.end(), 0u);
+    for (uint32_t i = 0; i < size; i++) {
+        pathHashes[i] = HashFnv1a(m_Sources[i].Name);
+    }
+    std::ranges::sort(order, [&](uint32_t a, uint32_t b) {
+        return pathHashes[a] != pathHashes[b]
+                   ? pathHashes[a] < pathHashes[b]
+                   : m_Sources[a].Name < m_Sources[b].Name;
+    });
+    for (uint32_t i = 1; i < size; i++) {
+        if (m_Sources[order[i]].Name == m_Sources[order[i - 1]].Name) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "ArchiveWriter: %s added twice",
+                         m_Sources[order[i]].Name.c_str());
+            return false;
+        }
+    }
+
+    // Hash everything first; unchanged entries needn't be compressed.
+    if (previous && !previous->IsOpen()) {
+        previous = nullptr;
+    }
+    parallelFor(0, size, [&](Source &source) {
+        source.Failed = !Load(source);
+        source.Hash   = HashBytes(source.Bytes.data(), source.Bytes.size());
+        source.Size   = source.Bytes.size();
+        if (!source.Path.empty()) {
+            std::vector<std::byte>().swap(source.Bytes);
+        }
+
+        const uint32_t entry =
+            previous ? previous->Find(source.Name) : Archive::kNotFound;
+        const uint32_t requested =
+            source.Compress ? Archive::kCompressRequested : 0;
+        if (entry != Archive::kNotFound &&
+            previous->GetContentHash(entry) == source.Hash &&
+            previous->GetSize(entry) == source.Size &&
+            (previous->GetFlags(entry) & Archive::kCompressRequested) ==
+                requested) {
+            source.Reuse = entry;
+        }
+    });
+
+    uint32_t reused = 0;
+    for (const Source &source : m_Sources) {
+        if (source.Failed) {
+            return false;
+        }
+        reused += source.Reuse != Archive::kNotFound;
+    }
+    if (previous && reused == size && previous->GetEntryCount() == size) {
+        m_Stats.Entries  = size;
+        m_Stats.Reused   = size;
+        m_Stats.UpToDate = true;
+        return true;
+    }
+
+    FileWriter writer;
+    if (!writer.Open(path)) {
+        return false;
+    }
+    Archive::Header header{};
+    writer.Write(&header, sizeof(header));
+
+    std::vector<Archive::Entry> entries(size);
+    std::vector<uint32_t>       blockSizes;
+    for (uint32_t begin = 0; begin < size && writer.IsOk();) {
+        // Bound the source bytes in memory, not the entry count.
+        uint32_t end       = begin;
+        size_t   batchSize = 0;
+        while (end < size && (end == begin ||
+                              batchSize + m_Sources[end].Size <=
+                                  m_Specification.BatchSize)) {
+            batchSize += m_Sources[end++].Size;
+        }
+
+        parallelFor(begin, end, [&](Source &source) {
+            if (source.Reuse != Archive::kNotFound) {
+                return;
+            }
+            if (!Load(source)) {
+                source.Failed = true;
+                return;
+            }
+            // The hash must describe what is stored.
+            if (HashBytes(source.Bytes.data(), source.Bytes.size()) !=
+                source.Hash) {
+                SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                             "ArchiveWriter: %s changed while packing",
+                             source.Name.c_str());
+                source.Failed = true;
+                return;
+            }
+            if (source.Compress) {
+                Compress(source);
+            }
+        });
+
+        for (uint32_t i = begin; i < end; i++) {
+            Source &source = m_Sources[i];
+            if (source.Failed) {
+                return false;
+            }
+
+            uint32_t flags = source.Compress ? Archive::kCompressRequested : 0;
+
+            std::span<const std::byte> bytes = source.Bytes;
+            std::span<const uint32_t>  blocks;
+            if (source.Reuse != Archive::kNotFound) {
+                bytes  = previous->GetStoredBytes(source.Reuse);
+                blocks = previous->GetBlockSizes(source.Reuse);
+                flags  = previous->GetFlags(source.Reuse);
+                m_Stats.Reused++;
+            } else if (!source.BlockSizes.empty()) {
+                bytes  = source.Stored;
+                blocks = source.BlockSizes;
+                flags |= Archive::kCompressed;
+            }
+
+            writer.Pad(Archive::kAlignment);
+            Archive::Entry &entry = entries[i];
+            entry.PathHash        = pathHashes[i];
+            entry.ContentHash     = source.Hash;
+            entry.Offset          = writer.GetPosition();
+            entry.Size            = source.Size;
+            entry.StoredSize      = bytes.size();
+            entry.FirstBlock      = static_cast<uint32_t>(blockSizes.size());
+            entry.BlockCount      = static_cast<uint32_t>(blocks.size());
+            entry.Flags           = flags;
+            writer.Write(bytes.data(), bytes.size());
+            blockSizes.insert(blockSizes.end(), blocks.begin(), blocks.end());
+
+            m_Stats.Compressed += entry.BlockCount > 0;
+            m_Stats.Size += entry.Size;
+            m_Stats.StoredSize += entry.StoredSize;
+
+            std::vector<std::byte>().swap(source.Stored);
+            if (!source.Path.empty()) {
+                std::vector<std::byte>().swap(source.Bytes);
+            }
+        }
+        begin = end;
+    }
+
+    // Table of contents: entries by hash, bucket starts, blocks, names.
+    const uint32_t bucketBits =
+        size > 1 ? static_cast<uint32_t>(std::bit_width(size - 1)) : 0;
+    const uint32_t              bucketCount = 1u << bucketBits;
+    std::vector<uint32_t>       buckets(bucketCount + 1, size);
+    std::string                 names;
+    std::vector<Archive::Entry> sorted;
+    sorted.reserve(size);
+    for (uint32_t i : order) {
+        Archive::Entry &entry = entries[i];
+        entry.NameOffset      = static_cast<uint32_t>(names.size());
+        entry.NameLength      = static_cast<uint32_t>(m_Sources[i].Name.size());
+        names += m_Sources[i].Name;
+        sorted.push_back(entry);
+    }
+    for (uint32_t i = size; i > 0; i--) {
+        const uint64_t hash = sorted[i - 1].PathHash;
+        buckets[bucketBits ? hash >> (64 - bucketBits) : 0] = i - 1;
+    }
+    for (uint32_t bucket = bucketCount; bucket > 0; bucket--) {
+        buckets[bucket - 1] = std::min(buckets[bucket - 1], buckets[bucket]);
+    }
+
+    std::vector<std::byte> toc;
+    auto append = [&toc](const void *data, size_t bytes) {
+        const auto *first = static_cast<const std::byte *>(data);
+        toc.insert(toc.end(), first, first + bytes);
+    };
+    append(sorted.data(), sorted.size() * sizeof(Archive::Entry));
+    append(buckets.data(), buckets.size() * sizeof(uint32_t));
+    append(blockSizes.data(), blockSizes.size() * sizeof(uint32_t));
+    append(names.data(), names.size());
+
+    writer.Pad(alignof(Archive::Entry));
+    header.Magic      = Archive::kMagic;
+    header.Version    = Archive::kVersion;
+    header.EntryCount = size;
+    header.BucketBits = bucketBits;
+    header.BlockCount = static_cast<uint32_t>(blockSizes.size());
+    header.NamesSize  = static_cast<uint32_t>(names.size());
+    header.TocOffset  = writer.GetPosition();
+    header.TocSize    = toc.size();
+    header.TocHash    = HashBytes(toc.data(), toc.size());
+    writer.Write(toc.data(), toc.size());
+    writer.WriteAt(0, &header, sizeof(header));
+
+    m_Stats.Entries = size;
+    if (previous) {
+        previous->Close();
+    }
+    return writer.Commit();
+}
+
+bool ArchiveWriter::Load(Source &source) const {
+    if (source.Path.empty()) {
+        return true;
+    }
+
+    SDL_IOStream *stream = SDL_IOFromFile(source.Path.c_str(), "rb");
+    const Sint64  size   = stream ? SDL_GetIOSize(stream) : -1;
+    bool          ok     = size >= 0;
+    if (ok) {
+        source.Bytes.resize(static_cast<size_t>(size));
+        ok = SDL_ReadIO(stream, source.Bytes.data(), source.Bytes.size()) ==
+             source.Bytes.size();
+    }
+    if (stream) {
+        SDL_CloseIO(stream);
+    }
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "ArchiveWriter: cannot read %s: %s",
+                     source.Path.c_str(),
+                     SDL_GetError());
+    }
+    return ok;
+}
+
+void ArchiveWriter::Compress(Source &source) const {
+    const int bound = LZ4_compressBound(static_cast<int>(Archive::kBlockSize));
+    const size_t blockCount =
+        (source.Size + Archive::kBlockSize - 1) / Archive::kBlockSize;
+    source.Stored.resize(blockCount * bound);
+
+    size_t stored = 0;
+    for (size_t offset = 0; offset < source.Size;
+         offset += Archive::kBlockSize) {
+        const size_t blockSize =
+            std::min(Archive::kBlockSize, source.Size - offset);
+        const auto *block =
+            reinterpret_cast<const char *>(source.Bytes.data() + offset);
+        auto *out = reinterpret_cast<char *>(source.Stored.data() + stored);
+
+        // A block that doesn't shrink is stored raw; Read() knows it by
+        // its size.
+        int size = LZ4_compress_default(
+            block, out, static_cast<int>(blockSize), bound);
+        if (size <= 0 || static_cast<size_t>(size) >= blockSize) {
+            std::memcpy(out, block, blockSize);
+            size = static_cast<int>(blockSize);
+        }
+        source.BlockSizes.push_back(static_cast<uint32_t>(size));
+        stored += static_cast<size_t>(size);
+    }
+
+    const double limit =
+        static_cast<double>(source.Size) * (1.0 - m_Specification.MinSavings);
+    if (source.Size == 0 || static_cast<double>(stored) > limit) {
+        std::vector<std::byte>().swap(source.Stored);
+        source.BlockSizes.clear();
+        return;
+    }
+    source.Stored.resize(stored);
+}
+
+} // namespace brnCore
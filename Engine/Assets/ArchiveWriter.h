@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Assets/Archive.h"
+#include "Engine/Core/JobSystem.h"
+
+namespace brnCore {
+
+struct ArchiveWriterSpecification {
+    // Entries whose LZ4 blocks save less than this are stored as-is, so
+    // they can be read in place.
+    float MinSavings = 1.0f / 16.0f;
+    // Source bytes held in memory at once while compressing.
+    size_t BatchSize = 256 << 20;
+};
+
+struct ArchiveWriteStats {
+    uint32_t Entries    = 0;
+    uint32_t Compressed = 0;
+    uint32_t Reused     = 0; // copied from the previous archive as stored
+    uint64_t Size       = 0; // uncompressed
+    uint64_t StoredSize = 0;
+    bool     UpToDate   = false; // nothing changed; nothing was written
+};
+
+/*
+ * Builds an Archive. Sources are read, hashed and compressed on the job
+ * system; the file itself is written sequentially.
+ *
+ * Given the previous build of the same archive, entries whose content
+ * hash didn't change are copied over as stored instead of compressed
+ * again, and if nothing at all changed the file is left alone.
+ */
+class ArchiveWriter {
+  public:
+    explicit ArchiveWriter(const ArchiveWriterSpecification &specification =
+                               ArchiveWriterSpecification());
+
+    // Paths inside the archive use '/' and are case sensitive.
+    void AddFile(std::string name, std::string sourcePath, bool compress);
+    void AddBytes(std::string            name,
+                  std::vector<std::byte> bytes,
+                  bool                   compress);
+
+    /*
+     * `previous` may be the archive at `path` itself; it is closed before
+     * the new file replaces it.
+     */
+    bool Write(const char *path,
+               JobSystem  *jobSystem = nullptr,
+               Archive    *previous  = nullptr);
+
+    const ArchiveWriteStats &GetStats() const { return m_Stats; }
+
+  private:
+    struct Source {
+        std::string            Name;
+        std::string            Path; // empty for AddBytes
+        std::vector<std::byte> Bytes;
+        bool                   Compress = false;
+        bool                   Failed   = false;
+
+        uint64_t Hash  = 0;
+        uint64_t Size  = 0;
+        uint32_t Reuse = Archive::kNotFound; // entry in the previous archive
+
+        std::vector<std::byte> Stored; // LZ4 blocks, if they paid off
+        std::vector<uint32_t>  BlockSizes;
+    };
+
+    bool Load(Source &source) const;
+    void Compress(Source &source) const;
+
+    ArchiveWriterSpecification m_Specification;
+    std::vector<Source>        m_Sources;
+    ArchiveWriteStats          m_Stats;
+};
+
+} // namespace brnCore
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_surface.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Engine/Assets/FileSystem.h"
+
+typedef struct TTF_Font TTF_Font;
+
+namespace brnCore {
+
+enum class AssetType : uint8_t { Texture, Font };
+
+enum class AssetState : uint8_t {
+    Loading, // reading, decoding or waiting for its GPU upload
+    Ready,
+    Failed,
+};
+
+struct Texture {
+    SDL_GPUTexture *Handle = nullptr;
+    uint32_t        Width  = 0;
+    uint32_t        Height = 0;
+};
+
+struct Font {
+    TTF_Font *Handle = nullptr;
+    float     Size   = 0.0f;
+    void     *Data   = nullptr; // the file, if owned; TTF reads it lazily
+    // Unique to this load, unlike Handle, whose address a later font may
+    // reuse: key caches of font data on it.
+    uint64_t Id  = 0;
+    bool     Sdf = false; // rasterizes signed distance fields
+};
+
+using AssetResource = std::variant<std::monostate, Texture, Font>;
+
+// One mip level of a texture waiting for its upload, RGBA8.
+struct TextureLevel {
+    const std::byte *Pixels = nullptr;
+    uint32_t         Width  = 0;
+    uint32_t         Height = 0;
+    uint32_t         Pitch  = 0;
+};
+
+/*
+ * Shared state behind every handle to one asset. Owned by the
+ * AssetManager; handles only count references to it.
+ */
+struct AssetEntry {
+    AssetType   Type;
+    uint64_t    Key;
+    std::string Path;
+    float       FontSize = 0.0f;
+    bool        FontSdf  = false;
+
+    std::atomic<uint32_t>   RefCount{0};
+    std::atomic<AssetState> State{AssetState::Loading};
+
+    // Set on the render thread by AssetManager::Update(), never elsewhere.
+    AssetResource Resource;
+
+    // Render thread only. State stays Ready while a reload is in flight.
+    bool Reloading    = false;
+    bool ReloadQueued = false; // changed again while loading
+
+    // In flight between the IO thread, the decode job and the upload.
+    FileData                  File;
+    SDL_Surface              *Decoded = nullptr;
+    std::vector<TextureLevel> Levels; // into Decoded or File
+    AssetResource             Pending;
+
+    // Bumped when the last handle goes away, so the manager knows to sweep.
+    std::atomic<uint32_t> *Unreferenced = nullptr;
+};
+
+/*
+ * Reference-counted handle to an asset that may still be loading.
+ *
+ *   TextureHandle sprite = assets.LoadTexture("Assets/hero.png");
+ *   ...
+ *   if (const Texture *texture = sprite.Get()) { draw it }
+ *
+ * Copies are cheap (one atomic increment). Get() returns nullptr until
+ * the asset is ready and must be called on the render thread, which is
+ * where the manager publishes finished assets between frames.
+ */
+template <typename T>
+class AssetHandle {
+  public:
+    AssetHandle() = default;
+    explicit AssetHandle(AssetEntry *entry) : m_Entry(entry) { Retain(); }
+    ~AssetHandle() { Release(); }
+
+    AssetHandle(const AssetHandle &other) : m_Entry(other.m_Entry) {
+        Retain();
+    }
+    AssetHandle(AssetHandle &&other) noexcept
+        : m_Entry(std::exchange(other.m_Entry, nullptr)) {}
+
+    AssetHandle &operator=(AssetHandle other) noexcept {
+        std::swap(m_Entry, other.m_Entry);
+        return *this;
+    }
+
+    bool IsValid() const { return m_Entry != nullptr; }
+    explicit operator bool() const { return IsValid(); }
+
+    AssetState GetState() const {
+        return m_Entry ? m_Entry->State.load(std::memory_order_acquire)
+                       : AssetState::Failed;
+    }
+    bool IsReady() const { return GetState() == AssetState::Ready; }
+
+    const T *Get() const {
+        return m_Entry ? std::get_if<T>(&m_Entry->Resource) : nullptr;
+    }
+    const T *operator->() const { return Get(); }
+
+    const std::string &GetPath() const { return m_Entry->Path; }
+
+    bool operator==(const AssetHandle &other) const {
+        return m_Entry == other.m_Entry;
+    }
+
+  private:
+    void Retain() {
+        if (m_Entry) {
+            m_Entry->RefCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Release() {
+        if (m_Entry &&
+            m_Entry->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_Entry->Unreferenced->fetch_add(1, std::memory_order_relaxed);
+        }
+        m_Entry = nullptr;
+    }
+
+    AssetEntry *m_Entry = nullptr;
+};
+
+using TextureHandle = AssetHandle<Texture>;
+using FontHandle    = AssetHandle<Font>;
+
+} // namespace brnCore
@@ -0,0 +1,483 @@
+#include "AssetManager.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+#include <SDL3_image/SDL_image.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include "Engine/Assets/CookedTexture.h"
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/StringId.h"
+
+namespace brnCore {
+
+namespace {
+constexpr uint32_t kBytesPerPixel = 4; // everything is uploaded as RGBA8
+
+uint64_t GetUploadSize(const AssetEntry &entry) {
+    uint64_t size = 0;
+    for (const TextureLevel &level : entry.Levels) {
+        size += static_cast<uint64_t>(level.Width) * level.Height *
+                kBytesPerPixel;
+    }
+    return size;
+}
+} // namespace
+
+AssetManager::AssetManager(SDL_GPUDevice                     *device,
+                           std::shared_ptr<JobSystem>         jobSystem,
+                           std::shared_ptr<VirtualFileSystem> fileSystem,
+                           const AssetManagerSpecification   &specification)
+    : m_Device(device), m_JobSystem(std::move(jobSystem)),
+      m_FileSystem(std::move(fileSystem)), m_Specification(specification) {
+    if (!TTF_Init()) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AssetManager: failed to initialize SDL_ttf: %s",
+                     SDL_GetError());
+    }
+
+    m_IoQueue  = SDL_CreateAsyncIOQueue();
+    m_IoThread = std::thread(&AssetManager::IoThreadMain, this);
+
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size  = static_cast<Uint32>(m_Specification.UploadBudget),
+    };
+    m_TransferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+}
+
+AssetManager::~AssetManager() {
+    // A signal only wakes a thread that is already waiting, so repeat it
+    // until the IO thread has seen m_Stopping.
+    m_Stopping.store(true);
+    while (!m_IoThreadDone.load()) {
+        SDL_SignalAsyncIOQueue(m_IoQueue);
+        SDL_Delay(1);
+    }
+    m_IoThread.join();
+    m_JobSystem->Wait(m_DecodeJobs);
+    SDL_DestroyAsyncIOQueue(m_IoQueue);
+
+    for (AssetEntry *entry : m_Uploads) {
+        SDL_DestroySurface(entry->Decoded);
+    }
+    for (AssetEntry *entry : m_Finished) {
+        ReleaseResource(entry->Pending);
+    }
+
+    uint32_t referenced = 0;
+    for (auto &[key, entry] : m_Entries) {
+        referenced += entry->RefCount.load() > 0;
+        ReleaseResource(entry->Resource);
+    }
+    if (referenced) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "AssetManager: %u assets still referenced at shutdown",
+                    referenced);
+    }
+
+    SDL_ReleaseGPUTransferBuffer(m_Device, m_TransferBuffer);
+    TTF_Quit();
+}
+
+TextureHandle AssetManager::LoadTexture(std::string_view path) {
+    return Acquire<Texture>(AssetType::Texture, path, 0.0f, false);
+}
+
+FontHandle
+AssetManager::LoadFont(std::string_view path, float size, bool sdf) {
+    return Acquire<Font>(AssetType::Font, path, size, sdf);
+}
+
+template <typename T>
+AssetHandle<T> AssetManager::Acquire(AssetType        type,
+                                     std::string_view path,
+                                     float            size,
+                                     bool             sdf) {
+    uint64_t key = HashFnv1a(path);
+    key          = HashCombine(key, static_cast<uint64_t>(type));
+    key          = HashCombine(key, std::bit_cast<uint32_t>(size));
+    key          = HashCombine(key, sdf);
+
+    // The handle is created under the lock, so Sweep() can't free an
+    // entry that is being shared again.
+    std::scoped_lock             lock(m_Mutex);
+    std::unique_ptr<AssetEntry> &slot = m_Entries[key];
+    if (slot) {
+        assert(slot->Path == path && "asset path hash collision");
+        return AssetHandle<T>(slot.get());
+    }
+
+    slot                = std::make_unique<AssetEntry>();
+    AssetEntry *entry   = slot.get();
+    entry->Type         = type;
+    entry->Key          = key;
+    entry->Path         = path;
+    entry->FontSize     = size;
+    entry->FontSdf      = sdf;
+    entry->Unreferenced = &m_Unreferenced;
+    m_LoadingCount.fetch_add(1, std::memory_order_relaxed);
+    StartLoad(*entry);
+    return AssetHandle<T>(entry);
+}
+
+uint32_t AssetManager::Reload(std::string_view path) {
+    std::scoped_lock lock(m_Mutex);
+    uint32_t         count = 0;
+    for (auto &[key, slot] : m_Entries) {
+        AssetEntry &entry = *slot;
+        if (entry.Path != path) {
+            continue;
+        }
+        count++;
+        if (entry.Reloading ||
+            entry.State.load(std::memory_order_relaxed) ==
+                AssetState::Loading) {
+            // The load in flight may have read the old file.
+            entry.ReloadQueued = true;
+            continue;
+        }
+        entry.Reloading = true;
+        m_LoadingCount.fetch_add(1, std::memory_order_relaxed);
+        StartLoad(entry);
+    }
+    return count;
+}
+
+void AssetManager::StartLoad(AssetEntry &entry) {
+    const FileSource *source = m_FileSystem->Find(entry.Path);
+    const std::string nativePath =
+        source ? source->GetNativePath(entry.Path) : std::string();
+    if (source && nativePath.empty()) {
+        // Already in memory (an archive): no IO to wait for.
+        m_JobSystem->Schedule(m_DecodeJobs, [this, &entry, source] {
+            if (!source->Read(entry.Path, entry.File)) {
+                entry.File = {};
+            }
+            Decode(entry);
+        });
+        return;
+    }
+
+    // Counted before submitting, so the IO thread never sees zero while
+    // this read is outstanding.
+    m_IoInFlight.fetch_add(1);
+    if (!source || !SDL_LoadFileAsync(nativePath.c_str(), m_IoQueue, &entry)) {
+        m_IoInFlight.fetch_sub(1);
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AssetManager: cannot read %s: %s",
+                     entry.Path.c_str(),
+                     source ? SDL_GetError() : "not found");
+        std::scoped_lock decodedLock(m_DecodedMutex);
+        m_Finished.push_back(&entry);
+    }
+}
+
+void AssetManager::IoThreadMain() {
+    while (!m_Stopping.load() || m_IoInFlight.load() > 0) {
+        SDL_AsyncIOOutcome outcome;
+        if (!SDL_WaitAsyncIOResult(m_IoQueue, &outcome, -1)) {
+            continue; // signalled
+        }
+        m_IoInFlight.fetch_sub(1);
+
+        auto *entry = static_cast<AssetEntry *>(outcome.userdata);
+        if (outcome.result != SDL_ASYNCIO_COMPLETE || m_Stopping.load()) {
+            if (outcome.result != SDL_ASYNCIO_COMPLETE) {
+                SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                             "AssetManager: cannot read %s: %s",
+                             entry->Path.c_str(),
+                             SDL_GetError());
+            }
+            SDL_free(outcome.buffer);
+            std::scoped_lock lock(m_DecodedMutex);
+            m_Finished.push_back(entry);
+            continue;
+        }
+
+        entry->File.Storage.reset(outcome.buffer);
+        entry->File.Bytes = {static_cast<const std::byte *>(outcome.buffer),
+                             static_cast<size_t>(outcome.bytes_transferred)};
+        m_JobSystem->Schedule(m_DecodeJobs, [this, entry] { Decode(*entry); });
+    }
+    m_IoThreadDone.store(true);
+}
+
+void AssetManager::Decode(AssetEntry &entry) {
+    CookedTexture cooked;
+    if (entry.Type == AssetType::Texture && cooked.Parse(entry.File.Bytes)) {
+        // Cooked by BrainCook: the mips are uploaded straight from the file.
+        for (uint32_t i = 0; i < cooked.Levels.size(); i++) {
+            const CookedTexture::Level &level = cooked.Levels[i];
+            entry.Levels.push_back({cooked.GetPixels(i).data(),
+                                    level.Width,
+                                    level.Height,
+                                    level.Width * kBytesPerPixel});
+        }
+        std::scoped_lock lock(m_DecodedMutex);
+        m_Uploads.push_back(&entry);
+        return;
+    }
+
+    SDL_IOStream *stream =
+        entry.File.Bytes.empty()
+            ? nullptr
+            : SDL_IOFromConstMem(entry.File.Bytes.data(),
+                                 entry.File.Bytes.size());
+
+    if (!stream) {
+        entry.File = {};
+    } else if (entry.Type == AssetType::Texture) {
+        SDL_Surface *surface = IMG_Load_IO(stream, true);
+        entry.File           = {};
+
+        if (surface && surface->format != SDL_PIXELFORMAT_RGBA32) {
+            SDL_Surface *converted =
+                SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+            SDL_DestroySurface(surface);
+            surface = converted;
+        }
+        if (surface) {
+            entry.Decoded = surface;
+            entry.Levels  = {{static_cast<const std::byte *>(surface->pixels),
+                              static_cast<uint32_t>(surface->w),
+                              static_cast<uint32_t>(surface->h),
+                              static_cast<uint32_t>(surface->pitch)}};
+            std::scoped_lock lock(m_DecodedMutex);
+            m_Uploads.push_back(&entry);
+            return;
+        }
+    } else {
+        TTF_Font *font = nullptr;
+        {
+            std::scoped_lock lock(m_FontMutex);
+            font = TTF_OpenFontIO(stream, true, entry.FontSize);
+            if (font && entry.FontSdf) {
+                // Before anyone shares it: it changes every glyph.
+                TTF_SetFontSDF(font, true);
+            }
+        }
+        if (font) {
+            // The bytes must outlive the font; a view into an archive
+            // does anyway.
+            void *data    = entry.File.Storage.release();
+            entry.Pending = Font{font,
+                                 entry.FontSize,
+                                 data,
+                                 m_NextFontId.fetch_add(1),
+                                 entry.FontSdf};
+        }
+        entry.File = {};
+    }
+
+    if (std::holds_alternative<std::monostate>(entry.Pending)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AssetManager: cannot decode %s: %s",
+                     entry.Path.c_str(),
+                     SDL_GetError());
+    }
+    std::scoped_lock lock(m_DecodedMutex);
+    m_Finished.push_back(&entry);
+}
+
+void AssetManager::Update() {
+    std::vector<AssetEntry *> finished;
+    std::vector<AssetEntry *> uploads;
+    uint64_t                  uploadBytes = 0;
+    {
+        std::scoped_lock lock(m_DecodedMutex);
+        finished.swap(m_Finished);
+
+        // Always let one through, or an asset bigger than the budget
+        // would never be uploaded.
+        while (!m_Uploads.empty()) {
+            const uint64_t size = GetUploadSize(*m_Uploads.front());
+            if (!uploads.empty() &&
+                uploadBytes + size > m_Specification.UploadBudget) {
+                break;
+            }
+            uploads.push_back(m_Uploads.front());
+            m_Uploads.pop_front();
+            uploadBytes += size;
+        }
+    }
+
+    for (AssetEntry *entry : finished) {
+        Finish(*entry);
+    }
+    if (!uploads.empty()) {
+        UploadTextures(uploads, uploadBytes);
+    }
+    m_UploadedBytes = uploadBytes;
+
+    if (m_Unreferenced.exchange(0, std::memory_order_relaxed) > 0) {
+        Sweep();
+    }
+}
+
+void AssetManager::Finish(AssetEntry &entry) {
+    const bool ok = !std::holds_alternative<std::monostate>(entry.Pending);
+    if (ok) {
+        // Between frames, so no layer sees a half-swapped asset. The GPU
+        // keeps a released texture alive until frames using it are done.
+        ReleaseResource(entry.Resource);
+        entry.Resource = std::exchange(entry.Pending, std::monostate{});
+        entry.State.store(AssetState::Ready, std::memory_order_release);
+    } else if (entry.Reloading) {
+        // Likely caught mid-save; the next change reloads it again.
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "AssetManager: keeping the previous %s",
+                    entry.Path.c_str());
+    } else {
+        entry.State.store(AssetState::Failed, std::memory_order_release);
+    }
+    entry.Reloading = false;
+
+    if (entry.ReloadQueued) {
+        entry.ReloadQueued = false;
+        entry.Reloading    = true;
+        StartLoad(entry);
+        return;
+    }
+    m_LoadingCount.fetch_sub(1, std::memory_order_relaxed);
+
+    // Its handles may have gone while it was loading.
+    if (entry.RefCount.load() == 0) {
+        m_Unreferenced.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AssetManager::UploadTextures(const std::vector<AssetEntry *> &entries,
+                                  uint64_t                         bytes) {
+    // Only a lone oversized texture needs a buffer of its own.
+    SDL_GPUTransferBuffer *transferBuffer = m_TransferBuffer;
+    if (bytes > m_Specification.UploadBudget) {
+        const SDL_GPUTransferBufferCreateInfo transferInfo{
+            .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+            .size  = static_cast<Uint32>(bytes),
+        };
+        transferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+    }
+
+    // Cycling hands back a fresh buffer if last frame's copy is in flight.
+    auto *mapped = static_cast<std::byte *>(
+        SDL_MapGPUTransferBuffer(m_Device, transferBuffer, true));
+    SDL_GPUCommandBuffer *commandBuffer =
+        SDL_AcquireGPUCommandBuffer(m_Device);
+    if (!mapped || !commandBuffer) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AssetManager: cannot upload textures: %s",
+                     SDL_GetError());
+        if (commandBuffer) {
+            SDL_CancelGPUCommandBuffer(commandBuffer);
+        }
+        // Try again next frame.
+        std::scoped_lock lock(m_DecodedMutex);
+        m_Uploads.insert(m_Uploads.begin(), entries.begin(), entries.end());
+        return;
+    }
+
+    SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    uint32_t         offset   = 0;
+    for (AssetEntry *entry : entries) {
+        const TextureLevel &base = entry->Levels.front();
+
+        const SDL_GPUTextureCreateInfo textureInfo{
+            .type                 = SDL_GPU_TEXTURETYPE_2D,
+            .format               = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
+            .usage                = SDL_GPU_TEXTUREUSAGE_SAMPLER,
+            .width                = base.Width,
+            .height               = base.Height,
+            .layer_count_or_depth = 1,
+            .num_levels           = static_cast<Uint32>(entry->Levels.size()),
+        };
+        SDL_GPUTexture *texture = SDL_CreateGPUTexture(m_Device, &textureInfo);
+        if (!texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "AssetManager: cannot create texture for %s: %s",
+                         entry->Path.c_str(),
+                         SDL_GetError());
+        } else {
+            for (uint32_t mip = 0; mip < entry->Levels.size(); mip++) {
+                const TextureLevel &level = entry->Levels[mip];
+
+                // Source rows may be padded; the transfer is tightly packed.
+                const size_t rowBytes = size_t(level.Width) * kBytesPerPixel;
+                for (uint32_t y = 0; y < level.Height; y++) {
+                    std::memcpy(mapped + offset + y * rowBytes,
+                                level.Pixels + size_t(y) * level.Pitch,
+                                rowBytes);
+                }
+
+                const SDL_GPUTextureTransferInfo source{
+                    .transfer_buffer = transferBuffer,
+                    .offset          = offset,
+                    .pixels_per_row  = level.Width,
+                    .rows_per_layer  = level.Height,
+                };
+                const SDL_GPUTextureRegion destination{
+                    .texture   = texture,
+                    .mip_level = mip,
+                    .w         = level.Width,
+                    .h         = level.Height,
+                    .d         = 1,
+                };
+                SDL_UploadToGPUTexture(copyPass, &source, &destination, false);
+                offset += static_cast<uint32_t>(rowBytes * level.Height);
+            }
+            entry->Pending = Texture{texture, base.Width, base.Height};
+        }
+
+        SDL_DestroySurface(entry->Decoded);
+        entry->Decoded = nullptr;
+        entry->Levels.clear();
+        entry->File = {};
+    }
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_UnmapGPUTransferBuffer(m_Device, transferBuffer);
+    SDL_SubmitGPUCommandBuffer(commandBuffer);
+
+    if (transferBuffer != m_TransferBuffer) {
+        // Released once the copy has executed.
+        SDL_ReleaseGPUTransferBuffer(m_Device, transferBuffer);
+    }
+
+    // Draws recorded after this point are submitted after the copy.
+    for (AssetEntry *entry : entries) {
+        Finish(*entry);
+    }
+}
+
+void AssetManager::ReleaseResource(AssetResource &resource) {
+    if (Texture *texture = std::get_if<Texture>(&resource)) {
+        SDL_ReleaseGPUTexture(m_Device, texture->Handle);
+    } else if (Font *font = std::get_if<Font>(&resource)) {
+        TTF_CloseFont(font->Handle);
+        SDL_free(font->Data);
+    }
+    resource = std::monostate{};
+}
+
+void AssetManager::Sweep() {
+    std::scoped_lock lock(m_Mutex);
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        AssetEntry &entry = *it->second;
+        if (entry.RefCount.load(std::memory_order_acquire) == 0 &&
+            entry.State.load(std::memory_order_acquire) !=
+                AssetState::Loading &&
+            !entry.Reloading) {
+            ReleaseResource(entry.Resource);
+            it = m_Entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace brnCore
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <SDL3/SDL_asyncio.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Assets/AssetHandle.h"
+#include "Engine/Assets/FileSystem.h"
+#include "Engine/Core/JobSystem.h"
+
+namespace brnCore {
+
+struct AssetManagerSpecification {
+    // Bytes copied to the GPU per Update() at most. A single asset larger
+    // than this still goes through, alone in its frame.
+    uint64_t UploadBudget = 16 << 20;
+};
+
+/*
+ * Loads textures and fonts without blocking the frame.
+ *
+ * Paths are looked up in the VirtualFileSystem. Loose files are read
+ * with SDL_AsyncIO and their completion is picked up by a dedicated IO
+ * thread, which hands the bytes to a job worker for decoding (SDL_image /
+ * SDL_ttf); files inside an archive are decoded straight from the
+ * mapping. Textures cooked by BrainCook need no decoding and bring their
+ * whole mip chain. Decoded images wait in a queue that
+ * Update() drains on the render thread, uploading at most UploadBudget
+ * bytes per frame. Requests for an asset that is already loaded or in
+ * flight return another handle to the same entry.
+ *
+ * Assets are freed by Update() once their last handle is gone.
+ */
+class AssetManager {
+  public:
+    AssetManager(
+        SDL_GPUDevice                     *device,
+        std::shared_ptr<JobSystem>         jobSystem,
+        std::shared_ptr<VirtualFileSystem> fileSystem,
+        const AssetManagerSpecification   &specification =
+            AssetManagerSpecification());
+    ~AssetManager();
+
+    AssetManager(const AssetManager &)            = delete;
+    AssetManager &operator=(const AssetManager &) = delete;
+
+    // Safe from any thread.
+    TextureHandle LoadTexture(std::string_view path);
+    // With `sdf`, the font rasterizes signed distance fields, for a
+    // TextRenderer that draws them.
+    FontHandle LoadFont(std::string_view path, float size, bool sdf = false);
+
+    /*
+     * Loads the assets read from `path` again, in the background, and
+     * swaps them in at the Update() that finds them ready; until then
+     * handles keep returning the old version, and they keep it for good
+     * if the new file fails to decode. Render thread only. Returns the
+     * number of assets affected.
+     */
+    uint32_t Reload(std::string_view path);
+
+    /*
+     * Once per frame on the render thread, before anything draws:
+     * publishes decoded assets, records this frame's uploads and frees
+     * unreferenced assets.
+     */
+    void Update();
+
+    uint32_t GetLoadingCount() const {
+        return m_LoadingCount.load(std::memory_order_relaxed);
+    }
+    uint64_t GetUploadedBytes() const { return m_UploadedBytes; }
+
+  private:
+    template <typename T>
+    AssetHandle<T> Acquire(AssetType        type,
+                           std::string_view path,
+                           float            size,
+                           bool             sdf);
+
+    void StartLoad(AssetEntry &entry);
+    void IoThreadMain();
+    void Decode(AssetEntry &entry);
+    void Finish(AssetEntry &entry);
+    void UploadTextures(const std::vector<AssetEntry *> &entries,
+                        uint64_t                         bytes);
+    void ReleaseResource(AssetResource &resource);
+    void Sweep();
+
+    SDL_GPUDevice                     *m_Device;
+    std::shared_ptr<JobSystem>         m_JobSystem;
+    std::shared_ptr<VirtualFileSystem> m_FileSystem;
+    AssetManagerSpecification          m_Specification;
+
+    std::mutex                                                m_Mutex;
+    std::unordered_map<uint64_t, std::unique_ptr<AssetEntry>> m_Entries;
+    std::atomic<uint32_t>                                     m_Unreferenced{0};
+    std::atomic<uint32_t>                                     m_LoadingCount{0};
+
+    SDL_AsyncIOQueue     *m_IoQueue = nullptr;
+    std::thread           m_IoThread;
+    std::atomic<uint32_t> m_IoInFlight{0};
+    std::atomic<bool>     m_Stopping{false};
+    std::atomic<bool>     m_IoThreadDone{false};
+
+    JobCounter m_DecodeJobs;
+    // FreeType faces share one library, which isn't safe to open from
+    // several threads at once.
+    std::mutex            m_FontMutex;
+    std::atomic<uint64_t> m_NextFontId{1};
+
+    // Decoded on a worker, waiting for Update().
+    std::mutex                m_DecodedMutex;
+    std::deque<AssetEntry *>  m_Uploads;
+    std::vector<AssetEntry *> m_Finished;
+
+    SDL_GPUTransferBuffer *m_TransferBuffer = nullptr;
+    uint64_t               m_UploadedBytes  = 0; // last Update()
+};
+
+} // namespace brnCore
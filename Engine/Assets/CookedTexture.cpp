@@ -0,0 +1,45 @@
+#include "CookedTexture.h"
+
+#include <algorithm>
+
+namespace brnCore {
+
+bool CookedTexture::Parse(std::span<const std::byte> bytes) {
+    *this = {};
+    if (bytes.size() < sizeof(Header)) {
+        return false;
+    }
+    const auto *header = reinterpret_cast<const Header *>(bytes.data());
+    if (header->Magic != kMagic || header->Version != kVersion ||
+        header->LevelCount == 0 || header->LevelCount > kMaxLevels ||
+        bytes.size() < sizeof(Header) + header->LevelCount * sizeof(Level)) {
+        return false;
+    }
+
+    const auto *levels =
+        reinterpret_cast<const Level *>(bytes.data() + sizeof(Header));
+    uint32_t width  = header->Width;
+    uint32_t height = header->Height;
+    for (uint32_t i = 0; i < header->LevelCount; i++) {
+        const Level &level = levels[i];
+        if (level.Width != width || level.Height != height ||
+            level.Offset % kAlignment ||
+            level.Offset + GetLevelSize(width, height) > bytes.size()) {
+            return false;
+        }
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+
+    Info   = header;
+    Levels = {levels, header->LevelCount};
+    Bytes  = bytes;
+    return true;
+}
+
+std::span<const std::byte> CookedTexture::GetPixels(uint32_t level) const {
+    const Level &info = Levels[level];
+    return Bytes.subspan(info.Offset, GetLevelSize(info.Width, info.Height));
+}
+
+} // namespace brnCore
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace brnCore {
+
+/*
+ * Runtime texture format (.btex), written by BrainCook: RGBA8 pixels with
+ * the full mip chain precomputed, so loading is a copy to the GPU with no
+ * decoding. Levels are tightly packed, largest first, each starting on a
+ * 16 byte boundary.
+ */
+struct CookedTexture {
+    static constexpr uint32_t kMagic     = 0x544e5242; // "BRNT"
+    static constexpr uint16_t kVersion   = 1;
+    static constexpr uint32_t kMaxLevels = 16;
+    static constexpr size_t   kAlignment = 16;
+
+    // Header flags.
+    static constexpr uint32_t kSrgb = 1 << 0; // color, filtered in linear
+
+    struct Header {
+        uint32_t Magic;
+        uint16_t Version;
+        uint16_t LevelCount;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Flags;
+        uint32_t Reserved;
+    };
+
+    struct Level {
+        uint64_t Offset; // from the start of the file
+        uint32_t Width;
+        uint32_t Height;
+    };
+
+    // Header, then LevelCount levels, then the pixels.
+    const Header              *Info = nullptr;
+    std::span<const Level>     Levels;
+    std::span<const std::byte> Bytes;
+
+    // Validates a cooked texture in memory; false if it isn't one.
+    bool Parse(std::span<const std::byte> bytes);
+
+    std::span<const std::byte> GetPixels(uint32_t level) const;
+
+    static uint64_t GetLevelSize(uint32_t width, uint32_t height) {
+        return uint64_t(width) * height * 4;
+    }
+};
+
+} // namespace brnCore
@@ -0,0 +1,145 @@
+#include "FileSystem.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+
+#include <filesystem>
+#include <mutex>
+
+namespace brnCore {
+
+DirectorySource::DirectorySource(std::string root) : m_Root(std::move(root)) {
+    if (!m_Root.empty() && m_Root.back() != '/' && m_Root.back() != '\\') {
+        m_Root += '/';
+    }
+}
+
+bool DirectorySource::Contains(std::string_view path) const {
+    SDL_PathInfo info;
+    return SDL_GetPathInfo(GetNativePath(path).c_str(), &info) &&
+           info.type == SDL_PATHTYPE_FILE;
+}
+
+bool DirectorySource::Read(std::string_view path, FileData &out) const {
+    size_t size = 0;
+    void  *data = SDL_LoadFile(GetNativePath(path).c_str(), &size);
+    if (!data) {
+        return false;
+    }
+    out.Storage.reset(data);
+    out.Bytes = {static_cast<const std::byte *>(data), size};
+    return true;
+}
+
+std::string DirectorySource::GetNativePath(std::string_view path) const {
+    return m_Root + std::string(path);
+}
+
+std::string DirectorySource::GetVirtualPath(std::string_view nativePath) const {
+    // Both made absolute, so "./Assets/a.png" and "/work/Assets/a.png"
+    // map alike whatever the root was mounted as.
+    namespace fs = std::filesystem;
+    std::error_code rootError, fileError;
+    fs::path        root =
+        fs::weakly_canonical(m_Root.empty() ? "." : m_Root, rootError);
+    const fs::path file =
+        fs::weakly_canonical(fs::path(nativePath), fileError);
+    if (rootError || fileError) {
+        return {};
+    }
+    if (!root.has_filename()) {
+        root = root.parent_path(); // drop the trailing separator
+    }
+
+    const fs::path relative = file.lexically_relative(root);
+    if (relative.empty() || relative == "." || *relative.begin() == "..") {
+        return {};
+    }
+    return relative.generic_string();
+}
+
+ArchiveSource::ArchiveSource(std::unique_ptr<Archive> archive)
+    : m_Archive(std::move(archive)) {}
+
+bool ArchiveSource::Contains(std::string_view path) const {
+    return m_Archive->Find(path) != Archive::kNotFound;
+}
+
+bool ArchiveSource::Read(std::string_view path, FileData &out) const {
+    const uint32_t entry = m_Archive->Find(path);
+    if (entry == Archive::kNotFound) {
+        return false;
+    }
+    if (!m_Archive->IsCompressed(entry)) {
+        out.Storage.reset();
+        out.Bytes = m_Archive->GetView(entry);
+        return true;
+    }
+
+    const size_t size = m_Archive->GetSize(entry);
+    auto        *data = static_cast<std::byte *>(SDL_malloc(size ? size : 1));
+    if (!data || !m_Archive->Read(entry, {data, size})) {
+        SDL_free(data);
+        return false;
+    }
+    out.Storage.reset(data);
+    out.Bytes = {data, size};
+    return true;
+}
+
+void VirtualFileSystem::Mount(std::unique_ptr<FileSource> source) {
+    std::unique_lock lock(m_Mutex);
+    m_Sources.push_back(std::move(source));
+}
+
+bool VirtualFileSystem::MountDirectory(std::string root) {
+    Mount(std::make_unique<DirectorySource>(std::move(root)));
+    return true;
+}
+
+bool VirtualFileSystem::MountArchive(const char *path) {
+    auto archive = std::make_unique<Archive>();
+    if (!archive->Open(path)) {
+        return false;
+    }
+    Mount(std::make_unique<ArchiveSource>(std::move(archive)));
+    return true;
+}
+
+const FileSource *VirtualFileSystem::Find(std::string_view path) const {
+    std::shared_lock lock(m_Mutex);
+    for (auto it = m_Sources.rbegin(); it != m_Sources.rend(); ++it) {
+        if ((*it)->Contains(path)) {
+            return it->get();
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string>
+VirtualFileSystem::GetVirtualPaths(std::string_view nativePath) const {
+    std::vector<std::string> paths;
+    std::shared_lock         lock(m_Mutex);
+    for (auto it = m_Sources.rbegin(); it != m_Sources.rend(); ++it) {
+        std::string path = (*it)->GetVirtualPath(nativePath);
+        if (!path.empty()) {
+            paths.push_back(std::move(path));
+        }
+    }
+    return paths;
+}
+
+bool VirtualFileSystem::Read(std::string_view path, FileData &out) const {
+    const FileSource *source = Find(path);
+    if (!source || !source->Read(path, out)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "VirtualFileSystem: cannot read %.*s",
+                     static_cast<int>(path.size()),
+                     path.data());
+        return false;
+    }
+    return true;
+}
+
+} // namespace brnCore
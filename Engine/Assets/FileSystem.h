@@ -0,0 +1,106 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Engine/Assets/Archive.h"
+
+namespace brnCore {
+
+// A whole file: either a view into memory that outlives it (a mapped
+// archive) or a buffer it owns.
+struct FileData {
+    std::unique_ptr<void, decltype(&SDL_free)> Storage{nullptr, &SDL_free};
+    std::span<const std::byte>                 Bytes;
+};
+
+// Somewhere files can be found: a directory, an archive, ...
+class FileSource {
+  public:
+    virtual ~FileSource() = default;
+
+    virtual bool Contains(std::string_view path) const             = 0;
+    virtual bool Read(std::string_view path, FileData &out) const = 0;
+
+    /*
+     * The file's path on disk, if this source maps paths onto loose files;
+     * callers may then read it themselves (asynchronously). Empty for
+     * sources whose files are already in memory.
+     */
+    virtual std::string GetNativePath(std::string_view path) const {
+        return {};
+    }
+
+    // The inverse: the path a file on disk has in this source, or empty
+    // if the source doesn't map onto it.
+    virtual std::string GetVirtualPath(std::string_view nativePath) const {
+        return {};
+    }
+};
+
+// Loose files under a root directory ("" for the working directory).
+class DirectorySource : public FileSource {
+  public:
+    explicit DirectorySource(std::string root);
+
+    bool        Contains(std::string_view path) const override;
+    bool        Read(std::string_view path, FileData &out) const override;
+    std::string GetNativePath(std::string_view path) const override;
+    std::string GetVirtualPath(std::string_view nativePath) const override;
+
+  private:
+    std::string m_Root;
+};
+
+// Entries of a mapped Archive; stored entries are read without a copy.
+class ArchiveSource : public FileSource {
+  public:
+    explicit ArchiveSource(std::unique_ptr<Archive> archive);
+
+    bool Contains(std::string_view path) const override;
+    bool Read(std::string_view path, FileData &out) const override;
+
+    const Archive &GetArchive() const { return *m_Archive; }
+
+  private:
+    std::unique_ptr<Archive> m_Archive;
+};
+
+/*
+ * Layered lookup over several sources. Later mounts shadow earlier ones,
+ * so a patch archive or a directory of loose overrides mounted last wins
+ * over the shipped archive.
+ *
+ * Sources stay mounted for the lifetime of the file system, so pointers
+ * returned by Find() and views returned by Read() remain valid. Lookups
+ * may run on any thread.
+ */
+class VirtualFileSystem {
+  public:
+    void Mount(std::unique_ptr<FileSource> source);
+    bool MountDirectory(std::string root);
+    bool MountArchive(const char *path);
+
+    // The source that provides `path`, or nullptr.
+    const FileSource *Find(std::string_view path) const;
+    bool              Read(std::string_view path, FileData &out) const;
+
+    /*
+     * The paths a file on disk (e.g. one a FileWatcher reported) is found
+     * under, one per mounted directory it lies in, latest mount first.
+     */
+    std::vector<std::string> GetVirtualPaths(std::string_view nativePath) const;
+
+  private:
+    mutable std::shared_mutex                m_Mutex;
+    std::vector<std::unique_ptr<FileSource>> m_Sources;
+};
+
+} // namespace brnCore
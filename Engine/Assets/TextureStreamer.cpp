@@ -0,0 +1,473 @@
+#include "TextureStreamer.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+
+namespace brnCore {
+
+TextureStreamer::TextureStreamer(
+    SDL_GPUDevice                      *device,
+    std::shared_ptr<JobSystem>          jobSystem,
+    std::shared_ptr<VirtualFileSystem>  fileSystem,
+    const TextureStreamerSpecification &specification)
+    : m_Device(device), m_JobSystem(std::move(jobSystem)),
+      m_FileSystem(std::move(fileSystem)), m_Specification(specification) {}
+
+TextureStreamer::~TextureStreamer() {
+    m_JobSystem->Wait(m_Jobs);
+    for (const std::unique_ptr<Record> &record : m_Records) {
+        if (record && record->Texture.Handle) {
+            SDL_ReleaseGPUTexture(m_Device, record->Texture.Handle);
+        }
+    }
+    SDL_ReleaseGPUTransferBuffer(m_Device, m_TransferBuffer);
+}
+
+StreamedTextureId TextureStreamer::Load(std::string_view path) {
+    StreamedTextureId id;
+    if (!m_FreeIds.empty()) {
+        id = m_FreeIds.back();
+        m_FreeIds.pop_back();
+    } else {
+        id = static_cast<StreamedTextureId>(m_Records.size());
+        m_Records.emplace_back();
+    }
+
+    m_Records[id]  = std::make_unique<Record>();
+    Record *record = m_Records[id].get();
+    record->Id     = id;
+    record->Path   = path;
+    record->Live   = true;
+
+    record->Loading = true;
+    m_LoadsInFlight++;
+    m_JobSystem->Schedule(m_Jobs, [this, record, id] {
+        if (Open(*record)) {
+            Stage(*record,
+                  record->TailLevel,
+                  static_cast<uint32_t>(record->Cooked.Levels.size()));
+        }
+        std::scoped_lock lock(m_LoadedMutex);
+        m_Loaded.push_back(id);
+    });
+    return id;
+}
+
+void TextureStreamer::Unload(StreamedTextureId id) {
+    Record &record = *m_Records[id];
+    record.Live    = false;
+    std::erase(m_Uploads, &record);
+    // Otherwise freed when its job is done.
+    if (!record.Loading) {
+        Free(id);
+    }
+}
+
+const StreamedTexture *TextureStreamer::Get(StreamedTextureId id) const {
+    const Record *record = m_Records[id].get();
+    return record && record->Texture.Handle ? &record->Texture : nullptr;
+}
+
+void TextureStreamer::Request(StreamedTextureId id,
+                              uint32_t          level,
+                              float             priority) {
+    Record &record = *m_Records[id];
+    if (record.UsedFrame != m_Frame) {
+        record.UsedFrame      = m_Frame;
+        record.RequestedLevel = level;
+        record.Priority       = priority;
+    } else {
+        record.RequestedLevel = std::min(record.RequestedLevel, level);
+        record.Priority       = std::max(record.Priority, priority);
+    }
+}
+
+void TextureStreamer::RequestSize(StreamedTextureId id,
+                                  float             width,
+                                  float             height) {
+    // Its size isn't known before it opens; the next frame asks again.
+    if (const StreamedTexture *texture = Get(id)) {
+        Request(id,
+                GetRequiredLevel(*texture, width, height),
+                std::max(width * height, 0.0f));
+    }
+}
+
+uint32_t TextureStreamer::GetRequiredLevel(const StreamedTexture &texture,
+                                           float                  width,
+                                           float                  height) {
+    // What the sampler picks when magnification is isotropic: the axis
+    // that shrinks the most.
+    const float ratio =
+        std::max(static_cast<float>(texture.Width) / std::max(width, 1.0f),
+                 static_cast<float>(texture.Height) / std::max(height, 1.0f));
+    if (ratio <= 1.0f) {
+        return 0;
+    }
+    const auto level = static_cast<uint32_t>(std::floor(std::log2(ratio)));
+    return std::min(level, texture.LevelCount - 1);
+}
+
+void TextureStreamer::Update() {
+    std::vector<StreamedTextureId> loaded;
+    {
+        std::scoped_lock lock(m_LoadedMutex);
+        loaded.swap(m_Loaded);
+    }
+    for (const StreamedTextureId id : loaded) {
+        Record &record = *m_Records[id];
+        record.Loading = false;
+        m_LoadsInFlight--;
+        if (!record.Live) {
+            Free(id);
+            continue;
+        }
+        if (!record.Opened && !record.Failed) {
+            const auto levelCount =
+                static_cast<uint32_t>(record.Cooked.Levels.size());
+            record.Opened      = true;
+            record.TargetLevel = record.TailLevel;
+            record.Texture     = {nullptr,
+                                  record.Cooked.Info->Width,
+                                  record.Cooked.Info->Height,
+                                  levelCount,
+                                  levelCount};
+        }
+        if (!record.Staged.empty()) {
+            m_Uploads.push_back(&record);
+        }
+    }
+
+    Fit();
+
+    std::vector<Record *> shrinks;
+    std::vector<Record *> loads;
+    for (const std::unique_ptr<Record> &slot : m_Records) {
+        Record *record = slot.get();
+        if (!record || !record->Live || !record->Opened || record->Loading ||
+            !record->Staged.empty()) {
+            continue;
+        }
+        if (record->TargetLevel > record->Texture.ResidentLevel) {
+            shrinks.push_back(record);
+        } else if (record->TargetLevel < record->Texture.ResidentLevel) {
+            loads.push_back(record);
+        }
+    }
+
+    // The most recently and widely seen first.
+    std::ranges::sort(loads, [](const Record *a, const Record *b) {
+        return a->UsedFrame != b->UsedFrame ? a->UsedFrame > b->UsedFrame
+                                            : a->Priority > b->Priority;
+    });
+    for (Record *record : loads) {
+        if (m_LoadsInFlight >= m_Specification.MaxLoadsInFlight) {
+            break;
+        }
+        const uint32_t level    = record->TargetLevel;
+        const uint32_t resident = record->Texture.ResidentLevel;
+
+        record->Loading = true;
+        m_LoadsInFlight++;
+        m_JobSystem->Schedule(m_Jobs, [this, record, level, resident] {
+            Stage(*record, level, resident);
+            std::scoped_lock lock(m_LoadedMutex);
+            m_Loaded.push_back(record->Id);
+        });
+    }
+
+    // Always let one through, or a load bigger than the budget would
+    // never be uploaded.
+    std::vector<Record *> uploads;
+    uint64_t              uploadBytes = 0;
+    while (!m_Uploads.empty()) {
+        const uint64_t size = m_Uploads.front()->Staged.size();
+        if (!uploads.empty() &&
+            uploadBytes + size > m_Specification.UploadBudget) {
+            break;
+        }
+        uploads.push_back(m_Uploads.front());
+        m_Uploads.pop_front();
+        uploadBytes += size;
+    }
+
+    // Evictions need no transfer, only a copy into the smaller texture.
+    SDL_GPUCommandBuffer *commandBuffer =
+        shrinks.empty() ? nullptr : SDL_AcquireGPUCommandBuffer(m_Device);
+    if (commandBuffer) {
+        SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        for (Record *record : shrinks) {
+            Reallocate(copyPass, *record, record->TargetLevel);
+        }
+        SDL_EndGPUCopyPass(copyPass);
+        SDL_SubmitGPUCommandBuffer(commandBuffer);
+    }
+    if (!uploads.empty()) {
+        Upload(uploads, uploadBytes);
+    }
+    m_UploadedBytes = uploadBytes;
+    m_Frame++;
+}
+
+bool TextureStreamer::Open(Record &record) {
+    const FileSource *source = m_FileSystem->Find(record.Path);
+    const std::string nativePath =
+        source ? source->GetNativePath(record.Path) : std::string();
+
+    // Loose files stay mapped: levels are paged in only when loaded.
+    std::span<const std::byte> bytes;
+    if (!nativePath.empty()) {
+        if (record.Mapping.Open(nativePath.c_str())) {
+            bytes = record.Mapping.GetBytes();
+        }
+    } else if (source && source->Read(record.Path, record.File)) {
+        bytes = record.File.Bytes;
+    }
+    if (!record.Cooked.Parse(bytes)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TextureStreamer: %s is not a cooked texture",
+                     record.Path.c_str());
+        record.Failed = true;
+        return false;
+    }
+
+    record.TailLevel = static_cast<uint32_t>(record.Cooked.Levels.size()) - 1;
+    while (record.TailLevel > 0) {
+        const CookedTexture::Level &level =
+            record.Cooked.Levels[record.TailLevel - 1];
+        if (level.Width > m_Specification.TailSize ||
+            level.Height > m_Specification.TailSize) {
+            break;
+        }
+        record.TailLevel--;
+    }
+    return true;
+}
+
+void TextureStreamer::Stage(Record  &record,
+                            uint32_t level,
+                            uint32_t resident) {
+    record.Staged.resize(GetChainSize(record, level) -
+                         GetChainSize(record, resident));
+
+    // Touching the file here rather than in Update() keeps page faults
+    // off the render thread.
+    size_t offset = 0;
+    for (uint32_t i = level; i < resident; i++) {
+        const std::span<const std::byte> pixels = record.Cooked.GetPixels(i);
+        std::memcpy(
+            record.Staged.data() + offset, pixels.data(), pixels.size());
+        offset += pixels.size();
+    }
+    record.Loaded = level;
+}
+
+void TextureStreamer::Fit() {
+    uint64_t total = 0;
+    for (const std::unique_ptr<Record> &slot : m_Records) {
+        Record *record = slot.get();
+        if (!record || !record->Live || !record->Opened) {
+            continue;
+        }
+        if (record->UsedFrame == m_Frame) {
+            record->TargetLevel =
+                std::min(record->RequestedLevel, record->TailLevel);
+        } else if (m_Frame - record->UsedFrame >
+                   m_Specification.EvictionDelay) {
+            record->TargetLevel = record->TailLevel;
+        }
+        total += GetChainSize(*record, record->TargetLevel);
+    }
+    if (total <= m_Specification.Budget) {
+        return;
+    }
+
+    // Least recently used first, then the cheapest loss: a level is
+    // worth its priority, four times more for every level the texture is
+    // already short of its request, so the cuts spread out.
+    auto worth = [](const Record *record) {
+        return std::ldexp(record->Priority,
+                          2 * (static_cast<int>(record->TargetLevel) -
+                               static_cast<int>(record->RequestedLevel)));
+    };
+    auto after = [&worth](const Record *a, const Record *b) {
+        return a->UsedFrame != b->UsedFrame ? a->UsedFrame > b->UsedFrame
+                                            : worth(a) > worth(b);
+    };
+    std::priority_queue<Record *, std::vector<Record *>, decltype(after)>
+        victims(after);
+    for (const std::unique_ptr<Record> &slot : m_Records) {
+        Record *record = slot.get();
+        if (record && record->Live && record->Opened &&
+            record->TargetLevel < record->TailLevel) {
+            victims.push(record);
+        }
+    }
+
+    while (total > m_Specification.Budget && !victims.empty()) {
+        Record *record = victims.top();
+        victims.pop();
+        total -= GetChainSize(*record, record->TargetLevel) -
+                 GetChainSize(*record, record->TargetLevel + 1);
+        record->TargetLevel++;
+        if (record->TargetLevel < record->TailLevel) {
+            victims.push(record);
+        }
+    }
+}
+
+uint64_t TextureStreamer::GetChainSize(const Record &record,
+                                       uint32_t      level) const {
+    uint64_t size = 0;
+    for (uint32_t i = level; i < record.Cooked.Levels.size(); i++) {
+        const CookedTexture::Level &info = record.Cooked.Levels[i];
+        size += CookedTexture::GetLevelSize(info.Width, info.Height);
+    }
+    return size;
+}
+
+bool TextureStreamer::Reallocate(SDL_GPUCopyPass *copyPass,
+                                 Record          &record,
+                                 uint32_t         level) {
+    StreamedTexture            &texture = record.Texture;
+    const CookedTexture::Level &top     = record.Cooked.Levels[level];
+
+    const SDL_GPUTextureCreateInfo textureInfo{
+        .type                 = SDL_GPU_TEXTURETYPE_2D,
+        .format               = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
+        .usage                = SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width                = top.Width,
+        .height               = top.Height,
+        .layer_count_or_depth = 1,
+        .num_levels           = texture.LevelCount - level,
+    };
+    SDL_GPUTexture *handle = SDL_CreateGPUTexture(m_Device, &textureInfo);
+    if (!handle) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TextureStreamer: cannot create texture for %s: %s",
+                     record.Path.c_str(),
+                     SDL_GetError());
+        return false;
+    }
+
+    // Levels present in both are copied on the GPU; the old texture is
+    // released once this copy has executed.
+    const uint32_t resident = texture.ResidentLevel;
+    for (uint32_t i = std::max(level, resident); i < texture.LevelCount; i++) {
+        const SDL_GPUTextureLocation source{
+            .texture   = texture.Handle,
+            .mip_level = i - resident,
+        };
+        const SDL_GPUTextureLocation destination{
+            .texture   = handle,
+            .mip_level = i - level,
+        };
+        const CookedTexture::Level &info = record.Cooked.Levels[i];
+        SDL_CopyGPUTextureToTexture(
+            copyPass, &source, &destination, info.Width, info.Height, 1, false);
+    }
+    if (texture.Handle) {
+        SDL_ReleaseGPUTexture(m_Device, texture.Handle);
+    }
+
+    m_ResidentBytes += GetChainSize(record, level);
+    m_ResidentBytes -= GetChainSize(record, resident);
+    texture.Handle        = handle;
+    texture.ResidentLevel = level;
+    return true;
+}
+
+void TextureStreamer::Upload(const std::vector<Record *> &records,
+                             uint64_t                     bytes) {
+    if (!m_TransferBuffer) {
+        const SDL_GPUTransferBufferCreateInfo transferInfo{
+            .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+            .size  = static_cast<Uint32>(m_Specification.UploadBudget),
+        };
+        m_TransferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+    }
+
+    // Only a lone oversized load needs a buffer of its own.
+    SDL_GPUTransferBuffer *transferBuffer = m_TransferBuffer;
+    if (bytes > m_Specification.UploadBudget) {
+        const SDL_GPUTransferBufferCreateInfo transferInfo{
+            .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+            .size  = static_cast<Uint32>(bytes),
+        };
+        transferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+    }
+
+    auto *mapped = static_cast<std::byte *>(
+        SDL_MapGPUTransferBuffer(m_Device, transferBuffer, true));
+    SDL_GPUCommandBuffer *commandBuffer =
+        SDL_AcquireGPUCommandBuffer(m_Device);
+    if (!mapped || !commandBuffer) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TextureStreamer: cannot upload textures: %s",
+                     SDL_GetError());
+        if (commandBuffer) {
+            SDL_CancelGPUCommandBuffer(commandBuffer);
+        }
+        // Try again next frame.
+        m_Uploads.insert(m_Uploads.begin(), records.begin(), records.end());
+        return;
+    }
+
+    SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    uint32_t         offset   = 0;
+    for (Record *record : records) {
+        std::memcpy(
+            mapped + offset, record->Staged.data(), record->Staged.size());
+
+        const uint32_t resident = record->Texture.ResidentLevel;
+        if (Reallocate(copyPass, *record, record->Loaded)) {
+            uint32_t levelOffset = offset;
+            for (uint32_t i = record->Loaded; i < resident; i++) {
+                const CookedTexture::Level &level = record->Cooked.Levels[i];
+
+                const SDL_GPUTextureTransferInfo source{
+                    .transfer_buffer = transferBuffer,
+                    .offset          = levelOffset,
+                    .pixels_per_row  = level.Width,
+                    .rows_per_layer  = level.Height,
+                };
+                const SDL_GPUTextureRegion destination{
+                    .texture   = record->Texture.Handle,
+                    .mip_level = i - record->Loaded,
+                    .w         = level.Width,
+                    .h         = level.Height,
+                    .d         = 1,
+                };
+                SDL_UploadToGPUTexture(copyPass, &source, &destination, false);
+                levelOffset += static_cast<uint32_t>(
+                    CookedTexture::GetLevelSize(level.Width, level.Height));
+            }
+        }
+        offset += static_cast<uint32_t>(record->Staged.size());
+        record->Staged = {};
+    }
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_UnmapGPUTransferBuffer(m_Device, transferBuffer);
+    SDL_SubmitGPUCommandBuffer(commandBuffer);
+
+    if (transferBuffer != m_TransferBuffer) {
+        // Released once the copy has executed.
+        SDL_ReleaseGPUTransferBuffer(m_Device, transferBuffer);
+    }
+}
+
+void TextureStreamer::Free(StreamedTextureId id) {
+    Record &record = *m_Records[id];
+    if (record.Texture.Handle) {
+        m_ResidentBytes -= GetChainSize(record, record.Texture.ResidentLevel);
+        SDL_ReleaseGPUTexture(m_Device, record.Texture.Handle);
+    }
+    m_Records[id].reset();
+    m_FreeIds.push_back(id);
+}
+
+} // namespace brnCore
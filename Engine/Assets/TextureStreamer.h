@@ -0,0 +1,166 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Engine/Assets/CookedTexture.h"
+#include "Engine/Assets/FileSystem.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/MappedFile.h"
+
+namespace brnCore {
+
+using StreamedTextureId = uint32_t;
+
+inline constexpr StreamedTextureId kInvalidStreamedTexture =
+    std::numeric_limits<StreamedTextureId>::max();
+
+struct TextureStreamerSpecification {
+    // GPU memory for streamed textures. Over it, the least recently used
+    // and then the least important textures lose their finest levels.
+    uint64_t Budget = 256ull << 20;
+    // Bytes copied to the GPU per Update() at most. A single load larger
+    // than this still goes through, alone in its frame.
+    uint64_t UploadBudget = 8 << 20;
+    // Levels no larger than this are loaded with the texture and never
+    // evicted, so there is always something to draw.
+    uint32_t TailSize = 64;
+    // A texture that wasn't requested for this many frames drops to its
+    // tail.
+    uint32_t EvictionDelay    = 120;
+    uint32_t MaxLoadsInFlight = 8;
+};
+
+struct StreamedTexture {
+    // Holds levels [ResidentLevel, LevelCount) of the full chain, so its
+    // own level 0 is the finest level resident. Sample it as usual: UVs
+    // are normalized, and it never has levels that aren't populated.
+    SDL_GPUTexture *Handle        = nullptr;
+    uint32_t        Width         = 0; // of the full resolution level
+    uint32_t        Height        = 0;
+    uint32_t        LevelCount    = 0;
+    uint32_t        ResidentLevel = 0;
+};
+
+/*
+ * Keeps only the mip levels of cooked textures that are actually seen on
+ * the GPU.
+ *
+ * Every frame the renderer requests the level each texture is drawn at
+ * (RequestSize() derives it from the size on screen). Update() fits the
+ * requests into Budget, evicts what is no longer wanted and loads what is
+ * missing: a job copies the levels out of the file, which stays mapped
+ * (loose files) or is a view into a mapped archive, and Update() uploads
+ * them under UploadBudget. A texture whose resident chain changes is
+ * reallocated at its new size and the levels it keeps are copied over on
+ * the GPU; SDL_GPU has no sparse textures, so this is what frees memory.
+ *
+ * Only textures cooked by BrainCook can be streamed. Render thread only.
+ */
+class TextureStreamer {
+  public:
+    TextureStreamer(SDL_GPUDevice                      *device,
+                    std::shared_ptr<JobSystem>          jobSystem,
+                    std::shared_ptr<VirtualFileSystem>  fileSystem,
+                    const TextureStreamerSpecification &specification =
+                        TextureStreamerSpecification());
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer &)            = delete;
+    TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+    // Starts loading the texture's tail; Get() is null until it arrives.
+    StreamedTextureId Load(std::string_view path);
+    void              Unload(StreamedTextureId id);
+
+    const StreamedTexture *Get(StreamedTextureId id) const;
+
+    /*
+     * Asks for `level` and everything coarser to be resident, for this
+     * frame. Several requests for one texture keep the finest level and
+     * the highest priority; priority (e.g. area on screen) decides which
+     * textures keep their detail when the budget is short.
+     */
+    void Request(StreamedTextureId id, uint32_t level, float priority = 1.0f);
+    // Requests the level that maps about one texel to a pixel when the
+    // texture covers `width` x `height` pixels.
+    void RequestSize(StreamedTextureId id, float width, float height);
+
+    static uint32_t GetRequiredLevel(const StreamedTexture &texture,
+                                     float                  width,
+                                     float                  height);
+
+    // Once per frame, after the frame's requests and before drawing.
+    void Update();
+
+    // Takes effect at the next Update(), which evicts down to it.
+    void SetBudget(uint64_t bytes) { m_Specification.Budget = bytes; }
+
+    uint64_t GetResidentBytes() const { return m_ResidentBytes; }
+    uint64_t GetUploadedBytes() const { return m_UploadedBytes; }
+
+  private:
+    struct Record {
+        StreamedTextureId Id;
+        std::string       Path;
+        StreamedTexture   Texture;
+        bool              Live    = false;
+        bool              Opened  = false;
+        bool              Loading = false; // a job owns the fields below
+
+        bool          Failed    = false;
+        uint32_t      TailLevel = 0;
+        CookedTexture Cooked; // views into File or Mapping
+        FileData      File;
+        MappedFile    Mapping;
+
+        // Levels [Loaded, Texture.ResidentLevel) waiting for the upload.
+        uint32_t               Loaded = 0;
+        std::vector<std::byte> Staged;
+
+        uint32_t TargetLevel    = 0;
+        uint32_t RequestedLevel = 0;
+        float    Priority       = 0.0f;
+        uint64_t UsedFrame      = 0; // last frame it was requested
+    };
+
+    bool     Open(Record &record);
+    void     Stage(Record &record, uint32_t level, uint32_t resident);
+    void     Fit();
+    uint64_t GetChainSize(const Record &record, uint32_t level) const;
+    bool     Reallocate(SDL_GPUCopyPass *copyPass,
+                        Record          &record,
+                        uint32_t         level);
+    void     Upload(const std::vector<Record *> &records, uint64_t bytes);
+    void     Free(StreamedTextureId id);
+
+    SDL_GPUDevice                     *m_Device;
+    std::shared_ptr<JobSystem>         m_JobSystem;
+    std::shared_ptr<VirtualFileSystem> m_FileSystem;
+    TextureStreamerSpecification       m_Specification;
+
+    std::vector<std::unique_ptr<Record>> m_Records; // by id
+    std::vector<StreamedTextureId>       m_FreeIds;
+    uint64_t                             m_Frame = 1;
+
+    JobCounter                     m_Jobs;
+    uint32_t                       m_LoadsInFlight = 0;
+    std::mutex                     m_LoadedMutex;
+    std::vector<StreamedTextureId> m_Loaded; // jobs done, for Update()
+    std::deque<Record *>           m_Uploads;
+
+    SDL_GPUTransferBuffer *m_TransferBuffer = nullptr; // on first upload
+    uint64_t               m_ResidentBytes  = 0;
+    uint64_t               m_UploadedBytes  = 0; // last Update()
+};
+
+} // namespace brnCore
@@ -0,0 +1,206 @@
+#include "AudioDecoder.h"
+
+#include <SDL3/SDL_endian.h>
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace brnCore {
+
+namespace {
+constexpr uint16_t kFormatPcm        = 1;
+constexpr uint16_t kFormatFloat      = 3;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+bool ReadTag(SDL_IOStream *stream, char (&tag)[4]) {
+    return SDL_ReadIO(stream, tag, sizeof(tag)) == sizeof(tag);
+}
+
+bool IsTag(const char (&tag)[4], const char *expected) {
+    return std::memcmp(tag, expected, sizeof(tag)) == 0;
+}
+
+int32_t ReadInt24(const uint8_t *bytes) {
+    const auto value = static_cast<uint32_t>(bytes[0]) |
+                       static_cast<uint32_t>(bytes[1]) << 8 |
+                       static_cast<uint32_t>(bytes[2]) << 16;
+    return static_cast<int32_t>(value << 8) >> 8;
+}
+} // namespace
+
+WavDecoder::WavDecoder(SDL_IOStream *stream, FileData file)
+    : m_File(std::move(file)), m_Stream(stream) {
+    if (m_Stream && !ParseHeader()) {
+        m_Channels = 0;
+    }
+}
+
+WavDecoder::~WavDecoder() {
+    if (m_Stream) {
+        SDL_CloseIO(m_Stream);
+    }
+}
+
+bool WavDecoder::ParseHeader() {
+    char     tag[4];
+    uint32_t size;
+    if (!ReadTag(m_Stream, tag) || !IsTag(tag, "RIFF") ||
+        !SDL_ReadU32LE(m_Stream, &size) || !ReadTag(m_Stream, tag) ||
+        !IsTag(tag, "WAVE")) {
+        return false;
+    }
+
+    uint16_t format     = 0;
+    uint16_t channels   = 0;
+    bool     haveFormat = false;
+    while (ReadTag(m_Stream, tag) && SDL_ReadU32LE(m_Stream, &size)) {
+        const Sint64 start = SDL_TellIO(m_Stream);
+        if (IsTag(tag, "fmt ")) {
+            uint32_t rate, byteRate;
+            uint16_t blockAlign, bits;
+            if (size < 16 || !SDL_ReadU16LE(m_Stream, &format) ||
+                !SDL_ReadU16LE(m_Stream, &channels) ||
+                !SDL_ReadU32LE(m_Stream, &rate) ||
+                !SDL_ReadU32LE(m_Stream, &byteRate) ||
+                !SDL_ReadU16LE(m_Stream, &blockAlign) ||
+                !SDL_ReadU16LE(m_Stream, &bits)) {
+                return false;
+            }
+            // The real format is the first two bytes of the subformat.
+            uint16_t extra;
+            uint32_t mask;
+            if (format == kFormatExtensible &&
+                (size < 40 || !SDL_ReadU16LE(m_Stream, &extra) ||
+                 !SDL_ReadU16LE(m_Stream, &extra) ||
+                 !SDL_ReadU32LE(m_Stream, &mask) ||
+                 !SDL_ReadU16LE(m_Stream, &format))) {
+                return false;
+            }
+            m_SampleRate = static_cast<int>(rate);
+            m_Bits       = bits;
+            m_FrameBytes = blockAlign;
+            m_Float      = format == kFormatFloat;
+            haveFormat   = true;
+        } else if (IsTag(tag, "data")) {
+            if (!haveFormat) {
+                return false;
+            }
+            const bool supported =
+                (format == kFormatPcm &&
+                 (m_Bits == 8 || m_Bits == 16 || m_Bits == 24 ||
+                  m_Bits == 32)) ||
+                (format == kFormatFloat && m_Bits == 32);
+            if (!supported || channels < 1 || channels > 2 ||
+                m_FrameBytes != channels * m_Bits / 8 || m_SampleRate <= 0) {
+                SDL_SetError("unsupported WAV format %u, %u bits, %u channels",
+                             format,
+                             m_Bits,
+                             channels);
+                return false;
+            }
+
+            // Streamed recordings may leave the size unset: trust the file.
+            uint64_t     bytes = size;
+            const Sint64 total = SDL_GetIOSize(m_Stream);
+            if (total > start) {
+                bytes = std::min<uint64_t>(bytes, total - start);
+            }
+            m_Channels   = channels;
+            m_Frames     = bytes / m_FrameBytes;
+            m_DataOffset = start;
+            return true;
+        }
+        // Chunks are padded to an even size.
+        const Sint64 next = start + size + (size & 1);
+        if (SDL_SeekIO(m_Stream, next, SDL_IO_SEEK_SET) < 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool WavDecoder::Seek(uint64_t frame) {
+    m_Frame            = std::min(frame, m_Frames);
+    const Sint64 offset = static_cast<Sint64>(m_Frame * m_FrameBytes);
+    return SDL_SeekIO(m_Stream, m_DataOffset + offset, SDL_IO_SEEK_SET) >= 0;
+}
+
+uint32_t WavDecoder::Read(float *output, uint32_t frames) {
+    frames = static_cast<uint32_t>(
+        std::min<uint64_t>(frames, m_Frames - m_Frame));
+    m_Bytes.resize(static_cast<size_t>(frames) * m_FrameBytes);
+    const size_t read = SDL_ReadIO(m_Stream, m_Bytes.data(), m_Bytes.size());
+    frames            = static_cast<uint32_t>(read / m_FrameBytes);
+    m_Frame += frames;
+
+    const uint32_t count = frames * m_Channels;
+    const uint8_t *bytes = m_Bytes.data();
+    switch (m_Bits) {
+    case 8: // unsigned
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] = (static_cast<float>(bytes[i]) - 128.0f) * 0x1p-7f;
+        }
+        break;
+    case 16:
+        for (uint32_t i = 0; i < count; i++) {
+            int16_t sample;
+            std::memcpy(&sample, bytes + 2 * i, sizeof(sample));
+            output[i] = static_cast<float>(SDL_Swap16LE(sample)) * 0x1p-15f;
+        }
+        break;
+    case 24:
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] =
+                static_cast<float>(ReadInt24(bytes + 3 * i)) * 0x1p-23f;
+        }
+        break;
+    case 32:
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t sample;
+            std::memcpy(&sample, bytes + 4 * i, sizeof(sample));
+            sample = SDL_Swap32LE(sample);
+            if (m_Float) {
+                std::memcpy(&output[i], &sample, sizeof(float));
+            } else {
+                output[i] = static_cast<float>(static_cast<int32_t>(sample)) *
+                            0x1p-31f;
+            }
+        }
+        break;
+    }
+    return frames;
+}
+
+std::unique_ptr<AudioDecoder> OpenAudioDecoder(
+    const VirtualFileSystem &fileSystem, std::string_view path) {
+    const FileSource *source = fileSystem.Find(path);
+    const std::string nativePath =
+        source ? source->GetNativePath(path) : std::string();
+
+    std::unique_ptr<WavDecoder> decoder;
+    if (!nativePath.empty()) {
+        decoder = std::make_unique<WavDecoder>(
+            SDL_IOFromFile(nativePath.c_str(), "rb"));
+    } else {
+        FileData file;
+        if (source && source->Read(path, file)) {
+            SDL_IOStream *stream =
+                SDL_IOFromConstMem(file.Bytes.data(), file.Bytes.size());
+            decoder = std::make_unique<WavDecoder>(stream, std::move(file));
+        }
+    }
+
+    if (!decoder || !decoder->IsValid()) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AudioDecoder: cannot stream %.*s: %s",
+                     static_cast<int>(path.size()),
+                     path.data(),
+                     source ? SDL_GetError() : "not found");
+        return nullptr;
+    }
+    return decoder;
+}
+
+} // namespace brnCore
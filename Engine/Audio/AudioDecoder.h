@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL3/SDL_iostream.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "Engine/Assets/FileSystem.h"
+
+namespace brnCore {
+
+/*
+ * Decodes a sound a block at a time, for the AudioMixer's streams: only
+ * the block being decoded is ever in memory. One thread at a time.
+ */
+class AudioDecoder {
+  public:
+    virtual ~AudioDecoder() = default;
+
+    uint32_t GetChannels() const { return m_Channels; }
+    int      GetSampleRate() const { return m_SampleRate; }
+    uint64_t GetFrames() const { return m_Frames; }
+
+    // Continues decoding at exactly `frame` (clamped to the end).
+    virtual bool Seek(uint64_t frame) = 0;
+    // Decodes up to `frames` interleaved float frames into `output`;
+    // fewer only at the end of the sound, 0 past it or on an error.
+    virtual uint32_t Read(float *output, uint32_t frames) = 0;
+
+  protected:
+    uint32_t m_Channels   = 0; // 1 or 2
+    int      m_SampleRate = 0;
+    uint64_t m_Frames     = 0;
+};
+
+/*
+ * PCM WAV: 8, 16, 24 or 32 bit integer, or 32 bit float, mono or stereo.
+ * Reads straight from the stream, so seeking is exact and free.
+ */
+class WavDecoder : public AudioDecoder {
+  public:
+    // Takes ownership of `stream` even when it fails, and keeps `file`
+    // alive for it when it reads from memory.
+    explicit WavDecoder(SDL_IOStream *stream, FileData file = {});
+    ~WavDecoder() override;
+
+    WavDecoder(const WavDecoder &)            = delete;
+    WavDecoder &operator=(const WavDecoder &) = delete;
+
+    bool IsValid() const { return m_Stream && m_Channels > 0; }
+
+    bool     Seek(uint64_t frame) override;
+    uint32_t Read(float *output, uint32_t frames) override;
+
+  private:
+    bool ParseHeader();
+
+    FileData             m_File;
+    SDL_IOStream        *m_Stream     = nullptr;
+    int64_t              m_DataOffset = 0;
+    uint32_t             m_FrameBytes = 0;
+    uint32_t             m_Bits       = 0;
+    bool                 m_Float      = false;
+    uint64_t             m_Frame      = 0; // next one Read() returns
+    std::vector<uint8_t> m_Bytes;          // one block, undecoded
+};
+
+/*
+ * Opens `path` for streaming. Loose files are read from disk as they
+ * play; files in an archive play from its mapping (compressed entries
+ * are inflated into memory whole, so store long tracks uncompressed).
+ * Logs and returns nullptr if the file can't be read or decoded.
+ */
+std::unique_ptr<AudioDecoder> OpenAudioDecoder(
+    const VirtualFileSystem &fileSystem, std::string_view path);
+
+} // namespace brnCore
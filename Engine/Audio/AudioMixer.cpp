@@ -0,0 +1,843 @@
+#include "AudioMixer.h"
+
+#include <SDL3/SDL_hints.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include "Engine/Audio/AudioDecoder.h"
+#include "Engine/Core/RingBuffer.h"
+
+namespace brnCore {
+
+namespace {
+// Frames resampled per kernel call; the scratch buffer stays in L1.
+constexpr uint32_t kChunkFrames = 256;
+constexpr uint32_t kPadFrames   = 2;
+constexpr uint64_t kOne         = 1ull << 32; // a source frame, fixed point
+
+constexpr float kMinPitch = 1.0f / 256.0f;
+constexpr float kMaxPitch = 16.0f;
+
+// Source frames a stream keeps contiguous for the kernels; fast pitches
+// just resample in shorter chunks.
+constexpr uint32_t kWindowFrames = 1024;
+// Frames the decoder thread decodes at a time.
+constexpr uint32_t kDecodeFrames = 1024;
+// How often it tops up the rings while streams play.
+constexpr auto kDecodePeriod = std::chrono::milliseconds(10);
+
+// Constant power pan: the two gains are the cosine and sine of 0 to 90
+// degrees, so the total power stays the same across the field.
+void GetPanGains(float gain, float pan, float &left, float &right) {
+    const float angle = (pan + 1.0f) * 0.25f * 3.14159265f;
+    left              = gain * std::cos(angle);
+    right             = gain * std::sin(angle);
+}
+
+AudioMixerSpecification Validate(AudioMixerSpecification specification) {
+    // Handles keep the slot in 16 bits.
+    specification.MaxVoices = std::clamp(specification.MaxVoices, 1u, 65536u);
+    specification.MaxSounds = std::max(specification.MaxSounds, 1u);
+
+    specification.BufferFrames = std::max(specification.BufferFrames, 16u);
+    specification.SampleRate   = std::max(specification.SampleRate, 8000);
+    // The ring has to hold more than a device buffer and a decode block.
+    specification.StreamMilliseconds =
+        std::max(specification.StreamMilliseconds, 50u);
+    return specification;
+}
+} // namespace
+
+struct AudioMixer::Stream {
+    Stream(std::unique_ptr<AudioDecoder> decoder, bool loop, size_t frames)
+        : Decoder(std::move(decoder)), Channels(Decoder->GetChannels()),
+          SampleRate(Decoder->GetSampleRate()), Loop(loop),
+          Ring(frames * Channels), Window(kWindowFrames * Channels) {}
+
+    // Decoder thread.
+    std::unique_ptr<AudioDecoder> Decoder;
+    const uint32_t                Channels;
+    const int                     SampleRate;
+    const bool                    Loop;
+    bool                          Ended = false; // until a seek
+
+    // Decoded samples, written by the decoder thread, read by the audio
+    // thread.
+    RingBuffer<float> Ring;
+
+    // The audio thread asks for a seek with a new request number...
+    std::atomic<uint64_t> SeekFrame{0};
+    std::atomic<uint32_t> SeekRequest{0};
+    // ...and the decoder thread answers it, once its samples start at
+    // SeekCursor in the ring.
+    std::atomic<uint32_t> SeekServed{0};
+    std::atomic<uint64_t> SeekCursor{0};
+    // Ring position past the last sample (and the silent padding) of a
+    // stream that doesn't loop.
+    std::atomic<uint64_t> EndCursor{std::numeric_limits<uint64_t>::max()};
+    std::atomic<bool>     Primed{false}; // filled once
+    std::atomic<bool>     Done{false};   // the voice let go of it
+
+    // Audio thread: frames taken from the ring, from the one the voice
+    // is at on.
+    std::vector<float> Window;
+    uint32_t           WindowFrames = 0;
+    uint32_t           Skipped      = 0; // last seek SkipTo() was done for
+    bool               Starved      = false;
+};
+
+AudioMixer::AudioMixer(const AudioMixerSpecification &specification)
+    : m_Specification(Validate(specification)), m_Kernels(GetMixKernels()),
+      m_Sounds(std::make_unique<std::atomic<Sound *>[]>(
+          m_Specification.MaxSounds)),
+      m_FreeSlots(m_Specification.MaxVoices),
+      m_Handles(std::make_unique<std::atomic<VoiceHandle>[]>(
+          m_Specification.MaxVoices)),
+      m_Generations(std::make_unique<uint16_t[]>(m_Specification.MaxVoices)),
+      m_Commands(m_Specification.CommandCapacity),
+      m_Retired(m_Specification.MaxSounds) {
+    for (uint32_t slot = 0; slot < m_Specification.MaxVoices; slot++) {
+        m_FreeSlots.Push(slot);
+    }
+    for (SoundId id = m_Specification.MaxSounds; id-- > 0;) {
+        m_FreeSounds.push_back(id);
+    }
+    m_Voices.resize(m_Specification.MaxVoices);
+    m_Playing.reserve(m_Specification.MaxVoices);
+    m_Scratch.resize(2 * kChunkFrames);
+    m_Output.resize(2 * m_Specification.BufferFrames);
+    m_DecodeThread = std::thread(&AudioMixer::DecodeThreadMain, this);
+}
+
+AudioMixer::~AudioMixer() {
+    // Returns once the callback is done for good.
+    if (m_Stream) {
+        SDL_DestroyAudioStream(m_Stream);
+    }
+
+    {
+        std::scoped_lock lock(m_StreamMutex);
+        m_StopDecoding = true;
+    }
+    m_StreamWake.notify_one();
+    m_DecodeThread.join();
+
+    for (uint32_t id = 0; id < m_Specification.MaxSounds; id++) {
+        delete m_Sounds[id].load(std::memory_order_relaxed);
+    }
+    Command command;
+    while (m_Commands.Pop(command)) {
+        if (command.Type == CommandType::Retire) {
+            delete command.Source;
+        }
+    }
+    Sound *sound;
+    while (m_Retired.Pop(sound)) {
+        delete sound;
+    }
+    for (Sound *unretired : m_Unretired) {
+        delete unretired;
+    }
+}
+
+bool AudioMixer::Open() {
+    if (m_Stream) {
+        return true;
+    }
+
+    const std::string frames = std::to_string(m_Specification.BufferFrames);
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, frames.c_str());
+
+    const SDL_AudioSpec spec{SDL_AUDIO_F32, 2, m_Specification.SampleRate};
+    m_Stream = SDL_OpenAudioDeviceStream(
+        SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, &Callback, this);
+    if (!m_Stream) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AudioMixer: cannot open the audio device: %s",
+                     SDL_GetError());
+        return false;
+    }
+    SDL_ResumeAudioStreamDevice(m_Stream);
+    SDL_LogInfo(SDL_LOG_CATEGORY_CUSTOM,
+                "AudioMixer: %d Hz, %u frame buffers, %s kernels",
+                m_Specification.SampleRate,
+                m_Specification.BufferFrames,
+                m_Kernels.Name);
+    return true;
+}
+
+SoundId AudioMixer::CreateSound(std::span<const float> samples,
+                                uint32_t               channels,
+                                int                    sampleRate) {
+    if (channels < 1 || channels > 2 || sampleRate <= 0 ||
+        samples.size() < channels) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AudioMixer: unsupported sound (%u channels, %d Hz)",
+                     channels,
+                     sampleRate);
+        return kInvalidSound;
+    }
+
+    auto sound        = std::make_unique<Sound>();
+    sound->Frames     = static_cast<uint32_t>(samples.size() / channels);
+    sound->Channels   = channels;
+    sound->SampleRate = sampleRate;
+    sound->Samples.reserve((sound->Frames + kPadFrames) * channels);
+    sound->Samples.assign(samples.begin(),
+                          samples.begin() + sound->Frames * channels);
+    sound->Samples.resize((sound->Frames + kPadFrames) * channels, 0.0f);
+
+    std::lock_guard lock(m_SoundMutex);
+    if (m_FreeSounds.empty()) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AudioMixer: more than %u sounds",
+                     m_Specification.MaxSounds);
+        return kInvalidSound;
+    }
+    const SoundId id = m_FreeSounds.back();
+    m_FreeSounds.pop_back();
+    m_Sounds[id].store(sound.release(), std::memory_order_release);
+    return id;
+}
+
+SoundId AudioMixer::LoadSound(const VirtualFileSystem &fileSystem,
+                              std::string_view         path) {
+    FileData file;
+    if (!fileSystem.Read(path, file)) {
+        return kInvalidSound;
+    }
+
+    SDL_IOStream *stream =
+        SDL_IOFromConstMem(file.Bytes.data(), file.Bytes.size());
+    SDL_AudioSpec spec;
+    Uint8        *wav    = nullptr;
+    Uint32        length = 0;
+    if (!stream || !SDL_LoadWAV_IO(stream, true, &spec, &wav, &length)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AudioMixer: cannot decode %.*s: %s",
+                     static_cast<int>(path.size()),
+                     path.data(),
+                     SDL_GetError());
+        return kInvalidSound;
+    }
+
+    // Anything past stereo is downmixed by the conversion.
+    const int           channels = std::min(spec.channels, 2);
+    const SDL_AudioSpec floatSpec{SDL_AUDIO_F32, channels, spec.freq};
+    Uint8              *samples   = nullptr;
+    int                 byteCount = 0;
+
+    const bool converted = SDL_ConvertAudioSamples(
+        &spec, wav, static_cast<int>(length), &floatSpec, &samples, &byteCount);
+    SDL_free(wav);
+    if (!converted) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "AudioMixer: cannot convert %.*s: %s",
+                     static_cast<int>(path.size()),
+                     path.data(),
+                     SDL_GetError());
+        return kInvalidSound;
+    }
+
+    const SoundId id =
+        CreateSound({reinterpret_cast<const float *>(samples),
+                     static_cast<size_t>(byteCount) / sizeof(float)},
+                    static_cast<uint32_t>(channels),
+                    spec.freq);
+    SDL_free(samples);
+    return id;
+}
+
+void AudioMixer::DestroySound(SoundId sound) {
+    if (sound >= m_Specification.MaxSounds) {
+        return;
+    }
+
+    std::lock_guard lock(m_SoundMutex);
+    Sound          *source = m_Sounds[sound].exchange(nullptr);
+    if (!source) {
+        return;
+    }
+    m_FreeSounds.push_back(sound);
+    // Voices may still be reading it: the audio thread hands it back.
+    if (!Send({.Type = CommandType::Retire, .Source = source})) {
+        m_Unretired.push_back(source);
+    }
+}
+
+VoiceHandle AudioMixer::Play(SoundId                   sound,
+                             const VoiceSpecification &specification) {
+    Sound *source = sound < m_Specification.MaxSounds
+                        ? m_Sounds[sound].load(std::memory_order_acquire)
+                        : nullptr;
+    if (!source) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "AudioMixer: no sound %u", sound);
+        return kInvalidVoice;
+    }
+
+    uint32_t slot;
+    if (!m_FreeSlots.Pop(slot)) {
+        return kInvalidVoice; // every voice is busy
+    }
+
+    // The slot is ours alone until the audio thread frees it again.
+    uint16_t &generation = m_Generations[slot];
+    generation           = generation == 0xFFFF ? 1 : generation + 1;
+    const VoiceHandle handle = (static_cast<VoiceHandle>(generation) << 16) |
+                               slot;
+    m_Handles[slot].store(handle, std::memory_order_release);
+
+    if (!Send({.Type          = CommandType::Play,
+               .Voice         = handle,
+               .Source        = source,
+               .Specification = specification})) {
+        m_Handles[slot].store(kInvalidVoice, std::memory_order_release);
+        m_FreeSlots.Push(slot);
+        return kInvalidVoice;
+    }
+    return handle;
+}
+
+void AudioMixer::Stop(VoiceHandle voice) {
+    Send({.Type = CommandType::Stop, .Voice = voice});
+}
+
+void AudioMixer::SetGain(VoiceHandle voice, float gain) {
+    Send({.Type = CommandType::SetGain, .Voice = voice, .Value = gain});
+}
+
+void AudioMixer::SetPan(VoiceHandle voice, float pan) {
+    Send({.Type = CommandType::SetPan, .Voice = voice, .Value = pan});
+}
+
+void AudioMixer::SetPitch(VoiceHandle voice, float pitch) {
+    Send({.Type = CommandType::SetPitch, .Voice = voice, .Value = pitch});
+}
+
+VoiceHandle AudioMixer::PlayStream(const VirtualFileSystem  &fileSystem,
+                                   std::string_view          path,
+                                   const VoiceSpecification &specification) {
+    std::unique_ptr<AudioDecoder> decoder =
+        OpenAudioDecoder(fileSystem, path);
+    if (!decoder) {
+        return kInvalidVoice;
+    }
+
+    const uint64_t frames = static_cast<uint64_t>(decoder->GetSampleRate()) *
+                            m_Specification.StreamMilliseconds / 1000;
+    auto stream = std::make_unique<Stream>(
+        std::move(decoder), specification.Loop, frames);
+
+    uint32_t slot;
+    if (!m_FreeSlots.Pop(slot)) {
+        return kInvalidVoice;
+    }
+    uint16_t &generation = m_Generations[slot];
+    generation           = generation == 0xFFFF ? 1 : generation + 1;
+    const VoiceHandle handle = (static_cast<VoiceHandle>(generation) << 16) |
+                               slot;
+    m_Handles[slot].store(handle, std::memory_order_release);
+
+    // The voice stays silent until the decoder thread filled the ring.
+    if (!Send({.Type          = CommandType::Play,
+               .Voice         = handle,
+               .Feed          = stream.get(),
+               .Specification = specification})) {
+        m_Handles[slot].store(kInvalidVoice, std::memory_order_release);
+        m_FreeSlots.Push(slot);
+        return kInvalidVoice;
+    }
+    {
+        std::scoped_lock lock(m_StreamMutex);
+        m_NewStreams.push_back(std::move(stream));
+    }
+    m_StreamWake.notify_one();
+    return handle;
+}
+
+void AudioMixer::Seek(VoiceHandle voice, uint64_t frame) {
+    Send({.Type = CommandType::Seek, .Voice = voice, .Frame = frame});
+}
+
+bool AudioMixer::IsPlaying(VoiceHandle voice) const {
+    return voice != kInvalidVoice &&
+           GetSlot(voice) < m_Specification.MaxVoices &&
+           m_Handles[GetSlot(voice)].load(std::memory_order_acquire) == voice;
+}
+
+void AudioMixer::SetMasterGain(float gain) {
+    m_MasterGain.store(gain, std::memory_order_relaxed);
+}
+
+float AudioMixer::GetMasterGain() const {
+    return m_MasterGain.load(std::memory_order_relaxed);
+}
+
+void AudioMixer::Update() {
+    std::lock_guard lock(m_SoundMutex);
+    std::erase_if(m_Unretired, [this](Sound *sound) {
+        return Send({.Type = CommandType::Retire, .Source = sound});
+    });
+
+    Sound *sound;
+    while (m_Retired.Pop(sound)) {
+        delete sound;
+    }
+    m_CommandsLost.store(false, std::memory_order_relaxed);
+
+    const uint32_t underruns = m_Underruns.load(std::memory_order_relaxed);
+    if (underruns != m_ReportedUnderruns) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "AudioMixer: %u stream underruns, %llu frames missed",
+                    underruns,
+                    static_cast<unsigned long long>(GetUnderrunFrames()));
+        m_ReportedUnderruns = underruns;
+    }
+}
+
+void AudioMixer::Mix(float *output, uint32_t frames) {
+    std::fill_n(output, 2 * frames, 0.0f);
+
+    Command command;
+    while (m_Commands.Pop(command)) {
+        Execute(command);
+    }
+
+    for (size_t i = 0; i < m_Playing.size();) {
+        if (Render(m_Voices[m_Playing[i]], output, frames)) {
+            i++;
+        } else {
+            Release(i);
+        }
+    }
+
+    m_Kernels.ScaleClamp(
+        output, 2 * frames, m_MasterGain.load(std::memory_order_relaxed));
+    m_ActiveCount.store(static_cast<uint32_t>(m_Playing.size()),
+                        std::memory_order_relaxed);
+}
+
+void SDLCALL AudioMixer::Callback(void            *userdata,
+                                  SDL_AudioStream *stream,
+                                  int              additionalAmount,
+                                  int              totalAmount) {
+    auto          *mixer = static_cast<AudioMixer *>(userdata);
+    const uint64_t start = SDL_GetPerformanceCounter();
+
+    const auto frameBytes = static_cast<int>(2 * sizeof(float));
+    const auto total      = static_cast<uint32_t>(
+        (additionalAmount + frameBytes - 1) / frameBytes);
+    for (uint32_t done = 0; done < total;) {
+        const uint32_t frames =
+            std::min(total - done, mixer->m_Specification.BufferFrames);
+        float *output = mixer->m_Output.data();
+        mixer->Mix(output, frames);
+        SDL_PutAudioStreamData(
+            stream, output, static_cast<int>(frames) * frameBytes);
+        done += frames;
+    }
+
+    if (total > 0) {
+        const double seconds =
+            static_cast<double>(SDL_GetPerformanceCounter() - start) /
+            static_cast<double>(SDL_GetPerformanceFrequency());
+        const auto load = static_cast<float>(
+            seconds * mixer->m_Specification.SampleRate / total);
+        // Smoothed over a few dozen callbacks.
+        const float previous = mixer->m_Load.load(std::memory_order_relaxed);
+        mixer->m_Load.store(previous + (load - previous) * 0.05f,
+                            std::memory_order_relaxed);
+    }
+}
+
+bool AudioMixer::Send(const Command &command) {
+    if (m_Commands.Push(command)) {
+        return true;
+    }
+    if (!m_CommandsLost.exchange(true, std::memory_order_relaxed)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "AudioMixer: command queue full, commands dropped");
+    }
+    return false;
+}
+
+void AudioMixer::Execute(const Command &command) {
+    if (command.Type == CommandType::Play) {
+        const VoiceSpecification &specification = command.Specification;
+
+        Voice &voice   = m_Voices[GetSlot(command.Voice)];
+        voice          = Voice();
+        voice.Source   = command.Source;
+        voice.Feed     = command.Feed;
+        voice.Handle   = command.Voice;
+        voice.Gain     = specification.Gain;
+        voice.Pan      = std::clamp(specification.Pan, -1.0f, 1.0f);
+        voice.Loop     = specification.Loop;
+        SetStep(voice, specification.Pitch);
+        // Starts at full volume: ramping in would soften the attack.
+        GetPanGains(voice.Gain, voice.Pan, voice.Left, voice.Right);
+        m_Playing.push_back(GetSlot(command.Voice));
+        return;
+    }
+
+    if (command.Type == CommandType::Retire) {
+        for (size_t i = 0; i < m_Playing.size();) {
+            if (m_Voices[m_Playing[i]].Source == command.Source) {
+                Release(i);
+            } else {
+                i++;
+            }
+        }
+        m_Retired.Push(command.Source); // holds every sound there can be
+        return;
+    }
+
+    Voice *voice = Find(command.Voice);
+    if (!voice) {
+        return; // ended already
+    }
+    switch (command.Type) {
+    case CommandType::Stop:
+        voice->Stopping = true;
+        break;
+    case CommandType::SetGain:
+        voice->Gain = command.Value;
+        break;
+    case CommandType::SetPan:
+        voice->Pan = std::clamp(command.Value, -1.0f, 1.0f);
+        break;
+    case CommandType::SetPitch:
+        SetStep(*voice, command.Value);
+        break;
+    case CommandType::Seek:
+        if (Stream *stream = voice->Feed) {
+            // The decoder thread starts over from there. What the ring
+            // holds is stale: dropping it now leaves it the room.
+            const uint32_t request =
+                stream->SeekRequest.load(std::memory_order_relaxed) + 1;
+            stream->SeekFrame.store(command.Frame, std::memory_order_relaxed);
+            stream->SeekRequest.store(request, std::memory_order_release);
+            stream->Ring.Clear();
+            stream->WindowFrames = 0;
+            voice->Position      = 0;
+        } else {
+            const uint64_t frames = voice->Source->Frames;
+            voice->Position = (voice->Loop ? command.Frame % frames
+                                           : std::min(command.Frame, frames))
+                              << 32;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+AudioMixer::Voice *AudioMixer::Find(VoiceHandle handle) {
+    if (GetSlot(handle) >= m_Voices.size()) {
+        return nullptr;
+    }
+    Voice &voice = m_Voices[GetSlot(handle)];
+    return (voice.Source || voice.Feed) && voice.Handle == handle ? &voice
+                                                                  : nullptr;
+}
+
+void AudioMixer::SetStep(Voice &voice, float pitch) const {
+    const int    source = voice.Feed ? voice.Feed->SampleRate
+                                     : voice.Source->SampleRate;
+    const double rate   = static_cast<double>(source) /
+                        m_Specification.SampleRate;
+    const double step = std::clamp(pitch, kMinPitch, kMaxPitch) * rate;
+    voice.Step        = std::max<uint64_t>(
+        static_cast<uint64_t>(step * static_cast<double>(kOne)), 1);
+}
+
+bool AudioMixer::Render(Voice &voice, float *output, uint32_t frames) {
+    // Ramps from last buffer's gains to the current ones.
+    float targetLeft, targetRight;
+    GetPanGains(voice.Stopping ? 0.0f : voice.Gain,
+                voice.Pan,
+                targetLeft,
+                targetRight);
+    const Ramp ramp{voice.Left,
+                    voice.Right,
+                    (targetLeft - voice.Left) / frames,
+                    (targetRight - voice.Right) / frames};
+
+    const bool playing = voice.Feed ? RenderStream(voice, output, frames, ramp)
+                                    : RenderSound(voice, output, frames, ramp);
+    voice.Left  = targetLeft;
+    voice.Right = targetRight;
+    return playing && !voice.Stopping;
+}
+
+bool AudioMixer::RenderSound(Voice      &voice,
+                             float      *output,
+                             uint32_t    frames,
+                             const Ramp &ramp) {
+    const Sound   &sound    = *voice.Source;
+    const uint32_t channels = sound.Channels;
+
+    // A loop's last frame interpolates towards its first, not the
+    // padding: it is done apart.
+    const uint64_t end  = static_cast<uint64_t>(sound.Frames) << 32;
+    const uint64_t wrap = voice.Loop ? end - kOne : end;
+    const float    step = static_cast<float>(voice.Step * 0x1p-32);
+
+    float *scratch = m_Scratch.data();
+    for (uint32_t done = 0; done < frames;) {
+        uint32_t     count    = std::min(frames - done, kChunkFrames);
+        const auto   index    = static_cast<uint32_t>(voice.Position >> 32);
+        const auto   fraction = static_cast<float>(
+            static_cast<uint32_t>(voice.Position) * 0x1p-32);
+        const float *source   = sound.Samples.data() + index * channels;
+
+        if (voice.Position < wrap) {
+            const uint64_t available =
+                (wrap - voice.Position + voice.Step - 1) / voice.Step;
+            count = static_cast<uint32_t>(
+                std::min<uint64_t>(count, available));
+            if (channels == 1) {
+                m_Kernels.ResampleMono(source, fraction, step, scratch, count);
+            } else {
+                m_Kernels.ResampleStereo(
+                    source, fraction, step, scratch, count);
+            }
+        } else {
+            const float *first = sound.Samples.data();
+            const float *last  = source + channels - 1; // right, or mono
+            scratch[0] = source[0] + fraction * (first[0] - source[0]);
+            scratch[1] = *last + fraction * (first[channels - 1] - *last);
+            count      = 1;
+        }
+
+        m_Kernels.Accumulate(scratch,
+                             output + 2 * done,
+                             count,
+                             ramp.Left + ramp.LeftStep * done,
+                             ramp.Right + ramp.RightStep * done,
+                             ramp.LeftStep,
+                             ramp.RightStep);
+        voice.Position += count * voice.Step;
+        done += count;
+
+        if (voice.Position >= end) {
+            if (!voice.Loop) {
+                return false;
+            }
+            voice.Position %= end;
+        }
+    }
+    return true;
+}
+
+bool AudioMixer::RenderStream(Voice      &voice,
+                              float      *output,
+                              uint32_t    frames,
+                              const Ramp &ramp) {
+    Stream        &stream   = *voice.Feed;
+    const uint32_t channels = stream.Channels;
+
+    // Silent, but not starved, until the decoder thread got to it.
+    const uint32_t request = stream.SeekRequest.load(std::memory_order_relaxed);
+    if (!stream.Primed.load(std::memory_order_acquire) ||
+        stream.SeekServed.load(std::memory_order_acquire) != request) {
+        return true;
+    }
+    if (stream.Skipped != request) {
+        stream.Ring.SkipTo(stream.SeekCursor.load(std::memory_order_relaxed));
+        stream.Skipped = request;
+    }
+
+    // Output frame `count` - 1 reads window frames up to this one.
+    const auto lastFrame = [&voice](uint32_t count) {
+        return (voice.Position + (count - 1) * voice.Step) >> 32;
+    };
+    // Output frames whose two source frames lie below frame `limit`.
+    const auto fitting = [&voice](uint64_t limit) -> uint64_t {
+        const uint64_t bound = (limit - 1) << 32;
+        return limit > 1 && bound > voice.Position
+                   ? (bound - voice.Position - 1) / voice.Step + 1
+                   : 0;
+    };
+
+    const float step   = static_cast<float>(voice.Step * 0x1p-32);
+    float      *window = stream.Window.data();
+    float      *scratch = m_Scratch.data();
+    for (uint32_t done = 0; done < frames;) {
+        uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(
+            std::min(frames - done, kChunkFrames), fitting(kWindowFrames)));
+
+        // Tops the window up with what the chunk needs, as far as the
+        // ring has it.
+        const auto needed = static_cast<uint32_t>(lastFrame(count) + 2);
+        if (stream.WindowFrames < needed) {
+            const size_t read = stream.Ring.Read(
+                window + stream.WindowFrames * channels,
+                (needed - stream.WindowFrames) * channels);
+            stream.WindowFrames += static_cast<uint32_t>(read / channels);
+        }
+        if (stream.WindowFrames < needed) {
+            count = static_cast<uint32_t>(
+                std::min<uint64_t>(count, fitting(stream.WindowFrames)));
+        }
+
+        if (count == 0) {
+            const bool ended =
+                stream.Ring.GetReadCursor() >=
+                stream.EndCursor.load(std::memory_order_acquire);
+            if (ended) {
+                return false;
+            }
+            // Counted once however many buffers it stays dry for.
+            if (!stream.Starved) {
+                m_Underruns.fetch_add(1, std::memory_order_relaxed);
+                stream.Starved = true;
+            }
+            m_UnderrunFrames.fetch_add(frames - done,
+                                       std::memory_order_relaxed);
+            return true;
+        }
+        stream.Starved = false;
+
+        const auto   index    = static_cast<uint32_t>(voice.Position >> 32);
+        const auto   fraction = static_cast<float>(
+            static_cast<uint32_t>(voice.Position) * 0x1p-32);
+        const float *source   = window + index * channels;
+        if (channels == 1) {
+            m_Kernels.ResampleMono(source, fraction, step, scratch, count);
+        } else {
+            m_Kernels.ResampleStereo(source, fraction, step, scratch, count);
+        }
+        m_Kernels.Accumulate(scratch,
+                             output + 2 * done,
+                             count,
+                             ramp.Left + ramp.LeftStep * done,
+                             ramp.Right + ramp.RightStep * done,
+                             ramp.LeftStep,
+                             ramp.RightStep);
+        voice.Position += count * voice.Step;
+        done += count;
+
+        // Drops the frames behind the voice; a frame or two remain.
+        const auto behind = static_cast<uint32_t>(std::min<uint64_t>(
+            voice.Position >> 32, stream.WindowFrames));
+        std::memmove(window,
+                     window + behind * channels,
+                     (stream.WindowFrames - behind) * channels * sizeof(float));
+        stream.WindowFrames -= behind;
+        voice.Position -= static_cast<uint64_t>(behind) << 32;
+    }
+    return true;
+}
+
+void AudioMixer::Release(size_t playing) {
+    const uint32_t slot = m_Playing[playing];
+    m_Playing[playing]  = m_Playing.back();
+    m_Playing.pop_back();
+
+    Voice &voice = m_Voices[slot];
+    if (voice.Feed) {
+        voice.Feed->Done.store(true, std::memory_order_release);
+    }
+    voice.Source = nullptr;
+    voice.Feed   = nullptr;
+    m_Handles[slot].store(kInvalidVoice, std::memory_order_release);
+    m_FreeSlots.Push(slot);
+}
+
+void AudioMixer::DecodeThreadMain() {
+    std::vector<float> block(2 * kDecodeFrames);
+
+    std::unique_lock lock(m_StreamMutex);
+    while (!m_StopDecoding) {
+        for (std::unique_ptr<Stream> &stream : m_NewStreams) {
+            m_Streams.push_back(std::move(stream));
+        }
+        m_NewStreams.clear();
+        lock.unlock();
+
+        std::erase_if(m_Streams, [](const std::unique_ptr<Stream> &stream) {
+            return stream->Done.load(std::memory_order_acquire);
+        });
+        for (const std::unique_ptr<Stream> &stream : m_Streams) {
+            Fill(*stream, block);
+        }
+
+        lock.lock();
+        const auto woken = [this] {
+            return m_StopDecoding || !m_NewStreams.empty();
+        };
+        if (m_Streams.empty()) {
+            m_StreamWake.wait(lock, woken);
+        } else {
+            m_StreamWake.wait_for(lock, kDecodePeriod, woken);
+        }
+    }
+}
+
+void AudioMixer::Fill(Stream &stream, std::vector<float> &block) {
+    AudioDecoder  &decoder  = *stream.Decoder;
+    const uint32_t channels = stream.Channels;
+
+    // A seek is answered once the ring is refilled from the new frame,
+    // so the voice doesn't start on an empty ring.
+    const uint32_t request = stream.SeekRequest.load(std::memory_order_acquire);
+    const bool     seeking =
+        request != stream.SeekServed.load(std::memory_order_relaxed);
+    if (seeking) {
+        uint64_t frame = stream.SeekFrame.load(std::memory_order_relaxed);
+        if (stream.Loop && decoder.GetFrames() > 0) {
+            frame %= decoder.GetFrames();
+        }
+        decoder.Seek(frame);
+        stream.Ended = false;
+        stream.EndCursor.store(std::numeric_limits<uint64_t>::max(),
+                               std::memory_order_relaxed);
+        stream.SeekCursor.store(stream.Ring.GetWriteCursor(),
+                                std::memory_order_relaxed);
+    }
+
+    // Leaves room for the padding, so the end can always be written.
+    bool rewound = false;
+    while (!stream.Ended) {
+        const size_t writable = stream.Ring.GetWritable() / channels;
+        if (writable <= kPadFrames) {
+            break;
+        }
+        const auto frames = static_cast<uint32_t>(
+            std::min<size_t>(writable - kPadFrames, kDecodeFrames));
+        const uint32_t decoded = decoder.Read(block.data(), frames);
+        stream.Ring.Write(block.data(), decoded * channels);
+        if (decoded == frames) {
+            rewound = false;
+            continue;
+        }
+
+        // Loops start over seamlessly, unless there is nothing to play.
+        if (stream.Loop && !(rewound && decoded == 0)) {
+            rewound = decoder.Seek(0);
+            if (rewound) {
+                continue;
+            }
+        }
+        std::fill_n(block.data(), kPadFrames * channels, 0.0f);
+        stream.Ring.Write(block.data(), kPadFrames * channels);
+        stream.Ended = true;
+        stream.EndCursor.store(stream.Ring.GetWriteCursor(),
+                               std::memory_order_release);
+    }
+    if (seeking) {
+        stream.SeekServed.store(request, std::memory_order_release);
+    }
+    stream.Primed.store(true, std::memory_order_release);
+}
+
+} // namespace brnCore
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <SDL3/SDL_audio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Engine/Assets/FileSystem.h"
+#include "Engine/Audio/MixKernels.h"
+#include "Engine/Core/BoundedQueue.h"
+
+namespace brnCore {
+
+using SoundId     = uint32_t;
+using VoiceHandle = uint32_t; // slot and generation; 0 is never valid
+
+inline constexpr SoundId kInvalidSound =
+    std::numeric_limits<SoundId>::max();
+inline constexpr VoiceHandle kInvalidVoice = 0;
+
+struct AudioMixerSpecification {
+    int SampleRate = 48000;
+    // Frames the device asks for at a time. Smaller is lower latency
+    // (256 at 48 kHz is 5.3 ms) and more callbacks; a hint the driver
+    // may round.
+    uint32_t BufferFrames = 256;
+    // Voices playing at once at most; Play() fails while all are busy.
+    uint32_t MaxVoices = 512;
+    uint32_t MaxSounds = 1024;
+    // Play/Stop/Set* calls queued between two callbacks at most.
+    uint32_t CommandCapacity = 4096;
+    // Decoded audio buffered ahead per stream, which bounds its memory
+    // (a quarter second of 48 kHz stereo is 94 KiB) and how long the
+    // decoder thread may stall before the stream runs dry.
+    uint32_t StreamMilliseconds = 250;
+};
+
+struct VoiceSpecification {
+    float Gain  = 1.0f;
+    float Pan   = 0.0f; // -1 left to 1 right, constant power
+    float Pitch = 1.0f; // playback rate, 2 is an octave up
+    bool  Loop  = false;
+};
+
+/*
+ * Mixes every sound the game plays into one SDL audio stream.
+ *
+ * Sounds are decoded up front to float PCM at their own rate. Play()
+ * takes a voice from a fixed pool and queues a command; the audio
+ * callback drains the queue and mixes all playing voices, resampling
+ * (linear) with SIMD kernels picked for the CPU at startup. Nothing is
+ * allocated or locked on the audio thread, and Play() and the Set*
+ * calls are lock free, from any thread.
+ *
+ * Changes of gain and pan ramp over one buffer, and Stop() fades out
+ * over one, so they never click.
+ *
+ * Long tracks are streamed instead: PlayStream() hands the file to a
+ * decoder thread that keeps a lock-free ring per stream filled a few
+ * hundred milliseconds ahead, and the callback only ever reads from the
+ * ring. Looping and Seek() are sample accurate. A ring found empty is
+ * an underrun: the stream goes silent until the decoder catches up, and
+ * the counters below say how often that happened.
+ *
+ * SDL_AUDIO_DRIVER=dummy (or disk, which writes sdlaudio.raw) runs the
+ * whole path without a sound card.
+ */
+class AudioMixer {
+  public:
+    explicit AudioMixer(
+        const AudioMixerSpecification &specification =
+            AudioMixerSpecification());
+    ~AudioMixer();
+
+    AudioMixer(const AudioMixer &)            = delete;
+    AudioMixer &operator=(const AudioMixer &) = delete;
+
+    // Opens the default playback device and starts mixing into it.
+    // Without it, Mix() can be driven by hand (offline rendering).
+    bool Open();
+
+    // Interleaved samples, 1 or 2 channels, at `sampleRate`.
+    SoundId CreateSound(std::span<const float> samples,
+                        uint32_t               channels,
+                        int                    sampleRate);
+    // A WAV file, converted to float.
+    SoundId LoadSound(const VirtualFileSystem &fileSystem,
+                      std::string_view         path);
+    // Stops the voices playing it. Not while another thread may still
+    // be calling Play() with it.
+    void DestroySound(SoundId sound);
+
+    VoiceHandle Play(SoundId                   sound,
+                     const VoiceSpecification &specification =
+                         VoiceSpecification());
+    void        Stop(VoiceHandle voice);
+    void        SetGain(VoiceHandle voice, float gain);
+    void        SetPan(VoiceHandle voice, float pan);
+    void        SetPitch(VoiceHandle voice, float pitch);
+    // Until it ended or was stopped, and the mixer noticed.
+    bool        IsPlaying(VoiceHandle voice) const;
+
+    // Streams a WAV file from disk or an archive on its own voice.
+    VoiceHandle PlayStream(const VirtualFileSystem  &fileSystem,
+                           std::string_view          path,
+                           const VoiceSpecification &specification =
+                               VoiceSpecification());
+    // Continues a voice at source frame `frame`; a stream goes silent
+    // until the decoder got there (about a buffer).
+    void Seek(VoiceHandle voice, uint64_t frame);
+
+    void  SetMasterGain(float gain);
+    float GetMasterGain() const;
+
+    // Frees destroyed sounds once the audio thread let go of them. Once
+    // per frame, on any one thread.
+    void Update();
+
+    /*
+     * Mixes `frames` frames of interleaved stereo into `output`. The
+     * audio callback calls this; call it directly only when the device
+     * isn't open.
+     */
+    void Mix(float *output, uint32_t frames);
+
+    uint32_t GetActiveVoiceCount() const {
+        return m_ActiveCount.load(std::memory_order_relaxed);
+    }
+    // Fraction of one core the callback spends mixing, smoothed.
+    float GetLoad() const { return m_Load.load(std::memory_order_relaxed); }
+    const char *GetKernelName() const { return m_Kernels.Name; }
+    // Times a playing stream ran dry, and the frames it missed, so far.
+    uint32_t GetUnderrunCount() const {
+        return m_Underruns.load(std::memory_order_relaxed);
+    }
+    uint64_t GetUnderrunFrames() const {
+        return m_UnderrunFrames.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Stream; // decoder, ring and seek state, in the .cpp
+
+    struct Sound {
+        // Two frames of silence past the end, so interpolation never
+        // reads out of bounds; loops wrap to the start on their own.
+        std::vector<float> Samples;
+        uint32_t           Frames;
+        uint32_t           Channels;
+        int                SampleRate;
+    };
+
+    enum class CommandType : uint8_t {
+        Play,
+        Stop,
+        SetGain,
+        SetPan,
+        SetPitch,
+        Seek,
+        Retire, // a destroyed sound
+    };
+
+    struct Command {
+        CommandType        Type   = CommandType::Stop;
+        VoiceHandle        Voice  = kInvalidVoice;
+        Sound             *Source = nullptr;
+        Stream            *Feed   = nullptr;
+        VoiceSpecification Specification;
+        float              Value = 0.0f;
+        uint64_t           Frame = 0;
+    };
+
+    // Audio thread only.
+    struct Voice {
+        const Sound *Source = nullptr;
+        Stream      *Feed   = nullptr; // streamed instead
+        VoiceHandle  Handle = kInvalidVoice;
+        // Source frames, 32.32 fixed point: exact over any length. For
+        // a stream, from the start of its window.
+        uint64_t Position = 0;
+        uint64_t Step     = 0;
+        float    Gain     = 1.0f;
+        float    Pan      = 0.0f;
+        float    Left     = 0.0f; // gains reached at the end of last Mix
+        float    Right    = 0.0f;
+        bool     Loop     = false;
+        bool     Stopping = false; // ends once faded out
+    };
+
+    // Gains at the first frame of a buffer and their change per frame.
+    struct Ramp {
+        float Left;
+        float Right;
+        float LeftStep;
+        float RightStep;
+    };
+
+    static void SDLCALL Callback(void            *userdata,
+                                 SDL_AudioStream *stream,
+                                 int              additionalAmount,
+                                 int              totalAmount);
+
+    bool   Send(const Command &command);
+    void   Execute(const Command &command);
+    Voice *Find(VoiceHandle handle);
+    void   SetStep(Voice &voice, float pitch) const;
+    bool   Render(Voice &voice, float *output, uint32_t frames);
+    bool   RenderSound(Voice      &voice,
+                       float      *output,
+                       uint32_t    frames,
+                       const Ramp &ramp);
+    bool   RenderStream(Voice      &voice,
+                        float      *output,
+                        uint32_t    frames,
+                        const Ramp &ramp);
+    void   Release(size_t playing);
+    void   DecodeThreadMain();
+    void   Fill(Stream &stream, std::vector<float> &block);
+
+    static uint32_t GetSlot(VoiceHandle handle) { return handle & 0xFFFF; }
+
+    AudioMixerSpecification m_Specification;
+    const MixKernels       &m_Kernels;
+    SDL_AudioStream        *m_Stream = nullptr;
+
+    // Sounds by id; read by Play() on any thread.
+    std::unique_ptr<std::atomic<Sound *>[]> m_Sounds;
+    std::mutex                              m_SoundMutex;
+    std::vector<SoundId>                    m_FreeSounds;
+    std::vector<Sound *>                    m_Unretired; // queue was full
+
+    // Game threads take slots from m_FreeSlots and the audio thread puts
+    // them back; m_Handles holds the handle each slot is playing as.
+    BoundedQueue<uint32_t>                      m_FreeSlots;
+    std::unique_ptr<std::atomic<VoiceHandle>[]> m_Handles;
+    std::unique_ptr<uint16_t[]>                 m_Generations;
+    BoundedQueue<Command>                       m_Commands;
+    BoundedQueue<Sound *>                       m_Retired;
+    std::atomic<float>                          m_MasterGain{1.0f};
+    std::atomic<bool>                           m_CommandsLost{false};
+
+    std::vector<Voice>    m_Voices;  // by slot
+    std::vector<uint32_t> m_Playing; // slots, in no order
+    std::vector<float>    m_Scratch; // one chunk of resampled frames
+    std::vector<float>    m_Output;  // one device buffer
+    std::atomic<uint32_t> m_ActiveCount{0};
+    std::atomic<float>    m_Load{0.0f};
+    std::atomic<uint32_t> m_Underruns{0};
+    std::atomic<uint64_t> m_UnderrunFrames{0};
+    uint32_t              m_ReportedUnderruns = 0;
+
+    // Streams are handed to the decoder thread through m_NewStreams,
+    // and it frees them once the audio thread marked them done.
+    std::thread                          m_DecodeThread;
+    std::mutex                           m_StreamMutex;
+    std::condition_variable              m_StreamWake;
+    std::vector<std::unique_ptr<Stream>> m_NewStreams;
+    std::vector<std::unique_ptr<Stream>> m_Streams; // decoder thread only
+    bool                                 m_StopDecoding = false;
+};
+
+} // namespace brnCore
@@ -0,0 +1,482 @@
+#include "MixKernels.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BRN_MIX_X86 1
+#include <immintrin.h>
+// GCC and Clang only emit AVX2 in functions that ask for it; MSVC emits
+// any intrinsic anywhere. Those functions clear the upper halves before
+// their scalar tails: SSE code after dirty AVX registers runs slowly.
+#if defined(__GNUC__) || defined(__clang__)
+#define BRN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BRN_TARGET_AVX2
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BRN_MIX_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace brnCore {
+
+namespace {
+/*
+ * Scalar versions, from frame `first` on: the whole job without SIMD,
+ * and the tails the vector loops leave. Positions are recomputed from
+ * the frame number rather than accumulated, so every path rounds the
+ * same way.
+ */
+void ResampleMonoFrom(const float *source,
+                      float        fraction,
+                      float        step,
+                      float       *output,
+                      uint32_t     first,
+                      uint32_t     frames) {
+    for (uint32_t i = first; i < frames; i++) {
+        const float position = fraction + step * static_cast<float>(i);
+        const auto  index    = static_cast<uint32_t>(position);
+        const float t        = position - static_cast<float>(index);
+        const float a        = source[index];
+        const float sample   = a + t * (source[index + 1] - a);
+        output[2 * i]        = sample;
+        output[2 * i + 1]    = sample;
+    }
+}
+
+void ResampleStereoFrom(const float *source,
+                        float        fraction,
+                        float        step,
+                        float       *output,
+                        uint32_t     first,
+                        uint32_t     frames) {
+    for (uint32_t i = first; i < frames; i++) {
+        const float  position = fraction + step * static_cast<float>(i);
+        const auto   index    = static_cast<uint32_t>(position);
+        const float  t        = position - static_cast<float>(index);
+        const float *a        = source + 2 * index;
+        output[2 * i]         = a[0] + t * (a[2] - a[0]);
+        output[2 * i + 1]     = a[1] + t * (a[3] - a[1]);
+    }
+}
+
+void AccumulateFrom(const float *input,
+                    float       *output,
+                    uint32_t     first,
+                    uint32_t     frames,
+                    float        left,
+                    float        right,
+                    float        leftStep,
+                    float        rightStep) {
+    for (uint32_t i = first; i < frames; i++) {
+        const auto frame = static_cast<float>(i);
+        output[2 * i] += input[2 * i] * (left + leftStep * frame);
+        output[2 * i + 1] += input[2 * i + 1] * (right + rightStep * frame);
+    }
+}
+
+void ScaleClampFrom(float   *samples,
+                    uint32_t first,
+                    uint32_t count,
+                    float    gain) {
+    for (uint32_t i = first; i < count; i++) {
+        samples[i] = std::clamp(samples[i] * gain, -1.0f, 1.0f);
+    }
+}
+
+#if !defined(BRN_MIX_X86) && !defined(BRN_MIX_NEON)
+void ResampleMonoScalar(const float *source,
+                        float        fraction,
+                        float        step,
+                        float       *output,
+                        uint32_t     frames) {
+    ResampleMonoFrom(source, fraction, step, output, 0, frames);
+}
+
+void ResampleStereoScalar(const float *source,
+                          float        fraction,
+                          float        step,
+                          float       *output,
+                          uint32_t     frames) {
+    ResampleStereoFrom(source, fraction, step, output, 0, frames);
+}
+
+void AccumulateScalar(const float *input,
+                      float       *output,
+                      uint32_t     frames,
+                      float        left,
+                      float        right,
+                      float        leftStep,
+                      float        rightStep) {
+    AccumulateFrom(
+        input, output, 0, frames, left, right, leftStep, rightStep);
+}
+
+void ScaleClampScalar(float *samples, uint32_t count, float gain) {
+    ScaleClampFrom(samples, 0, count, gain);
+}
+#endif
+
+#if defined(BRN_MIX_X86)
+// SSE2 has no gather: indices go through memory, the math stays wide.
+void ResampleMonoSse2(const float *source,
+                      float        fraction,
+                      float        step,
+                      float       *output,
+                      uint32_t     frames) {
+    const __m128 start = _mm_set1_ps(fraction);
+    const __m128 delta = _mm_set1_ps(step);
+    __m128       frame = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+    alignas(16) int32_t indices[4];
+    uint32_t            i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128  position = _mm_add_ps(start, _mm_mul_ps(frame, delta));
+        const __m128i index    = _mm_cvttps_epi32(position);
+        const __m128  t = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), index);
+
+        const __m128 a = _mm_setr_ps(source[indices[0]],
+                                     source[indices[1]],
+                                     source[indices[2]],
+                                     source[indices[3]]);
+        const __m128 b = _mm_setr_ps(source[indices[0] + 1],
+                                     source[indices[1] + 1],
+                                     source[indices[2] + 1],
+                                     source[indices[3] + 1]);
+        const __m128 sample =
+            _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+        _mm_storeu_ps(output + 2 * i, _mm_unpacklo_ps(sample, sample));
+        _mm_storeu_ps(output + 2 * i + 4, _mm_unpackhi_ps(sample, sample));
+        frame = _mm_add_ps(frame, _mm_set1_ps(4.0f));
+    }
+    ResampleMonoFrom(source, fraction, step, output, i, frames);
+}
+
+void ResampleStereoSse2(const float *source,
+                        float        fraction,
+                        float        step,
+                        float       *output,
+                        uint32_t     frames) {
+    const __m128 start = _mm_set1_ps(fraction);
+    const __m128 delta = _mm_set1_ps(step);
+    __m128       frame = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+    alignas(16) int32_t indices[4];
+    alignas(16) float   weights[4];
+    uint32_t            i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128  position = _mm_add_ps(start, _mm_mul_ps(frame, delta));
+        const __m128i index    = _mm_cvttps_epi32(position);
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), index);
+        _mm_store_ps(weights,
+                     _mm_sub_ps(position, _mm_cvtepi32_ps(index)));
+
+        // Both channels of a frame are adjacent: one 64 bit load each.
+        for (int j = 0; j < 4; j++) {
+            const float *pair = source + 2 * indices[j];
+            const __m128 a    = _mm_castpd_ps(
+                _mm_load_sd(reinterpret_cast<const double *>(pair)));
+            const __m128 b = _mm_castpd_ps(
+                _mm_load_sd(reinterpret_cast<const double *>(pair + 2)));
+            const __m128 sample = _mm_add_ps(
+                a, _mm_mul_ps(_mm_set1_ps(weights[j]), _mm_sub_ps(b, a)));
+            _mm_storel_pi(reinterpret_cast<__m64 *>(output + 2 * (i + j)),
+                          sample);
+        }
+        frame = _mm_add_ps(frame, _mm_set1_ps(4.0f));
+    }
+    ResampleStereoFrom(source, fraction, step, output, i, frames);
+}
+
+void AccumulateSse2(const float *input,
+                    float       *output,
+                    uint32_t     frames,
+                    float        left,
+                    float        right,
+                    float        leftStep,
+                    float        rightStep) {
+    // Two frames per vector: gains L0 R0 L1 R1.
+    const __m128 base  = _mm_setr_ps(left, right, left, right);
+    const __m128 delta = _mm_setr_ps(leftStep, rightStep, leftStep, rightStep);
+    __m128       frame = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+
+    uint32_t i = 0;
+    for (; i + 2 <= frames; i += 2) {
+        const __m128 gain = _mm_add_ps(base, _mm_mul_ps(frame, delta));
+        const __m128 mixed =
+            _mm_add_ps(_mm_loadu_ps(output + 2 * i),
+                       _mm_mul_ps(_mm_loadu_ps(input + 2 * i), gain));
+        _mm_storeu_ps(output + 2 * i, mixed);
+        frame = _mm_add_ps(frame, _mm_set1_ps(2.0f));
+    }
+    AccumulateFrom(
+        input, output, i, frames, left, right, leftStep, rightStep);
+}
+
+void ScaleClampSse2(float *samples, uint32_t count, float gain) {
+    const __m128 scale = _mm_set1_ps(gain);
+    const __m128 low   = _mm_set1_ps(-1.0f);
+    const __m128 high  = _mm_set1_ps(1.0f);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 sample = _mm_mul_ps(_mm_loadu_ps(samples + i), scale);
+        _mm_storeu_ps(samples + i, _mm_min_ps(_mm_max_ps(sample, low), high));
+    }
+    ScaleClampFrom(samples, i, count, gain);
+}
+
+BRN_TARGET_AVX2 void ResampleMonoAvx2(const float *source,
+                                      float        fraction,
+                                      float        step,
+                                      float       *output,
+                                      uint32_t     frames) {
+    const __m256 start = _mm256_set1_ps(fraction);
+    const __m256 delta = _mm256_set1_ps(step);
+    __m256       frame =
+        _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    uint32_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 position =
+            _mm256_add_ps(start, _mm256_mul_ps(frame, delta));
+        const __m256  whole  = _mm256_floor_ps(position);
+        const __m256i index  = _mm256_cvttps_epi32(whole);
+        const __m256  t      = _mm256_sub_ps(position, whole);
+        const __m256  a      = _mm256_i32gather_ps(source, index, 4);
+        const __m256  b      = _mm256_i32gather_ps(source + 1, index, 4);
+        const __m256  sample =
+            _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+
+        // s0 s0 s1 s1 | s4 s4 s5 s5 and s2 s2 s3 s3 | s6 s6 s7 s7.
+        const __m256 low  = _mm256_unpacklo_ps(sample, sample);
+        const __m256 high = _mm256_unpackhi_ps(sample, sample);
+        _mm256_storeu_ps(output + 2 * i,
+                         _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_storeu_ps(output + 2 * i + 8,
+                         _mm256_permute2f128_ps(low, high, 0x31));
+        frame = _mm256_add_ps(frame, _mm256_set1_ps(8.0f));
+    }
+    _mm256_zeroupper();
+    ResampleMonoFrom(source, fraction, step, output, i, frames);
+}
+
+BRN_TARGET_AVX2 void ResampleStereoAvx2(const float *source,
+                                        float        fraction,
+                                        float        step,
+                                        float       *output,
+                                        uint32_t     frames) {
+    const __m256 start = _mm256_set1_ps(fraction);
+    const __m256 delta = _mm256_set1_ps(step);
+    __m256       frame =
+        _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    uint32_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 position =
+            _mm256_add_ps(start, _mm256_mul_ps(frame, delta));
+        const __m256  whole = _mm256_floor_ps(position);
+        const __m256i index = _mm256_cvttps_epi32(whole);
+        const __m256  t     = _mm256_sub_ps(position, whole);
+        const __m256i left  = _mm256_add_epi32(index, index); // in floats
+
+        const __m256 leftA  = _mm256_i32gather_ps(source, left, 4);
+        const __m256 rightA = _mm256_i32gather_ps(source + 1, left, 4);
+        const __m256 leftB  = _mm256_i32gather_ps(source + 2, left, 4);
+        const __m256 rightB = _mm256_i32gather_ps(source + 3, left, 4);
+        const __m256 leftSample = _mm256_add_ps(
+            leftA, _mm256_mul_ps(t, _mm256_sub_ps(leftB, leftA)));
+        const __m256 rightSample = _mm256_add_ps(
+            rightA, _mm256_mul_ps(t, _mm256_sub_ps(rightB, rightA)));
+
+        const __m256 low  = _mm256_unpacklo_ps(leftSample, rightSample);
+        const __m256 high = _mm256_unpackhi_ps(leftSample, rightSample);
+        _mm256_storeu_ps(output + 2 * i,
+                         _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_storeu_ps(output + 2 * i + 8,
+                         _mm256_permute2f128_ps(low, high, 0x31));
+        frame = _mm256_add_ps(frame, _mm256_set1_ps(8.0f));
+    }
+    _mm256_zeroupper();
+    ResampleStereoFrom(source, fraction, step, output, i, frames);
+}
+
+BRN_TARGET_AVX2 void AccumulateAvx2(const float *input,
+                                    float       *output,
+                                    uint32_t     frames,
+                                    float        left,
+                                    float        right,
+                                    float        leftStep,
+                                    float        rightStep) {
+    // Four frames per vector.
+    const __m256 base =
+        _mm256_setr_ps(left, right, left, right, left, right, left, right);
+    const __m256 delta = _mm256_setr_ps(leftStep,
+                                        rightStep,
+                                        leftStep,
+                                        rightStep,
+                                        leftStep,
+                                        rightStep,
+                                        leftStep,
+                                        rightStep);
+    __m256 frame =
+        _mm256_setr_ps(0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f);
+
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m256 gain = _mm256_add_ps(base, _mm256_mul_ps(frame, delta));
+        const __m256 mixed =
+            _mm256_add_ps(_mm256_loadu_ps(output + 2 * i),
+                          _mm256_mul_ps(_mm256_loadu_ps(input + 2 * i), gain));
+        _mm256_storeu_ps(output + 2 * i, mixed);
+        frame = _mm256_add_ps(frame, _mm256_set1_ps(4.0f));
+    }
+    _mm256_zeroupper();
+    AccumulateFrom(
+        input, output, i, frames, left, right, leftStep, rightStep);
+}
+
+BRN_TARGET_AVX2 void ScaleClampAvx2(float   *samples,
+                                    uint32_t count,
+                                    float    gain) {
+    const __m256 scale = _mm256_set1_ps(gain);
+    const __m256 low   = _mm256_set1_ps(-1.0f);
+    const __m256 high  = _mm256_set1_ps(1.0f);
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 sample =
+            _mm256_mul_ps(_mm256_loadu_ps(samples + i), scale);
+        _mm256_storeu_ps(samples + i,
+                         _mm256_min_ps(_mm256_max_ps(sample, low), high));
+    }
+    _mm256_zeroupper();
+    ScaleClampFrom(samples, i, count, gain);
+}
+#endif
+
+#if defined(BRN_MIX_NEON)
+void ResampleMonoNeon(const float *source,
+                      float        fraction,
+                      float        step,
+                      float       *output,
+                      uint32_t     frames) {
+    const float32x4_t start  = vdupq_n_f32(fraction);
+    const float32x4_t offset = {0.0f, 1.0f, 2.0f, 3.0f};
+
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const float32x4_t frame =
+            vaddq_f32(offset, vdupq_n_f32(static_cast<float>(i)));
+        const float32x4_t position = vmlaq_n_f32(start, frame, step);
+        const uint32x4_t  index    = vcvtq_u32_f32(position);
+        const float32x4_t t = vsubq_f32(position, vcvtq_f32_u32(index));
+
+        float32x4_t a = vdupq_n_f32(0.0f);
+        float32x4_t b = vdupq_n_f32(0.0f);
+        a = vsetq_lane_f32(source[vgetq_lane_u32(index, 0)], a, 0);
+        a = vsetq_lane_f32(source[vgetq_lane_u32(index, 1)], a, 1);
+        a = vsetq_lane_f32(source[vgetq_lane_u32(index, 2)], a, 2);
+        a = vsetq_lane_f32(source[vgetq_lane_u32(index, 3)], a, 3);
+        b = vsetq_lane_f32(source[vgetq_lane_u32(index, 0) + 1], b, 0);
+        b = vsetq_lane_f32(source[vgetq_lane_u32(index, 1) + 1], b, 1);
+        b = vsetq_lane_f32(source[vgetq_lane_u32(index, 2) + 1], b, 2);
+        b = vsetq_lane_f32(source[vgetq_lane_u32(index, 3) + 1], b, 3);
+
+        const float32x4_t sample = vmlaq_f32(a, t, vsubq_f32(b, a));
+        vst2q_f32(output + 2 * i, (float32x4x2_t{{sample, sample}}));
+    }
+    ResampleMonoFrom(source, fraction, step, output, i, frames);
+}
+
+void ResampleStereoNeon(const float *source,
+                        float        fraction,
+                        float        step,
+                        float       *output,
+                        uint32_t     frames) {
+    // A frame is one 64 bit vector; nothing to gain from going wider.
+    for (uint32_t i = 0; i < frames; i++) {
+        const float       position = fraction + step * static_cast<float>(i);
+        const auto        index    = static_cast<uint32_t>(position);
+        const float       t        = position - static_cast<float>(index);
+        const float32x2_t a        = vld1_f32(source + 2 * index);
+        const float32x2_t b        = vld1_f32(source + 2 * index + 2);
+        vst1_f32(output + 2 * i, vmla_n_f32(a, vsub_f32(b, a), t));
+    }
+}
+
+void AccumulateNeon(const float *input,
+                    float       *output,
+                    uint32_t     frames,
+                    float        left,
+                    float        right,
+                    float        leftStep,
+                    float        rightStep) {
+    const float32x4_t base   = {left, right, left, right};
+    const float32x4_t delta  = {leftStep, rightStep, leftStep, rightStep};
+    const float32x4_t offset = {0.0f, 0.0f, 1.0f, 1.0f};
+
+    uint32_t i = 0;
+    for (; i + 2 <= frames; i += 2) {
+        const float32x4_t frame =
+            vaddq_f32(offset, vdupq_n_f32(static_cast<float>(i)));
+        const float32x4_t gain = vmlaq_f32(base, frame, delta);
+        vst1q_f32(output + 2 * i,
+                  vmlaq_f32(vld1q_f32(output + 2 * i),
+                            vld1q_f32(input + 2 * i),
+                            gain));
+    }
+    AccumulateFrom(
+        input, output, i, frames, left, right, leftStep, rightStep);
+}
+
+void ScaleClampNeon(float *samples, uint32_t count, float gain) {
+    const float32x4_t low  = vdupq_n_f32(-1.0f);
+    const float32x4_t high = vdupq_n_f32(1.0f);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t sample = vmulq_n_f32(vld1q_f32(samples + i), gain);
+        vst1q_f32(samples + i, vminq_f32(vmaxq_f32(sample, low), high));
+    }
+    ScaleClampFrom(samples, i, count, gain);
+}
+#endif
+} // namespace
+
+const MixKernels &GetMixKernels() {
+    static const MixKernels kernels = [] {
+#if defined(BRN_MIX_X86)
+        if (SDL_HasAVX2()) {
+            return MixKernels{"AVX2",
+                              ResampleMonoAvx2,
+                              ResampleStereoAvx2,
+                              AccumulateAvx2,
+                              ScaleClampAvx2};
+        }
+        return MixKernels{"SSE2",
+                          ResampleMonoSse2,
+                          ResampleStereoSse2,
+                          AccumulateSse2,
+                          ScaleClampSse2};
+#elif defined(BRN_MIX_NEON)
+        return MixKernels{"NEON",
+                          ResampleMonoNeon,
+                          ResampleStereoNeon,
+                          AccumulateNeon,
+                          ScaleClampNeon};
+#else
+        return MixKernels{"Scalar",
+                          ResampleMonoScalar,
+                          ResampleStereoScalar,
+                          AccumulateScalar,
+                          ScaleClampScalar};
+#endif
+    }();
+    return kernels;
+}
+
+} // namespace brnCore
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace brnCore {
+
+/*
+ * Inner loops of the AudioMixer, picked once for the CPU it runs on:
+ * AVX2, SSE2 or NEON, with a scalar fallback. Buffers are interleaved
+ * stereo float unless noted; none of them needs to be aligned.
+ */
+struct MixKernels {
+    const char *Name;
+
+    /*
+     * Linearly interpolates `frames` output frames from `source`, the
+     * first at `fraction` (in [0, 1)) past source frame 0 and each next
+     * one `step` source frames further. Reads source frames up to
+     * fraction + frames * step, plus one. Mono sources come out on both
+     * channels.
+     */
+    void (*ResampleMono)(const float *source,
+                         float        fraction,
+                         float        step,
+                         float       *output,
+                         uint32_t     frames);
+    void (*ResampleStereo)(const float *source,
+                           float        fraction,
+                           float        step,
+                           float       *output,
+                           uint32_t     frames);
+
+    /*
+     * output += input * gain, where the left and right gains start at
+     * `left` and `right` and change by `leftStep` and `rightStep` every
+     * frame, so volume changes ramp instead of clicking.
+     */
+    void (*Accumulate)(const float *input,
+                       float       *output,
+                       uint32_t     frames,
+                       float        left,
+                       float        right,
+                       float        leftStep,
+                       float        rightStep);
+
+    // Scales `count` samples by `gain` and clamps them to [-1, 1].
+    void (*ScaleClamp)(float *samples, uint32_t count, float gain);
+};
+
+const MixKernels &GetMixKernels();
+
+} // namespace brnCore
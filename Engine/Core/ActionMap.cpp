@@ -0,0 +1,90 @@
+#include "ActionMap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Core/Input.h"
+
+namespace brnCore {
+
+namespace {
+// A binding's value, and whether it went down or up this frame.
+float Evaluate(const InputBinding  &binding,
+               const InputSnapshot &snapshot,
+               bool                &pressed,
+               bool                &released) {
+    const auto button = static_cast<uint8_t>(binding.Code);
+    switch (binding.Type) {
+    case InputBinding::Source::Key: {
+        const auto key = static_cast<SDL_Scancode>(binding.Code);
+        pressed        = snapshot.WasKeyPressed(key);
+        released       = snapshot.WasKeyReleased(key);
+        return snapshot.IsKeyDown(key) ? binding.Scale : 0.0f;
+    }
+    case InputBinding::Source::MouseButton:
+        pressed  = snapshot.WasMouseButtonPressed(button);
+        released = snapshot.WasMouseButtonReleased(button);
+        return snapshot.IsMouseButtonDown(button) ? binding.Scale : 0.0f;
+    case InputBinding::Source::GamepadButton: {
+        if (binding.Gamepad >= kMaxGamepads) {
+            return 0.0f;
+        }
+        const GamepadState &gamepad = snapshot.GetGamepad(binding.Gamepad);
+        pressed                     = gamepad.Pressed.test(button);
+        released                    = gamepad.Released.test(button);
+        return gamepad.Down.test(button) ? binding.Scale : 0.0f;
+    }
+    case InputBinding::Source::GamepadAxis:
+        if (binding.Gamepad >= kMaxGamepads) {
+            return 0.0f;
+        }
+        return snapshot.GetGamepad(binding.Gamepad).Axes[binding.Code] *
+               binding.Scale;
+    }
+    return 0.0f;
+}
+} // namespace
+
+void ActionMap::Bind(StringId action, const InputBinding &binding) {
+    m_Actions[action].Bindings.push_back(binding);
+}
+
+void ActionMap::Unbind(StringId action) { m_Actions.erase(action); }
+
+void ActionMap::Update(const InputSnapshot &snapshot) {
+    for (auto &[id, action] : m_Actions) {
+        ActionState &state   = action.State;
+        const bool   wasDown = state.Down;
+
+        // Keys and buttons report their own edges, so a tap between two
+        // frames still presses (and releases) the action; a binding let
+        // go while another holds it doesn't.
+        float value    = 0.0f;
+        bool  pressed  = false;
+        bool  released = false;
+        for (const InputBinding &binding : action.Bindings) {
+            bool        bindingPressed  = false;
+            bool        bindingReleased = false;
+            const float bindingValue    = Evaluate(
+                binding, snapshot, bindingPressed, bindingReleased);
+            if (std::abs(bindingValue) > std::abs(value)) {
+                value = bindingValue;
+            }
+            pressed |= bindingPressed;
+            released |= bindingReleased;
+        }
+
+        state.Value    = std::clamp(value, -1.0f, 1.0f);
+        state.Down     = std::abs(state.Value) >= m_Threshold;
+        state.Pressed  = !wasDown && (state.Down || pressed);
+        state.Released = !state.Down && (wasDown || (pressed && released));
+    }
+}
+
+const ActionState &ActionMap::Get(StringId action) const {
+    static const ActionState kReleased;
+    const auto               it = m_Actions.find(action);
+    return it != m_Actions.end() ? it->second.State : kReleased;
+}
+
+} // namespace brnCore
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <SDL3/SDL_gamepad.h>
+#include <SDL3/SDL_scancode.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/StringId.h"
+
+namespace brnCore {
+
+class InputSnapshot;
+
+// One control an action listens to.
+struct InputBinding {
+    enum class Source : uint8_t {
+        Key,
+        MouseButton,
+        GamepadButton,
+        GamepadAxis,
+    };
+
+    Source   Type    = Source::Key;
+    int      Code    = 0;    // scancode, mouse button, gamepad button/axis
+    float    Scale   = 1.0f; // -1 makes a stick's right count as left
+    uint32_t Gamepad = 0;    // slot, for the gamepad sources
+
+    static InputBinding Key(SDL_Scancode key, float scale = 1.0f) {
+        return {Source::Key, key, scale};
+    }
+    static InputBinding MouseButton(uint8_t button) {
+        return {Source::MouseButton, button};
+    }
+    static InputBinding GamepadButton(SDL_GamepadButton button,
+                                      float             scale   = 1.0f,
+                                      uint32_t          gamepad = 0) {
+        return {Source::GamepadButton, button, scale, gamepad};
+    }
+    static InputBinding GamepadAxis(SDL_GamepadAxis axis,
+                                    float           scale   = 1.0f,
+                                    uint32_t        gamepad = 0) {
+        return {Source::GamepadAxis, axis, scale, gamepad};
+    }
+};
+
+struct ActionState {
+    // The strongest of the bindings, in [-1, 1]: 0 or the binding's
+    // scale for buttons and keys, the scaled position for axes.
+    float Value    = 0.0f;
+    bool  Down     = false; // |Value| past the threshold
+    bool  Pressed  = false; // went down this frame
+    bool  Released = false;
+};
+
+/*
+ * Named actions ("Jump", "MoveX") bound to any number of keys, buttons
+ * and axes, so game code asks what the player wants instead of which
+ * key is held, and bindings can change without touching it.
+ *
+ *   actions.Bind("MoveX", InputBinding::Key(SDL_SCANCODE_D));
+ *   actions.Bind("MoveX", InputBinding::Key(SDL_SCANCODE_A, -1.0f));
+ *   actions.Bind("MoveX", InputBinding::GamepadAxis(SDL_GAMEPAD_AXIS_LEFTX));
+ *   float move = actions.GetValue("MoveX");
+ *
+ * Evaluated once per frame against the frame's InputSnapshot, so every
+ * reader agrees on it.
+ */
+class ActionMap {
+  public:
+    void Bind(StringId action, const InputBinding &binding);
+    // Drops every binding of `action`.
+    void Unbind(StringId action);
+
+    void Update(const InputSnapshot &snapshot);
+
+    // A released, zero state for unknown actions.
+    const ActionState &Get(StringId action) const;
+    bool  IsDown(StringId action) const { return Get(action).Down; }
+    bool  WasPressed(StringId action) const { return Get(action).Pressed; }
+    bool  WasReleased(StringId action) const { return Get(action).Released; }
+    float GetValue(StringId action) const { return Get(action).Value; }
+
+    // How far an axis must be pushed to count as down.
+    void SetThreshold(float threshold) { m_Threshold = threshold; }
+
+  private:
+    struct Action {
+        std::vector<InputBinding> Bindings;
+        ActionState               State;
+    };
+
+    std::unordered_map<StringId, Action> m_Actions;
+    float                                m_Threshold = 0.5f;
+};
+
+} // namespace brnCore
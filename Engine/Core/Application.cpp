@@ -7,6 +7,7 @@
 #include <SDL3/SDL_gpu.h>
 #include <SDL3/SDL_init.h>
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 
@@ -15,6 +16,28 @@
 namespace brnCore {
 static Application *s_Application = nullptr;
 
+// Set from the command line, the config or the console; the ones that
+// override a specification only do so when changed from the default.
+static CVar<int32_t> s_FrameCap(
+    "app.FrameCap",
+    0,
+    "Frames per second at most; 0 leaves the pace to the present mode",
+    0,
+    1000);
+static CVar<int32_t> s_JobWorkers(
+    "job.Workers",
+    0,
+    "Job worker threads; 0 is one per logical core but one",
+    0,
+    256,
+    kCVarInit);
+static CVar<int32_t> s_StreamingBudget(
+    "stream.BudgetMB",
+    static_cast<int32_t>(TextureStreamerSpecification().Budget >> 20),
+    "GPU memory for streamed textures, in MiB",
+    16,
+    1 << 16);
+
 Application::Application(const ApplicationSpecification &appSpec)
     : m_Window(nullptr), m_GpuDevice(nullptr), m_AppSpec(appSpec) {
     s_Application = this;
@@ -25,20 +48,115 @@ SDL_AppResult Application::Init() {
                        m_AppSpec.version.c_str(),
                        m_AppSpec.appidentifier.c_str());
 
-    if (!SDL_Init(SDL_INIT_VIDEO)) {
+    // What the command line and config set, before anything reads it.
+    CVarRegistry::Get().ApplyChanges();
+    if (!s_JobWorkers.IsDefault()) {
+        m_AppSpec.JobSpec.WorkerCount = s_JobWorkers.Get();
+    }
+    if (!s_StreamingBudget.IsDefault()) {
+        m_AppSpec.StreamingSpec.Budget =
+            uint64_t(s_StreamingBudget.Get()) << 20;
+    }
+
+    // A headless replay runs everything but the window, so it needs no
+    // display: there is no window to create, claim or present to.
+    const InputRecordingSpecification &recording = m_AppSpec.RecordingSpec;
+    m_Headless = !recording.ReplayPath.empty() && recording.Headless;
+
+    if (!SDL_Init(m_Headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO)) {
         SDL_LogError(APP_LOG_CATEGORY_GENERIC,
                      "Failed to Initialize SDL: %s",
                      SDL_GetError());
         return SDL_APP_FAILURE;
     }
 
+    m_JobSystem = std::make_shared<JobSystem>(m_AppSpec.JobSpec);
+
     m_Window = std::make_unique<Window>(m_AppSpec.WindowSpec);
-    m_Window->Create();
+    if (!m_Headless) {
+        m_Window->Create();
+    }
 
     m_GpuDevice = std::make_unique<Device>();
     m_GpuDevice->Create();
 
-    if (!SDL_ShowWindow(m_Window->GetHandle())) {
+    // Keyboard and mouse work without it.
+    if (!SDL_InitSubSystem(SDL_INIT_GAMEPAD)) {
+        SDL_LogWarn(APP_LOG_CATEGORY_GENERIC,
+                    "Failed to Initialize gamepads: %s",
+                    SDL_GetError());
+    }
+    m_Input          = std::make_shared<Input>(m_AppSpec.InputSpec);
+    m_LatencyTracker = std::make_shared<LatencyTracker>(m_AppSpec.LatencySpec);
+
+    uint64_t seed = m_AppSpec.RandomSeed ? m_AppSpec.RandomSeed
+                                         : SDL_GetPerformanceCounter();
+    if (!recording.ReplayPath.empty()) {
+        m_InputReplay = std::make_unique<InputReplay>();
+        if (!m_InputReplay->Open(recording.ReplayPath.c_str())) {
+            return SDL_APP_FAILURE;
+        }
+        seed = m_InputReplay->GetSeed();
+        m_Input->SetReplaying(true);
+    } else if (!recording.RecordPath.empty()) {
+        m_InputRecorder = std::make_unique<InputRecorder>();
+        if (!m_InputRecorder->Open(recording.RecordPath.c_str(), seed)) {
+            SDL_LogWarn(APP_LOG_CATEGORY_GENERIC,
+                        "Failed to record to %s",
+                        recording.RecordPath.c_str());
+            m_InputRecorder.reset();
+        }
+    }
+    m_Random.Seed(seed);
+
+    m_FileSystem = std::make_shared<VirtualFileSystem>();
+    m_FileSystem->MountDirectory("");
+    for (const std::string &archive : m_AppSpec.Archives) {
+        if (!m_FileSystem->MountArchive(archive.c_str())) {
+            SDL_LogWarn(APP_LOG_CATEGORY_GENERIC,
+                        "Failed to mount %s",
+                        archive.c_str());
+        }
+    }
+#if defined(BRAIN_SHADER_ROOT)
+    // Shaders compiled by this build, over any packed copies.
+    m_FileSystem->MountDirectory(BRAIN_SHADER_ROOT);
+#endif
+
+    m_AssetManager = std::make_shared<AssetManager>(m_GpuDevice->GetHandle(),
+                                                    m_JobSystem,
+                                                    m_FileSystem,
+                                                    m_AppSpec.AssetSpec);
+    m_TextureStreamer =
+        std::make_shared<TextureStreamer>(m_GpuDevice->GetHandle(),
+                                          m_JobSystem,
+                                          m_FileSystem,
+                                          m_AppSpec.StreamingSpec);
+    m_StreamingBudgetCallback =
+        s_StreamingBudget.AddCallback([this](int32_t megabytes) {
+            m_TextureStreamer->SetBudget(uint64_t(megabytes) << 20);
+        });
+
+    if (!m_AppSpec.WatchDirectories.empty()) {
+        m_FileWatcher = std::make_unique<FileWatcher>();
+        for (const std::string &directory : m_AppSpec.WatchDirectories) {
+            m_FileWatcher->Watch(directory);
+        }
+    }
+
+    // A game still runs without sound, so no device is not an error.
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+        m_AudioMixer = std::make_shared<AudioMixer>(m_AppSpec.AudioSpec);
+        if (!m_AudioMixer->Open()) {
+            m_AudioMixer.reset();
+        }
+    } else {
+        SDL_LogWarn(APP_LOG_CATEGORY_GENERIC,
+                    "Failed to Initialize audio: %s",
+                    SDL_GetError());
+    }
+
+    if (!m_Headless && !SDL_ShowWindow(m_Window->GetHandle())) {
         SDL_LogError(APP_LOG_CATEGORY_GENERIC,
                      "Failed to Create Window: %s",
                      SDL_GetError());
@@ -53,43 +171,170 @@ void Application::Run() {
         return;
     }
 
-    float lastTime = GetTime();
+    float          lastTime    = GetTime();
+    const uint64_t replayStart = SDL_GetTicksNS();
 
     bool b_Run = true;
     while (b_Run) {
+        // Settings change between frames, never within one.
+        CVarRegistry::Get().ApplyChanges();
 
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
                 b_Run = false;
             }
-
-            for (auto &layer : m_LayerStack) {
-                layer->OnEvent(event);
+            // A replay plays the recorded session, not what happens now.
+            if (!m_InputReplay) {
+                DispatchEvent(event);
             }
         }
+        float replayDelta = 0.0f;
+        if (m_InputReplay) {
+            if (!m_InputReplay->NextFrame(m_ReplayEvents, replayDelta)) {
+                break;
+            }
+            for (SDL_Event &recorded : m_ReplayEvents) {
+                DispatchEvent(recorded);
+            }
+        }
+        // Everything below sees this frame's input, and only it.
+        m_Input->Update();
+        const uint64_t frame = m_Input->GetSnapshot().GetFrame();
+        m_LatencyTracker->BeginFrame(frame);
 
         float currentTime = GetTime();
 
-        float    deltaTime = (currentTime - lastTime) / 1000.0f;
+        float deltaTime = (currentTime - lastTime) / 1000.0f;
+        lastTime        = currentTime;
+        if (m_InputReplay) {
+            const float timestep = m_AppSpec.RecordingSpec.ReplayTimestep;
+            deltaTime            = timestep > 0.0f ? timestep : replayDelta;
+        }
+        if (m_InputRecorder) {
+            m_InputRecorder->EndFrame(deltaTime);
+        }
         Timestep ts(deltaTime);
-        lastTime = currentTime;
+
+        const float fixedTimestep = m_AppSpec.FixedTimestep;
+        uint32_t    fixedSteps    = 0;
+        m_FixedAccumulator += deltaTime;
+        while (m_FixedAccumulator >= fixedTimestep &&
+               fixedSteps < m_AppSpec.MaxFixedSteps) {
+            for (const std::unique_ptr<Layer> &layer : m_LayerStack) {
+                layer->OnFixedUpdate(fixedTimestep);
+            }
+            m_FixedAccumulator -= fixedTimestep;
+            fixedSteps++;
+        }
+        if (fixedSteps == m_AppSpec.MaxFixedSteps) {
+            m_FixedAccumulator = std::min(m_FixedAccumulator, fixedTimestep);
+        }
+        m_FixedAlpha = m_FixedAccumulator / fixedTimestep;
 
         for (const std::unique_ptr<Layer> &layer : m_LayerStack) {
             layer->OnUpdate(ts);
         }
+        m_LatencyTracker->MarkUpdated();
+
+        if (m_FileWatcher) {
+            std::vector<std::string> changed;
+            m_FileWatcher->Poll(changed);
+            // Reported as found on disk; assets are keyed by their path
+            // in the file system.
+            for (const std::string &file : changed) {
+                const std::vector<std::string> paths =
+                    m_FileSystem->GetVirtualPaths(file);
+                if (paths.empty()) {
+                    SDL_LogWarn(APP_LOG_CATEGORY_GENERIC,
+                                "%s changed, but is under no mounted "
+                                "directory",
+                                file.c_str());
+                }
+                for (const std::string &path : paths) {
+                    m_AssetManager->Reload(path);
+                }
+            }
+        }
+
+        // Publishes assets that finished loading and uploads the next
+        // batch, so every layer sees the same assets for the whole frame.
+        m_AssetManager->Update();
+        // Acts on the mip levels last frame's draws asked for.
+        m_TextureStreamer->Update();
+        if (m_AudioMixer) {
+            m_AudioMixer->Update();
+        }
+
+        // Cursor driven UI is drawn where the cursor is now, not where
+        // it was when the events were pumped.
+        if (m_AppSpec.InputSpec.LateLatchPointer) {
+            m_Input->LatchPointer();
+        }
 
         // NOTE: rendering can be done elsewhere (eg. render thread)
         for (const std::unique_ptr<Layer> &layer : m_LayerStack) {
             layer->OnRender();
         }
+        m_LatencyTracker->MarkSubmitted();
 
         m_Window->Update();
+
+        // Clicks where the pointer is, so whatever it hits reacts as if
+        // the user clicked; only when LatencySpec asks for it.
+        const glm::vec2 pointer = m_Input->GetPointerPosition();
+        m_LatencyTracker->InjectIfDue(
+            SDL_GetWindowID(m_Window->GetHandle()), pointer.x, pointer.y);
+        if (m_AppSpec.MaxFrames != 0 && frame >= m_AppSpec.MaxFrames) {
+            b_Run = false;
+        }
+
+        // A replay runs as fast as it can.
+        if (const int32_t cap = s_FrameCap.Get(); cap > 0 && !m_InputReplay) {
+            WaitForFrameCap(cap);
+        }
+    }
+
+    if (m_InputReplay) {
+        const uint64_t frames = m_InputReplay->GetFrame();
+        const double   ms     = (SDL_GetTicksNS() - replayStart) * 1e-6;
+        SDL_LogInfo(APP_LOG_CATEGORY_GENERIC,
+                    "Replayed %llu frames in %.1f ms, %.3f ms per frame",
+                    static_cast<unsigned long long>(frames),
+                    ms,
+                    frames ? ms / frames : 0.0);
     }
 
     Stop();
 }
 
+void Application::WaitForFrameCap(int32_t framesPerSecond) {
+    // Paced against a deadline rather than from the end of the frame, so
+    // the time spent between frames doesn't add up to a slower rate.
+    const uint64_t period = 1'000'000'000ull / framesPerSecond;
+    const uint64_t now    = SDL_GetTicksNS();
+    if (m_NextFrameTime == 0 || now > m_NextFrameTime + period) {
+        // First frame, or too far behind to catch up: start over.
+        m_NextFrameTime = now + period;
+        return;
+    }
+    if (now < m_NextFrameTime) {
+        SDL_DelayPrecise(m_NextFrameTime - now);
+    }
+    m_NextFrameTime += period;
+}
+
+void Application::DispatchEvent(SDL_Event &event) {
+    if (m_InputRecorder) {
+        m_InputRecorder->Record(event);
+    }
+    m_LatencyTracker->RecordEvent(event);
+    m_Input->ProcessEvent(event);
+    for (auto &layer : m_LayerStack) {
+        layer->OnEvent(event);
+    }
+}
+
 // TODO: Either delete this function or replace Quit
 void Application::Stop() { Quit(SDL_APP_SUCCESS); }
 
@@ -108,6 +353,30 @@ SDL_AppResult Application::Event(const SDL_Event *event) {
 }
 
 void Application::Quit(const SDL_AppResult result) {
+    // Layers hold asset handles, and assets hold GPU resources.
+    m_LayerStack.clear();
+    if (m_InputRecorder && m_InputRecorder->Close()) {
+        SDL_LogInfo(APP_LOG_CATEGORY_GENERIC,
+                    "Recorded %llu frames to %s",
+                    static_cast<unsigned long long>(
+                        m_InputRecorder->GetFrameCount()),
+                    m_AppSpec.RecordingSpec.RecordPath.c_str());
+    }
+    m_InputRecorder.reset();
+    m_InputReplay.reset();
+    m_FileWatcher.reset();
+    m_AudioMixer.reset();
+    m_Input.reset();
+    // Before the device: it holds fences of it.
+    if (const std::string &path = m_AppSpec.LatencySpec.ReportPath;
+        !path.empty()) {
+        m_LatencyTracker->LogStats();
+        m_LatencyTracker->WriteReport(path.c_str());
+    }
+    m_LatencyTracker.reset();
+    s_StreamingBudget.RemoveCallback(m_StreamingBudgetCallback);
+    m_TextureStreamer.reset();
+    m_AssetManager.reset();
     m_GpuDevice->Destroy();
     m_Window->Destroy();
 }
@@ -6,19 +6,56 @@
 #include <SDL3/SDL_gpu.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "Engine/Assets/AssetManager.h"
+#include "Engine/Assets/TextureStreamer.h"
+#include "Engine/Audio/AudioMixer.h"
+#include "Engine/Core/CVar.h"
 #include "Engine/Core/Device.h"
+#include "Engine/Core/FileWatcher.h"
+#include "Engine/Core/Input.h"
+#include "Engine/Core/InputRecorder.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/LatencyTracker.h"
 #include "Engine/Core/Layer.h"
+#include "Engine/Core/Random.h"
 #include "Engine/Core/Window.h"
 
 namespace brnCore {
 
 struct ApplicationSpecification {
-    std::string         appname       = "BrianEngine SDL";
-    std::string         version       = "1.0.0";
-    std::string         appidentifier = "com.brainengine.brainengine-sdl";
-    WindowSpecification WindowSpec;
+    std::string               appname       = "BrianEngine SDL";
+    std::string               version       = "1.0.0";
+    std::string               appidentifier = "com.brainengine.brainengine-sdl";
+    WindowSpecification       WindowSpec;
+    JobSystemSpecification    JobSpec;
+    AssetManagerSpecification AssetSpec;
+    InputSpecification        InputSpec;
+    // GPU memory budget and upload rate of streamed textures.
+    TextureStreamerSpecification StreamingSpec;
+    // Output rate, device buffer size and voice pool of the mixer.
+    AudioMixerSpecification AudioSpec;
+    // Input latency report and synthetic input, for automated runs.
+    LatencySpecification LatencySpec;
+    // Records a session, or replays one in place of live input.
+    InputRecordingSpecification RecordingSpec;
+    // Of the engine RNG; 0 picks one from the clock. Recordings keep
+    // it, and their replays use it.
+    uint64_t RandomSeed = 0;
+    // Mounted over the working directory in order; later ones win.
+    std::vector<std::string> Archives;
+    // Assets loaded from files under these are reloaded when the files
+    // change on disk. For development; empty (off) by default.
+    std::vector<std::string> WatchDirectories;
+    float                    FixedTimestep = 1.0f / 60.0f; // seconds
+    // Fixed steps per frame at most; a slower frame drops the rest
+    // instead of falling further behind every frame.
+    uint32_t MaxFixedSteps = 4;
+    // Quits after this many frames; 0 runs until closed. With
+    // LatencySpec, measures latency without anyone at the controls.
+    uint64_t MaxFrames = 0;
 };
 
 class Application {
@@ -57,19 +94,70 @@ class Application {
         return nullptr;
     }
 
-    std::shared_ptr<Window> GetWindow() const { return m_Window; }
-    std::shared_ptr<Device> GetGpuDevice() const { return m_GpuDevice; }
+    std::shared_ptr<Window>       GetWindow() const { return m_Window; }
+    std::shared_ptr<Device>       GetGpuDevice() const { return m_GpuDevice; }
+    std::shared_ptr<JobSystem>    GetJobSystem() const { return m_JobSystem; }
+    std::shared_ptr<Input>        GetInput() const { return m_Input; }
+    std::shared_ptr<VirtualFileSystem> GetFileSystem() const {
+        return m_FileSystem;
+    }
+    std::shared_ptr<AssetManager> GetAssetManager() const {
+        return m_AssetManager;
+    }
+    std::shared_ptr<TextureStreamer> GetTextureStreamer() const {
+        return m_TextureStreamer;
+    }
+    // Null when no audio device could be opened.
+    std::shared_ptr<AudioMixer> GetAudioMixer() const { return m_AudioMixer; }
+    // Renderers hand it the fence of the submission that presents.
+    std::shared_ptr<LatencyTracker> GetLatencyTracker() const {
+        return m_LatencyTracker;
+    }
+
+    // The engine RNG: simulation code draws from it, never from its own,
+    // so a replay repeats the recorded session bit for bit.
+    Random &GetRandom() { return m_Random; }
+    bool    IsReplaying() const { return m_InputReplay != nullptr; }
+    // A replay without a window (RecordingSpec.Headless): GetWindow()
+    // has no handle, so layers have no swapchain to draw into.
+    bool IsHeadless() const { return m_Headless; }
+
+    // Fraction of a fixed step the frame is past the last OnFixedUpdate,
+    // for interpolating simulated state when rendering.
+    float GetFixedAlpha() const { return m_FixedAlpha; }
 
     static Application &Get();
     static float        GetTime();
 
   private:
-    ApplicationSpecification m_AppSpec;
-    std::shared_ptr<Window>  m_Window;
-    std::shared_ptr<Device>  m_GpuDevice;
+    ApplicationSpecification           m_AppSpec;
+    std::shared_ptr<Window>            m_Window;
+    std::shared_ptr<Device>            m_GpuDevice;
+    std::shared_ptr<JobSystem>         m_JobSystem;
+    std::shared_ptr<Input>             m_Input;
+    std::shared_ptr<VirtualFileSystem> m_FileSystem;
+    std::shared_ptr<AssetManager>      m_AssetManager;
+    std::shared_ptr<TextureStreamer>   m_TextureStreamer;
+    std::unique_ptr<FileWatcher>       m_FileWatcher;
+    std::shared_ptr<AudioMixer>        m_AudioMixer;
+    std::shared_ptr<LatencyTracker>    m_LatencyTracker;
+    std::unique_ptr<InputRecorder>     m_InputRecorder;
+    std::unique_ptr<InputReplay>       m_InputReplay;
+    std::vector<SDL_Event>             m_ReplayEvents;
+    Random                             m_Random;
 
     std::vector<std::unique_ptr<Layer>> m_LayerStack;
 
+    bool  m_Headless         = false;
+    float m_FixedAccumulator = 0.0f;
+    float m_FixedAlpha       = 0.0f;
+
+    uint64_t       m_NextFrameTime           = 0; // ns, for app.FrameCap
+    CVarCallbackId m_StreamingBudgetCallback = 0;
+
+    void DispatchEvent(SDL_Event &event);
+    void WaitForFrameCap(int32_t framesPerSecond);
+
     SDL_AppResult OnUpdate(float lastTime);
     SDL_AppResult OnRender();
     SDL_AppResult OnQuit();
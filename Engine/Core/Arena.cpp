@@ -0,0 +1,198 @@
+#include "Arena.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace brnCore {
+
+namespace {
+constexpr size_t kHugePageSize = 2 << 20;
+
+size_t RoundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+/*
+ * Huge pages are best effort: explicit huge pages need to be reserved by
+ * the OS (hugetlbfs / SeLockMemoryPrivilege), so fall back to a regular
+ * mapping and, on Linux, ask for transparent huge pages instead.
+ */
+void *MapPages(size_t size, bool hugePages, bool &gotHugePages) {
+    gotHugePages = false;
+#if defined(_WIN32)
+    if (hugePages) {
+        const size_t largePage = GetLargePageMinimum();
+        if (largePage && size % largePage == 0) {
+            if (void *memory = VirtualAlloc(nullptr,
+                                            size,
+                                            MEM_RESERVE | MEM_COMMIT |
+                                                MEM_LARGE_PAGES,
+                                            PAGE_READWRITE)) {
+                gotHugePages = true;
+                return memory;
+            }
+        }
+    }
+    return VirtualAlloc(
+        nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__linux__)
+    if (hugePages) {
+        void *memory = mmap(nullptr,
+                            size,
+                            PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                            -1,
+                            0);
+        if (memory != MAP_FAILED) {
+            gotHugePages = true;
+            return memory;
+        }
+    }
+    void *memory = mmap(nullptr,
+                        size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    if (hugePages) {
+        madvise(memory, size, MADV_HUGEPAGE);
+    }
+    return memory;
+#else
+    (void)hugePages;
+    // aligned_alloc wants a multiple of the alignment; macOS returns
+    // null otherwise.
+    constexpr size_t kAlignment = alignof(std::max_align_t);
+    return std::aligned_alloc(kAlignment,
+                              (size + kAlignment - 1) & ~(kAlignment - 1));
+#endif
+}
+
+void UnmapPages(void *memory, size_t size) {
+#if defined(_WIN32)
+    (void)size;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#elif defined(__linux__)
+    munmap(memory, size);
+#else
+    (void)size;
+    std::free(memory);
+#endif
+}
+} // namespace
+
+Arena::Arena(const ArenaSpecification &specification)
+    : m_specification(specification),
+      m_NextChunkSize(specification.ChunkSize) {}
+
+Arena::~Arena() { Release(); }
+
+void *Arena::AllocateSlow(size_t size, size_t alignment) {
+    Chunk *chunk = AllocateChunk(size + alignment + sizeof(Chunk));
+    if (!chunk) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Arena: failed to allocate a %zu byte chunk",
+                     size + alignment + sizeof(Chunk));
+        return nullptr;
+    }
+
+    chunk->Next = m_Chunks;
+    m_Chunks    = chunk;
+    m_Cursor    = reinterpret_cast<std::byte *>(chunk) + sizeof(Chunk);
+    m_End       = reinterpret_cast<std::byte *>(chunk) + chunk->Size;
+
+    return Allocate(size, alignment);
+}
+
+void Arena::RegisterDestructor(void *object, void (*destroy)(void *)) {
+    auto *node = static_cast<DestructorNode *>(
+        Allocate(sizeof(DestructorNode), alignof(DestructorNode)));
+    node->Destroy = destroy;
+    node->Object  = object;
+    node->Next    = m_Destructors;
+    m_Destructors = node;
+}
+
+Arena::Chunk *Arena::AllocateChunk(size_t minSize) {
+    size_t size = std::max(m_NextChunkSize, minSize);
+    if (m_specification.UseHugePages) {
+        size = RoundUp(size, kHugePageSize);
+    }
+    m_NextChunkSize =
+        std::min(m_NextChunkSize * 2, m_specification.MaxChunkSize);
+
+    bool  gotHugePages = false;
+    void *memory = MapPages(size, m_specification.UseHugePages, gotHugePages);
+    if (!memory) {
+        return nullptr;
+    }
+
+    auto *chunk      = static_cast<Chunk *>(memory);
+    chunk->Next      = nullptr;
+    chunk->Size      = size;
+    chunk->HugePages = gotHugePages;
+
+    m_BytesReserved += size;
+    m_ChunkCount++;
+    return chunk;
+}
+
+void Arena::FreeChunk(Chunk *chunk) { UnmapPages(chunk, chunk->Size); }
+
+void Arena::RunDestructors() {
+    for (DestructorNode *node = m_Destructors; node; node = node->Next) {
+        node->Destroy(node->Object);
+    }
+    m_Destructors = nullptr;
+}
+
+void Arena::Reset() {
+    RunDestructors();
+    if (!m_Chunks) {
+        return;
+    }
+
+    while (m_Chunks->Next) {
+        Chunk *next = m_Chunks->Next->Next;
+        m_BytesReserved -= m_Chunks->Next->Size;
+        m_ChunkCount--;
+        FreeChunk(m_Chunks->Next);
+        m_Chunks->Next = next;
+    }
+
+    m_Cursor    = reinterpret_cast<std::byte *>(m_Chunks) + sizeof(Chunk);
+    m_End       = reinterpret_cast<std::byte *>(m_Chunks) + m_Chunks->Size;
+    m_BytesUsed = 0;
+}
+
+void Arena::Release() {
+    RunDestructors();
+
+    while (m_Chunks) {
+        Chunk *next = m_Chunks->Next;
+        FreeChunk(m_Chunks);
+        m_Chunks = next;
+    }
+
+    m_Cursor        = nullptr;
+    m_End           = nullptr;
+    m_NextChunkSize = m_specification.ChunkSize;
+    m_BytesUsed     = 0;
+    m_BytesReserved = 0;
+    m_ChunkCount    = 0;
+}
+
+} // namespace brnCore
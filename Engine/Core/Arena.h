@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace brnCore {
+
+struct ArenaSpecification {
+    size_t ChunkSize    = 1 << 20;  // first chunk, doubles on growth
+    size_t MaxChunkSize = 64 << 20; // growth stops here
+    bool   UseHugePages = false;
+};
+
+/*
+ * Chunked bump allocator for data that lives as long as its owner
+ * (usually a Layer). Individual frees are no-ops; everything is released
+ * at once by Release() or the destructor, which costs one call per chunk
+ * plus one per registered non-trivial destructor.
+ *
+ * Derives from std::pmr::memory_resource so pmr containers can use it
+ * directly: std::pmr::vector<Tile> tiles{layer.GetArena()};
+ */
+class Arena : public std::pmr::memory_resource {
+  public:
+    explicit Arena(
+        const ArenaSpecification &specification = ArenaSpecification());
+    ~Arena() override;
+
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *Allocate(size_t size,
+                   size_t alignment = alignof(std::max_align_t)) {
+        const auto cursor  = reinterpret_cast<uintptr_t>(m_Cursor);
+        const auto aligned = (cursor + alignment - 1) & ~(alignment - 1);
+        if (m_Cursor &&
+            aligned + size <= reinterpret_cast<uintptr_t>(m_End)) {
+            m_Cursor = reinterpret_cast<std::byte *>(aligned + size);
+            m_BytesUsed += size;
+            return reinterpret_cast<void *>(aligned);
+        }
+        return AllocateSlow(size, alignment);
+    }
+
+    template <typename T, typename... Args>
+    T *New(Args &&...args) {
+        void *memory = Allocate(sizeof(T), alignof(T));
+        T    *object = ::new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            RegisterDestructor(
+                object, [](void *ptr) { static_cast<T *>(ptr)->~T(); });
+        }
+        return object;
+    }
+
+    // Storage only; elements are left uninitialized.
+    template <typename T>
+        requires(std::is_trivially_destructible_v<T>)
+    T *NewArray(size_t count) {
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Runs registered destructors in reverse order and frees every chunk.
+    void Release();
+
+    // Like Release(), but keeps the newest (largest) chunk for reuse.
+    void Reset();
+
+    size_t GetBytesUsed() const { return m_BytesUsed; }
+    size_t GetBytesReserved() const { return m_BytesReserved; }
+    size_t GetChunkCount() const { return m_ChunkCount; }
+
+  private:
+    struct Chunk {
+        Chunk *Next;
+        size_t Size;
+        bool   HugePages;
+    };
+
+    struct DestructorNode {
+        void (*Destroy)(void *);
+        void           *Object;
+        DestructorNode *Next;
+    };
+
+    void  RegisterDestructor(void *object, void (*destroy)(void *));
+    void  RunDestructors();
+    void *AllocateSlow(size_t size, size_t alignment);
+
+    Chunk *AllocateChunk(size_t minSize);
+    void   FreeChunk(Chunk *chunk);
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        return Allocate(bytes, alignment);
+    }
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    ArenaSpecification m_specification;
+
+    Chunk          *m_Chunks      = nullptr;
+    DestructorNode *m_Destructors = nullptr;
+    std::byte      *m_Cursor      = nullptr;
+    std::byte      *m_End         = nullptr;
+    size_t          m_NextChunkSize;
+
+    size_t m_BytesUsed     = 0;
+    size_t m_BytesReserved = 0;
+    size_t m_ChunkCount    = 0;
+};
+
+} // namespace brnCore
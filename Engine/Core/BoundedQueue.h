@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace brnCore {
+
+/*
+ * Fixed capacity queue any number of threads may push to and pop from
+ * without locks (Vyukov's bounded MPMC queue). Each cell carries a
+ * sequence number telling whether it is free for the push or holds an
+ * element for the pop of the current lap, so a push and a pop touch one
+ * shared counter and one cell each, and never wait on one another.
+ *
+ * Never allocates after construction, which makes it usable from the
+ * audio thread. T must be default constructible and movable.
+ */
+template <typename T>
+class BoundedQueue {
+  public:
+    // Rounded up to a power of two.
+    explicit BoundedQueue(size_t capacity)
+        : m_Mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+          m_Cells(std::make_unique<Cell[]>(m_Mask + 1)) {
+        for (size_t i = 0; i <= m_Mask; i++) {
+            m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue &)            = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    // False if the queue is full.
+    bool Push(T value) {
+        size_t position = m_Tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell        &cell = m_Cells[position & m_Mask];
+            const size_t sequence =
+                cell.Sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<intptr_t>(sequence - position);
+            if (lap == 0) {
+                if (m_Tail.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    cell.Value = std::move(value);
+                    cell.Sequence.store(position + 1,
+                                        std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;
+            } else {
+                position = m_Tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // False if the queue is empty.
+    bool Pop(T &value) {
+        size_t position = m_Head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell        &cell = m_Cells[position & m_Mask];
+            const size_t sequence =
+                cell.Sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<intptr_t>(sequence - (position + 1));
+            if (lap == 0) {
+                if (m_Head.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.Value);
+                    cell.Sequence.store(position + m_Mask + 1,
+                                        std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;
+            } else {
+                position = m_Head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t GetCapacity() const { return m_Mask + 1; }
+
+  private:
+    struct Cell {
+        std::atomic<size_t> Sequence;
+        T                   Value{};
+    };
+
+    // Pushers and poppers each get their own cache line.
+    static constexpr size_t kCacheLine = 64;
+
+    const size_t            m_Mask;
+    std::unique_ptr<Cell[]> m_Cells;
+    alignas(kCacheLine) std::atomic<size_t> m_Tail{0};
+    alignas(kCacheLine) std::atomic<size_t> m_Head{0};
+};
+
+} // namespace brnCore
@@ -0,0 +1,287 @@
+#include "CVar.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Engine/Core/FileWriter.h"
+
+namespace brnCore {
+
+namespace {
+std::string_view Trim(std::string_view text) {
+    constexpr std::string_view kSpace = " \t\r\n";
+    const size_t               begin  = text.find_first_not_of(kSpace);
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(begin, text.find_last_not_of(kSpace) - begin + 1);
+}
+
+bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return SDL_tolower(x) == SDL_tolower(y);
+           });
+}
+} // namespace
+
+bool ParseCVarValue(std::string_view text, bool &value) {
+    text = Trim(text);
+    for (const char *yes : {"1", "true", "on", "yes"}) {
+        if (EqualsIgnoreCase(text, yes)) {
+            value = true;
+            return true;
+        }
+    }
+    for (const char *no : {"0", "false", "off", "no"}) {
+        if (EqualsIgnoreCase(text, no)) {
+            value = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseCVarValue(std::string_view text, int32_t &value) {
+    text              = Trim(text);
+    const char *end   = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && !text.empty();
+}
+
+bool ParseCVarValue(std::string_view text, float &value) {
+    // strtof rather than from_chars, which not every standard library
+    // has for floats yet; it needs the terminator.
+    const std::string copy(Trim(text));
+    char             *end = nullptr;
+    errno                 = 0;
+    value                 = std::strtof(copy.c_str(), &end);
+    return !copy.empty() && end == copy.c_str() + copy.size() && errno == 0;
+}
+
+bool ParseCVarValue(std::string_view text, std::string &value) {
+    value = Trim(text);
+    return true;
+}
+
+std::string FormatCVarValue(bool value) { return value ? "true" : "false"; }
+
+std::string FormatCVarValue(int32_t value) { return std::to_string(value); }
+
+std::string FormatCVarValue(float value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%g", value);
+    return text;
+}
+
+std::string FormatCVarValue(const std::string &value) { return value; }
+
+CVarBase::CVarBase(const char *name,
+                   const char *description,
+                   CVarType    type,
+                   uint32_t    flags)
+    : m_Name(name), m_Description(description), m_Type(type),
+      m_Flags(flags) {
+    CVarRegistry::Get().Register(this);
+}
+
+CVarBase::~CVarBase() { CVarRegistry::Get().Unregister(this); }
+
+void CVarBase::Queue() {
+    if (!m_Queued) {
+        m_Queued = true;
+        CVarRegistry::Get().m_Queued.push_back(this);
+    }
+}
+
+CVarRegistry &CVarRegistry::Get() {
+    // Built on first use, so variables defined at namespace scope in any
+    // file can register during static initialization.
+    static CVarRegistry registry;
+    return registry;
+}
+
+void CVarRegistry::Register(CVarBase *variable) {
+    std::lock_guard lock(m_Mutex);
+    if (!m_Variables.emplace(variable->GetName(), variable).second) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "CVarRegistry: %s is defined twice",
+                     variable->GetName());
+    }
+}
+
+void CVarRegistry::Unregister(CVarBase *variable) {
+    std::lock_guard lock(m_Mutex);
+    const auto      found = m_Variables.find(variable->GetName());
+    if (found != m_Variables.end() && found->second == variable) {
+        m_Variables.erase(found);
+    }
+    std::erase(m_Queued, variable);
+}
+
+CVarBase *CVarRegistry::Find(std::string_view name) const {
+    std::lock_guard lock(m_Mutex);
+    const auto      found = m_Variables.find(name);
+    return found != m_Variables.end() ? found->second : nullptr;
+}
+
+bool CVarRegistry::SetLocked(CVarBase        *variable,
+                             std::string_view value,
+                             std::string     &error) {
+    if (m_Started && (variable->GetFlags() & kCVarInit)) {
+        error = std::string(variable->GetName()) +
+                " is only read at startup: set it on the command line or "
+                "in the config";
+        return false;
+    }
+    return variable->Parse(value, error);
+}
+
+bool CVarRegistry::Set(std::string_view name,
+                       std::string_view value,
+                       std::string     *error) {
+    std::string message;
+    bool        done = false;
+    {
+        std::lock_guard lock(m_Mutex);
+        const auto      found = m_Variables.find(name);
+        if (found == m_Variables.end()) {
+            message = "unknown variable " + std::string(name);
+        } else {
+            done = SetLocked(found->second, value, message);
+        }
+    }
+    if (!done) {
+        if (error) {
+            *error = message;
+        } else {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_CUSTOM, "CVarRegistry: %s", message.c_str());
+        }
+    }
+    return done;
+}
+
+bool CVarRegistry::Reset(std::string_view name, std::string *error) {
+    const CVarBase *variable = Find(name);
+    return Set(name,
+               variable ? variable->DefaultToString() : std::string(),
+               error);
+}
+
+void CVarRegistry::ParseCommandLine(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        const std::string_view argument = argv[i];
+        if (argument.size() < 2 || argument[0] != '+') {
+            continue;
+        }
+        const size_t equals = argument.find('=');
+        if (equals != std::string_view::npos) {
+            Set(argument.substr(1, equals - 1), argument.substr(equals + 1));
+        } else if (i + 1 < argc) {
+            Set(argument.substr(1), argv[++i]);
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                        "CVarRegistry: no value for %s",
+                        argv[i]);
+        }
+    }
+}
+
+bool CVarRegistry::LoadConfig(const char *path) {
+    size_t size = 0;
+    char  *data = static_cast<char *>(SDL_LoadFile(path, &size));
+    if (!data) {
+        return false;
+    }
+
+    std::string_view text(data, size);
+    uint32_t         lineNumber = 0;
+    while (!text.empty()) {
+        const size_t     end  = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        lineNumber++;
+
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        const size_t equals = line.find('=');
+        std::string  error;
+        if (equals == std::string_view::npos) {
+            error = "expected name = value";
+        } else if (Set(Trim(line.substr(0, equals)),
+                       line.substr(equals + 1),
+                       &error)) {
+            continue;
+        }
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "CVarRegistry: %s:%u: %s",
+                    path,
+                    lineNumber,
+                    error.c_str());
+    }
+    SDL_free(data);
+    return true;
+}
+
+bool CVarRegistry::SaveConfig(const char *path) const {
+    std::string text;
+    for (const CVarBase *variable : GetAll()) {
+        if (!variable->IsDefault()) {
+            text += variable->GetName();
+            text += " = ";
+            text += variable->ToString();
+            text += '\n';
+        }
+    }
+
+    FileWriter writer;
+    if (!writer.Open(path)) {
+        return false;
+    }
+    writer.Write(text.data(), text.size());
+    return writer.Commit();
+}
+
+void CVarRegistry::ApplyChanges() {
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Started = true;
+        if (m_Queued.empty()) {
+            return;
+        }
+        for (CVarBase *variable : m_Queued) {
+            variable->m_Queued = false;
+            if (variable->Publish()) {
+                m_Changed.push_back(variable);
+            }
+        }
+        m_Queued.clear();
+    }
+    // Callbacks may set variables again: those wait for the next frame.
+    for (CVarBase *variable : m_Changed) {
+        variable->Notify();
+    }
+    m_Changed.clear();
+}
+
+std::vector<const CVarBase *> CVarRegistry::GetAll() const {
+    std::lock_guard               lock(m_Mutex);
+    std::vector<const CVarBase *> variables;
+    variables.reserve(m_Variables.size());
+    for (const auto &[name, variable] : m_Variables) {
+        variables.push_back(variable);
+    }
+    return variables;
+}
+
+} // namespace brnCore
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace brnCore {
+
+enum class CVarType : uint8_t {
+    Bool,
+    Int,
+    Float,
+    String,
+};
+
+enum CVarFlags : uint32_t {
+    kCVarNone = 0,
+    // Only read at startup: sets by name after the first frame are
+    // refused, so the console doesn't pretend they did anything.
+    kCVarInit = 1 << 0,
+};
+
+using CVarCallbackId = uint32_t;
+
+template <typename T> class CVar;
+
+// Text to value and back, as the command line, config and console see
+// them: bools are true/false (or 1/0, on/off).
+bool        ParseCVarValue(std::string_view text, bool &value);
+bool        ParseCVarValue(std::string_view text, int32_t &value);
+bool        ParseCVarValue(std::string_view text, float &value);
+bool        ParseCVarValue(std::string_view text, std::string &value);
+std::string FormatCVarValue(bool value);
+std::string FormatCVarValue(int32_t value);
+std::string FormatCVarValue(float value);
+std::string FormatCVarValue(const std::string &value);
+
+/*
+ * What the registry knows of a variable, whatever its type. Defined by
+ * CVar<T>, which registers itself on construction.
+ */
+class CVarBase {
+  public:
+    CVarBase(const CVarBase &)            = delete;
+    CVarBase &operator=(const CVarBase &) = delete;
+
+    const char *GetName() const { return m_Name; }
+    const char *GetDescription() const { return m_Description; }
+    CVarType    GetType() const { return m_Type; }
+    uint32_t    GetFlags() const { return m_Flags; }
+
+    virtual std::string ToString() const        = 0;
+    virtual std::string DefaultToString() const = 0;
+    virtual bool        IsDefault() const       = 0;
+
+  protected:
+    CVarBase(const char *name,
+             const char *description,
+             CVarType    type,
+             uint32_t    flags);
+    ~CVarBase();
+
+    // Queues the change; with the registry lock held.
+    virtual bool Parse(std::string_view text, std::string &error) = 0;
+    virtual void QueueDefault()                                   = 0;
+    // Makes the queued value the current one; with the lock held.
+    virtual bool Publish() = 0;
+    // Runs the callbacks, without the lock.
+    virtual void Notify() = 0;
+
+    // Marks the variable for the next CVarRegistry::ApplyChanges().
+    void Queue();
+
+  private:
+    friend class CVarRegistry;
+
+    const char *m_Name;
+    const char *m_Description;
+    CVarType    m_Type;
+    uint32_t    m_Flags;
+    bool        m_Queued = false;
+};
+
+/*
+ * Every variable, by name, and the ways to set them: "name value"
+ * strings from the command line, a config file or the console.
+ *
+ * Sets from any thread only queue the value; ApplyChanges(), which the
+ * application calls at the start of every frame, publishes all of them
+ * together and then runs their callbacks on the main thread. Within a
+ * frame a variable never changes under its readers.
+ */
+class CVarRegistry {
+  public:
+    static CVarRegistry &Get();
+
+    CVarBase *Find(std::string_view name) const;
+    // Null when `name` doesn't exist or isn't a CVar<T>.
+    template <typename T> CVar<T> *Find(std::string_view name) const {
+        return dynamic_cast<CVar<T> *>(Find(name));
+    }
+
+    // Parses and queues `value`. On failure, fills `error` or, without
+    // one, logs it.
+    bool Set(std::string_view name,
+             std::string_view value,
+             std::string     *error = nullptr);
+    bool Reset(std::string_view name, std::string *error = nullptr);
+
+    // Arguments of the form "+name=value" or "+name value"; the rest is
+    // left to the application.
+    void ParseCommandLine(int argc, char **argv);
+    // "name = value" lines; "#" starts a comment. A missing file only
+    // returns false: there is simply nothing to change.
+    bool LoadConfig(const char *path);
+    // Every variable not at its default, in the LoadConfig() format.
+    bool SaveConfig(const char *path) const;
+
+    // Main thread, at the frame boundary.
+    void ApplyChanges();
+
+    // Sorted by name.
+    std::vector<const CVarBase *> GetAll() const;
+
+  private:
+    friend class CVarBase;
+    template <typename T> friend class CVar;
+
+    CVarRegistry() = default;
+
+    void Register(CVarBase *variable);
+    void Unregister(CVarBase *variable);
+    bool SetLocked(CVarBase *variable,
+                   std::string_view value,
+                   std::string     &error);
+
+    mutable std::mutex                     m_Mutex;
+    std::map<std::string_view, CVarBase *> m_Variables;
+    std::vector<CVarBase *>                m_Queued;
+    std::vector<CVarBase *>                m_Changed; // ApplyChanges() only
+    bool                                   m_Started = false;
+};
+
+/*
+ * A tunable, defined once at namespace scope where it is used:
+ *
+ *   static CVar<int> s_FrameCap("app.FrameCap", 0, "Frames per second");
+ *   ...
+ *   if (const int cap = s_FrameCap.Get(); cap > 0) { ... }
+ *
+ * Get() is one relaxed atomic load: reading a variable every frame, or
+ * in every job, costs the same as reading a plain global. Other files
+ * declare it extern, or look it up once with CVarRegistry::Find<T>()
+ * and keep the pointer.
+ *
+ * T is bool, int32_t, float or std::string. Numbers are clamped to
+ * [min, max]. Strings are only for the main thread: their readers get a
+ * reference that ApplyChanges() may rewrite.
+ */
+template <typename T> class CVar final : public CVarBase {
+    static constexpr bool kAtomic = !std::is_same_v<T, std::string>;
+    using Value = std::conditional_t<kAtomic, std::atomic<T>, T>;
+    using Read  = std::conditional_t<kAtomic, T, const T &>;
+
+  public:
+    using Callback = std::function<void(Read)>;
+
+    CVar(const char *name,
+         T           defaultValue,
+         const char *description,
+         uint32_t    flags = kCVarNone)
+        : CVar(name, defaultValue, description, Lowest(), Highest(), flags) {
+    }
+    CVar(const char *name,
+         T           defaultValue,
+         const char *description,
+         T           min,
+         T           max,
+         uint32_t    flags = kCVarNone)
+        : CVarBase(name, description, TypeOf(), flags),
+          m_Value(defaultValue), m_Pending(defaultValue),
+          m_Default(defaultValue), m_Min(min), m_Max(max) {}
+
+    Read Get() const {
+        if constexpr (kAtomic) {
+            return m_Value.load(std::memory_order_relaxed);
+        } else {
+            return m_Value;
+        }
+    }
+    operator Read() const { return Get(); }
+
+    // Takes effect at the next frame boundary.
+    void Set(T value) {
+        std::lock_guard lock(CVarRegistry::Get().m_Mutex);
+        m_Pending = Clamp(std::move(value));
+        Queue();
+    }
+
+    // Main thread. The callback runs there too, at the frame boundary
+    // where the value changed; owners that go away first remove theirs.
+    CVarCallbackId AddCallback(Callback callback) {
+        m_Callbacks.emplace_back(++m_NextCallbackId, std::move(callback));
+        return m_NextCallbackId;
+    }
+    void RemoveCallback(CVarCallbackId id) {
+        std::erase_if(m_Callbacks,
+                      [id](const auto &entry) { return entry.first == id; });
+    }
+
+    T GetDefault() const { return m_Default; }
+
+    std::string ToString() const override { return FormatCVarValue(Get()); }
+    std::string DefaultToString() const override {
+        return FormatCVarValue(m_Default);
+    }
+    bool        IsDefault() const override { return Get() == m_Default; }
+
+  private:
+    static constexpr CVarType TypeOf() {
+        if constexpr (std::is_same_v<T, bool>) {
+            return CVarType::Bool;
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+            return CVarType::Int;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return CVarType::Float;
+        } else {
+            static_assert(std::is_same_v<T, std::string>,
+                          "CVar is bool, int32_t, float or std::string");
+            return CVarType::String;
+        }
+    }
+    static T Lowest() {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return std::numeric_limits<T>::lowest();
+        } else {
+            return T();
+        }
+    }
+    static T Highest() {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return std::numeric_limits<T>::max();
+        } else {
+            return T();
+        }
+    }
+    T Clamp(T value) const {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            return value < m_Min ? m_Min : value > m_Max ? m_Max : value;
+        } else {
+            return value;
+        }
+    }
+
+    bool Parse(std::string_view text, std::string &error) override {
+        T value{};
+        if (!ParseCVarValue(text, value)) {
+            error = "not a valid value: " + std::string(text);
+            return false;
+        }
+        m_Pending = Clamp(std::move(value));
+        Queue();
+        return true;
+    }
+    void QueueDefault() override {
+        m_Pending = m_Default;
+        Queue();
+    }
+    bool Publish() override {
+        if (m_Pending == Get()) {
+            return false;
+        }
+        if constexpr (kAtomic) {
+            m_Value.store(m_Pending, std::memory_order_relaxed);
+        } else {
+            m_Value = m_Pending;
+        }
+        return true;
+    }
+    void Notify() override {
+        for (const auto &[id, callback] : m_Callbacks) {
+            callback(Get());
+        }
+    }
+
+    Value m_Value;
+    T     m_Pending; // guarded by the registry lock
+    T     m_Default;
+    T     m_Min;
+    T     m_Max;
+
+    std::vector<std::pair<CVarCallbackId, Callback>> m_Callbacks;
+    CVarCallbackId                                   m_NextCallbackId = 0;
+};
+
+} // namespace brnCore
@@ -0,0 +1,115 @@
+#include "CVarConsole.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "Engine/Core/CVar.h"
+
+namespace brnCore {
+
+namespace {
+std::string_view NextWord(std::string_view &text) {
+    const size_t begin = text.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        text = {};
+        return {};
+    }
+    text                  = text.substr(begin);
+    const size_t     end  = std::min(text.find(' '), text.size());
+    std::string_view word = text.substr(0, end);
+    text.remove_prefix(end);
+    return word;
+}
+} // namespace
+
+void CVarConsole::Draw(const char *title, bool *open) {
+    if (!ImGui::Begin(title, open)) {
+        ImGui::End();
+        return;
+    }
+
+    const float inputHeight = ImGui::GetFrameHeightWithSpacing();
+    if (ImGui::BeginChild("Lines",
+                          ImVec2(0.0f, -inputHeight),
+                          ImGuiChildFlags_None,
+                          ImGuiWindowFlags_HorizontalScrollbar)) {
+        for (const std::string &line : m_Lines) {
+            ImGui::TextUnformatted(line.c_str());
+        }
+        if (m_ScrollToBottom ||
+            ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
+            ImGui::SetScrollHereY(1.0f);
+        }
+        m_ScrollToBottom = false;
+    }
+    ImGui::EndChild();
+
+    ImGui::SetNextItemWidth(-1.0f);
+    if (ImGui::InputText("##Command",
+                         m_Input.data(),
+                         m_Input.size(),
+                         ImGuiInputTextFlags_EnterReturnsTrue)) {
+        Execute(m_Input.data());
+        m_Input[0] = '\0';
+        // Keeps typing in the box after Enter.
+        ImGui::SetKeyboardFocusHere(-1);
+    }
+    ImGui::End();
+}
+
+void CVarConsole::Execute(std::string_view command) {
+    std::string_view       rest = command;
+    const std::string_view name = NextWord(rest);
+    if (name.empty()) {
+        return;
+    }
+    Print("> " + std::string(command));
+    m_ScrollToBottom = true;
+
+    CVarRegistry          &registry = CVarRegistry::Get();
+    const std::string_view argument = NextWord(rest);
+    std::string            error;
+
+    if (name == "list") {
+        for (const CVarBase *variable : registry.GetAll()) {
+            if (std::string_view(variable->GetName()).starts_with(argument)) {
+                Print(std::string(variable->GetName()) + " = " +
+                      variable->ToString());
+            }
+        }
+    } else if (name == "reset") {
+        if (!registry.Reset(argument, &error)) {
+            Print(error);
+        }
+    } else if (name == "save") {
+        const std::string path(argument);
+        Print(!path.empty() && registry.SaveConfig(path.c_str())
+                  ? "saved " + path
+                  : "cannot save to '" + path + "'");
+    } else if (const CVarBase *variable = registry.Find(name); !variable) {
+        Print("unknown variable " + std::string(name));
+    } else if (argument.empty()) {
+        Print(std::string(variable->GetName()) + " = " +
+              variable->ToString() + " (default " +
+              variable->DefaultToString() + ")");
+        Print(std::string("  ") + variable->GetDescription());
+    } else {
+        // The rest of the line, so strings may hold spaces.
+        const std::string_view value = command.substr(
+            argument.data() - command.data());
+        Print(registry.Set(name, value, &error)
+                  ? std::string(name) + " set, from the next frame"
+                  : error);
+    }
+}
+
+void CVarConsole::Print(std::string line) {
+    if (m_Lines.size() == kMaxLines) {
+        m_Lines.pop_front();
+    }
+    m_Lines.push_back(std::move(line));
+}
+
+} // namespace brnCore
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <string>
+#include <string_view>
+
+namespace brnCore {
+
+/*
+ * An ImGui window to read and set CVars while the application runs:
+ *
+ *   r.PresentMode           prints the value, default and description
+ *   r.PresentMode 0         sets it, from the next frame
+ *   reset r.PresentMode     back to the default
+ *   list [prefix]           every variable, or those starting with prefix
+ *   save <path>             writes what differs from the defaults
+ *
+ * Draw() from inside an ImGui frame; Execute() works without one, for
+ * commands from anywhere else.
+ */
+class CVarConsole {
+  public:
+    void Draw(const char *title = "Console", bool *open = nullptr);
+    void Execute(std::string_view command);
+
+    void Print(std::string line);
+    void Clear() { m_Lines.clear(); }
+
+  private:
+    static constexpr size_t kMaxLines = 512;
+
+    std::deque<std::string> m_Lines;
+    std::array<char, 256>   m_Input{};
+    bool                    m_ScrollToBottom = false;
+};
+
+} // namespace brnCore
@@ -8,6 +8,13 @@
 
 namespace brnCore {
 
+static CVar<int32_t> s_PresentMode(
+    "r.PresentMode",
+    SDL_GPU_PRESENTMODE_MAILBOX,
+    "0 vsync, 1 immediate (tears), 2 mailbox (vsync without blocking)",
+    SDL_GPU_PRESENTMODE_VSYNC,
+    SDL_GPU_PRESENTMODE_MAILBOX);
+
 Device::Device() : m_GpuDevice(nullptr, &SDL_DestroyGPUDevice) {}
 Device::~Device() { Destroy(); }
 
@@ -53,9 +60,12 @@ void Device::Create() {
         // return SDL_APP_FAILURE;
     }
 
-    if (!SDL_ClaimWindowForGPUDevice(
-            m_GpuDevice.get(),
-            brnCore::Application::Get().GetWindow()->GetHandle())) {
+    // Headless: nothing to present to, the device draws offscreen only.
+    SDL_Window *window = brnCore::Application::Get().GetWindow()->GetHandle();
+    if (!window) {
+        return;
+    }
+    if (!SDL_ClaimWindowForGPUDevice(m_GpuDevice.get(), window)) {
         SDL_LogError(brnCore::Application::Get().APP_LOG_CATEGORY_GENERIC,
                      "Failed to Claim Window for GPU Device: %s",
                      SDL_GetError());
@@ -63,28 +73,38 @@ void Device::Create() {
         // return SDL_APP_FAILURE;
     }
 
-    SDL_GPUPresentMode presentMode = SDL_GPU_PRESENTMODE_VSYNC;
+    ApplyPresentMode();
+    m_PresentModeCallback =
+        s_PresentMode.AddCallback([this](int32_t) { ApplyPresentMode(); });
+}
+
+void Device::ApplyPresentMode() {
+    SDL_Window *window = brnCore::Application::Get().GetWindow()->GetHandle();
+    auto presentMode   = static_cast<SDL_GPUPresentMode>(s_PresentMode.Get());
 
-    if (SDL_WindowSupportsGPUPresentMode(
-            m_GpuDevice.get(),
-            brnCore::Application::Get().GetWindow()->GetHandle(),
-            presentMode)) {
-        presentMode = SDL_GPU_PRESENTMODE_MAILBOX;
+    // Every window supports VSYNC.
+    if (!SDL_WindowSupportsGPUPresentMode(
+            m_GpuDevice.get(), window, presentMode)) {
+        presentMode = SDL_GPU_PRESENTMODE_VSYNC;
     }
 
-    SDL_SetGPUSwapchainParameters(
-        m_GpuDevice.get(),
-        brnCore::Application::Get().GetWindow()->GetHandle(),
-        SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
-        presentMode);
+    SDL_SetGPUSwapchainParameters(m_GpuDevice.get(),
+                                  window,
+                                  SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
+                                  presentMode);
 }
 
 void Device::Destroy() {
+    if (m_PresentModeCallback) {
+        s_PresentMode.RemoveCallback(m_PresentModeCallback);
+        m_PresentModeCallback = 0;
+    }
     if (m_GpuDevice) {
         SDL_WaitForGPUIdle(m_GpuDevice.get());
-        SDL_ReleaseWindowFromGPUDevice(
-            m_GpuDevice.get(),
-            brnCore::Application::Get().GetWindow()->GetHandle());
+        if (SDL_Window *window =
+                brnCore::Application::Get().GetWindow()->GetHandle()) {
+            SDL_ReleaseWindowFromGPUDevice(m_GpuDevice.get(), window);
+        }
     }
     m_GpuDevice = nullptr;
 }
@@ -4,6 +4,8 @@
 
 #include <memory>
 
+#include "Engine/Core/CVar.h"
+
 namespace brnCore {
 
 class Device {
@@ -17,6 +19,11 @@ class Device {
     SDL_GPUDevice *GetHandle() const { return m_GpuDevice.get(); }
 
   private:
+    // r.PresentMode, or VSYNC where the window doesn't support it.
+    void ApplyPresentMode();
+
     std::unique_ptr<SDL_GPUDevice, decltype(&SDL_DestroyGPUDevice)> m_GpuDevice;
+
+    CVarCallbackId m_PresentModeCallback = 0;
 };
 } // namespace brnCore
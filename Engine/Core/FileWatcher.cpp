@@ -0,0 +1,165 @@
+#include "FileWatcher.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <filesystem>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace brnCore {
+
+FileWatcher::FileWatcher(const FileWatcherSpecification &specification)
+    : m_Specification(specification) {
+#if defined(__linux__)
+    m_Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_Fd < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "FileWatcher: inotify is unavailable");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#if defined(__linux__)
+    if (m_Fd >= 0) {
+        close(m_Fd);
+    }
+#endif
+}
+
+bool FileWatcher::Watch(const std::string &directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "FileWatcher: %s is not a directory",
+                     directory.c_str());
+        return false;
+    }
+
+    std::string root = std::filesystem::path(directory).generic_string();
+    while (root.size() > 1 && root.back() == '/') {
+        root.pop_back();
+    }
+#if !defined(__linux__)
+    m_Roots.push_back(root);
+#endif
+    AddDirectory(root, false);
+    return true;
+}
+
+void FileWatcher::Poll(std::vector<std::string> &changed) {
+    const uint64_t now = SDL_GetTicks();
+
+#if defined(__linux__)
+    alignas(inotify_event) char buffer[4096];
+    ssize_t                     size;
+    while (m_Fd >= 0 && (size = read(m_Fd, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < size;) {
+            const auto *event =
+                reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                            "FileWatcher: too many changes, some were lost");
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                m_Directories.erase(event->wd);
+                continue;
+            }
+            const auto it = m_Directories.find(event->wd);
+            if (it == m_Directories.end() || event->len == 0) {
+                continue;
+            }
+
+            const std::string path = it->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                // Files may have landed in it before it was watched.
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    AddDirectory(path, true);
+                }
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                Touch(path, now);
+            } else if (event->mask & (IN_MOVED_FROM | IN_DELETE)) {
+                // An editor's temporary, renamed over the real file.
+                m_Pending.erase(path);
+            }
+        }
+    }
+#else
+    if (now - m_LastScan >= m_Specification.ScanIntervalMs) {
+        m_LastScan = now;
+        for (const std::string &root : m_Roots) {
+            AddDirectory(root, true);
+        }
+    }
+#endif
+
+    for (auto it = m_Pending.begin(); it != m_Pending.end();) {
+        if (now - it->second >= m_Specification.DebounceMs) {
+            changed.push_back(it->first);
+            it = m_Pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void FileWatcher::AddDirectory(const std::string &directory,
+                               bool               reportFiles) {
+    std::error_code error;
+#if defined(__linux__)
+    const int watch = inotify_add_watch(m_Fd,
+                                        directory.c_str(),
+                                        IN_CLOSE_WRITE | IN_MOVED_TO |
+                                            IN_MOVED_FROM | IN_CREATE |
+                                            IN_DELETE);
+    if (watch < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "FileWatcher: cannot watch %s",
+                    directory.c_str());
+        return;
+    }
+    m_Directories[watch] = directory;
+
+    // inotify isn't recursive: every directory needs its own watch.
+    for (const auto &entry :
+         std::filesystem::directory_iterator(directory, error)) {
+        const std::string path = directory + "/" +
+                                 entry.path().filename().generic_string();
+        if (entry.is_directory(error)) {
+            AddDirectory(path, reportFiles);
+        } else if (reportFiles) {
+            Touch(path, SDL_GetTicks());
+        }
+    }
+#else
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator(directory, error)) {
+        if (!entry.is_regular_file(error)) {
+            continue;
+        }
+        const int64_t time =
+            entry.last_write_time(error).time_since_epoch().count();
+        const auto [it, added] =
+            m_Times.try_emplace(entry.path().generic_string(), time);
+        if (added || it->second != time) {
+            it->second = time;
+            if (reportFiles) {
+                Touch(it->first, SDL_GetTicks());
+            }
+        }
+    }
+#endif
+}
+
+void FileWatcher::Touch(const std::string &path, uint64_t now) {
+    m_Pending[path] = now;
+}
+
+} // namespace brnCore
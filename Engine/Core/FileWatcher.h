@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brnCore {
+
+struct FileWatcherSpecification {
+    // A file is reported once it has had no events for this long, so an
+    // editor's save (truncate, write, rename...) is reported once, whole.
+    uint64_t DebounceMs = 100;
+    // Rescan interval on platforms without change notifications.
+    uint64_t ScanIntervalMs = 500;
+};
+
+/*
+ * Reports files that were written or moved into watched directories,
+ * recursively. Uses inotify on Linux and falls back to comparing
+ * modification times elsewhere. Not thread-safe; poll it once a frame.
+ */
+class FileWatcher {
+  public:
+    explicit FileWatcher(const FileWatcherSpecification &specification =
+                             FileWatcherSpecification());
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &)            = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    // Reported paths start with `directory` and use '/';
+    // VirtualFileSystem::GetVirtualPaths() maps them to asset paths.
+    bool Watch(const std::string &directory);
+
+    // Appends the files that changed and have since been quiet.
+    void Poll(std::vector<std::string> &changed);
+
+  private:
+    void AddDirectory(const std::string &directory, bool reportFiles);
+    void Touch(const std::string &path, uint64_t now);
+
+    FileWatcherSpecification                  m_Specification;
+    std::unordered_map<std::string, uint64_t> m_Pending; // path -> last event
+#if defined(__linux__)
+    int                                  m_Fd = -1;
+    std::unordered_map<int, std::string> m_Directories; // by watch descriptor
+#else
+    std::vector<std::string>                 m_Roots;
+    std::unordered_map<std::string, int64_t> m_Times; // last write times
+    uint64_t                                 m_LastScan = 0;
+#endif
+};
+
+} // namespace brnCore
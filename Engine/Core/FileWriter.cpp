@@ -0,0 +1,85 @@
+#include "FileWriter.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+
+namespace brnCore {
+
+FileWriter::~FileWriter() { Discard(); }
+
+bool FileWriter::Open(const char *path) {
+    Discard();
+    m_Path          = path;
+    m_TemporaryPath = m_Path + ".tmp";
+    m_Position      = 0;
+    m_Ok            = true;
+
+    m_Stream = SDL_IOFromFile(m_TemporaryPath.c_str(), "wb");
+    if (!m_Stream) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "FileWriter: cannot create %s: %s",
+                     m_TemporaryPath.c_str(),
+                     SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool FileWriter::Write(const void *data, size_t size) {
+    m_Ok = IsOk() && SDL_WriteIO(m_Stream, data, size) == size;
+    m_Position += size;
+    return m_Ok;
+}
+
+bool FileWriter::Pad(size_t alignment) {
+    static constexpr std::byte kZeros[64] = {};
+
+    size_t padding = (alignment - m_Position % alignment) % alignment;
+    while (padding > 0 && m_Ok) {
+        const size_t size = std::min(padding, sizeof(kZeros));
+        Write(kZeros, size);
+        padding -= size;
+    }
+    return m_Ok;
+}
+
+bool FileWriter::WriteAt(uint64_t offset, const void *data, size_t size) {
+    const auto end = static_cast<Sint64>(m_Position);
+    m_Ok = IsOk() &&
+           SDL_SeekIO(m_Stream, static_cast<Sint64>(offset), SDL_IO_SEEK_SET) ==
+               static_cast<Sint64>(offset) &&
+           SDL_WriteIO(m_Stream, data, size) == size &&
+           SDL_SeekIO(m_Stream, end, SDL_IO_SEEK_SET) == end;
+    return m_Ok;
+}
+
+bool FileWriter::Commit() {
+    if (!m_Stream) {
+        return false;
+    }
+
+    const bool closed = SDL_CloseIO(m_Stream);
+    m_Stream          = nullptr;
+    if (!m_Ok || !closed ||
+        !SDL_RenamePath(m_TemporaryPath.c_str(), m_Path.c_str())) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "FileWriter: failed to write %s: %s",
+                     m_Path.c_str(),
+                     SDL_GetError());
+        SDL_RemovePath(m_TemporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void FileWriter::Discard() {
+    if (m_Stream) {
+        SDL_CloseIO(m_Stream);
+        m_Stream = nullptr;
+        SDL_RemovePath(m_TemporaryPath.c_str());
+    }
+}
+
+} // namespace brnCore
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL3/SDL_iostream.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace brnCore {
+
+/*
+ * Writes a file through a temporary next to it (`path.tmp`) that Commit()
+ * renames into place, so a failed or interrupted write leaves the
+ * previous file intact. Errors are sticky: check IsOk() or the result of
+ * Commit() once instead of after every write.
+ */
+class FileWriter {
+  public:
+    FileWriter() = default;
+    ~FileWriter(); // discards the file unless committed
+
+    FileWriter(const FileWriter &)            = delete;
+    FileWriter &operator=(const FileWriter &) = delete;
+
+    bool Open(const char *path);
+    bool Write(const void *data, size_t size);
+    // Writes zeros up to the next multiple of `alignment`.
+    bool Pad(size_t alignment);
+    // Overwrites bytes already written, e.g. a header filled in last.
+    bool WriteAt(uint64_t offset, const void *data, size_t size);
+
+    bool Commit();
+    void Discard();
+
+    bool     IsOk() const { return m_Stream && m_Ok; }
+    uint64_t GetPosition() const { return m_Position; }
+
+  private:
+    SDL_IOStream *m_Stream = nullptr;
+    std::string   m_Path;
+    std::string   m_TemporaryPath;
+    uint64_t      m_Position = 0;
+    bool          m_Ok       = true;
+};
+
+} // namespace brnCore
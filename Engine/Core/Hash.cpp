@@ -0,0 +1,89 @@
+#include "Hash.h"
+
+#include <bit>
+#include <cstring>
+
+namespace brnCore {
+
+namespace {
+constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ull;
+constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4full;
+constexpr uint64_t kPrime3 = 0x165667b19e3779f9ull;
+constexpr uint64_t kPrime4 = 0x85ebca77c2b2ae63ull;
+constexpr uint64_t kPrime5 = 0x27d4eb2f165667c5ull;
+
+uint64_t Read64(const std::byte *p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Read32(const std::byte *p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t Round(uint64_t accumulator, uint64_t input) {
+    accumulator += input * kPrime2;
+    accumulator = std::rotl(accumulator, 31);
+    return accumulator * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t hash, uint64_t accumulator) {
+    hash ^= Round(0, accumulator);
+    return hash * kPrime1 + kPrime4;
+}
+} // namespace
+
+uint64_t HashBytes(const void *data, size_t size, uint64_t seed) {
+    const auto *p   = static_cast<const std::byte *>(data);
+    const auto *end = p + size;
+
+    uint64_t hash;
+    if (size >= 32) {
+        uint64_t v1 = seed + kPrime1 + kPrime2;
+        uint64_t v2 = seed + kPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kPrime1;
+        for (; end - p >= 32; p += 32) {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+        }
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) +
+               std::rotl(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    } else {
+        hash = seed + kPrime5;
+    }
+    hash += size;
+
+    for (; end - p >= 8; p += 8) {
+        hash ^= Round(0, Read64(p));
+        hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (end - p >= 4) {
+        hash ^= Read32(p) * kPrime1;
+        hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        hash ^= static_cast<uint8_t>(*p) * kPrime5;
+        hash = std::rotl(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace brnCore
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace brnCore {
+
+/*
+ * 64-bit hash of a byte range (the xxHash64 algorithm), for content
+ * hashes of files and large buffers. Reads 32 bytes per step, so it runs
+ * at memory speed where the bytewise HashFnv1a in StringId.h does not.
+ * Not cryptographic.
+ */
+uint64_t HashBytes(const void *data, size_t size, uint64_t seed = 0);
+
+// Mixes `value` into `hash`, for combining hashes of several parts.
+constexpr uint64_t HashCombine(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace brnCore
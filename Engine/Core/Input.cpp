@@ -0,0 +1,229 @@
+#include "Input.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace brnCore {
+
+namespace {
+float ToUnit(Sint16 value) {
+    return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+// Radial, so diagonals aren't cut off, and rescaled so the stick still
+// reaches every value from 0 up.
+glm::vec2 ApplyDeadZone(glm::vec2 stick, float deadZone) {
+    const float length = glm::length(stick);
+    if (length <= deadZone) {
+        return glm::vec2(0.0f);
+    }
+    const float scaled = (std::min(length, 1.0f) - deadZone) / (1 - deadZone);
+    return stick * (scaled / length);
+}
+} // namespace
+
+Input::Input(const InputSpecification &specification)
+    : m_Specification(specification) {}
+
+Input::~Input() {
+    for (uint32_t index = 0; index < kMaxGamepads; index++) {
+        CloseGamepad(index);
+    }
+}
+
+void Input::ProcessEvent(const SDL_Event &event) {
+    InputSnapshot &pending = m_Pending;
+    switch (event.type) {
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP: {
+        const SDL_Scancode key = event.key.scancode;
+        if (event.key.repeat || key >= SDL_SCANCODE_COUNT) {
+            break;
+        }
+        pending.m_Keys.set(key, event.key.down);
+        (event.key.down ? pending.m_KeysPressed : pending.m_KeysReleased)
+            .set(key);
+        break;
+    }
+    case SDL_EVENT_MOUSE_MOTION:
+        pending.m_MousePosition = {event.motion.x, event.motion.y};
+        pending.m_MouseDelta += glm::vec2(event.motion.xrel, event.motion.yrel);
+        break;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP: {
+        const SDL_MouseButtonFlags mask = SDL_BUTTON_MASK(event.button.button);
+        if (event.button.down) {
+            pending.m_Buttons |= mask;
+            pending.m_ButtonsPressed |= mask;
+        } else {
+            pending.m_Buttons &= ~mask;
+            pending.m_ButtonsReleased |= mask;
+        }
+        pending.m_MousePosition = {event.button.x, event.button.y};
+        break;
+    }
+    case SDL_EVENT_MOUSE_WHEEL: {
+        const float sign =
+            event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? -1.0f : 1.0f;
+        pending.m_MouseWheel += sign * glm::vec2(event.wheel.x, event.wheel.y);
+        break;
+    }
+    case SDL_EVENT_GAMEPAD_ADDED:
+        OpenGamepad(event.gdevice.which);
+        break;
+    case SDL_EVENT_GAMEPAD_REMOVED:
+        if (const int32_t index = FindGamepad(event.gdevice.which);
+            index >= 0) {
+            CloseGamepad(static_cast<uint32_t>(index));
+        }
+        break;
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP: {
+        const int32_t index  = FindGamepad(event.gbutton.which);
+        const uint8_t button = event.gbutton.button;
+        if (index < 0 || button >= SDL_GAMEPAD_BUTTON_COUNT) {
+            break;
+        }
+        GamepadState &gamepad = pending.m_Gamepads[index];
+        gamepad.Down.set(button, event.gbutton.down);
+        (event.gbutton.down ? gamepad.Pressed : gamepad.Released).set(button);
+        break;
+    }
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION: {
+        const int32_t index = FindGamepad(event.gaxis.which);
+        if (index >= 0 && event.gaxis.axis < SDL_GAMEPAD_AXIS_COUNT) {
+            m_Gamepads[index].Axes[event.gaxis.axis] = event.gaxis.value;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void Input::Update() {
+    // Sticks and triggers move continuously: their events would only
+    // flood the queue, so they are read once here instead.
+    for (uint32_t index = 0; index < kMaxGamepads; index++) {
+        SampleGamepad(index);
+    }
+
+    m_Pending.m_Frame++;
+    m_Pending.m_Timestamp = SDL_GetTicksNS();
+    m_Snapshot            = m_Pending;
+    m_Pointer             = m_Snapshot.m_MousePosition;
+
+    // Edges and motion start over for the next frame.
+    m_Pending.m_KeysPressed.reset();
+    m_Pending.m_KeysReleased.reset();
+    m_Pending.m_ButtonsPressed  = 0;
+    m_Pending.m_ButtonsReleased = 0;
+    m_Pending.m_MouseDelta      = glm::vec2(0.0f);
+    m_Pending.m_MouseWheel      = glm::vec2(0.0f);
+    for (GamepadState &gamepad : m_Pending.m_Gamepads) {
+        gamepad.Pressed.reset();
+        gamepad.Released.reset();
+    }
+
+    m_Actions.Update(m_Snapshot);
+}
+
+void Input::LatchPointer() {
+    if (m_Replaying) {
+        return;
+    }
+    SDL_PumpEvents();
+    float x, y;
+    SDL_GetMouseState(&x, &y);
+    m_Pointer = {x, y};
+}
+
+int32_t Input::FindGamepad(SDL_JoystickID id) const {
+    for (uint32_t index = 0; index < kMaxGamepads; index++) {
+        if (m_Gamepads[index].Connected && m_Gamepads[index].Id == id) {
+            return static_cast<int32_t>(index);
+        }
+    }
+    return -1;
+}
+
+void Input::OpenGamepad(SDL_JoystickID id) {
+    if (FindGamepad(id) >= 0) {
+        return;
+    }
+    const auto free = std::find_if(
+        m_Gamepads.begin(), m_Gamepads.end(), [](const Gamepad &gamepad) {
+            return !gamepad.Connected;
+        });
+    if (free == m_Gamepads.end()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "Input: more than %u gamepads, ignoring one",
+                    kMaxGamepads);
+        return;
+    }
+
+    SDL_Gamepad *handle = m_Replaying ? nullptr : SDL_OpenGamepad(id);
+    if (!handle && !m_Replaying) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Input: cannot open gamepad: %s",
+                     SDL_GetError());
+        return;
+    }
+    *free = {handle, id, true};
+
+    GamepadState &state = m_Pending.m_Gamepads[free - m_Gamepads.begin()];
+    state               = GamepadState();
+    state.Connected     = true;
+}
+
+void Input::CloseGamepad(uint32_t index) {
+    Gamepad &gamepad = m_Gamepads[index];
+    if (!gamepad.Connected) {
+        return;
+    }
+    if (gamepad.Handle) {
+        SDL_CloseGamepad(gamepad.Handle);
+    }
+    gamepad = Gamepad();
+
+    // Whatever was held is let go.
+    GamepadState &state = m_Pending.m_Gamepads[index];
+    state.Released |= state.Down;
+    state.Down.reset();
+    state.Axes.fill(0.0f);
+    state.Connected = false;
+}
+
+void Input::SampleGamepad(uint32_t index) {
+    const Gamepad &gamepad = m_Gamepads[index];
+    if (!gamepad.Connected) {
+        return;
+    }
+
+    // Both read the same: SDL updates the device state as it queues the
+    // axis events, so the last event is where the stick is.
+    std::array<float, SDL_GAMEPAD_AXIS_COUNT> &axes =
+        m_Pending.m_Gamepads[index].Axes;
+    for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; axis++) {
+        axes[axis] = ToUnit(
+            gamepad.Handle
+                ? SDL_GetGamepadAxis(gamepad.Handle,
+                                     static_cast<SDL_GamepadAxis>(axis))
+                : gamepad.Axes[axis]);
+    }
+
+    // The dead zone takes both axes of a stick together.
+    const auto stick = [&](SDL_GamepadAxis x, SDL_GamepadAxis y) {
+        const glm::vec2 value =
+            ApplyDeadZone({axes[x], axes[y]}, m_Specification.StickDeadZone);
+        axes[x] = value.x;
+        axes[y] = value.y;
+    };
+    stick(SDL_GAMEPAD_AXIS_LEFTX, SDL_GAMEPAD_AXIS_LEFTY);
+    stick(SDL_GAMEPAD_AXIS_RIGHTX, SDL_GAMEPAD_AXIS_RIGHTY);
+}
+
+} // namespace brnCore
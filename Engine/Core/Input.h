@@ -0,0 +1,172 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_gamepad.h>
+#include <SDL3/SDL_mouse.h>
+#include <SDL3/SDL_scancode.h>
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+#include "Engine/Core/ActionMap.h"
+
+namespace brnCore {
+
+inline constexpr uint32_t kMaxGamepads = 4;
+
+struct InputSpecification {
+    // Stick travel that reads as 0, against drift; the rest is rescaled
+    // to the whole [0, 1].
+    float StickDeadZone = 0.15f;
+    // Samples the pointer again right before OnRender, so UI that
+    // follows the cursor is drawn where it is now rather than where it
+    // was when the frame's events were pumped.
+    bool LateLatchPointer = true;
+};
+
+struct GamepadState {
+    bool Connected = false;
+    // Sticks in [-1, 1] past the dead zone (y down), triggers in [0, 1].
+    std::array<float, SDL_GAMEPAD_AXIS_COUNT> Axes{};
+    std::bitset<SDL_GAMEPAD_BUTTON_COUNT>     Down;
+    std::bitset<SDL_GAMEPAD_BUTTON_COUNT>     Pressed; // this frame
+    std::bitset<SDL_GAMEPAD_BUTTON_COUNT>     Released;
+};
+
+/*
+ * The state of every input device as of one frame, frozen: whatever
+ * reads it during the frame sees the same thing. Presses and releases
+ * are edges since the last snapshot, so a key tapped between two frames
+ * shows as both pressed and released.
+ */
+class InputSnapshot {
+  public:
+    bool IsKeyDown(SDL_Scancode key) const { return m_Keys.test(key); }
+    bool WasKeyPressed(SDL_Scancode key) const {
+        return m_KeysPressed.test(key);
+    }
+    bool WasKeyReleased(SDL_Scancode key) const {
+        return m_KeysReleased.test(key);
+    }
+
+    // SDL_BUTTON_LEFT, SDL_BUTTON_RIGHT, ...
+    bool IsMouseButtonDown(uint8_t button) const {
+        return m_Buttons & SDL_BUTTON_MASK(button);
+    }
+    bool WasMouseButtonPressed(uint8_t button) const {
+        return m_ButtonsPressed & SDL_BUTTON_MASK(button);
+    }
+    bool WasMouseButtonReleased(uint8_t button) const {
+        return m_ButtonsReleased & SDL_BUTTON_MASK(button);
+    }
+    // In window coordinates; the delta and wheel add up the frame's
+    // motion.
+    glm::vec2 GetMousePosition() const { return m_MousePosition; }
+    glm::vec2 GetMouseDelta() const { return m_MouseDelta; }
+    glm::vec2 GetMouseWheel() const { return m_MouseWheel; }
+
+    const GamepadState &GetGamepad(uint32_t index) const {
+        return m_Gamepads[index];
+    }
+
+    uint64_t GetFrame() const { return m_Frame; }
+    // SDL_GetTicksNS() when the snapshot was taken.
+    uint64_t GetTimestamp() const { return m_Timestamp; }
+
+  private:
+    friend class Input;
+
+    std::bitset<SDL_SCANCODE_COUNT> m_Keys;
+    std::bitset<SDL_SCANCODE_COUNT> m_KeysPressed;
+    std::bitset<SDL_SCANCODE_COUNT> m_KeysReleased;
+
+    SDL_MouseButtonFlags m_Buttons         = 0;
+    SDL_MouseButtonFlags m_ButtonsPressed  = 0;
+    SDL_MouseButtonFlags m_ButtonsReleased = 0;
+    glm::vec2            m_MousePosition{0.0f};
+    glm::vec2            m_MouseDelta{0.0f};
+    glm::vec2            m_MouseWheel{0.0f};
+
+    std::array<GamepadState, kMaxGamepads> m_Gamepads;
+
+    uint64_t m_Frame     = 0;
+    uint64_t m_Timestamp = 0;
+};
+
+/*
+ * Turns the event stream into one InputSnapshot per frame.
+ *
+ * The application hands every event to ProcessEvent() while pumping and
+ * calls Update() once after: the snapshot is then final for the frame,
+ * and the ActionMap is evaluated against it. Gamepads are opened as
+ * they connect, into the first free of kMaxGamepads slots.
+ *
+ * LatchPointer() is the one exception to the frozen frame: cursor
+ * driven UI reads GetPointerPosition(), which it refreshes as late as
+ * possible, so what is under the cursor is drawn where the cursor is.
+ *
+ * While replaying, recorded events stand in for the devices: gamepads
+ * are not opened, sticks read the recorded axis events, and the pointer
+ * is not latched, so the snapshots come out as they were recorded.
+ */
+class Input {
+  public:
+    explicit Input(
+        const InputSpecification &specification = InputSpecification());
+    ~Input();
+
+    Input(const Input &)            = delete;
+    Input &operator=(const Input &) = delete;
+
+    void ProcessEvent(const SDL_Event &event);
+    // Freezes what the events since the last call said into the
+    // snapshot, and updates the actions.
+    void Update();
+
+    const InputSnapshot &GetSnapshot() const { return m_Snapshot; }
+    ActionMap           &GetActions() { return m_Actions; }
+    const ActionMap     &GetActions() const { return m_Actions; }
+
+    /*
+     * Pumps the OS events and reads the pointer again. The events stay
+     * queued for the next frame; only the pointer position moves ahead.
+     * Render thread, right before recording draws that depend on it.
+     */
+    void LatchPointer();
+    // Latched this frame, or the snapshot's.
+    glm::vec2 GetPointerPosition() const { return m_Pointer; }
+
+    void SetReplaying(bool replaying) { m_Replaying = replaying; }
+    bool IsReplaying() const { return m_Replaying; }
+
+    const InputSpecification &GetSpecification() const {
+        return m_Specification;
+    }
+
+  private:
+    struct Gamepad {
+        SDL_Gamepad   *Handle    = nullptr; // null while replaying
+        SDL_JoystickID Id        = 0;
+        bool           Connected = false;
+        // Last axis events, what a replay reads instead of the device.
+        std::array<Sint16, SDL_GAMEPAD_AXIS_COUNT> Axes{};
+    };
+
+    int32_t FindGamepad(SDL_JoystickID id) const;
+    void    OpenGamepad(SDL_JoystickID id);
+    void    CloseGamepad(uint32_t index);
+    void    SampleGamepad(uint32_t index);
+
+    InputSpecification                m_Specification;
+    InputSnapshot                     m_Pending; // being built by events
+    InputSnapshot                     m_Snapshot;
+    std::array<Gamepad, kMaxGamepads> m_Gamepads;
+    ActionMap                         m_Actions;
+    glm::vec2                         m_Pointer{0.0f};
+    bool                              m_Replaying = false;
+};
+
+} // namespace brnCore
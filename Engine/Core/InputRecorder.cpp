@@ -0,0 +1,266 @@
+#include "InputRecorder.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace brnCore {
+
+namespace {
+constexpr uint32_t kMagic   = 0x524e5242; // "BRNR"
+constexpr uint16_t kVersion = 1;
+
+struct Header {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t EventSize; // sizeof(SDL_Event) of the build that recorded
+    uint64_t Seed;
+    uint64_t FrameCount;
+};
+
+struct FrameRecord {
+    float    DeltaSeconds;
+    uint32_t EventCount;
+    uint32_t Size; // of the events that follow
+};
+
+struct EventRecord {
+    uint32_t Type;
+    uint32_t Size; // of what follows
+};
+
+constexpr size_t kCommonSize = sizeof(SDL_CommonEvent);
+
+// Size of the event struct of `type`, or 0 when it is not recorded.
+size_t GetEventSize(uint32_t type) {
+    if (type >= SDL_EVENT_WINDOW_FIRST && type <= SDL_EVENT_WINDOW_LAST) {
+        return sizeof(SDL_WindowEvent);
+    }
+    switch (type) {
+    case SDL_EVENT_QUIT:
+        return sizeof(SDL_CommonEvent);
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        return sizeof(SDL_KeyboardEvent);
+    case SDL_EVENT_MOUSE_MOTION:
+        return sizeof(SDL_MouseMotionEvent);
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        return sizeof(SDL_MouseButtonEvent);
+    case SDL_EVENT_MOUSE_WHEEL:
+        return sizeof(SDL_MouseWheelEvent);
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        return sizeof(SDL_GamepadAxisEvent);
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        return sizeof(SDL_GamepadButtonEvent);
+    case SDL_EVENT_GAMEPAD_ADDED:
+    case SDL_EVENT_GAMEPAD_REMOVED:
+    case SDL_EVENT_GAMEPAD_REMAPPED:
+        return sizeof(SDL_GamepadDeviceEvent);
+    default:
+        return 0;
+    }
+}
+
+void Append(std::vector<std::byte> &bytes, const void *data, size_t size) {
+    const auto *begin = static_cast<const std::byte *>(data);
+    bytes.insert(bytes.end(), begin, begin + size);
+}
+} // namespace
+
+bool InputRecorder::Open(const char *path, uint64_t seed) {
+    if (!m_Writer.Open(path)) {
+        return false;
+    }
+    Header header{};
+    header.Magic     = kMagic;
+    header.Version   = kVersion;
+    header.EventSize = sizeof(SDL_Event);
+    header.Seed      = seed;
+    m_Writer.Write(&header, sizeof(header));
+
+    m_Frame.clear();
+    m_FrameEvents = 0;
+    m_FrameCount  = 0;
+    return m_Writer.IsOk();
+}
+
+void InputRecorder::Record(const SDL_Event &event) {
+    if (!IsOpen()) {
+        return;
+    }
+
+    const auto *bytes = reinterpret_cast<const std::byte *>(&event);
+    if (event.type == SDL_EVENT_TEXT_INPUT) {
+        const size_t length = event.text.text ? std::strlen(event.text.text)
+                                              : 0;
+        const EventRecord record{
+            event.type,
+            static_cast<uint32_t>(sizeof(SDL_WindowID) + length)};
+        Append(m_Frame, &record, sizeof(record));
+        Append(m_Frame, &event.text.windowID, sizeof(SDL_WindowID));
+        Append(m_Frame, event.text.text, length);
+        m_FrameEvents++;
+        return;
+    }
+
+    const size_t size = GetEventSize(event.type);
+    if (size == 0) {
+        return;
+    }
+    const EventRecord record{event.type,
+                             static_cast<uint32_t>(size - kCommonSize)};
+    Append(m_Frame, &record, sizeof(record));
+    Append(m_Frame, bytes + kCommonSize, size - kCommonSize);
+    m_FrameEvents++;
+}
+
+void InputRecorder::EndFrame(float deltaSeconds) {
+    if (!IsOpen()) {
+        return;
+    }
+    const FrameRecord record{
+        deltaSeconds, m_FrameEvents, static_cast<uint32_t>(m_Frame.size())};
+    m_Writer.Write(&record, sizeof(record));
+    m_Writer.Write(m_Frame.data(), m_Frame.size());
+    m_Frame.clear();
+    m_FrameEvents = 0;
+    m_FrameCount++;
+}
+
+bool InputRecorder::Close() {
+    if (!IsOpen()) {
+        m_Writer.Discard();
+        return false;
+    }
+    // Frames recorded after the last EndFrame() are dropped with it.
+    m_Writer.WriteAt(offsetof(Header, FrameCount),
+                     &m_FrameCount,
+                     sizeof(m_FrameCount));
+    return m_Writer.Commit();
+}
+
+bool InputReplay::Open(const char *path) {
+    if (!m_File.Open(path)) {
+        return false;
+    }
+
+    auto fail = [&](const char *reason) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "InputReplay: %s: %s", path, reason);
+        m_File.Close();
+        return false;
+    };
+
+    Header header;
+    if (m_File.GetSize() < sizeof(header)) {
+        return fail("truncated header");
+    }
+    std::memcpy(&header, m_File.GetData(), sizeof(header));
+    if (header.Magic != kMagic) {
+        return fail("not an input recording");
+    }
+    if (header.Version != kVersion) {
+        return fail("unsupported version");
+    }
+    if (header.EventSize != sizeof(SDL_Event)) {
+        return fail("recorded by a build with other SDL events");
+    }
+
+    m_File.Prefetch();
+    m_Seed       = header.Seed;
+    m_FrameCount = header.FrameCount;
+    m_Frame      = 0;
+    m_Offset     = sizeof(header);
+    return true;
+}
+
+bool InputReplay::NextFrame(std::vector<SDL_Event> &events,
+                            float                  &deltaSeconds) {
+    events.clear();
+    m_Text.clear();
+    if (!m_File.IsOpen() || m_Frame == m_FrameCount) {
+        return false;
+    }
+
+    auto fail = [&]() {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "InputReplay: frame %llu is corrupt, stopping",
+                     static_cast<unsigned long long>(m_Frame));
+        events.clear();
+        m_File.Close();
+        return false;
+    };
+
+    const std::byte *data = m_File.GetData();
+    const size_t     size = m_File.GetSize();
+    FrameRecord      frame;
+    if (size - m_Offset < sizeof(frame)) {
+        return fail();
+    }
+    std::memcpy(&frame, data + m_Offset, sizeof(frame));
+    m_Offset += sizeof(frame);
+    if (size - m_Offset < frame.Size) {
+        return fail();
+    }
+
+    const uint64_t now    = SDL_GetTicksNS();
+    size_t         offset = m_Offset;
+    const size_t   end    = m_Offset + frame.Size;
+    // Text lands in m_Text, which may still move: pointed at after.
+    std::vector<std::pair<size_t, size_t>> text;
+    for (uint32_t i = 0; i < frame.EventCount; i++) {
+        EventRecord record;
+        if (end - offset < sizeof(record)) {
+            return fail();
+        }
+        std::memcpy(&record, data + offset, sizeof(record));
+        offset += sizeof(record);
+        if (end - offset < record.Size) {
+            return fail();
+        }
+
+        SDL_Event event{};
+        event.type = record.Type;
+        if (record.Type == SDL_EVENT_TEXT_INPUT) {
+            if (record.Size < sizeof(SDL_WindowID)) {
+                return fail();
+            }
+            std::memcpy(
+                &event.text.windowID, data + offset, sizeof(SDL_WindowID));
+            const auto *begin = reinterpret_cast<const char *>(
+                data + offset + sizeof(SDL_WindowID));
+            text.emplace_back(events.size(), m_Text.size());
+            m_Text.insert(m_Text.end(),
+                          begin,
+                          begin + record.Size - sizeof(SDL_WindowID));
+            m_Text.push_back('\0');
+        } else {
+            if (record.Size != GetEventSize(record.Type) - kCommonSize) {
+                return fail();
+            }
+            std::memcpy(reinterpret_cast<std::byte *>(&event) + kCommonSize,
+                        data + offset,
+                        record.Size);
+        }
+        // Stamped as played, so latency reads the replay's, not the
+        // recording's.
+        event.common.timestamp = now;
+        events.push_back(event);
+        offset += record.Size;
+    }
+    for (const auto &[index, start] : text) {
+        events[index].text.text = m_Text.data() + start;
+    }
+
+    m_Offset     = end;
+    deltaSeconds = frame.DeltaSeconds;
+    m_Frame++;
+    return true;
+}
+
+} // namespace brnCore
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL3/SDL_events.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/FileWriter.h"
+#include "Engine/Core/MappedFile.h"
+
+namespace brnCore {
+
+struct InputRecordingSpecification {
+    // Records every event and frame time of the session to this file.
+    std::string RecordPath;
+    // Plays this recording instead of live input: every frame gets the
+    // recorded events and delta time, as fast as it runs, and the
+    // application quits at the end. Takes precedence over RecordPath.
+    std::string ReplayPath;
+    // Plays every frame with this delta (seconds) instead of the
+    // recorded one; 0 keeps the recording's.
+    float ReplayTimestep = 0.0f;
+    // Replays without a window, so without a display: the GPU device is
+    // created but claims no window (see Application::IsHeadless()).
+    bool Headless = false;
+};
+
+/*
+ * A session as a file:
+ *
+ *   Header
+ *   per frame: FrameRecord, then its events, each an EventRecord and
+ *              the event without its SDL_CommonEvent part
+ *
+ * Events are written as the platform lays them out: a recording replays
+ * on the build and platform that made it. Timestamps are left out (the
+ * replay stamps events as it plays them), and so are events that only
+ * point at memory SDL owns (drops, clipboard, user events), except text
+ * input, whose text is stored after the event instead.
+ */
+class InputRecorder {
+  public:
+    // The engine RNG seed is kept, so the replay draws the same numbers.
+    bool Open(const char *path, uint64_t seed);
+    void Record(const SDL_Event &event);
+    // Writes the frame's events with the frame's delta time.
+    void EndFrame(float deltaSeconds);
+    bool Close();
+
+    bool     IsOpen() const { return m_Writer.IsOk(); }
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+
+  private:
+    FileWriter             m_Writer;
+    std::vector<std::byte> m_Frame; // events of the frame, encoded
+    uint32_t               m_FrameEvents = 0;
+    uint64_t               m_FrameCount  = 0;
+};
+
+class InputReplay {
+  public:
+    bool Open(const char *path);
+
+    // The next frame's events and delta; false past the last frame.
+    // Text input events point into storage valid until the next call.
+    bool NextFrame(std::vector<SDL_Event> &events, float &deltaSeconds);
+
+    uint64_t GetSeed() const { return m_Seed; }
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+    uint64_t GetFrame() const { return m_Frame; }
+
+  private:
+    MappedFile        m_File;
+    size_t            m_Offset     = 0;
+    uint64_t          m_Seed       = 0;
+    uint64_t          m_FrameCount = 0;
+    uint64_t          m_Frame      = 0;
+    std::vector<char> m_Text; // of the frame's text input events
+};
+
+} // namespace brnCore
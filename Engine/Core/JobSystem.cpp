@@ -0,0 +1,99 @@
+#include "JobSystem.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+
+namespace brnCore {
+
+namespace {
+thread_local uint32_t t_ThreadIndex = 0;
+} // namespace
+
+JobSystem::JobSystem(const JobSystemSpecification &specification) {
+    uint32_t workerCount = specification.WorkerCount;
+    if (workerCount == 0) {
+        const int cores = SDL_GetNumLogicalCPUCores();
+        workerCount     = cores > 1 ? static_cast<uint32_t>(cores - 1) : 0;
+    }
+
+    m_Workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; i++) {
+        m_Workers.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_WorkAvailable.notify_all();
+
+    for (std::thread &worker : m_Workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::Schedule(JobCounter &counter, Job job) {
+    counter.m_Pending.fetch_add(1, std::memory_order_relaxed);
+    if (m_Workers.empty()) {
+        QueuedJob queued{std::move(job), &counter};
+        Run(queued);
+        return;
+    }
+
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Queue.push_back({std::move(job), &counter});
+    }
+    m_WorkAvailable.notify_one();
+}
+
+void JobSystem::Wait(JobCounter &counter) {
+    while (!counter.IsDone()) {
+        if (!TryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t JobSystem::GetThreadIndex() { return t_ThreadIndex; }
+
+void JobSystem::WorkerMain(uint32_t index) {
+    t_ThreadIndex = index;
+
+    while (true) {
+        QueuedJob job;
+        {
+            std::unique_lock lock(m_Mutex);
+            m_WorkAvailable.wait(
+                lock, [this] { return m_Stopping || !m_Queue.empty(); });
+            if (m_Queue.empty()) {
+                return;
+            }
+            job = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        Run(job);
+    }
+}
+
+bool JobSystem::TryRunOne() {
+    QueuedJob job;
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (m_Queue.empty()) {
+            return false;
+        }
+        job = std::move(m_Queue.front());
+        m_Queue.pop_front();
+    }
+    Run(job);
+    return true;
+}
+
+void JobSystem::Run(QueuedJob &job) {
+    job.Function();
+    job.Counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace brnCore
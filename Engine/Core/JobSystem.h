@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace brnCore {
+
+struct JobSystemSpecification {
+    uint32_t WorkerCount = 0; // 0 = one per logical core minus the caller
+};
+
+// Counts outstanding jobs; JobSystem::Wait() blocks until it drops to zero.
+class JobCounter {
+  public:
+    bool IsDone() const {
+        return m_Pending.load(std::memory_order_acquire) == 0;
+    }
+
+  private:
+    std::atomic<uint32_t> m_Pending{0};
+
+    friend class JobSystem;
+};
+
+/*
+ * Fixed pool of worker threads fed from a shared queue. Waiting threads
+ * run queued jobs instead of sleeping, so jobs may schedule and wait on
+ * nested work (e.g. a system splitting its query with ParallelFor).
+ */
+class JobSystem {
+  public:
+    using Job = std::function<void()>;
+
+    explicit JobSystem(
+        const JobSystemSpecification &specification = JobSystemSpecification());
+    ~JobSystem();
+
+    JobSystem(const JobSystem &)            = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    void Schedule(JobCounter &counter, Job job);
+    void Wait(JobCounter &counter);
+
+    /*
+     * Calls fn(begin, end) over [0, count) in ranges of at most `grain`
+     * items, using the workers and the calling thread. Blocks until done.
+     */
+    template <typename Fn>
+    void ParallelFor(uint32_t count, uint32_t grain, Fn &&fn) {
+        grain = std::max(grain, 1u);
+        if (count <= grain || m_Workers.empty()) {
+            if (count) {
+                fn(0u, count);
+            }
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = grain; begin < count; begin += grain) {
+            const uint32_t end = std::min(begin + grain, count);
+            Schedule(counter, [&fn, begin, end] { fn(begin, end); });
+        }
+        fn(0u, grain);
+        Wait(counter);
+    }
+
+    // Workers plus the thread that created the system.
+    uint32_t GetThreadCount() const {
+        return static_cast<uint32_t>(m_Workers.size()) + 1;
+    }
+
+    // 0 on non-worker threads, 1..N on workers; for per-thread scratch.
+    static uint32_t GetThreadIndex();
+
+  private:
+    struct QueuedJob {
+        Job         Function;
+        JobCounter *Counter;
+    };
+
+    void WorkerMain(uint32_t index);
+    bool TryRunOne();
+    void Run(QueuedJob &job);
+
+    std::vector<std::thread> m_Workers;
+    std::deque<QueuedJob>    m_Queue;
+    std::mutex               m_Mutex;
+    std::condition_variable  m_WorkAvailable;
+    bool                     m_Stopping = false;
+};
+
+} // namespace brnCore
@@ -0,0 +1,385 @@
+#include "LatencyTracker.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_mouse.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+#include "Engine/Core/FileWriter.h"
+
+namespace brnCore {
+
+namespace {
+double ToMilliseconds(uint64_t from, uint64_t to) {
+    return to > from ? static_cast<double>(to - from) * 1e-6 : 0.0;
+}
+
+// The kind of an input event, or Count for the rest.
+InputKind Classify(const SDL_Event &event) {
+    switch (event.type) {
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        return event.key.repeat ? InputKind::Count : InputKind::Key;
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        return InputKind::MouseButton;
+    case SDL_EVENT_MOUSE_MOTION:
+        return InputKind::MouseMotion;
+    case SDL_EVENT_MOUSE_WHEEL:
+        return InputKind::MouseWheel;
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        return InputKind::Gamepad;
+    default:
+        return InputKind::Count;
+    }
+}
+} // namespace
+
+const char *GetInputKindName(InputKind kind) {
+    switch (kind) {
+    case InputKind::Key:
+        return "key";
+    case InputKind::MouseButton:
+        return "button";
+    case InputKind::MouseMotion:
+        return "motion";
+    case InputKind::MouseWheel:
+        return "wheel";
+    case InputKind::Gamepad:
+        return "gamepad";
+    default:
+        return "?";
+    }
+}
+
+const char *GetFrameStageName(FrameStage stage) {
+    switch (stage) {
+    case FrameStage::Update:
+        return "update";
+    case FrameStage::Submit:
+        return "submit";
+    case FrameStage::Present:
+        return "present";
+    default:
+        return "?";
+    }
+}
+
+void LatencyHistogram::Add(double milliseconds) {
+    milliseconds      = std::max(milliseconds, 0.0);
+    const auto bucket = static_cast<uint32_t>(
+        std::min(milliseconds / kBucketMs, static_cast<double>(kBucketCount)));
+    m_Buckets[bucket]++;
+    m_Count++;
+    m_SumMs += milliseconds;
+    m_MaxMs = std::max(m_MaxMs, milliseconds);
+}
+
+double LatencyHistogram::GetPercentile(double percentile) const {
+    if (m_Count == 0) {
+        return 0.0;
+    }
+    const auto rank = std::max<uint64_t>(
+        static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_Count)), 1);
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < kBucketCount; bucket++) {
+        seen += m_Buckets[bucket];
+        if (seen >= rank) {
+            return std::min((bucket + 1) * kBucketMs, m_MaxMs);
+        }
+    }
+    return m_MaxMs;
+}
+
+LatencyTracker::LatencyTracker(const LatencySpecification &specification)
+    : m_Specification(specification) {}
+
+LatencyTracker::~LatencyTracker() {
+    if (m_PresentThread.joinable()) {
+        {
+            std::lock_guard lock(m_PresentMutex);
+            m_Stopping = true;
+        }
+        m_PresentWake.notify_one();
+        m_PresentThread.join();
+    }
+}
+
+void LatencyTracker::RecordEvent(const SDL_Event &event) {
+    const InputKind kind = Classify(event);
+    if (kind == InputKind::Count) {
+        return;
+    }
+    if (m_Pending.EventCount == kMaxEvents) {
+        m_Stats.Dropped++;
+        return;
+    }
+    // Events pushed without a timestamp count from when they are seen.
+    const uint64_t timestamp =
+        event.common.timestamp ? event.common.timestamp : SDL_GetTicksNS();
+    m_Pending.Events[m_Pending.EventCount++] = {timestamp, kind};
+}
+
+void LatencyTracker::BeginFrame(uint64_t frame) {
+    Poll();
+
+    // Without a fence, the last frame got as far as it will.
+    FrameRecord &last = m_Frames[m_Current];
+    if (last.Active && last.Fences == 0) {
+        Finish(last);
+    }
+
+    // A frame still waiting this late never gets its fence back in time:
+    // it goes in without Present rather than holding up the ring.
+    m_Current           = (m_Current + 1) % kMaxFramesInFlight;
+    FrameRecord &record = m_Frames[m_Current];
+    if (record.Active) {
+        Finish(record);
+    }
+
+    std::swap(record, m_Pending);
+    m_Pending.EventCount = 0;
+    record.Frame         = frame;
+    record.Stages.fill(0);
+    record.Fences = 0;
+    record.Active = true;
+}
+
+void LatencyTracker::TrackPresent(SDL_GPUDevice *device, SDL_GPUFence *fence) {
+    if (!fence) {
+        return;
+    }
+    FrameRecord &record = m_Frames[m_Current];
+    if (!record.Active) {
+        SDL_ReleaseGPUFence(device, fence);
+        return;
+    }
+    record.Fences++;
+
+    if (!m_PresentThread.joinable()) {
+        m_PresentThread = std::thread(&LatencyTracker::PresentThreadMain, this);
+    }
+    {
+        std::lock_guard lock(m_PresentMutex);
+        m_Fences.push_back({device, fence, record.Frame});
+    }
+    m_PresentWake.notify_one();
+}
+
+void LatencyTracker::Mark(FrameStage stage) {
+    FrameRecord &record = m_Frames[m_Current];
+    if (record.Active && record.Stages[size_t(stage)] == 0) {
+        record.Stages[size_t(stage)] = SDL_GetTicksNS();
+    }
+    Poll();
+}
+
+void LatencyTracker::Poll() {
+    {
+        std::lock_guard lock(m_PresentMutex);
+        m_PresentedScratch.swap(m_Presented);
+    }
+    for (const Presented &presented : m_PresentedScratch) {
+        for (FrameRecord &record : m_Frames) {
+            if (!record.Active || record.Frame != presented.Frame ||
+                record.Fences == 0) {
+                continue;
+            }
+            // Fences are waited on in order: the last one is the latest.
+            record.Stages[size_t(FrameStage::Present)] = presented.Timestamp;
+            if (--record.Fences == 0) {
+                Finish(record);
+            }
+        }
+    }
+    m_PresentedScratch.clear();
+}
+
+void LatencyTracker::Finish(FrameRecord &record) {
+    record.Active = false;
+    if (record.EventCount == 0) {
+        return;
+    }
+    // Stamped by a fence, but not by the last of them.
+    if (record.Fences != 0) {
+        record.Stages[size_t(FrameStage::Present)] = 0;
+    }
+
+    uint64_t oldest = record.Events[0].Timestamp;
+    for (uint32_t i = 1; i < record.EventCount; i++) {
+        oldest = std::min(oldest, record.Events[i].Timestamp);
+    }
+
+    m_Stats.Frames++;
+    m_Stats.Events += record.EventCount;
+    for (size_t stage = 0; stage < size_t(FrameStage::Count); stage++) {
+        const uint64_t reached = record.Stages[stage];
+        if (reached == 0) {
+            continue;
+        }
+        m_Stats.PerFrame[stage].Add(ToMilliseconds(oldest, reached));
+        for (uint32_t i = 0; i < record.EventCount; i++) {
+            const Event &event = record.Events[i];
+            m_Stats.PerKind[size_t(event.Kind)][stage].Add(
+                ToMilliseconds(event.Timestamp, reached));
+        }
+    }
+}
+
+void LatencyTracker::PresentThreadMain() {
+    std::unique_lock lock(m_PresentMutex);
+    while (true) {
+        m_PresentWake.wait(
+            lock, [this] { return m_Stopping || !m_Fences.empty(); });
+        if (m_Fences.empty()) {
+            return;
+        }
+        const PendingFence pending = m_Fences.front();
+        m_Fences.pop_front();
+        // At shutdown nobody reads the result: just give them back.
+        if (m_Stopping) {
+            SDL_ReleaseGPUFence(pending.Device, pending.Fence);
+            continue;
+        }
+
+        // SDL guards its fences with a lock of their own, so waiting
+        // here does not get in the way of the main thread submitting.
+        lock.unlock();
+        const bool signaled =
+            SDL_WaitForGPUFences(pending.Device, true, &pending.Fence, 1);
+        const uint64_t presented = SDL_GetTicksNS();
+        SDL_ReleaseGPUFence(pending.Device, pending.Fence);
+        lock.lock();
+
+        if (signaled) {
+            m_Presented.push_back({pending.Frame, presented});
+        }
+    }
+}
+
+bool LatencyTracker::InjectClick(SDL_WindowID window, float x, float y) {
+    SDL_Event event{};
+    event.type             = SDL_EVENT_MOUSE_BUTTON_DOWN;
+    event.button.timestamp = SDL_GetTicksNS();
+    event.button.windowID  = window;
+    event.button.button    = SDL_BUTTON_LEFT;
+    event.button.down      = true;
+    event.button.clicks    = 1;
+    event.button.x         = x;
+    event.button.y         = y;
+    if (!SDL_PushEvent(&event)) {
+        return false;
+    }
+    event.type        = SDL_EVENT_MOUSE_BUTTON_UP;
+    event.button.down = false;
+    return SDL_PushEvent(&event);
+}
+
+void LatencyTracker::InjectIfDue(SDL_WindowID window, float x, float y) {
+    const uint32_t interval = m_Specification.InjectInterval;
+    if (interval != 0 && ++m_FrameCount % interval == 0 &&
+        !InjectClick(window, x, y)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "LatencyTracker: cannot inject input: %s",
+                    SDL_GetError());
+    }
+}
+
+void LatencyTracker::LogStats() const {
+    SDL_Log("LatencyTracker: %llu frames with input, %llu events, "
+            "%llu dropped",
+            static_cast<unsigned long long>(m_Stats.Frames),
+            static_cast<unsigned long long>(m_Stats.Events),
+            static_cast<unsigned long long>(m_Stats.Dropped));
+
+    const auto log = [](const char             *input,
+                        size_t                  stage,
+                        const LatencyHistogram &histogram) {
+        if (histogram.GetCount() == 0) {
+            return;
+        }
+        SDL_Log("  %-8s to %-8s %8llu  mean %7.2f  p50 %7.2f  p95 %7.2f  "
+                "p99 %7.2f  max %7.2f ms",
+                input,
+                GetFrameStageName(static_cast<FrameStage>(stage)),
+                static_cast<unsigned long long>(histogram.GetCount()),
+                histogram.GetMean(),
+                histogram.GetPercentile(50),
+                histogram.GetPercentile(95),
+                histogram.GetPercentile(99),
+                histogram.GetMax());
+    };
+    for (size_t stage = 0; stage < size_t(FrameStage::Count); stage++) {
+        log("frame", stage, m_Stats.PerFrame[stage]);
+    }
+    for (size_t kind = 0; kind < size_t(InputKind::Count); kind++) {
+        for (size_t stage = 0; stage < size_t(FrameStage::Count); stage++) {
+            log(GetInputKindName(static_cast<InputKind>(kind)),
+                stage,
+                m_Stats.PerKind[kind][stage]);
+        }
+    }
+}
+
+bool LatencyTracker::WriteReport(const char *path) const {
+    FileWriter writer;
+    if (!writer.Open(path)) {
+        return false;
+    }
+
+    // One row per histogram; `buckets` are the counts of every
+    // LatencyHistogram::kBucketMs from 0, up to the last non-empty one.
+    std::string text =
+        "input,stage,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,buckets\n";
+    const auto row = [&](const char             *input,
+                         size_t                  stage,
+                         const LatencyHistogram &histogram) {
+        char line[192];
+        std::snprintf(line,
+                      sizeof(line),
+                      "%s,%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,",
+                      input,
+                      GetFrameStageName(static_cast<FrameStage>(stage)),
+                      static_cast<unsigned long long>(histogram.GetCount()),
+                      histogram.GetMean(),
+                      histogram.GetPercentile(50),
+                      histogram.GetPercentile(95),
+                      histogram.GetPercentile(99),
+                      histogram.GetMax());
+        text += line;
+
+        const auto &buckets = histogram.GetBuckets();
+        const auto  last    = std::find_if(
+            buckets.rbegin(), buckets.rend(), [](uint32_t count) {
+                return count != 0;
+            });
+        for (auto it = buckets.begin(); it != last.base(); it++) {
+            if (it != buckets.begin()) {
+                text += ' ';
+            }
+            text += std::to_string(*it);
+        }
+        text += '\n';
+    };
+    for (size_t stage = 0; stage < size_t(FrameStage::Count); stage++) {
+        row("frame", stage, m_Stats.PerFrame[stage]);
+    }
+    for (size_t kind = 0; kind < size_t(InputKind::Count); kind++) {
+        for (size_t stage = 0; stage < size_t(FrameStage::Count); stage++) {
+            row(GetInputKindName(static_cast<InputKind>(kind)),
+                stage,
+                m_Stats.PerKind[kind][stage]);
+        }
+    }
+
+    writer.Write(text.data(), text.size());
+    return writer.Commit();
+}
+
+} // namespace brnCore
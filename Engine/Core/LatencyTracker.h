@@ -0,0 +1,190 @@
+#pragma once
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace brnCore {
+
+// Input events by what they come from.
+enum class InputKind : uint8_t {
+    Key,
+    MouseButton,
+    MouseMotion,
+    MouseWheel,
+    Gamepad,
+    Count,
+};
+
+// Points of a frame input latency is measured to.
+enum class FrameStage : uint8_t {
+    Update,  // the layers' OnUpdate ran
+    Submit,  // the layers' OnRender submitted their command buffers
+    Present, // the GPU finished the frame that goes on screen
+    Count,
+};
+
+const char *GetInputKindName(InputKind kind);
+const char *GetFrameStageName(FrameStage stage);
+
+/*
+ * Counts latencies in 0.25 ms buckets up to 100 ms, and one for all
+ * longer ones: percentiles come out to a bucket, and adding is a
+ * division and an increment.
+ */
+class LatencyHistogram {
+  public:
+    static constexpr double   kBucketMs    = 0.25;
+    static constexpr uint32_t kBucketCount = 400;
+
+    void Add(double milliseconds);
+
+    uint64_t GetCount() const { return m_Count; }
+    double   GetMean() const { return m_Count ? m_SumMs / m_Count : 0.0; }
+    double   GetMax() const { return m_MaxMs; }
+    // Upper edge of the bucket the `percentile` (0 to 100) falls in.
+    double GetPercentile(double percentile) const;
+    // kBucketCount + 1 counts; the last one is everything longer.
+    const std::array<uint32_t, kBucketCount + 1> &GetBuckets() const {
+        return m_Buckets;
+    }
+
+  private:
+    std::array<uint32_t, kBucketCount + 1> m_Buckets{};
+    uint64_t                               m_Count = 0;
+    double                                 m_SumMs = 0.0;
+    double                                 m_MaxMs = 0.0;
+};
+
+struct LatencyStats {
+    uint64_t Frames  = 0; // frames that had input
+    uint64_t Events  = 0;
+    uint64_t Dropped = 0; // events over a frame's capacity, not measured
+    // From the oldest input of a frame to each stage.
+    std::array<LatencyHistogram, size_t(FrameStage::Count)> PerFrame;
+    // From every input event to each stage of its frame, by kind.
+    std::array<std::array<LatencyHistogram, size_t(FrameStage::Count)>,
+               size_t(InputKind::Count)>
+        PerKind;
+};
+
+struct LatencySpecification {
+    // Writes every histogram as CSV here at shutdown, and logs a
+    // summary; for headless and automated runs. Empty: neither.
+    std::string ReportPath;
+    // Clicks the left mouse button through SDL_PushEvent every this
+    // many frames (0: never), so a run can measure without a person.
+    uint32_t InjectInterval = 0;
+};
+
+/*
+ * Measures input-to-photon latency.
+ *
+ * Every input event is stamped with its SDL timestamp (the same
+ * nanosecond clock as SDL_GetTicksNS()) and attached to the frame that
+ * consumes it. The frame then carries its id through the stages: the
+ * application marks Update and Submit, and the renderer that submits
+ * the swapchain hands over the fence of that submission. A thread of
+ * the tracker waits on it and stamps Present the moment it signals,
+ * rather than whenever the main thread next looks. A frame's latencies
+ * go into the histograms once it is presented, or at the next frame
+ * when nothing tracks its present.
+ */
+class LatencyTracker {
+  public:
+    explicit LatencyTracker(
+        const LatencySpecification &specification = LatencySpecification());
+    ~LatencyTracker();
+
+    LatencyTracker(const LatencyTracker &)            = delete;
+    LatencyTracker &operator=(const LatencyTracker &) = delete;
+
+    // Every event, while pumping; only input events are kept.
+    void RecordEvent(const SDL_Event &event);
+    // The events recorded since the last call belong to `frame`.
+    void BeginFrame(uint64_t frame);
+    void MarkUpdated() { Mark(FrameStage::Update); }
+    void MarkSubmitted() { Mark(FrameStage::Submit); }
+    // Takes ownership of the fence of the current frame's present; with
+    // several, the frame is presented when the last one signals.
+    void TrackPresent(SDL_GPUDevice *device, SDL_GPUFence *fence);
+
+    // Pushes a click at `x`, `y` (window coordinates) onto the SDL event
+    // queue, stamped now, as if the user made it.
+    static bool InjectClick(SDL_WindowID window, float x, float y);
+    // Once per frame: injects when InjectInterval says so.
+    void InjectIfDue(SDL_WindowID window, float x, float y);
+
+    const LatencyStats &GetStats() const { return m_Stats; }
+    void                LogStats() const;
+    bool                WriteReport(const char *path) const;
+
+    const LatencySpecification &GetSpecification() const {
+        return m_Specification;
+    }
+
+  private:
+    static constexpr uint32_t kMaxEvents         = 256; // per frame
+    static constexpr uint32_t kMaxFramesInFlight = 8;
+
+    struct Event {
+        uint64_t  Timestamp; // ns
+        InputKind Kind;
+    };
+
+    struct FrameRecord {
+        using StageTimes = std::array<uint64_t, size_t(FrameStage::Count)>;
+
+        uint64_t                      Frame = 0;
+        std::array<Event, kMaxEvents> Events;
+        uint32_t                      EventCount = 0;
+        StageTimes                    Stages{}; // ns, 0 until reached
+        uint32_t                      Fences = 0; // not signaled yet
+        bool                          Active = false;
+    };
+
+    struct PendingFence {
+        SDL_GPUDevice *Device;
+        SDL_GPUFence  *Fence;
+        uint64_t       Frame;
+    };
+
+    struct Presented {
+        uint64_t Frame;
+        uint64_t Timestamp; // ns
+    };
+
+    void Mark(FrameStage stage);
+    void Poll();
+    void Finish(FrameRecord &record);
+    void PresentThreadMain();
+
+    LatencySpecification m_Specification;
+    LatencyStats         m_Stats;
+
+    // Events of the frame being pumped, then a ring of frames in
+    // flight: m_Current is the newest, the others wait for a fence.
+    FrameRecord                                 m_Pending;
+    std::array<FrameRecord, kMaxFramesInFlight> m_Frames;
+    uint32_t                                    m_Current    = 0;
+    uint64_t                                    m_FrameCount = 0;
+
+    // Started by the first TrackPresent(); owns the fences handed to it.
+    std::thread              m_PresentThread;
+    std::mutex               m_PresentMutex;
+    std::condition_variable  m_PresentWake;
+    std::deque<PendingFence> m_Fences;    // guarded by m_PresentMutex
+    std::vector<Presented>   m_Presented; // guarded by m_PresentMutex
+    std::vector<Presented>   m_PresentedScratch;
+    bool                     m_Stopping = false;
+};
+
+} // namespace brnCore
@@ -3,11 +3,18 @@
 #include "Application.h"
 
 namespace brnCore {
+Arena &Layer::CreateArena(const ArenaSpecification &spec) {
+    m_Arena = std::make_unique<Arena>(spec);
+    return *m_Arena;
+}
+
 void Layer::QueueTransition(std::unique_ptr<Layer> toLayer) {
     // TODO: don't do this; make it async rather than immediate
     auto &layerStack = Application::Get().m_LayerStack;
     for (auto &layer : layerStack) {
         if (layer.get() == this) {
+            // Destroying the outgoing layer drops its arena, freeing the
+            // level's allocations chunk by chunk instead of object by object.
             layer = std::move(toLayer);
             return;
         }
@@ -4,12 +4,17 @@
 
 #include <memory>
 
+#include "Engine/Core/Arena.h"
+
 namespace brnCore {
 class Layer {
   public:
     virtual ~Layer() = default;
 
     virtual void OnEvent(SDL_Event &event) {}
+    // Called zero or more times per frame with a constant step, before
+    // OnUpdate; simulation (physics) goes here.
+    virtual void OnFixedUpdate(float fixedTimestep) {}
     virtual void OnUpdate(float ts) {}
     virtual void OnRender() {}
 
@@ -19,7 +24,20 @@ class Layer {
             std::move(std::make_unique<T>(std::forward<Args>(args)...)));
     }
 
+    // Null unless the layer called CreateArena().
+    Arena *GetArena() const { return m_Arena.get(); }
+
+  protected:
+    /*
+     * Gives the layer an arena for its long-lived (level) data. It is
+     * destroyed after the derived layer's members, so they may safely
+     * point into it, and released in one go when the layer is replaced.
+     */
+    Arena &CreateArena(const ArenaSpecification &spec = ArenaSpecification());
+
   private:
     void QueueTransition(std::unique_ptr<Layer> layer);
+
+    std::unique_ptr<Arena> m_Arena;
 };
 } // namespace brnCore
@@ -0,0 +1,163 @@
+#include "MappedFile.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace brnCore {
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        Close();
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+#if defined(_WIN32)
+        m_File    = std::exchange(other.m_File, nullptr);
+        m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const char *path) {
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path,
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "MappedFile: cannot open %s", path);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "MappedFile: %s is empty", path);
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *data =
+        mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "MappedFile: cannot map %s", path);
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File    = file;
+    m_Mapping = mapping;
+    m_Data    = static_cast<const std::byte *>(data);
+    m_Size    = static_cast<size_t>(size.QuadPart);
+#elif defined(__unix__) || defined(__APPLE__)
+    const int file = open(path, O_RDONLY);
+    if (file < 0) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "MappedFile: cannot open %s", path);
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "MappedFile: %s is empty", path);
+        close(file);
+        return false;
+    }
+
+    // The mapping keeps the file alive; the descriptor is not needed.
+    const size_t size = static_cast<size_t>(status.st_size);
+    void        *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "MappedFile: cannot map %s", path);
+        return false;
+    }
+
+    m_Data = static_cast<const std::byte *>(data);
+    m_Size = size;
+#else
+    size_t size = 0;
+    void  *data = SDL_LoadFile(path, &size);
+    if (!data || size == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "MappedFile: cannot read %s: %s",
+                     path,
+                     SDL_GetError());
+        SDL_free(data);
+        return false;
+    }
+
+    m_Data = static_cast<const std::byte *>(data);
+    m_Size = size;
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+    if (!m_Data) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_Mapping);
+    CloseHandle(m_File);
+    m_Mapping = nullptr;
+    m_File    = nullptr;
+#elif defined(__unix__) || defined(__APPLE__)
+    munmap(const_cast<std::byte *>(m_Data), m_Size);
+#else
+    SDL_free(const_cast<std::byte *>(m_Data));
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+void MappedFile::Prefetch() const {
+    if (!m_Data) {
+        return;
+    }
+
+#if defined(_WIN32)
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<std::byte *>(m_Data), m_Size};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#elif defined(__unix__) || defined(__APPLE__)
+    madvise(const_cast<std::byte *>(m_Data), m_Size, MADV_WILLNEED);
+#endif
+}
+
+} // namespace brnCore
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace brnCore {
+
+/*
+ * Read-only view of a whole file mapped into memory. Pages are loaded on
+ * first touch, so opening is O(1) and reading costs what paging the bytes
+ * in costs; nothing is copied or parsed up front.
+ *
+ * Platforms without mmap read the file into memory instead.
+ */
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Closes any previous mapping. Logs and returns false on failure.
+    bool Open(const char *path);
+    void Close();
+
+    // Hint that the whole file is about to be read front to back.
+    void Prefetch() const;
+
+    bool             IsOpen() const { return m_Data != nullptr; }
+    const std::byte *GetData() const { return m_Data; }
+    size_t           GetSize() const { return m_Size; }
+
+    std::span<const std::byte> GetBytes() const { return {m_Data, m_Size}; }
+
+  private:
+    const std::byte *m_Data = nullptr;
+    size_t           m_Size = 0;
+#if defined(_WIN32)
+    void *m_File    = nullptr;
+    void *m_Mapping = nullptr;
+#endif
+};
+
+} // namespace brnCore
@@ -0,0 +1,803 @@
+#include "MathKernels.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BRN_MATH_X86 1
+#include <immintrin.h>
+// GCC and Clang only emit instructions past SSE2 in functions that ask
+// for them; MSVC emits any intrinsic anywhere. Every CPU with AVX2 also
+// has FMA, which SDL has no query for. The AVX2 functions clear the
+// upper halves before their scalar tails, as the mixer's do.
+#if defined(__GNUC__) || defined(__clang__)
+#define BRN_MATH_SSE42  __attribute__((target("sse4.2")))
+#define BRN_MATH_AVX2   __attribute__((target("avx2,fma")))
+#define BRN_MATH_AVX512 __attribute__((target("avx512f")))
+#else
+#define BRN_MATH_SSE42
+#define BRN_MATH_AVX2
+#define BRN_MATH_AVX512
+#endif
+#endif
+
+namespace brnCore {
+
+namespace {
+// Above this the two rotations are taken as equal and blended, as glm.
+constexpr float kSlerpLinear = 1.0f - std::numeric_limits<float>::epsilon();
+
+/*
+ * acos(x) for x in [0, 1] as sqrt(1 - x) times a polynomial (Abramowitz
+ * and Stegun 4.4.46, within 2e-8), and sin(x) for x in [0, pi / 2] by
+ * its series to x^11 (within 6e-8). Every version evaluates them in the
+ * same order.
+ */
+constexpr float kAcos[8] = {1.5707963050f,
+                            -0.2145988016f,
+                            0.0889789874f,
+                            -0.0501743046f,
+                            0.0308918810f,
+                            -0.0170881256f,
+                            0.0066700901f,
+                            -0.0012624911f};
+constexpr float kSin[5]  = {-1.0f / 6.0f,
+                            1.0f / 120.0f,
+                            -1.0f / 5040.0f,
+                            1.0f / 362880.0f,
+                            -1.0f / 39916800.0f};
+
+float AcosScalar(float x) {
+    float p = kAcos[7];
+    for (int k = 6; k >= 0; k--) {
+        p = p * x + kAcos[k];
+    }
+    return std::sqrt(1.0f - x) * p;
+}
+
+float SinScalar(float x) {
+    const float x2 = x * x;
+    float       p  = kSin[4];
+    for (int k = 3; k >= 0; k--) {
+        p = p * x2 + kSin[k];
+    }
+    return x + x * x2 * p;
+}
+
+/*
+ * Scalar versions, from element `first` on: the whole job without SIMD,
+ * and the tails the vector loops leave.
+ */
+void TransformVec4From(const float *m,
+                       Vec4Arrays   input,
+                       Vec4Arrays   output,
+                       uint32_t     first,
+                       uint32_t     count) {
+    for (uint32_t i = first; i < count; i++) {
+        const float x = input.X[i];
+        const float y = input.Y[i];
+        const float z = input.Z[i];
+        const float w = input.W ? input.W[i] : 1.0f;
+        output.X[i]   = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+        output.Y[i]   = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+        output.Z[i]   = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+        if (output.W) {
+            output.W[i] = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
+        }
+    }
+}
+
+void TransformAabbsFrom(const float *m,
+                        Vec3Arrays   centers,
+                        Vec3Arrays   extents,
+                        Vec3Arrays   outputCenters,
+                        Vec3Arrays   outputExtents,
+                        uint32_t     first,
+                        uint32_t     count) {
+    float a[12];
+    for (int j = 0; j < 12; j++) {
+        a[j] = std::abs(m[j]);
+    }
+    for (uint32_t i = first; i < count; i++) {
+        const float cx     = centers.X[i];
+        const float cy     = centers.Y[i];
+        const float cz     = centers.Z[i];
+        const float ex     = extents.X[i];
+        const float ey     = extents.Y[i];
+        const float ez     = extents.Z[i];
+        outputCenters.X[i] = m[0] * cx + m[4] * cy + m[8] * cz + m[12];
+        outputCenters.Y[i] = m[1] * cx + m[5] * cy + m[9] * cz + m[13];
+        outputCenters.Z[i] = m[2] * cx + m[6] * cy + m[10] * cz + m[14];
+        outputExtents.X[i] = a[0] * ex + a[4] * ey + a[8] * ez;
+        outputExtents.Y[i] = a[1] * ex + a[5] * ey + a[9] * ez;
+        outputExtents.Z[i] = a[2] * ex + a[6] * ey + a[10] * ez;
+    }
+}
+
+void NormalizeQuatsFrom(Vec4Arrays q, uint32_t first, uint32_t count) {
+    for (uint32_t i = first; i < count; i++) {
+        const float x      = q.X[i];
+        const float y      = q.Y[i];
+        const float z      = q.Z[i];
+        const float w      = q.W[i];
+        const float length = std::sqrt((w * w + x * x) + (y * y + z * z));
+        if (length > 0.0f) {
+            const float inverse = 1.0f / length;
+            q.X[i]              = x * inverse;
+            q.Y[i]              = y * inverse;
+            q.Z[i]              = z * inverse;
+            q.W[i]              = w * inverse;
+        } else {
+            q.X[i] = q.Y[i] = q.Z[i] = 0.0f;
+            q.W[i]                   = 1.0f;
+        }
+    }
+}
+
+void SlerpQuatsFrom(Vec4Arrays   from,
+                    Vec4Arrays   to,
+                    const float *t,
+                    Vec4Arrays   output,
+                    uint32_t     first,
+                    uint32_t     count) {
+    for (uint32_t i = first; i < count; i++) {
+        float tx = to.X[i];
+        float ty = to.Y[i];
+        float tz = to.Z[i];
+        float tw = to.W[i];
+        float d  = (from.W[i] * tw + from.X[i] * tx) +
+                   (from.Y[i] * ty + from.Z[i] * tz);
+        if (d < 0.0f) {
+            tx = -tx;
+            ty = -ty;
+            tz = -tz;
+            tw = -tw;
+            d  = -d;
+        }
+
+        float a = 1.0f - t[i];
+        float b = t[i];
+        if (!(d > kSlerpLinear)) {
+            const float theta   = AcosScalar(d);
+            const float inverse = 1.0f / SinScalar(theta);
+            a                   = SinScalar(a * theta) * inverse;
+            b                   = SinScalar(b * theta) * inverse;
+        }
+        output.X[i] = a * from.X[i] + b * tx;
+        output.Y[i] = a * from.Y[i] + b * ty;
+        output.Z[i] = a * from.Z[i] + b * tz;
+        output.W[i] = a * from.W[i] + b * tw;
+    }
+}
+
+void TransformVec4Scalar(const float *matrix,
+                         Vec4Arrays   input,
+                         Vec4Arrays   output,
+                         uint32_t     count) {
+    TransformVec4From(matrix, input, output, 0, count);
+}
+
+void TransformAabbsScalar(const float *matrix,
+                          Vec3Arrays   centers,
+                          Vec3Arrays   extents,
+                          Vec3Arrays   outputCenters,
+                          Vec3Arrays   outputExtents,
+                          uint32_t     count) {
+    TransformAabbsFrom(
+        matrix, centers, extents, outputCenters, outputExtents, 0, count);
+}
+
+void NormalizeQuatsScalar(Vec4Arrays quats, uint32_t count) {
+    NormalizeQuatsFrom(quats, 0, count);
+}
+
+void SlerpQuatsScalar(Vec4Arrays   from,
+                      Vec4Arrays   to,
+                      const float *t,
+                      Vec4Arrays   output,
+                      uint32_t     count) {
+    SlerpQuatsFrom(from, to, t, output, 0, count);
+}
+
+#if defined(BRN_MATH_X86)
+/*
+ * SSE4.2: four elements at a time. Nothing here needs more than SSE4.1
+ * (blendv); SSE4.2 is what SDL reports and what every such CPU has.
+ */
+BRN_MATH_SSE42 __m128 AcosSse42(__m128 x) {
+    __m128 p = _mm_set1_ps(kAcos[7]);
+    for (int k = 6; k >= 0; k--) {
+        p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(kAcos[k]));
+    }
+    return _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)), p);
+}
+
+BRN_MATH_SSE42 __m128 SinSse42(__m128 x) {
+    const __m128 x2 = _mm_mul_ps(x, x);
+    __m128       p  = _mm_set1_ps(kSin[4]);
+    for (int k = 3; k >= 0; k--) {
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(kSin[k]));
+    }
+    return _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), p));
+}
+
+// m[row] * x + m[4 + row] * y + m[8 + row] * z + m[12 + row] * w
+BRN_MATH_SSE42 __m128 RowSse42(const __m128 *m,
+                               int           row,
+                               __m128        x,
+                               __m128        y,
+                               __m128        z,
+                               __m128        w) {
+    __m128 sum = _mm_mul_ps(m[row], x);
+    sum        = _mm_add_ps(sum, _mm_mul_ps(m[4 + row], y));
+    sum        = _mm_add_ps(sum, _mm_mul_ps(m[8 + row], z));
+    return _mm_add_ps(sum, _mm_mul_ps(m[12 + row], w));
+}
+
+BRN_MATH_SSE42 void TransformVec4Sse42(const float *matrix,
+                                       Vec4Arrays   input,
+                                       Vec4Arrays   output,
+                                       uint32_t     count) {
+    __m128 m[16];
+    for (int j = 0; j < 16; j++) {
+        m[j] = _mm_set1_ps(matrix[j]);
+    }
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(input.X + i);
+        const __m128 y = _mm_loadu_ps(input.Y + i);
+        const __m128 z = _mm_loadu_ps(input.Z + i);
+        const __m128 w = input.W ? _mm_loadu_ps(input.W + i)
+                                 : _mm_set1_ps(1.0f);
+        const __m128 ox = RowSse42(m, 0, x, y, z, w);
+        const __m128 oy = RowSse42(m, 1, x, y, z, w);
+        const __m128 oz = RowSse42(m, 2, x, y, z, w);
+        if (output.W) {
+            _mm_storeu_ps(output.W + i, RowSse42(m, 3, x, y, z, w));
+        }
+        _mm_storeu_ps(output.X + i, ox);
+        _mm_storeu_ps(output.Y + i, oy);
+        _mm_storeu_ps(output.Z + i, oz);
+    }
+    TransformVec4From(matrix, input, output, i, count);
+}
+
+BRN_MATH_SSE42 void TransformAabbsSse42(const float *matrix,
+                                        Vec3Arrays   centers,
+                                        Vec3Arrays   extents,
+                                        Vec3Arrays   outputCenters,
+                                        Vec3Arrays   outputExtents,
+                                        uint32_t     count) {
+    __m128 m[16];
+    __m128 a[16];
+    for (int j = 0; j < 16; j++) {
+        m[j] = _mm_set1_ps(matrix[j]);
+        a[j] = _mm_set1_ps(std::abs(matrix[j]));
+    }
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(centers.X + i);
+        const __m128 cy = _mm_loadu_ps(centers.Y + i);
+        const __m128 cz = _mm_loadu_ps(centers.Z + i);
+        const __m128 ex = _mm_loadu_ps(extents.X + i);
+        const __m128 ey = _mm_loadu_ps(extents.Y + i);
+        const __m128 ez = _mm_loadu_ps(extents.Z + i);
+        // The extent's w is 0, so the translation column drops out.
+        _mm_storeu_ps(outputCenters.X + i, RowSse42(m, 0, cx, cy, cz, one));
+        _mm_storeu_ps(outputCenters.Y + i, RowSse42(m, 1, cx, cy, cz, one));
+        _mm_storeu_ps(outputCenters.Z + i, RowSse42(m, 2, cx, cy, cz, one));
+        _mm_storeu_ps(outputExtents.X + i,
+                      RowSse42(a, 0, ex, ey, ez, zero));
+        _mm_storeu_ps(outputExtents.Y + i,
+                      RowSse42(a, 1, ex, ey, ez, zero));
+        _mm_storeu_ps(outputExtents.Z + i,
+                      RowSse42(a, 2, ex, ey, ez, zero));
+    }
+    TransformAabbsFrom(
+        matrix, centers, extents, outputCenters, outputExtents, i, count);
+}
+
+BRN_MATH_SSE42 void NormalizeQuatsSse42(Vec4Arrays q, uint32_t count) {
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x      = _mm_loadu_ps(q.X + i);
+        const __m128 y      = _mm_loadu_ps(q.Y + i);
+        const __m128 z      = _mm_loadu_ps(q.Z + i);
+        const __m128 w      = _mm_loadu_ps(q.W + i);
+        const __m128 length = _mm_sqrt_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)),
+                       _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z))));
+        const __m128 valid   = _mm_cmpgt_ps(length, _mm_setzero_ps());
+        const __m128 inverse = _mm_div_ps(one, length);
+        _mm_storeu_ps(q.X + i, _mm_and_ps(_mm_mul_ps(x, inverse), valid));
+        _mm_storeu_ps(q.Y + i, _mm_and_ps(_mm_mul_ps(y, inverse), valid));
+        _mm_storeu_ps(q.Z + i, _mm_and_ps(_mm_mul_ps(z, inverse), valid));
+        _mm_storeu_ps(q.W + i,
+                      _mm_blendv_ps(one, _mm_mul_ps(w, inverse), valid));
+    }
+    NormalizeQuatsFrom(q, i, count);
+}
+
+BRN_MATH_SSE42 void SlerpQuatsSse42(Vec4Arrays   from,
+                                    Vec4Arrays   to,
+                                    const float *t,
+                                    Vec4Arrays   output,
+                                    uint32_t     count) {
+    const __m128 one    = _mm_set1_ps(1.0f);
+    const __m128 sign   = _mm_set1_ps(-0.0f);
+    const __m128 linear = _mm_set1_ps(kSlerpLinear);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 fx = _mm_loadu_ps(from.X + i);
+        const __m128 fy = _mm_loadu_ps(from.Y + i);
+        const __m128 fz = _mm_loadu_ps(from.Z + i);
+        const __m128 fw = _mm_loadu_ps(from.W + i);
+        __m128       tx = _mm_loadu_ps(to.X + i);
+        __m128       ty = _mm_loadu_ps(to.Y + i);
+        __m128       tz = _mm_loadu_ps(to.Z + i);
+        __m128       tw = _mm_loadu_ps(to.W + i);
+        __m128       d  = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(fw, tw), _mm_mul_ps(fx, tx)),
+            _mm_add_ps(_mm_mul_ps(fy, ty), _mm_mul_ps(fz, tz)));
+
+        // The shorter way round: flips `to` where the dot is negative.
+        const __m128 flip = _mm_and_ps(d, sign);
+        tx                = _mm_xor_ps(tx, flip);
+        ty                = _mm_xor_ps(ty, flip);
+        tz                = _mm_xor_ps(tz, flip);
+        tw                = _mm_xor_ps(tw, flip);
+        d                 = _mm_xor_ps(d, flip);
+
+        const __m128 b       = _mm_loadu_ps(t + i);
+        const __m128 a       = _mm_sub_ps(one, b);
+        const __m128 theta   = AcosSse42(d);
+        const __m128 inverse = _mm_div_ps(one, SinSse42(theta));
+        const __m128 blend   = _mm_cmpgt_ps(d, linear);
+        const __m128 wa      = _mm_blendv_ps(
+            _mm_mul_ps(SinSse42(_mm_mul_ps(a, theta)), inverse), a, blend);
+        const __m128 wb = _mm_blendv_ps(
+            _mm_mul_ps(SinSse42(_mm_mul_ps(b, theta)), inverse), b, blend);
+
+        _mm_storeu_ps(output.X + i,
+                      _mm_add_ps(_mm_mul_ps(wa, fx), _mm_mul_ps(wb, tx)));
+        _mm_storeu_ps(output.Y + i,
+                      _mm_add_ps(_mm_mul_ps(wa, fy), _mm_mul_ps(wb, ty)));
+        _mm_storeu_ps(output.Z + i,
+                      _mm_add_ps(_mm_mul_ps(wa, fz), _mm_mul_ps(wb, tz)));
+        _mm_storeu_ps(output.W + i,
+                      _mm_add_ps(_mm_mul_ps(wa, fw), _mm_mul_ps(wb, tw)));
+    }
+    SlerpQuatsFrom(from, to, t, output, i, count);
+}
+
+// AVX2: eight elements at a time, with fused multiply-adds.
+BRN_MATH_AVX2 __m256 AcosAvx2(__m256 x) {
+    __m256 p = _mm256_set1_ps(kAcos[7]);
+    for (int k = 6; k >= 0; k--) {
+        p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(kAcos[k]));
+    }
+    return _mm256_mul_ps(
+        _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x)), p);
+}
+
+BRN_MATH_AVX2 __m256 SinAvx2(__m256 x) {
+    const __m256 x2 = _mm256_mul_ps(x, x);
+    __m256       p  = _mm256_set1_ps(kSin[4]);
+    for (int k = 3; k >= 0; k--) {
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(kSin[k]));
+    }
+    return _mm256_fmadd_ps(_mm256_mul_ps(x, x2), p, x);
+}
+
+BRN_MATH_AVX2 __m256 RowAvx2(const __m256 *m,
+                             int           row,
+                             __m256        x,
+                             __m256        y,
+                             __m256        z,
+                             __m256        w) {
+    __m256 sum = _mm256_mul_ps(m[row], x);
+    sum        = _mm256_fmadd_ps(m[4 + row], y, sum);
+    sum        = _mm256_fmadd_ps(m[8 + row], z, sum);
+    return _mm256_fmadd_ps(m[12 + row], w, sum);
+}
+
+BRN_MATH_AVX2 void TransformVec4Avx2(const float *matrix,
+                                     Vec4Arrays   input,
+                                     Vec4Arrays   output,
+                                     uint32_t     count) {
+    __m256 m[16];
+    for (int j = 0; j < 16; j++) {
+        m[j] = _mm256_set1_ps(matrix[j]);
+    }
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(input.X + i);
+        const __m256 y = _mm256_loadu_ps(input.Y + i);
+        const __m256 z = _mm256_loadu_ps(input.Z + i);
+        const __m256 w = input.W ? _mm256_loadu_ps(input.W + i)
+                                 : _mm256_set1_ps(1.0f);
+        const __m256 ox = RowAvx2(m, 0, x, y, z, w);
+        const __m256 oy = RowAvx2(m, 1, x, y, z, w);
+        const __m256 oz = RowAvx2(m, 2, x, y, z, w);
+        if (output.W) {
+            _mm256_storeu_ps(output.W + i, RowAvx2(m, 3, x, y, z, w));
+        }
+        _mm256_storeu_ps(output.X + i, ox);
+        _mm256_storeu_ps(output.Y + i, oy);
+        _mm256_storeu_ps(output.Z + i, oz);
+    }
+    _mm256_zeroupper();
+    TransformVec4From(matrix, input, output, i, count);
+}
+
+BRN_MATH_AVX2 void TransformAabbsAvx2(const float *matrix,
+                                      Vec3Arrays   centers,
+                                      Vec3Arrays   extents,
+                                      Vec3Arrays   outputCenters,
+                                      Vec3Arrays   outputExtents,
+                                      uint32_t     count) {
+    __m256 m[16];
+    __m256 a[16];
+    for (int j = 0; j < 16; j++) {
+        m[j] = _mm256_set1_ps(matrix[j]);
+        a[j] = _mm256_set1_ps(std::abs(matrix[j]));
+    }
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(centers.X + i);
+        const __m256 cy = _mm256_loadu_ps(centers.Y + i);
+        const __m256 cz = _mm256_loadu_ps(centers.Z + i);
+        const __m256 ex = _mm256_loadu_ps(extents.X + i);
+        const __m256 ey = _mm256_loadu_ps(extents.Y + i);
+        const __m256 ez = _mm256_loadu_ps(extents.Z + i);
+        _mm256_storeu_ps(outputCenters.X + i,
+                         RowAvx2(m, 0, cx, cy, cz, one));
+        _mm256_storeu_ps(outputCenters.Y + i,
+                         RowAvx2(m, 1, cx, cy, cz, one));
+        _mm256_storeu_ps(outputCenters.Z + i,
+                         RowAvx2(m, 2, cx, cy, cz, one));
+        _mm256_storeu_ps(outputExtents.X + i,
+                         RowAvx2(a, 0, ex, ey, ez, zero));
+        _mm256_storeu_ps(outputExtents.Y + i,
+                         RowAvx2(a, 1, ex, ey, ez, zero));
+        _mm256_storeu_ps(outputExtents.Z + i,
+                         RowAvx2(a, 2, ex, ey, ez, zero));
+    }
+    _mm256_zeroupper();
+    TransformAabbsFrom(
+        matrix, centers, extents, outputCenters, outputExtents, i, count);
+}
+
+BRN_MATH_AVX2 void NormalizeQuatsAvx2(Vec4Arrays q, uint32_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x      = _mm256_loadu_ps(q.X + i);
+        const __m256 y      = _mm256_loadu_ps(q.Y + i);
+        const __m256 z      = _mm256_loadu_ps(q.Z + i);
+        const __m256 w      = _mm256_loadu_ps(q.W + i);
+        const __m256 length = _mm256_sqrt_ps(
+            _mm256_add_ps(_mm256_fmadd_ps(x, x, _mm256_mul_ps(w, w)),
+                          _mm256_fmadd_ps(z, z, _mm256_mul_ps(y, y))));
+        const __m256 valid =
+            _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ);
+        const __m256 inverse = _mm256_div_ps(one, length);
+        _mm256_storeu_ps(q.X + i,
+                         _mm256_and_ps(_mm256_mul_ps(x, inverse), valid));
+        _mm256_storeu_ps(q.Y + i,
+                         _mm256_and_ps(_mm256_mul_ps(y, inverse), valid));
+        _mm256_storeu_ps(q.Z + i,
+                         _mm256_and_ps(_mm256_mul_ps(z, inverse), valid));
+        _mm256_storeu_ps(
+            q.W + i,
+            _mm256_blendv_ps(one, _mm256_mul_ps(w, inverse), valid));
+    }
+    _mm256_zeroupper();
+    NormalizeQuatsFrom(q, i, count);
+}
+
+BRN_MATH_AVX2 void SlerpQuatsAvx2(Vec4Arrays   from,
+                                  Vec4Arrays   to,
+                                  const float *t,
+                                  Vec4Arrays   output,
+                                  uint32_t     count) {
+    const __m256 one    = _mm256_set1_ps(1.0f);
+    const __m256 sign   = _mm256_set1_ps(-0.0f);
+    const __m256 linear = _mm256_set1_ps(kSlerpLinear);
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 fx = _mm256_loadu_ps(from.X + i);
+        const __m256 fy = _mm256_loadu_ps(from.Y + i);
+        const __m256 fz = _mm256_loadu_ps(from.Z + i);
+        const __m256 fw = _mm256_loadu_ps(from.W + i);
+        __m256       tx = _mm256_loadu_ps(to.X + i);
+        __m256       ty = _mm256_loadu_ps(to.Y + i);
+        __m256       tz = _mm256_loadu_ps(to.Z + i);
+        __m256       tw = _mm256_loadu_ps(to.W + i);
+        __m256       d  = _mm256_add_ps(
+            _mm256_fmadd_ps(fx, tx, _mm256_mul_ps(fw, tw)),
+            _mm256_fmadd_ps(fz, tz, _mm256_mul_ps(fy, ty)));
+
+        const __m256 flip = _mm256_and_ps(d, sign);
+        tx                = _mm256_xor_ps(tx, flip);
+        ty                = _mm256_xor_ps(ty, flip);
+        tz                = _mm256_xor_ps(tz, flip);
+        tw                = _mm256_xor_ps(tw, flip);
+        d                 = _mm256_xor_ps(d, flip);
+
+        const __m256 b       = _mm256_loadu_ps(t + i);
+        const __m256 a       = _mm256_sub_ps(one, b);
+        const __m256 theta   = AcosAvx2(d);
+        const __m256 inverse = _mm256_div_ps(one, SinAvx2(theta));
+        const __m256 blend   = _mm256_cmp_ps(d, linear, _CMP_GT_OQ);
+        const __m256 wa      = _mm256_blendv_ps(
+            _mm256_mul_ps(SinAvx2(_mm256_mul_ps(a, theta)), inverse),
+            a,
+            blend);
+        const __m256 wb = _mm256_blendv_ps(
+            _mm256_mul_ps(SinAvx2(_mm256_mul_ps(b, theta)), inverse),
+            b,
+            blend);
+
+        _mm256_storeu_ps(output.X + i,
+                         _mm256_fmadd_ps(wb, tx, _mm256_mul_ps(wa, fx)));
+        _mm256_storeu_ps(output.Y + i,
+                         _mm256_fmadd_ps(wb, ty, _mm256_mul_ps(wa, fy)));
+        _mm256_storeu_ps(output.Z + i,
+                         _mm256_fmadd_ps(wb, tz, _mm256_mul_ps(wa, fz)));
+        _mm256_storeu_ps(output.W + i,
+                         _mm256_fmadd_ps(wb, tw, _mm256_mul_ps(wa, fw)));
+    }
+    _mm256_zeroupper();
+    SlerpQuatsFrom(from, to, t, output, i, count);
+}
+
+/*
+ * AVX-512: sixteen elements at a time. Masked loads and stores take the
+ * tail too, so there is no scalar loop; masked off lanes compute on
+ * zeros and are never stored.
+ */
+BRN_MATH_AVX512 __mmask16 TailMask(uint32_t i, uint32_t count) {
+    return count - i >= 16 ? __mmask16(0xffff)
+                           : static_cast<__mmask16>((1u << (count - i)) - 1);
+}
+
+BRN_MATH_AVX512 __m512 AcosAvx512(__m512 x) {
+    __m512 p = _mm512_set1_ps(kAcos[7]);
+    for (int k = 6; k >= 0; k--) {
+        p = _mm512_fmadd_ps(p, x, _mm512_set1_ps(kAcos[k]));
+    }
+    return _mm512_mul_ps(
+        _mm512_sqrt_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), x)), p);
+}
+
+BRN_MATH_AVX512 __m512 SinAvx512(__m512 x) {
+    const __m512 x2 = _mm512_mul_ps(x, x);
+    __m512       p  = _mm512_set1_ps(kSin[4]);
+    for (int k = 3; k >= 0; k--) {
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(kSin[k]));
+    }
+    return _mm512_fmadd_ps(_mm512_mul_ps(x, x2), p, x);
+}
+
+BRN_MATH_AVX512 __m512 RowAvx512(const __m512 *m,
+                                 int           row,
+                                 __m512        x,
+                                 __m512        y,
+                                 __m512        z,
+                                 __m512        w) {
+    __m512 sum = _mm512_mul_ps(m[row], x);
+    sum        = _mm512_fmadd_ps(m[4 + row], y, sum);
+    sum        = _mm512_fmadd_ps(m[8 + row], z, sum);
+    return _mm512_fmadd_ps(m[12 + row], w, sum);
+}
+
+BRN_MATH_AVX512 void TransformVec4Avx512(const float *matrix,
+                                         Vec4Arrays   input,
+                                         Vec4Arrays   output,
+                                         uint32_t     count) {
+    __m512 m[16];
+    for (int j = 0; j < 16; j++) {
+        m[j] = _mm512_set1_ps(matrix[j]);
+    }
+
+    for (uint32_t i = 0; i < count; i += 16) {
+        const __mmask16 k = TailMask(i, count);
+        const __m512    x = _mm512_maskz_loadu_ps(k, input.X + i);
+        const __m512    y = _mm512_maskz_loadu_ps(k, input.Y + i);
+        const __m512    z = _mm512_maskz_loadu_ps(k, input.Z + i);
+        const __m512    w = input.W ? _mm512_maskz_loadu_ps(k, input.W + i)
+                                    : _mm512_set1_ps(1.0f);
+        const __m512 ox = RowAvx512(m, 0, x, y, z, w);
+        const __m512 oy = RowAvx512(m, 1, x, y, z, w);
+        const __m512 oz = RowAvx512(m, 2, x, y, z, w);
+        if (output.W) {
+            _mm512_mask_storeu_ps(
+                output.W + i, k, RowAvx512(m, 3, x, y, z, w));
+        }
+        _mm512_mask_storeu_ps(output.X + i, k, ox);
+        _mm512_mask_storeu_ps(output.Y + i, k, oy);
+        _mm512_mask_storeu_ps(output.Z + i, k, oz);
+    }
+}
+
+BRN_MATH_AVX512 void TransformAabbsAvx512(const float *matrix,
+                                          Vec3Arrays   centers,
+                                          Vec3Arrays   extents,
+                                          Vec3Arrays   outputCenters,
+                                          Vec3Arrays   outputExtents,
+                                          uint32_t     count) {
+    __m512 m[16];
+    __m512 a[16];
+    for (int j = 0; j < 16; j++) {
+        m[j] = _mm512_set1_ps(matrix[j]);
+        a[j] = _mm512_set1_ps(std::abs(matrix[j]));
+    }
+    const __m512 one  = _mm512_set1_ps(1.0f);
+    const __m512 zero = _mm512_setzero_ps();
+
+    for (uint32_t i = 0; i < count; i += 16) {
+        const __mmask16 k  = TailMask(i, count);
+        const __m512    cx = _mm512_maskz_loadu_ps(k, centers.X + i);
+        const __m512    cy = _mm512_maskz_loadu_ps(k, centers.Y + i);
+        const __m512    cz = _mm512_maskz_loadu_ps(k, centers.Z + i);
+        const __m512    ex = _mm512_maskz_loadu_ps(k, extents.X + i);
+        const __m512    ey = _mm512_maskz_loadu_ps(k, extents.Y + i);
+        const __m512    ez = _mm512_maskz_loadu_ps(k, extents.Z + i);
+        _mm512_mask_storeu_ps(
+            outputCenters.X + i, k, RowAvx512(m, 0, cx, cy, cz, one));
+        _mm512_mask_storeu_ps(
+            outputCenters.Y + i, k, RowAvx512(m, 1, cx, cy, cz, one));
+        _mm512_mask_storeu_ps(
+            outputCenters.Z + i, k, RowAvx512(m, 2, cx, cy, cz, one));
+        _mm512_mask_storeu_ps(
+            outputExtents.X + i, k, RowAvx512(a, 0, ex, ey, ez, zero));
+        _mm512_mask_storeu_ps(
+            outputExtents.Y + i, k, RowAvx512(a, 1, ex, ey, ez, zero));
+        _mm512_mask_storeu_ps(
+            outputExtents.Z + i, k, RowAvx512(a, 2, ex, ey, ez, zero));
+    }
+}
+
+BRN_MATH_AVX512 void NormalizeQuatsAvx512(Vec4Arrays q, uint32_t count) {
+    const __m512 one = _mm512_set1_ps(1.0f);
+
+    for (uint32_t i = 0; i < count; i += 16) {
+        const __mmask16 k      = TailMask(i, count);
+        const __m512    x      = _mm512_maskz_loadu_ps(k, q.X + i);
+        const __m512    y      = _mm512_maskz_loadu_ps(k, q.Y + i);
+        const __m512    z      = _mm512_maskz_loadu_ps(k, q.Z + i);
+        const __m512    w      = _mm512_maskz_loadu_ps(k, q.W + i);
+        const __m512    length = _mm512_sqrt_ps(
+            _mm512_add_ps(_mm512_fmadd_ps(x, x, _mm512_mul_ps(w, w)),
+                          _mm512_fmadd_ps(z, z, _mm512_mul_ps(y, y))));
+        const __mmask16 valid = _mm512_cmp_ps_mask(
+            length, _mm512_setzero_ps(), _CMP_GT_OQ);
+        const __m512 inverse = _mm512_div_ps(one, length);
+        _mm512_mask_storeu_ps(
+            q.X + i, k, _mm512_maskz_mul_ps(valid, x, inverse));
+        _mm512_mask_storeu_ps(
+            q.Y + i, k, _mm512_maskz_mul_ps(valid, y, inverse));
+        _mm512_mask_storeu_ps(
+            q.Z + i, k, _mm512_maskz_mul_ps(valid, z, inverse));
+        _mm512_mask_storeu_ps(
+            q.W + i, k, _mm512_mask_mul_ps(one, valid, w, inverse));
+    }
+}
+
+BRN_MATH_AVX512 void SlerpQuatsAvx512(Vec4Arrays   from,
+                                      Vec4Arrays   to,
+                                      const float *t,
+                                      Vec4Arrays   output,
+                                      uint32_t     count) {
+    const __m512 one    = _mm512_set1_ps(1.0f);
+    const __m512 linear = _mm512_set1_ps(kSlerpLinear);
+
+    for (uint32_t i = 0; i < count; i += 16) {
+        const __mmask16 k  = TailMask(i, count);
+        const __m512    fx = _mm512_maskz_loadu_ps(k, from.X + i);
+        const __m512    fy = _mm512_maskz_loadu_ps(k, from.Y + i);
+        const __m512    fz = _mm512_maskz_loadu_ps(k, from.Z + i);
+        const __m512    fw = _mm512_maskz_loadu_ps(k, from.W + i);
+        __m512          tx = _mm512_maskz_loadu_ps(k, to.X + i);
+        __m512          ty = _mm512_maskz_loadu_ps(k, to.Y + i);
+        __m512          tz = _mm512_maskz_loadu_ps(k, to.Z + i);
+        __m512          tw = _mm512_maskz_loadu_ps(k, to.W + i);
+        __m512          d  = _mm512_add_ps(
+            _mm512_fmadd_ps(fx, tx, _mm512_mul_ps(fw, tw)),
+            _mm512_fmadd_ps(fz, tz, _mm512_mul_ps(fy, ty)));
+
+        // AVX512F has no float xor: negates the flipped lanes instead.
+        const __mmask16 flip =
+            _mm512_cmp_ps_mask(d, _mm512_setzero_ps(), _CMP_LT_OQ);
+        const __m512 zero = _mm512_setzero_ps();
+        tx                = _mm512_mask_sub_ps(tx, flip, zero, tx);
+        ty                = _mm512_mask_sub_ps(ty, flip, zero, ty);
+        tz                = _mm512_mask_sub_ps(tz, flip, zero, tz);
+        tw                = _mm512_mask_sub_ps(tw, flip, zero, tw);
+        d                 = _mm512_mask_sub_ps(d, flip, zero, d);
+
+        const __m512    b       = _mm512_maskz_loadu_ps(k, t + i);
+        const __m512    a       = _mm512_sub_ps(one, b);
+        const __m512    theta   = AcosAvx512(d);
+        const __m512    inverse = _mm512_div_ps(one, SinAvx512(theta));
+        const __mmask16 blend   = _mm512_cmp_ps_mask(d, linear, _CMP_GT_OQ);
+        const __m512    wa      = _mm512_mask_blend_ps(
+            blend,
+            _mm512_mul_ps(SinAvx512(_mm512_mul_ps(a, theta)), inverse),
+            a);
+        const __m512 wb = _mm512_mask_blend_ps(
+            blend,
+            _mm512_mul_ps(SinAvx512(_mm512_mul_ps(b, theta)), inverse),
+            b);
+
+        _mm512_mask_storeu_ps(
+            output.X + i, k, _mm512_fmadd_ps(wb, tx, _mm512_mul_ps(wa, fx)));
+        _mm512_mask_storeu_ps(
+            output.Y + i, k, _mm512_fmadd_ps(wb, ty, _mm512_mul_ps(wa, fy)));
+        _mm512_mask_storeu_ps(
+            output.Z + i, k, _mm512_fmadd_ps(wb, tz, _mm512_mul_ps(wa, fz)));
+        _mm512_mask_storeu_ps(
+            output.W + i, k, _mm512_fmadd_ps(wb, tw, _mm512_mul_ps(wa, fw)));
+    }
+}
+#endif
+} // namespace
+
+std::span<const MathKernels> GetSupportedMathKernels() {
+    static const std::vector<MathKernels> kernels = [] {
+        std::vector<MathKernels> supported;
+#if defined(BRN_MATH_X86)
+        if (SDL_HasAVX512F()) {
+            supported.push_back({"AVX-512",
+                                 TransformVec4Avx512,
+                                 TransformAabbsAvx512,
+                                 NormalizeQuatsAvx512,
+                                 SlerpQuatsAvx512});
+        }
+        if (SDL_HasAVX2()) {
+            supported.push_back({"AVX2",
+                                 TransformVec4Avx2,
+                                 TransformAabbsAvx2,
+                                 NormalizeQuatsAvx2,
+                                 SlerpQuatsAvx2});
+        }
+        if (SDL_HasSSE42()) {
+            supported.push_back({"SSE4.2",
+                                 TransformVec4Sse42,
+                                 TransformAabbsSse42,
+                                 NormalizeQuatsSse42,
+                                 SlerpQuatsSse42});
+        }
+#endif
+        supported.push_back({"Scalar",
+                             TransformVec4Scalar,
+                             TransformAabbsScalar,
+                             NormalizeQuatsScalar,
+                             SlerpQuatsScalar});
+        return supported;
+    }();
+    return kernels;
+}
+
+const MathKernels &GetMathKernels() {
+    return GetSupportedMathKernels().front();
+}
+
+} // namespace brnCore
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace brnCore {
+
+/*
+ * Structure of arrays views: component i of element n is X[n], Y[n]...
+ * Inputs are only read through them. Quaternions are (X, Y, Z, W) with
+ * W the real part, as glm stores them.
+ */
+struct Vec3Arrays {
+    float *X;
+    float *Y;
+    float *Z;
+};
+
+struct Vec4Arrays {
+    float *X;
+    float *Y;
+    float *Z;
+    float *W;
+};
+
+/*
+ * Batched transform and bounds math, picked once for the CPU it runs on:
+ * AVX-512, AVX2 or SSE4.2, with a scalar fallback. Arrays need not be
+ * aligned; outputs may be the inputs. Matrices are 16 floats, column
+ * major like glm::mat4 (glm::value_ptr(m) fits).
+ *
+ * Results match glm's to float rounding: the AVX2 and AVX-512 versions
+ * fuse multiply-adds, and slerp uses polynomials for acos and sin that
+ * are within 1e-6 of the library functions.
+ */
+struct MathKernels {
+    const char *Name;
+
+    /*
+     * output = matrix * input for `count` vectors. A null input W is
+     * taken as 1, for points; a null output W is not written.
+     */
+    void (*TransformVec4)(const float *matrix,
+                          Vec4Arrays   input,
+                          Vec4Arrays   output,
+                          uint32_t     count);
+
+    /*
+     * Boxes as centers and half extents, through an affine `matrix`:
+     * the new boxes are the tightest axis-aligned ones around the
+     * transformed old ones (the center moves, the extent goes through
+     * the absolute value of the upper 3x3).
+     */
+    void (*TransformAabbs)(const float *matrix,
+                           Vec3Arrays   centers,
+                           Vec3Arrays   extents,
+                           Vec3Arrays   outputCenters,
+                           Vec3Arrays   outputExtents,
+                           uint32_t     count);
+
+    // In place; zero quaternions become the identity, as in glm.
+    void (*NormalizeQuats)(Vec4Arrays quats, uint32_t count);
+
+    /*
+     * output[n] = glm::slerp(from[n], to[n], t[n]): the shortest path,
+     * falling back to a linear blend when the two are almost equal.
+     * Inputs are unit quaternions and t is in [0, 1].
+     */
+    void (*SlerpQuats)(Vec4Arrays   from,
+                       Vec4Arrays   to,
+                       const float *t,
+                       Vec4Arrays   output,
+                       uint32_t     count);
+};
+
+// The fastest kernels this CPU runs, chosen on the first call.
+const MathKernels &GetMathKernels();
+
+// Every variant this CPU runs, fastest first, ending with the scalar one.
+std::span<const MathKernels> GetSupportedMathKernels();
+
+} // namespace brnCore
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+namespace brnCore {
+
+/*
+ * PCG32: small, fast, and the same sequence for the same seed on every
+ * platform and compiler, which std::uniform_*_distribution does not
+ * promise. Floats are built from integer bits, never from a division
+ * whose rounding could differ, so simulations replay bit for bit.
+ */
+class Random {
+  public:
+    explicit Random(uint64_t seed = 0) { Seed(seed); }
+
+    void Seed(uint64_t seed) {
+        m_Seed  = seed;
+        m_State = 0;
+        NextU32();
+        m_State += seed;
+        NextU32();
+    }
+    uint64_t GetSeed() const { return m_Seed; }
+
+    uint32_t NextU32() {
+        const uint64_t state = m_State;
+        m_State              = state * 6364136223846793005ull + kIncrement;
+        const auto xorShifted =
+            static_cast<uint32_t>(((state >> 18) ^ state) >> 27);
+        const auto rotation = static_cast<uint32_t>(state >> 59);
+        return (xorShifted >> rotation) | (xorShifted << (-rotation & 31));
+    }
+    uint64_t NextU64() {
+        const uint64_t high = NextU32();
+        return high << 32 | NextU32();
+    }
+
+    // In [0, 1).
+    float NextFloat() { return static_cast<float>(NextU32() >> 8) * 0x1p-24f; }
+    // In [min, max).
+    float Range(float min, float max) {
+        return min + (max - min) * NextFloat();
+    }
+    // In [min, max], without the bias of a modulo.
+    int32_t Range(int32_t min, int32_t max) {
+        const uint32_t span = static_cast<uint32_t>(max) -
+                              static_cast<uint32_t>(min) + 1;
+        if (span == 0) {
+            return static_cast<int32_t>(NextU32());
+        }
+        uint64_t product = uint64_t(NextU32()) * span;
+        if (static_cast<uint32_t>(product) < span) {
+            const uint32_t threshold = -span % span;
+            while (static_cast<uint32_t>(product) < threshold) {
+                product = uint64_t(NextU32()) * span;
+            }
+        }
+        return static_cast<int32_t>(static_cast<uint32_t>(min) +
+                                    static_cast<uint32_t>(product >> 32));
+    }
+    bool Chance(float probability) { return NextFloat() < probability; }
+
+  private:
+    static constexpr uint64_t kIncrement = 1442695040888963407ull;
+
+    uint64_t m_State = 0;
+    uint64_t m_Seed  = 0;
+};
+
+} // namespace brnCore
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace brnCore {
+
+/*
+ * Fixed capacity ring one producer thread writes to and one consumer
+ * thread reads from, without locks. Both sides run on 64-bit cursors
+ * that only ever grow; the producer publishes its cursor after copying
+ * in, the consumer its own after copying out, and each copy wraps at
+ * most once.
+ *
+ * Never allocates after construction, so the consumer may be the audio
+ * thread. T must be trivially copyable.
+ */
+template <typename T>
+class RingBuffer {
+  public:
+    // Rounded up to a power of two.
+    explicit RingBuffer(size_t capacity)
+        : m_Mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+          m_Items(std::make_unique<T[]>(m_Mask + 1)) {}
+
+    RingBuffer(const RingBuffer &)            = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    // Producer: copies in as much of `items` as fits, returns how much.
+    size_t Write(const T *items, size_t count) {
+        const uint64_t write = m_Write.load(std::memory_order_relaxed);
+        count                = std::min(count, GetWritable());
+        const size_t first   = GetFirstPart(write, count);
+        std::copy_n(items, first, m_Items.get() + GetOffset(write));
+        std::copy_n(items + first, count - first, m_Items.get());
+        m_Write.store(write + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer: copies out up to `count` items, returns how many.
+    size_t Read(T *items, size_t count) {
+        const uint64_t read = m_Read.load(std::memory_order_relaxed);
+        count               = std::min(count, GetReadable());
+        const size_t first  = GetFirstPart(read, count);
+        std::copy_n(m_Items.get() + GetOffset(read), first, items);
+        std::copy_n(m_Items.get(), count - first, items + first);
+        m_Read.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    /*
+     * Consumer: drops everything written before `cursor`, a value
+     * GetWriteCursor() returned, or all there is now. Lets the producer
+     * start over (after a seek) without touching what the consumer owns.
+     */
+    void SkipTo(uint64_t cursor) {
+        if (cursor > m_Read.load(std::memory_order_relaxed)) {
+            m_Read.store(cursor, std::memory_order_release);
+        }
+    }
+    void Clear() { SkipTo(m_Write.load(std::memory_order_acquire)); }
+
+    size_t GetWritable() const {
+        return GetCapacity() - static_cast<size_t>(
+                                   m_Write.load(std::memory_order_relaxed) -
+                                   m_Read.load(std::memory_order_acquire));
+    }
+    size_t GetReadable() const {
+        return static_cast<size_t>(m_Write.load(std::memory_order_acquire) -
+                                   m_Read.load(std::memory_order_relaxed));
+    }
+
+    // Items written (read) so far, ever.
+    uint64_t GetWriteCursor() const {
+        return m_Write.load(std::memory_order_relaxed);
+    }
+    uint64_t GetReadCursor() const {
+        return m_Read.load(std::memory_order_relaxed);
+    }
+    size_t GetCapacity() const { return m_Mask + 1; }
+
+  private:
+    // Where `cursor` lands in the ring, and how many of `count` items
+    // fit before the end of it; the rest continue at the start.
+    size_t GetOffset(uint64_t cursor) const {
+        return static_cast<size_t>(cursor) & m_Mask;
+    }
+    size_t GetFirstPart(uint64_t cursor, size_t count) const {
+        return std::min(count, m_Mask + 1 - GetOffset(cursor));
+    }
+
+    // The producer and the consumer each get their own cache line.
+    static constexpr size_t kCacheLine = 64;
+
+    const size_t         m_Mask;
+    std::unique_ptr<T[]> m_Items;
+    alignas(kCacheLine) std::atomic<uint64_t> m_Write{0};
+    alignas(kCacheLine) std::atomic<uint64_t> m_Read{0};
+};
+
+} // namespace brnCore
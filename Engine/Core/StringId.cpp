@@ -0,0 +1,117 @@
+#include "StringId.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+#include "Arena.h"
+
+namespace brnCore {
+
+#if BRN_STRINGID_NAMES
+namespace {
+/*
+ * Insert-only chained hash table. Writers serialize on a mutex and publish
+ * fully built entries with a release store into the bucket head; readers
+ * walk the chains with acquire loads and never lock. Entries are never
+ * removed, so a reader can't observe a freed node.
+ */
+class StringTable {
+  public:
+    StringId Insert(std::string_view name) {
+        const uint64_t hash = HashFnv1a(name);
+        auto          &head = m_Buckets[hash & (kBucketCount - 1)];
+
+        if (const Entry *entry = Find(head, hash)) {
+            CheckCollision(*entry, name);
+            return StringId(hash);
+        }
+
+        std::scoped_lock lock(m_Mutex);
+
+        // Another thread may have inserted it while we were waiting.
+        if (const Entry *entry = Find(head, hash)) {
+            CheckCollision(*entry, name);
+            return StringId(hash);
+        }
+
+        auto *entry = static_cast<Entry *>(m_Storage.Allocate(
+            sizeof(Entry) + name.size() + 1, alignof(Entry)));
+        entry->Hash   = hash;
+        entry->Length = name.size();
+        entry->Next   = head.load(std::memory_order_relaxed);
+        std::memcpy(entry->Name, name.data(), name.size());
+        entry->Name[name.size()] = '\0';
+
+        head.store(entry, std::memory_order_release);
+        return StringId(hash);
+    }
+
+    const char *Lookup(uint64_t hash) const {
+        const Entry *entry = Find(m_Buckets[hash & (kBucketCount - 1)], hash);
+        return entry ? entry->Name : nullptr;
+    }
+
+  private:
+    static constexpr size_t kBucketCount = 1 << 14;
+
+    struct Entry {
+        uint64_t Hash;
+        size_t   Length;
+        Entry   *Next;
+        char     Name[1];
+    };
+
+    static const Entry *Find(const std::atomic<Entry *> &head, uint64_t hash) {
+        for (const Entry *entry = head.load(std::memory_order_acquire); entry;
+             entry              = entry->Next) {
+            if (entry->Hash == hash) {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    static void CheckCollision(const Entry &entry, std::string_view name) {
+        if (std::string_view(entry.Name, entry.Length) != name) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "StringId collision: '%.*s' and '%s' both hash to "
+                         "0x%016llx",
+                         static_cast<int>(name.size()),
+                         name.data(),
+                         entry.Name,
+                         static_cast<unsigned long long>(entry.Hash));
+            assert(false && "StringId hash collision");
+        }
+    }
+
+    std::atomic<Entry *> m_Buckets[kBucketCount]{};
+    std::mutex           m_Mutex;
+    Arena m_Storage{ArenaSpecification{.ChunkSize = 64 << 10}};
+};
+
+StringTable &GetStringTable() {
+    static StringTable table;
+    return table;
+}
+} // namespace
+
+StringId StringId::Intern(std::string_view name) {
+    return GetStringTable().Insert(name);
+}
+
+const char *StringId::GetName() const {
+    return GetStringTable().Lookup(m_Value);
+}
+#else
+StringId StringId::Intern(std::string_view name) {
+    return StringId(HashFnv1a(name));
+}
+
+const char *StringId::GetName() const { return nullptr; }
+#endif
+
+} // namespace brnCore
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/*
+ * Keep the reverse (id -> name) table in debug builds only. Define
+ * BRN_STRINGID_NAMES=1 to keep it in release builds as well, e.g. for tools.
+ */
+#ifndef BRN_STRINGID_NAMES
+#ifdef NDEBUG
+#define BRN_STRINGID_NAMES 0
+#else
+#define BRN_STRINGID_NAMES 1
+#endif
+#endif
+
+/*
+ * With names kept, literals are hashed by a constexpr constructor that
+ * also registers the name when it runs at runtime; without, it is
+ * consteval and never costs anything at runtime.
+ */
+#if BRN_STRINGID_NAMES
+#define BRN_STRINGID_LITERAL constexpr
+#else
+#define BRN_STRINGID_LITERAL consteval
+#endif
+
+namespace brnCore {
+
+inline constexpr uint64_t kFnv1aOffsetBasis = 14695981039346656037ull;
+inline constexpr uint64_t kFnv1aPrime       = 1099511628211ull;
+
+constexpr uint64_t HashFnv1a(std::string_view str,
+                             uint64_t         hash = kFnv1aOffsetBasis) {
+    for (const char c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= kFnv1aPrime;
+    }
+    return hash;
+}
+
+/*
+ * 64-bit FNV-1a hash of a name, used as a key instead of std::string.
+ *
+ *   constexpr StringId kPlayer = "Player";        // hashed at compile time
+ *   StringId path = StringId::Intern(assetPath);  // hashed + registered
+ *
+ * Names that only exist at runtime go through Intern(), which records
+ * them for GetName() and reports collisions when names are kept. Release
+ * builds hash literals at compile time only; builds that keep names
+ * register a literal (and check it for collisions) each time one is
+ * built at runtime. A literal only ever built in a constant expression,
+ * such as kPlayer above, stays unnamed until it is also built at runtime
+ * or interned.
+ */
+class StringId {
+  public:
+    constexpr StringId() = default;
+    constexpr explicit StringId(uint64_t value) : m_Value(value) {}
+
+    template <size_t N>
+    BRN_STRINGID_LITERAL StringId(const char (&literal)[N])
+        : m_Value(HashFnv1a(std::string_view(literal, N - 1))) {
+#if BRN_STRINGID_NAMES
+        if !consteval {
+            Intern(std::string_view(literal, N - 1));
+        }
+#endif
+    }
+
+    static StringId Intern(std::string_view name);
+
+    // Registered name, or nullptr if unknown or names are compiled out.
+    const char *GetName() const;
+
+    constexpr uint64_t GetValue() const { return m_Value; }
+    constexpr bool     IsValid() const { return m_Value != 0; }
+
+    constexpr auto operator<=>(const StringId &) const = default;
+
+  private:
+    uint64_t m_Value = 0;
+};
+
+namespace literals {
+BRN_STRINGID_LITERAL StringId operator""_sid(const char *str, size_t length) {
+#if BRN_STRINGID_NAMES
+    if !consteval {
+        return StringId::Intern(std::string_view(str, length));
+    }
+#endif
+    return StringId(HashFnv1a(std::string_view(str, length)));
+}
+} // namespace literals
+
+} // namespace brnCore
+
+template <>
+struct std::hash<brnCore::StringId> {
+    // Already a well mixed hash; don't hash it again.
+    size_t operator()(brnCore::StringId id) const noexcept {
+        return static_cast<size_t>(id.GetValue());
+    }
+};
@@ -29,10 +29,14 @@ void Window::Destroy() {
     m_Window = nullptr;
 }
 
-void Window::Update() { SDL_GL_SwapWindow(m_Window.get()); }
+void Window::Update() {
+    if (m_Window) {
+        SDL_GL_SwapWindow(m_Window.get());
+    }
+}
 
 glm::vec2 Window::GetFramebufferSize() const {
-    int width, height;
+    int width = 0, height = 0;
     SDL_GetWindowSize(m_Window.get(), &width, &height);
     return {width, height};
 }
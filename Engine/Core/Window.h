@@ -28,6 +28,8 @@ class Window {
     void Update();
 
     glm::vec2 GetFramebufferSize() const;
+    // Asks SDL on every call; per frame code should read the Input
+    // snapshot (or Input::GetPointerPosition()) instead.
     glm::vec2 GetMousePos() const;
 
     bool ShouldClose(const SDL_EventType &event) const;
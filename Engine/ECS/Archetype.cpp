@@ -0,0 +1,161 @@
+#include "Archetype.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace brnCore {
+
+namespace {
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+Archetype::Archetype(uint32_t id, std::vector<ComponentId> components)
+    : m_Id(id), m_Components(std::move(components)) {
+    std::ranges::sort(m_Components);
+    m_ColumnOf.fill(kNoColumn);
+
+    size_t rowSize      = sizeof(Entity);
+    size_t maxAlignment = kColumnAlign;
+    for (size_t i = 0; i < m_Components.size(); i++) {
+        const ComponentInfo &info = ComponentRegistry::GetInfo(m_Components[i]);
+        m_Mask.set(m_Components[i]);
+        m_ColumnOf[m_Components[i]] = static_cast<int16_t>(i);
+        m_ColumnSizes.push_back(static_cast<uint32_t>(info.Size));
+        rowSize += info.Size;
+        maxAlignment = std::max(maxAlignment, info.Alignment);
+    }
+
+    // Worst case every column start loses a full alignment step.
+    const size_t padding = maxAlignment * (m_Components.size() + 1);
+    if (kChunkSize > padding + rowSize) {
+        m_ChunkCapacity =
+            static_cast<uint32_t>((kChunkSize - padding) / rowSize);
+    } else {
+        // A single row doesn't fit; give each row its own oversized chunk.
+        m_ChunkCapacity = 1;
+        m_ChunkBytes    = AlignUp(rowSize + padding, maxAlignment);
+    }
+
+    size_t offset = sizeof(Entity) * m_ChunkCapacity;
+    for (size_t i = 0; i < m_Components.size(); i++) {
+        const ComponentInfo &info = ComponentRegistry::GetInfo(m_Components[i]);
+        offset = AlignUp(offset, std::max(kColumnAlign, info.Alignment));
+        m_ColumnOffsets.push_back(static_cast<uint32_t>(offset));
+        offset += info.Size * m_ChunkCapacity;
+    }
+    assert(offset <= m_ChunkBytes);
+    m_ChunkAlignment = maxAlignment;
+}
+
+Archetype::~Archetype() { Clear(); }
+
+void Archetype::Clear() {
+    for (uint32_t row = m_EntityCount; row > 0; row--) {
+        for (size_t column = 0; column < m_Components.size(); column++) {
+            const ComponentInfo &info =
+                ComponentRegistry::GetInfo(m_Components[column]);
+            if (!info.Trivial && info.Size) {
+                info.Destroy(GetComponentByColumn(
+                    row - 1, static_cast<int16_t>(column)));
+            }
+        }
+    }
+
+    for (Chunk &chunk : m_Chunks) {
+        ::operator delete(chunk.Data, std::align_val_t{m_ChunkAlignment});
+    }
+    m_Chunks.clear();
+    m_EntityCount = 0;
+}
+
+void Archetype::AllocateChunk() {
+    Chunk chunk;
+    chunk.Data = static_cast<std::byte *>(
+        ::operator new(m_ChunkBytes, std::align_val_t{m_ChunkAlignment}));
+    m_Chunks.push_back(chunk);
+}
+
+uint32_t Archetype::PushRow(Entity entity) {
+    const uint32_t row        = m_EntityCount++;
+    const uint32_t chunkIndex = row / m_ChunkCapacity;
+    if (chunkIndex == m_Chunks.size()) {
+        AllocateChunk();
+    }
+
+    Chunk &chunk = m_Chunks[chunkIndex];
+    GetEntities(chunk)[chunk.Count++] = entity;
+    return row;
+}
+
+uint32_t Archetype::PushRows(const Entity *entities, uint32_t count) {
+    const uint32_t first = m_EntityCount;
+    for (uint32_t done = 0; done < count;) {
+        const uint32_t chunkIndex = m_EntityCount / m_ChunkCapacity;
+        if (chunkIndex == m_Chunks.size()) {
+            AllocateChunk();
+        }
+
+        Chunk         &chunk = m_Chunks[chunkIndex];
+        const uint32_t rows =
+            std::min(count - done, m_ChunkCapacity - chunk.Count);
+        std::memcpy(GetEntities(chunk) + chunk.Count,
+                    entities + done,
+                    rows * sizeof(Entity));
+        chunk.Count += rows;
+        m_EntityCount += rows;
+        done += rows;
+    }
+    return first;
+}
+
+Entity Archetype::RemoveRow(uint32_t row, bool destroyComponents) {
+    assert(row < m_EntityCount);
+    const uint32_t last = m_EntityCount - 1;
+
+    for (size_t i = 0; i < m_Components.size(); i++) {
+        const ComponentInfo &info = ComponentRegistry::GetInfo(m_Components[i]);
+        if (!info.Size) {
+            continue;
+        }
+
+        const auto column = static_cast<int16_t>(i);
+        void      *hole   = GetComponentByColumn(row, column);
+        if (destroyComponents && !info.Trivial) {
+            info.Destroy(hole);
+        }
+        if (row != last) {
+            void *tail = GetComponentByColumn(last, column);
+            if (info.Trivial) {
+                std::memcpy(hole, tail, info.Size);
+            } else {
+                info.Relocate(hole, tail);
+            }
+        }
+    }
+
+    Entity moved{};
+    if (row != last) {
+        moved = GetEntity(last);
+        GetEntities(m_Chunks[row / m_ChunkCapacity])[row % m_ChunkCapacity] =
+            moved;
+    }
+
+    const uint32_t lastChunk = last / m_ChunkCapacity;
+    m_Chunks[lastChunk].Count--;
+    m_EntityCount--;
+
+    // Keep at most one empty chunk around so add/remove at a chunk boundary
+    // doesn't allocate every time.
+    if (m_Chunks[lastChunk].Count == 0 && lastChunk + 1 < m_Chunks.size()) {
+        ::operator delete(m_Chunks.back().Data,
+                          std::align_val_t{m_ChunkAlignment});
+        m_Chunks.pop_back();
+    }
+
+    return moved;
+}
+
+} // namespace brnCore
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/ECS/Component.h"
+#include "Engine/ECS/Entity.h"
+
+namespace brnCore {
+
+/*
+ * Fixed size block holding Capacity rows of one archetype as a structure of
+ * arrays: [Entity x Capacity][Column 0 x Capacity][Column 1 x Capacity]...
+ * Columns start on cache line boundaries.
+ */
+struct Chunk {
+    std::byte *Data  = nullptr;
+    uint32_t   Count = 0;
+};
+
+/*
+ * Storage for every entity that has exactly the same set of components.
+ * Rows are kept dense: only the last chunk is ever partially filled, and
+ * removing a row moves the archetype's last row into the hole.
+ */
+class Archetype {
+  public:
+    static constexpr size_t  kChunkSize   = 16 * 1024;
+    static constexpr size_t  kColumnAlign = 64;
+    static constexpr int16_t kNoColumn    = -1;
+
+    Archetype(uint32_t id, std::vector<ComponentId> components);
+    ~Archetype();
+
+    Archetype(const Archetype &)            = delete;
+    Archetype &operator=(const Archetype &) = delete;
+
+    uint32_t                        GetId() const { return m_Id; }
+    const ComponentMask            &GetMask() const { return m_Mask; }
+    const std::vector<ComponentId> &GetComponents() const {
+        return m_Components;
+    }
+
+    bool Has(ComponentId component) const { return m_Mask.test(component); }
+
+    int16_t GetColumn(ComponentId component) const {
+        return m_ColumnOf[component];
+    }
+
+    uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+    uint32_t GetEntityCount() const { return m_EntityCount; }
+
+    std::vector<Chunk>       &GetChunks() { return m_Chunks; }
+    const std::vector<Chunk> &GetChunks() const { return m_Chunks; }
+
+    Entity *GetEntities(const Chunk &chunk) const {
+        return reinterpret_cast<Entity *>(chunk.Data);
+    }
+
+    void *GetColumnData(const Chunk &chunk, int16_t column) const {
+        return chunk.Data + m_ColumnOffsets[column];
+    }
+
+    void *GetComponent(uint32_t row, ComponentId component) const {
+        const Chunk &chunk = m_Chunks[row / m_ChunkCapacity];
+        const int16_t column = m_ColumnOf[component];
+        return static_cast<std::byte *>(GetColumnData(chunk, column)) +
+               static_cast<size_t>(row % m_ChunkCapacity) *
+                   m_ColumnSizes[column];
+    }
+
+    void *GetComponentByColumn(uint32_t row, int16_t column) const {
+        const Chunk &chunk = m_Chunks[row / m_ChunkCapacity];
+        return static_cast<std::byte *>(GetColumnData(chunk, column)) +
+               static_cast<size_t>(row % m_ChunkCapacity) *
+                   m_ColumnSizes[column];
+    }
+
+    Entity GetEntity(uint32_t row) const {
+        return GetEntities(m_Chunks[row / m_ChunkCapacity])
+            [row % m_ChunkCapacity];
+    }
+
+    // Appends a row with uninitialized component storage.
+    uint32_t PushRow(Entity entity);
+
+    // Appends `count` rows at once; returns the first one.
+    uint32_t PushRows(const Entity *entities, uint32_t count);
+
+    /*
+     * Removes a row, destroying its components unless they were already
+     * relocated elsewhere. Returns the entity that was moved into the
+     * freed row, or an invalid entity if the row was the last one.
+     */
+    Entity RemoveRow(uint32_t row, bool destroyComponents);
+
+    // Destroys every row and frees the chunks.
+    void Clear();
+
+    // Graph edges to the archetypes one component away, built lazily.
+    std::unordered_map<ComponentId, Archetype *> AddEdges;
+    std::unordered_map<ComponentId, Archetype *> RemoveEdges;
+
+  private:
+    void AllocateChunk();
+
+    uint32_t                 m_Id;
+    std::vector<ComponentId> m_Components;
+    ComponentMask            m_Mask;
+
+    std::array<int16_t, kMaxComponents> m_ColumnOf;
+    std::vector<uint32_t>               m_ColumnOffsets;
+    std::vector<uint32_t>               m_ColumnSizes;
+
+    size_t             m_ChunkBytes     = kChunkSize;
+    size_t             m_ChunkAlignment = kColumnAlign;
+    uint32_t           m_ChunkCapacity  = 0;
+    uint32_t           m_EntityCount    = 0;
+    std::vector<Chunk> m_Chunks;
+};
+
+} // namespace brnCore
@@ -0,0 +1,81 @@
+#include "CommandBuffer.h"
+
+#include <cstring>
+
+#include "World.h"
+
+namespace brnCore {
+
+CommandBuffer::CommandBuffer(World &world)
+    : m_World(&world), m_Payloads(ArenaSpecification{.ChunkSize = 64 << 10}) {}
+
+CommandBuffer::~CommandBuffer() { DiscardPayloads(); }
+
+Entity CommandBuffer::CreateEntity() {
+    const Entity entity = m_World->ReserveEntity();
+    m_Commands.push_back({CommandType::Create, 0, entity, nullptr});
+    return entity;
+}
+
+void CommandBuffer::DestroyEntity(Entity entity) {
+    m_Commands.push_back({CommandType::Destroy, 0, entity, nullptr});
+}
+
+void CommandBuffer::Flush() {
+    for (size_t i = 0; i < m_Commands.size(); i++) {
+        Command &command = m_Commands[i];
+        switch (command.Type) {
+        case CommandType::Create:
+            m_World->AdoptReserved(command.Target);
+            break;
+        case CommandType::Destroy:
+            m_World->DestroyEntity(command.Target);
+            break;
+        case CommandType::Add: {
+            const ComponentInfo &info =
+                ComponentRegistry::GetInfo(command.Component);
+            if (!m_World->IsAlive(command.Target)) {
+                if (command.Payload && !info.Trivial) {
+                    info.Destroy(command.Payload);
+                }
+                break;
+            }
+
+            void *storage =
+                m_World->AddComponentRaw(command.Target, command.Component);
+            if (command.Payload) {
+                if (info.Trivial) {
+                    std::memcpy(storage, command.Payload, info.Size);
+                } else {
+                    info.Relocate(storage, command.Payload);
+                }
+            }
+            break;
+        }
+        case CommandType::Remove:
+            if (m_World->IsAlive(command.Target)) {
+                m_World->RemoveComponentRaw(command.Target,
+                                            command.Component);
+            }
+            break;
+        }
+    }
+
+    m_Commands.clear();
+    m_Payloads.Reset();
+}
+
+void CommandBuffer::DiscardPayloads() {
+    for (const Command &command : m_Commands) {
+        if (command.Type == CommandType::Add && command.Payload) {
+            const ComponentInfo &info =
+                ComponentRegistry::GetInfo(command.Component);
+            if (!info.Trivial) {
+                info.Destroy(command.Payload);
+            }
+        }
+    }
+    m_Commands.clear();
+}
+
+} // namespace brnCore
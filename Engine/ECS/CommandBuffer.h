@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Arena.h"
+#include "Engine/ECS/Component.h"
+#include "Engine/ECS/Entity.h"
+
+namespace brnCore {
+
+class World;
+
+/*
+ * Records structural changes while queries are being iterated and applies
+ * them in order on Flush(). Component values are moved into an arena owned
+ * by the buffer, so recording allocates nothing once it has warmed up.
+ *
+ * A buffer is meant to be used from one thread at a time; give each system
+ * or worker its own and flush them on the main thread.
+ */
+class CommandBuffer {
+  public:
+    explicit CommandBuffer(World &world);
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer &)            = delete;
+    CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+    // The returned id is valid immediately; the entity exists after Flush().
+    Entity CreateEntity();
+    void   DestroyEntity(Entity entity);
+
+    template <ComponentType T, typename... Args>
+    void AddComponent(Entity entity, Args &&...args) {
+        void *payload = nullptr;
+        if constexpr (!std::is_empty_v<T>) {
+            payload = m_Payloads.Allocate(sizeof(T), alignof(T));
+            ::new (payload) T(std::forward<Args>(args)...);
+        }
+        m_Commands.push_back({CommandType::Add,
+                              ComponentRegistry::GetId<T>(),
+                              entity,
+                              payload});
+    }
+
+    template <ComponentType T>
+    void RemoveComponent(Entity entity) {
+        m_Commands.push_back({CommandType::Remove,
+                              ComponentRegistry::GetId<T>(),
+                              entity,
+                              nullptr});
+    }
+
+    void Flush();
+
+    bool IsEmpty() const { return m_Commands.empty(); }
+
+  private:
+    enum class CommandType : uint8_t { Create, Destroy, Add, Remove };
+
+    struct Command {
+        CommandType Type;
+        ComponentId Component;
+        Entity      Target;
+        void       *Payload;
+    };
+
+    void DiscardPayloads();
+
+    World               *m_World;
+    std::vector<Command> m_Commands;
+    Arena                m_Payloads;
+};
+
+} // namespace brnCore
@@ -0,0 +1,56 @@
+#include "Component.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+namespace brnCore {
+
+namespace {
+std::array<ComponentInfo, kMaxComponents> s_ComponentInfos;
+std::atomic<size_t>                       s_ComponentCount{0};
+std::mutex                                s_RegisterMutex;
+std::atomic<size_t>                       s_ResourceCount{0};
+} // namespace
+
+ComponentId ComponentRegistry::Register(const ComponentInfo &info) {
+    std::scoped_lock lock(s_RegisterMutex);
+
+    const size_t id = s_ComponentCount.load(std::memory_order_relaxed);
+    if (id == kMaxComponents) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Too many component types (max %zu) registering %s",
+                     kMaxComponents,
+                     info.Name);
+        std::abort();
+    }
+
+    s_ComponentInfos[id] = info;
+    s_ComponentCount.store(id + 1, std::memory_order_release);
+    return static_cast<ComponentId>(id);
+}
+
+const ComponentInfo &ComponentRegistry::GetInfo(ComponentId id) {
+    return s_ComponentInfos[id];
+}
+
+size_t ComponentRegistry::GetCount() {
+    return s_ComponentCount.load(std::memory_order_acquire);
+}
+
+ResourceId ResourceRegistry::Register(const char *name) {
+    const size_t id = s_ResourceCount.fetch_add(1, std::memory_order_relaxed);
+    if (id >= kMaxResources) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Too many resource types (max %zu) registering %s",
+                     kMaxResources,
+                     name);
+        std::abort();
+    }
+    return static_cast<ResourceId>(id);
+}
+
+} // namespace brnCore
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace brnCore {
+
+using ComponentId = uint16_t;
+
+inline constexpr size_t kMaxComponents = 256;
+using ComponentMask                    = std::bitset<kMaxComponents>;
+
+template <typename T>
+concept ComponentType = std::is_object_v<T> && !std::is_const_v<T> &&
+                        std::is_move_constructible_v<T> &&
+                        std::is_destructible_v<T>;
+
+/*
+ * Type-erased operations the archetype storage needs. Relocate
+ * move-constructs into dst and destroys src, which collapses to a memcpy
+ * for trivially copyable components.
+ */
+struct ComponentInfo {
+    const char *Name;
+    size_t      Size;
+    size_t      Alignment;
+    bool        Trivial;
+    void (*Relocate)(void *dst, void *src);
+    void (*Destroy)(void *ptr);
+};
+
+class ComponentRegistry {
+  public:
+    template <ComponentType T>
+    static ComponentId GetId() {
+        static const ComponentId id = Register(MakeInfo<T>());
+        return id;
+    }
+
+    static const ComponentInfo &GetInfo(ComponentId id);
+    static size_t               GetCount();
+
+  private:
+    template <typename T>
+    static ComponentInfo MakeInfo() {
+        ComponentInfo info{};
+        info.Name      = typeid(T).name();
+        info.Size      = std::is_empty_v<T> ? 0 : sizeof(T);
+        info.Alignment = alignof(T);
+        info.Trivial   = std::is_trivially_copyable_v<T>;
+        info.Relocate  = [](void *dst, void *src) {
+            ::new (dst) T(std::move(*static_cast<T *>(src)));
+            static_cast<T *>(src)->~T();
+        };
+        info.Destroy = [](void *ptr) { static_cast<T *>(ptr)->~T(); };
+        return info;
+    }
+
+    static ComponentId Register(const ComponentInfo &info);
+};
+
+/*
+ * World-wide singletons (time, input, physics settings...) that systems
+ * declare access to just like components.
+ */
+using ResourceId = uint16_t;
+
+inline constexpr size_t kMaxResources = 64;
+using ResourceMask                    = std::bitset<kMaxResources>;
+
+class ResourceRegistry {
+  public:
+    template <typename T>
+    static ResourceId GetId() {
+        static const ResourceId id = Register(typeid(T).name());
+        return id;
+    }
+
+  private:
+    static ResourceId Register(const char *name);
+};
+
+} // namespace brnCore
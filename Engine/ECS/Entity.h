@@ -0,0 +1,36 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <functional>
+
+namespace brnCore {
+
+/*
+ * Generational handle: Index selects the slot in the world's entity table,
+ * Generation is bumped every time that slot is freed so stale handles to a
+ * destroyed entity never alias a newer one.
+ */
+struct Entity {
+    static constexpr uint32_t kInvalidIndex = ~0u;
+
+    uint32_t Index      = kInvalidIndex;
+    uint32_t Generation = 0;
+
+    constexpr bool IsValid() const { return Index != kInvalidIndex; }
+
+    constexpr uint64_t GetValue() const {
+        return (static_cast<uint64_t>(Generation) << 32) | Index;
+    }
+
+    constexpr auto operator<=>(const Entity &) const = default;
+};
+
+} // namespace brnCore
+
+template <>
+struct std::hash<brnCore::Entity> {
+    size_t operator()(brnCore::Entity entity) const noexcept {
+        return std::hash<uint64_t>{}(entity.GetValue());
+    }
+};
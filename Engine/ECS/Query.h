@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/ECS/Archetype.h"
+#include "Engine/ECS/Component.h"
+
+namespace brnCore {
+
+/*
+ * Cached result of matching a component set against the world's
+ * archetypes. The world appends to Archetypes whenever it creates a new
+ * archetype that matches, so iterating never re-tests old archetypes.
+ * Columns holds, per matched archetype, the column of each queried
+ * component in declaration order.
+ */
+struct QueryState {
+    ComponentMask            Required;
+    std::vector<ComponentId> Components;
+    std::vector<Archetype *> Archetypes;
+    std::vector<int16_t>     Columns;
+    std::atomic<int>        *IterationDepth = nullptr;
+
+    bool Matches(const Archetype &archetype) const {
+        return (archetype.GetMask() & Required) == Required;
+    }
+
+    void Append(Archetype *archetype) {
+        Archetypes.push_back(archetype);
+        for (ComponentId component : Components) {
+            Columns.push_back(archetype->GetColumn(component));
+        }
+    }
+};
+
+// Blocks structural changes on the world while a query is being iterated.
+class IterationScope {
+  public:
+    explicit IterationScope(std::atomic<int> *depth) : m_Depth(depth) {
+        m_Depth->fetch_add(1, std::memory_order_relaxed);
+    }
+    ~IterationScope() { m_Depth->fetch_sub(1, std::memory_order_relaxed); }
+
+    IterationScope(const IterationScope &)            = delete;
+    IterationScope &operator=(const IterationScope &) = delete;
+
+  private:
+    std::atomic<int> *m_Depth;
+};
+
+// One chunk of a query's matches with typed access to its columns.
+template <typename... Ts>
+class QueryChunk {
+  public:
+    QueryChunk(const Archetype *archetype,
+               const Chunk     *chunk,
+               const int16_t   *columns)
+        : m_Archetype(archetype), m_Chunk(chunk), m_Columns(columns) {}
+
+    uint32_t GetCount() const { return m_Chunk->Count; }
+
+    const Entity *GetEntities() const {
+        return m_Archetype->GetEntities(*m_Chunk);
+    }
+
+    template <size_t I>
+    auto *Get() const {
+        using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+        return static_cast<T *>(
+            m_Archetype->GetColumnData(*m_Chunk, m_Columns[I]));
+    }
+
+    template <typename Fn>
+    void Each(Fn &&fn) const {
+        EachImpl(fn, std::index_sequence_for<Ts...>{});
+    }
+
+  private:
+    template <typename Fn, size_t... I>
+    void EachImpl(Fn &fn, std::index_sequence<I...>) const {
+        const auto     columns = std::make_tuple(Get<I>()...);
+        const uint32_t count   = m_Chunk->Count;
+        if constexpr (std::is_invocable_v<Fn, Entity, Ts &...>) {
+            const Entity *entities = GetEntities();
+            for (uint32_t i = 0; i < count; i++) {
+                fn(entities[i], std::get<I>(columns)[i]...);
+            }
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                fn(std::get<I>(columns)[i]...);
+            }
+        }
+    }
+
+    const Archetype *m_Archetype;
+    const Chunk     *m_Chunk;
+    const int16_t   *m_Columns;
+};
+
+/*
+ * Typed view over a QueryState. Components may be const-qualified to
+ * declare read-only access:
+ *
+ *   world.CreateQuery<Position, const Velocity>().Each(
+ *       [](Position &p, const Velocity &v) { p.Value += v.Value; });
+ *
+ * The callback may also take the Entity as its first parameter. Structural
+ * changes are not allowed while iterating; record them in a CommandBuffer.
+ */
+template <typename... Ts>
+class Query {
+  public:
+    static_assert(sizeof...(Ts) > 0, "A query needs at least one component");
+    static_assert((!std::is_empty_v<Ts> && ...),
+                  "Tag components carry no data to iterate");
+
+    Query() = default;
+    explicit Query(QueryState *state) : m_State(state) {}
+
+    template <typename Fn>
+    void Each(Fn &&fn) const {
+        IterationScope scope(m_State->IterationDepth);
+        ForEachChunkUnlocked(
+            [&](const QueryChunk<Ts...> &chunk) { chunk.Each(fn); });
+    }
+
+    template <typename Fn>
+    void EachChunk(Fn &&fn) const {
+        IterationScope scope(m_State->IterationDepth);
+        ForEachChunkUnlocked(fn);
+    }
+
+    /*
+     * Same as Each(), split into tasks of `chunksPerTask` chunks on the job
+     * system. fn runs concurrently, so it must only touch its arguments.
+     */
+    template <typename Fn>
+    void ParallelEach(JobSystem &jobs,
+                      Fn       &&fn,
+                      uint32_t   chunksPerTask = 4) const {
+        IterationScope scope(m_State->IterationDepth);
+
+        std::vector<QueryChunk<Ts...>> chunks;
+        CollectChunks(chunks);
+        jobs.ParallelFor(static_cast<uint32_t>(chunks.size()),
+                         chunksPerTask,
+                         [&](uint32_t begin, uint32_t end) {
+                             for (uint32_t i = begin; i < end; i++) {
+                                 chunks[i].Each(fn);
+                             }
+                         });
+    }
+
+    // Snapshot of the non-empty chunks, e.g. to split work across threads.
+    void CollectChunks(std::vector<QueryChunk<Ts...>> &out) const {
+        ForEachChunkUnlocked(
+            [&](const QueryChunk<Ts...> &chunk) { out.push_back(chunk); });
+    }
+
+    size_t GetEntityCount() const {
+        size_t count = 0;
+        for (const Archetype *archetype : m_State->Archetypes) {
+            count += archetype->GetEntityCount();
+        }
+        return count;
+    }
+
+    QueryState *GetState() const { return m_State; }
+
+  private:
+    template <typename Fn>
+    void ForEachChunkUnlocked(Fn &&fn) const {
+        constexpr size_t kCount = sizeof...(Ts);
+
+        const auto &archetypes = m_State->Archetypes;
+        for (size_t a = 0; a < archetypes.size(); a++) {
+            const int16_t *columns = &m_State->Columns[a * kCount];
+            for (const Chunk &chunk : archetypes[a]->GetChunks()) {
+                if (chunk.Count) {
+                    fn(QueryChunk<Ts...>(archetypes[a], &chunk, columns));
+                }
+            }
+        }
+    }
+
+    QueryState *m_State = nullptr;
+};
+
+} // namespace brnCore
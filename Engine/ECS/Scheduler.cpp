@@ -0,0 +1,176 @@
+#include "Scheduler.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+
+namespace brnCore {
+
+namespace {
+double ToMilliseconds(uint64_t ticks) {
+    return static_cast<double>(ticks) * 1000.0 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+} // namespace
+
+bool Scheduler::Conflicts(const SystemEntry &a, const SystemEntry &b) {
+    if ((a.Writes & (b.Reads | b.Writes)).any() ||
+        (b.Writes & a.Reads).any()) {
+        return true;
+    }
+    return (a.ResourceWrites & (b.ResourceReads | b.ResourceWrites)).any() ||
+           (b.ResourceWrites & a.ResourceReads).any();
+}
+
+void Scheduler::BuildGraph() {
+    for (SystemEntry &system : m_Systems) {
+        system.Dependents.clear();
+        system.Dependencies.clear();
+    }
+
+    /*
+     * A later system depends on every earlier one it conflicts with. That
+     * keeps registration order as the tie-breaker, so a frame produces the
+     * same results no matter how many workers there are.
+     */
+    const uint32_t count = static_cast<uint32_t>(m_Systems.size());
+    for (uint32_t j = 0; j < count; j++) {
+        for (uint32_t i = 0; i < j; i++) {
+            if (Conflicts(m_Systems[i], m_Systems[j])) {
+                m_Systems[i].Dependents.push_back(j);
+                m_Systems[j].Dependencies.push_back(i);
+            }
+        }
+    }
+}
+
+void Scheduler::Run(World &world, float deltaTime) {
+    const uint32_t count = static_cast<uint32_t>(m_Systems.size());
+
+    if (m_BoundWorld != &world || m_Stats.size() != count) {
+        for (SystemEntry &system : m_Systems) {
+            system.Commands = std::make_unique<CommandBuffer>(world);
+        }
+        m_BoundWorld = &world;
+        m_Remaining  = std::make_unique<std::atomic<uint32_t>[]>(count);
+        m_Stats.resize(count);
+        BuildGraph();
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        m_Stats[i].Name           = m_Systems[i].Name;
+        m_Stats[i].OnCriticalPath = false;
+        m_Remaining[i].store(
+            static_cast<uint32_t>(m_Systems[i].Dependencies.size()),
+            std::memory_order_relaxed);
+    }
+
+    m_FrameStart = SDL_GetPerformanceCounter();
+
+    if (m_Jobs) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (m_Systems[i].Dependencies.empty()) {
+                Launch(i, world, deltaTime);
+            }
+        }
+        m_Jobs->Wait(m_Counter);
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            Execute(i, world, deltaTime);
+        }
+    }
+
+    for (SystemEntry &system : m_Systems) {
+        system.Commands->Flush();
+    }
+
+    m_FrameMs = ToMilliseconds(SDL_GetPerformanceCounter() - m_FrameStart);
+    ComputeCriticalPath();
+}
+
+void Scheduler::Launch(uint32_t index, World &world, float deltaTime) {
+    m_Jobs->Schedule(m_Counter, [this, index, &world, deltaTime] {
+        Execute(index, world, deltaTime);
+
+        // The last dependency to finish releases the dependent.
+        for (uint32_t dependent : m_Systems[index].Dependents) {
+            if (m_Remaining[dependent].fetch_sub(
+                    1, std::memory_order_acq_rel) == 1) {
+                Launch(dependent, world, deltaTime);
+            }
+        }
+    });
+}
+
+void Scheduler::Execute(uint32_t index, World &world, float deltaTime) {
+    SystemEntry &system = m_Systems[index];
+
+    const uint64_t begin = SDL_GetPerformanceCounter();
+    const char    *missing =
+        system.Run(world, m_Jobs, *system.Commands, deltaTime);
+    const uint64_t end = SDL_GetPerformanceCounter();
+
+    // Once, not every frame it stays skipped.
+    if (missing && !system.SkipLogged) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Scheduler: skipping '%s', resource %s was never "
+                     "added to the world",
+                     system.Name.c_str(),
+                     missing);
+    }
+    system.SkipLogged = missing != nullptr;
+
+    SystemStats &stats = m_Stats[index];
+    stats.StartMs      = ToMilliseconds(begin - m_FrameStart);
+    stats.DurationMs   = ToMilliseconds(end - begin);
+    stats.ThreadIndex  = JobSystem::GetThreadIndex();
+}
+
+void Scheduler::ComputeCriticalPath() {
+    const uint32_t count = static_cast<uint32_t>(m_Systems.size());
+    m_CriticalPathMs     = 0.0;
+    if (count == 0) {
+        return;
+    }
+
+    // Dependencies always precede their dependents, so one pass suffices.
+    std::vector<double>  finish(count, 0.0);
+    std::vector<int32_t> previous(count, -1);
+    uint32_t             last = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        double start = 0.0;
+        for (uint32_t dependency : m_Systems[i].Dependencies) {
+            if (finish[dependency] > start) {
+                start       = finish[dependency];
+                previous[i] = static_cast<int32_t>(dependency);
+            }
+        }
+        finish[i] = start + m_Stats[i].DurationMs;
+        if (finish[i] > finish[last]) {
+            last = i;
+        }
+    }
+
+    m_CriticalPathMs = finish[last];
+    for (int32_t i = static_cast<int32_t>(last); i >= 0; i = previous[i]) {
+        m_Stats[i].OnCriticalPath = true;
+    }
+}
+
+void Scheduler::LogStats() const {
+    SDL_Log("Scheduler: %zu systems, frame %.3f ms, critical path %.3f ms",
+            m_Stats.size(),
+            m_FrameMs,
+            m_CriticalPathMs);
+    for (const SystemStats &stats : m_Stats) {
+        SDL_Log("  %c %-24s thread %2u  start %8.3f ms  took %8.3f ms",
+                stats.OnCriticalPath ? '*' : ' ',
+                stats.Name.c_str(),
+                stats.ThreadIndex,
+                stats.StartMs,
+                stats.DurationMs);
+    }
+}
+
+} // namespace brnCore
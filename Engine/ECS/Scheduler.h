@@ -0,0 +1,291 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/ECS/CommandBuffer.h"
+#include "Engine/ECS/Component.h"
+#include "Engine/ECS/World.h"
+
+namespace brnCore {
+
+// Access declarations, combined in a system's `using Access = ...`.
+template <typename... Ts>
+struct Read {};
+template <typename... Ts>
+struct Write {};
+template <typename... Ts>
+struct ReadResource {};
+template <typename... Ts>
+struct WriteResource {};
+
+namespace detail {
+template <template <typename...> class Kind, typename Declaration>
+struct ExtractAccess {
+    using Type = std::tuple<>;
+};
+
+template <template <typename...> class Kind, typename... Ts>
+struct ExtractAccess<Kind, Kind<Ts...>> {
+    using Type = std::tuple<Ts...>;
+};
+
+template <template <typename...> class Kind, typename... Declarations>
+using CollectAccess = decltype(std::tuple_cat(
+    std::declval<typename ExtractAccess<Kind, Declarations>::Type>()...));
+
+template <typename T, typename Tuple>
+struct TupleContains;
+
+template <typename T, typename... Ts>
+struct TupleContains<T, std::tuple<Ts...>>
+    : std::bool_constant<(std::is_same_v<T, Ts> || ...)> {};
+
+template <typename Tuple>
+struct MaskBuilder;
+
+template <typename... Ts>
+struct MaskBuilder<std::tuple<Ts...>> {
+    static ComponentMask Components() {
+        ComponentMask mask;
+        (mask.set(ComponentRegistry::GetId<Ts>()), ...);
+        return mask;
+    }
+    static ResourceMask Resources() {
+        ResourceMask mask;
+        (mask.set(ResourceRegistry::GetId<Ts>()), ...);
+        return mask;
+    }
+    // The first of the resources `world` doesn't have, or nullptr.
+    static const char *FindMissingResource(const World &world) {
+        const char *missing = nullptr;
+        (void)((world.GetResource<Ts>()
+                    ? false
+                    : (missing = typeid(Ts).name(), true)) ||
+               ...);
+        return missing;
+    }
+};
+} // namespace detail
+
+/*
+ * Compile-time access set of a system:
+ *
+ *   struct IntegrateSystem {
+ *       using Access = brnCore::SystemAccess<brnCore::Read<Velocity>,
+ *                                            brnCore::Write<Position>,
+ *                                            brnCore::ReadResource<Time>>;
+ *       void Run(brnCore::SystemContext<Access> &context);
+ *   };
+ *
+ * The scheduler derives the frame's dependency graph from these sets, and
+ * SystemContext refuses (at compile time) queries outside of them.
+ */
+template <typename... Declarations>
+struct SystemAccess {
+    using Reads  = detail::CollectAccess<Read, Declarations...>;
+    using Writes = detail::CollectAccess<Write, Declarations...>;
+    using ResourceReads =
+        detail::CollectAccess<ReadResource, Declarations...>;
+    using ResourceWrites =
+        detail::CollectAccess<WriteResource, Declarations...>;
+
+    template <typename T>
+    static constexpr bool CanWrite = detail::TupleContains<T, Writes>::value;
+    template <typename T>
+    static constexpr bool CanRead =
+        CanWrite<T> || detail::TupleContains<T, Reads>::value;
+
+    template <typename T>
+    static constexpr bool CanWriteResource =
+        detail::TupleContains<T, ResourceWrites>::value;
+    template <typename T>
+    static constexpr bool CanReadResource =
+        CanWriteResource<T> ||
+        detail::TupleContains<T, ResourceReads>::value;
+};
+
+// What a system may touch this frame, checked against its Access.
+template <typename Access>
+class SystemContext {
+  public:
+    SystemContext(World         &world,
+                  JobSystem     *jobs,
+                  CommandBuffer &commands,
+                  float          deltaTime)
+        : m_World(world), m_Jobs(jobs), m_Commands(commands),
+          m_DeltaTime(deltaTime) {}
+
+    float GetDeltaTime() const { return m_DeltaTime; }
+
+    // Non-const components need Write access, const ones Read or Write.
+    template <typename... Ts>
+    Query<Ts...> GetQuery() {
+        static_assert(
+            ((std::is_const_v<Ts>
+                  ? Access::template CanRead<std::remove_const_t<Ts>>
+                  : Access::template CanWrite<Ts>) &&
+             ...),
+            "Query component not declared in the system's Access");
+        return m_World.CreateQuery<Ts...>();
+    }
+
+    template <typename T>
+    T &GetResource() {
+        if constexpr (std::is_const_v<T>) {
+            static_assert(
+                Access::template CanReadResource<std::remove_const_t<T>>,
+                "Resource not declared in the system's Access");
+        } else {
+            static_assert(Access::template CanWriteResource<T>,
+                          "Resource not declared writable in the system's "
+                          "Access");
+        }
+        // The scheduler skips systems whose resources are missing.
+        auto *resource = m_World.GetResource<std::remove_const_t<T>>();
+        assert(resource && "Resource was never added to the world");
+        return *resource;
+    }
+
+    // Structural changes; applied after every system of the frame ran.
+    CommandBuffer &GetCommands() { return m_Commands; }
+
+    // Splits the query into chunk-sized tasks when a job system is present.
+    template <typename... Ts, typename Fn>
+    void ParallelEach(const Query<Ts...> &query,
+                      Fn                &&fn,
+                      uint32_t            chunksPerTask = 4) {
+        if (m_Jobs) {
+            query.ParallelEach(*m_Jobs, std::forward<Fn>(fn), chunksPerTask);
+        } else {
+            query.Each(std::forward<Fn>(fn));
+        }
+    }
+
+  private:
+    World         &m_World;
+    JobSystem     *m_Jobs;
+    CommandBuffer &m_Commands;
+    float          m_DeltaTime;
+};
+
+struct SystemStats {
+    std::string Name;
+    double      StartMs        = 0.0; // relative to the start of Run()
+    double      DurationMs     = 0.0;
+    uint32_t    ThreadIndex    = 0;
+    bool        OnCriticalPath = false;
+};
+
+/*
+ * Runs systems once per frame. Systems whose declared access conflicts
+ * (one writes what the other reads or writes) run in registration order;
+ * everything else runs concurrently on the job system. Command buffers are
+ * flushed in registration order once all systems finished, so results do
+ * not depend on thread timing. A system declaring a resource the world
+ * doesn't have is skipped; the first skip logs an error naming it.
+ */
+class Scheduler {
+  public:
+    // Without a job system, systems run serially on the calling thread.
+    explicit Scheduler(JobSystem *jobs = nullptr) : m_Jobs(jobs) {}
+
+    template <typename TSystem, typename... Args>
+    TSystem &AddSystem(std::string name, Args &&...args) {
+        using Access = typename TSystem::Access;
+
+        auto system = std::make_shared<TSystem>(std::forward<Args>(args)...);
+        TSystem *result = system.get();
+
+        using detail::MaskBuilder;
+
+        SystemEntry entry;
+        entry.Name   = std::move(name);
+        entry.Reads  = MaskBuilder<typename Access::Reads>::Components();
+        entry.Writes = MaskBuilder<typename Access::Writes>::Components();
+        entry.ResourceReads =
+            MaskBuilder<typename Access::ResourceReads>::Resources();
+        entry.ResourceWrites =
+            MaskBuilder<typename Access::ResourceWrites>::Resources();
+        entry.Run = [system](World         &world,
+                             JobSystem     *jobs,
+                             CommandBuffer &commands,
+                             float          deltaTime) -> const char * {
+            // A declared resource the world lacks fails the system.
+            const char *missing =
+                MaskBuilder<typename Access::ResourceReads>::
+                    FindMissingResource(world);
+            if (!missing) {
+                missing = MaskBuilder<typename Access::ResourceWrites>::
+                    FindMissingResource(world);
+            }
+            if (missing) {
+                return missing;
+            }
+
+            SystemContext<Access> context(world, jobs, commands, deltaTime);
+            system->Run(context);
+            return nullptr;
+        };
+        m_Systems.push_back(std::move(entry));
+        return *result;
+    }
+
+    void Run(World &world, float deltaTime);
+
+    const std::vector<SystemStats> &GetStats() const { return m_Stats; }
+    double GetFrameMs() const { return m_FrameMs; }
+    double GetCriticalPathMs() const { return m_CriticalPathMs; }
+
+    void LogStats() const;
+
+  private:
+    // Returns the resource that kept the system from running, if any.
+    using RunFunction = std::function<const char *(
+        World &, JobSystem *, CommandBuffer &, float)>;
+
+    struct SystemEntry {
+        std::string   Name;
+        ComponentMask Reads;
+        ComponentMask Writes;
+        ResourceMask  ResourceReads;
+        ResourceMask  ResourceWrites;
+        RunFunction   Run;
+        // Logged that it was skipped; cleared once it runs again.
+        bool          SkipLogged = false;
+
+        std::unique_ptr<CommandBuffer> Commands;
+        std::vector<uint32_t>          Dependents;
+        std::vector<uint32_t>          Dependencies;
+    };
+
+    static bool Conflicts(const SystemEntry &a, const SystemEntry &b);
+
+    void BuildGraph();
+    void Execute(uint32_t index, World &world, float deltaTime);
+    void Launch(uint32_t index, World &world, float deltaTime);
+    void ComputeCriticalPath();
+
+    JobSystem               *m_Jobs;
+    std::vector<SystemEntry> m_Systems;
+    World                   *m_BoundWorld = nullptr;
+
+    // Per-frame state.
+    std::unique_ptr<std::atomic<uint32_t>[]> m_Remaining;
+    JobCounter                               m_Counter;
+    uint64_t                                 m_FrameStart = 0;
+    std::vector<SystemStats>                 m_Stats;
+    double                                   m_FrameMs        = 0.0;
+    double                                   m_CriticalPathMs = 0.0;
+};
+
+} // namespace brnCore
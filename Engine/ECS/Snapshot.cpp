@@ -0,0 +1,698 @@
+#include "Snapshot.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "Engine/Core/FileWriter.h"
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/StringId.h"
+#include "World.h"
+
+namespace brnCore {
+
+struct Snapshot::Header {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Flags;
+    uint64_t ContentHash; // of the logical content, same for full and delta
+    uint64_t BaseHash;    // delta: ContentHash of the base
+    uint64_t TablesHash;  // of the tables that follow the header
+    uint64_t StoredBytes;
+    uint32_t ComponentCount;
+    uint32_t ArchetypeCount;
+    uint32_t BlockCount;
+    uint32_t SlotCount;
+};
+
+struct Snapshot::ComponentRecord {
+    uint64_t Name; // HashFnv1a of the type name
+    uint32_t Size;
+    uint32_t Alignment;
+};
+
+struct Snapshot::ArchetypeRecord {
+    uint64_t Signature; // hash of the sorted component names
+    uint32_t EntityCount;
+    uint32_t FirstBlock; // entity handles, then one block per component
+    uint32_t BlockCount;
+    uint32_t Reserved;
+};
+
+/*
+ * A full snapshot stores Size bytes at Offset. A delta stores PageCount
+ * page indices at Offset, padded to kBlockAlign, followed by those pages;
+ * the rest of the block is the same as in the base.
+ */
+struct Snapshot::BlockRecord {
+    uint64_t Signature; // owning archetype, 0 for the slot table
+    uint64_t Name;      // component name, or kEntityBlock/kSlotBlock
+    uint64_t Hash;      // of the logical bytes
+    uint64_t Offset;
+    uint64_t Size; // logical bytes
+    uint64_t StoredSize;
+    uint32_t Component; // index into the component table
+    uint32_t PageCount;
+};
+
+namespace {
+constexpr uint16_t kDeltaFlag   = 1 << 0;
+constexpr uint64_t kEntityBlock = 1;
+constexpr uint64_t kSlotBlock   = 2;
+constexpr uint32_t kNoComponent = ~0u;
+constexpr size_t   kBlockAlign  = Archetype::kColumnAlign;
+
+constexpr ComponentId kMissing = static_cast<ComponentId>(~0u);
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Delta page indices, padded so the pages after them stay aligned.
+size_t GetPageIndexBytes(uint32_t pageCount) {
+    return AlignUp(size_t(pageCount) * sizeof(uint32_t), kBlockAlign);
+}
+
+uint64_t GetComponentName(ComponentId component) {
+    return HashFnv1a(ComponentRegistry::GetInfo(component).Name);
+}
+
+// Copies rows [0, count) of a column into contiguous `out`.
+void GatherColumn(const Archetype  &table,
+                  int16_t           column,
+                  size_t            elementSize,
+                  std::vector<std::byte> &out) {
+    out.resize(table.GetEntityCount() * elementSize);
+    std::byte *cursor = out.data();
+    for (const Chunk &chunk : table.GetChunks()) {
+        const size_t bytes = chunk.Count * elementSize;
+        std::memcpy(cursor, table.GetColumnData(chunk, column), bytes);
+        cursor += bytes;
+    }
+}
+
+// Copies `count` contiguous rows into a column, starting at row `first`.
+void ScatterColumn(Archetype       &table,
+                   int16_t          column,
+                   size_t           elementSize,
+                   uint32_t         first,
+                   const std::byte *source,
+                   uint32_t         count) {
+    const uint32_t capacity = table.GetChunkCapacity();
+    for (uint32_t row = first; row < first + count;) {
+        const Chunk   &chunk  = table.GetChunks()[row / capacity];
+        const uint32_t offset = row % capacity;
+        const uint32_t rows =
+            std::min(first + count - row, capacity - offset);
+
+        auto *destination =
+            static_cast<std::byte *>(table.GetColumnData(chunk, column));
+        std::memcpy(destination + offset * elementSize,
+                    source,
+                    rows * elementSize);
+        source += rows * elementSize;
+        row += rows;
+    }
+}
+
+} // namespace
+
+bool Snapshot::Write(const World    &world,
+                     const char     *path,
+                     const Snapshot *base) {
+    if (base && (!base->IsOpen() || base->IsDelta())) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Snapshot: the base of %s must be a full snapshot",
+                     path);
+        return false;
+    }
+    world.AssertNotIterating();
+
+    struct Source {
+        const Archetype *Table; // nullptr for the slot table
+        int16_t          Column;
+        size_t           ElementSize;
+    };
+
+    std::vector<ComponentRecord> components;
+    std::vector<ArchetypeRecord> archetypes;
+    std::vector<BlockRecord>     blocks;
+    std::vector<Source>          sources;
+    std::vector<uint32_t>        componentIndex(kMaxComponents, kNoComponent);
+    ComponentMask                skipped;
+
+    const uint32_t slotCount = static_cast<uint32_t>(world.m_Records.size());
+    blocks.push_back({0,
+                      kSlotBlock,
+                      0,
+                      0,
+                      slotCount * sizeof(uint32_t),
+                      0,
+                      kNoComponent,
+                      0});
+    sources.push_back({nullptr, 0, sizeof(uint32_t)});
+
+    for (const auto &archetype : world.m_Archetypes) {
+        const uint32_t count = archetype->GetEntityCount();
+        if (count == 0) {
+            continue;
+        }
+
+        ArchetypeRecord record{};
+        record.EntityCount = count;
+        record.FirstBlock  = static_cast<uint32_t>(blocks.size());
+        blocks.push_back({0,
+                          kEntityBlock,
+                          0,
+                          0,
+                          count * sizeof(Entity),
+                          0,
+                          kNoComponent,
+                          0});
+        sources.push_back({archetype.get(), Archetype::kNoColumn, 0});
+
+        std::vector<uint64_t> names;
+        for (ComponentId component : archetype->GetComponents()) {
+            const ComponentInfo &info = ComponentRegistry::GetInfo(component);
+            if (!info.Trivial && info.Size) {
+                if (!skipped.test(component)) {
+                    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                                 "Snapshot: skipping %s, it is not "
+                                 "trivially copyable",
+                                 info.Name);
+                    skipped.set(component);
+                }
+                continue;
+            }
+
+            if (componentIndex[component] == kNoComponent) {
+                componentIndex[component] =
+                    static_cast<uint32_t>(components.size());
+                components.push_back({GetComponentName(component),
+                                      static_cast<uint32_t>(info.Size),
+                                      static_cast<uint32_t>(info.Alignment)});
+            }
+
+            const uint64_t name = GetComponentName(component);
+            names.push_back(name);
+            blocks.push_back({0,
+                              name,
+                              0,
+                              0,
+                              count * info.Size,
+                              0,
+                              componentIndex[component],
+                              0});
+            sources.push_back(
+                {archetype.get(), archetype->GetColumn(component), info.Size});
+        }
+
+        // By name, not ComponentId: ids depend on registration order.
+        std::ranges::sort(names);
+        uint64_t signature = kFnv1aOffsetBasis;
+        for (uint64_t name : names) {
+            signature = HashCombine(signature, name);
+        }
+        record.Signature  = signature;
+        record.BlockCount = static_cast<uint32_t>(blocks.size()) -
+                            record.FirstBlock;
+        for (uint32_t i = record.FirstBlock; i < blocks.size(); i++) {
+            blocks[i].Signature = signature;
+        }
+        archetypes.push_back(record);
+    }
+
+    // Written next to the file, so a failed autosave keeps the last one.
+    FileWriter writer;
+    if (!writer.Open(path)) {
+        return false;
+    }
+
+    Header header{};
+    header.Magic          = kMagic;
+    header.Version        = kVersion;
+    header.Flags          = base ? kDeltaFlag : 0;
+    header.BaseHash       = base ? base->GetContentHash() : 0;
+    header.ComponentCount = static_cast<uint32_t>(components.size());
+    header.ArchetypeCount = static_cast<uint32_t>(archetypes.size());
+    header.BlockCount     = static_cast<uint32_t>(blocks.size());
+    header.SlotCount      = slotCount;
+
+    // Tables are rewritten once the block offsets are known.
+    const size_t tablesSize = components.size() * sizeof(ComponentRecord) +
+                              archetypes.size() * sizeof(ArchetypeRecord) +
+                              blocks.size() * sizeof(BlockRecord);
+    writer.Write(&header, sizeof(header));
+    std::vector<std::byte> tables(tablesSize);
+    writer.Write(tables.data(), tables.size());
+
+    std::vector<std::byte> scratch;
+    std::vector<uint32_t>  pages;
+    std::vector<uint32_t>  generations;
+
+    uint64_t contentHash = HashCombine(kFnv1aOffsetBasis, slotCount);
+    for (size_t i = 0; i < blocks.size() && writer.IsOk(); i++) {
+        BlockRecord  &block  = blocks[i];
+        const Source &source = sources[i];
+
+        const std::byte *bytes = nullptr;
+        if (!source.Table) {
+            generations.resize(slotCount);
+            for (uint32_t slot = 0; slot < slotCount; slot++) {
+                generations[slot] = world.m_Records[slot].Generation;
+            }
+            bytes = reinterpret_cast<const std::byte *>(generations.data());
+        } else if (source.Column == Archetype::kNoColumn) {
+            scratch.clear();
+            for (const Chunk &chunk : source.Table->GetChunks()) {
+                const auto *entities = reinterpret_cast<const std::byte *>(
+                    source.Table->GetEntities(chunk));
+                scratch.insert(scratch.end(),
+                               entities,
+                               entities + chunk.Count * sizeof(Entity));
+            }
+            bytes = scratch.data();
+        } else {
+            GatherColumn(
+                *source.Table, source.Column, source.ElementSize, scratch);
+            bytes = scratch.data();
+        }
+
+        block.Hash  = HashBytes(bytes, block.Size);
+        contentHash = HashCombine(contentHash, block.Signature);
+        contentHash = HashCombine(contentHash, block.Name);
+        contentHash = HashCombine(contentHash, block.Hash);
+
+        writer.Pad(kBlockAlign);
+        block.Offset = writer.GetPosition();
+        if (!base) {
+            writer.Write(bytes, block.Size);
+            block.StoredSize = block.Size;
+            continue;
+        }
+
+        // Pages past the end of the base block (or without one) are new.
+        std::span<const std::byte> previous;
+        if (const BlockRecord *baseBlock =
+                base->FindBlock(block.Signature, block.Name)) {
+            previous = {base->m_File.GetData() + baseBlock->Offset,
+                        baseBlock->Size};
+        }
+        pages.clear();
+        for (size_t offset = 0; offset < block.Size; offset += kPageSize) {
+            const size_t size = std::min(kPageSize, block.Size - offset);
+            if (offset + size > previous.size() ||
+                std::memcmp(bytes + offset, previous.data() + offset, size)) {
+                pages.push_back(static_cast<uint32_t>(offset / kPageSize));
+            }
+        }
+
+        block.PageCount = static_cast<uint32_t>(pages.size());
+        writer.Write(pages.data(), pages.size() * sizeof(uint32_t));
+        writer.Pad(kBlockAlign);
+        for (uint32_t page : pages) {
+            const size_t offset = page * kPageSize;
+            writer.Write(bytes + offset,
+                         std::min(kPageSize, block.Size - offset));
+        }
+        block.StoredSize = writer.GetPosition() - block.Offset;
+    }
+
+    std::byte *cursor = tables.data();
+    for (const auto &table :
+         {std::span<const std::byte>(std::as_bytes(std::span(components))),
+          std::span<const std::byte>(std::as_bytes(std::span(archetypes))),
+          std::span<const std::byte>(std::as_bytes(std::span(blocks)))}) {
+        std::memcpy(cursor, table.data(), table.size());
+        cursor += table.size();
+    }
+    header.ContentHash = contentHash;
+    header.TablesHash  = HashBytes(tables.data(), tables.size());
+    header.StoredBytes = writer.GetPosition() - sizeof(header) - tablesSize;
+
+    writer.WriteAt(0, &header, sizeof(header));
+    writer.WriteAt(sizeof(header), tables.data(), tables.size());
+    return writer.Commit();
+}
+
+bool Snapshot::Open(const char *path) {
+    Close();
+    if (!m_File.Open(path)) {
+        return false;
+    }
+
+    auto fail = [&](const char *reason) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_CUSTOM, "Snapshot: %s: %s", path, reason);
+        m_File.Close();
+        return false;
+    };
+
+    if (m_File.GetSize() < sizeof(Header)) {
+        return fail("truncated header");
+    }
+    const Header &header = GetHeader();
+    if (header.Magic != kMagic) {
+        return fail("not a snapshot");
+    }
+    if (header.Version != kVersion) {
+        return fail("unsupported version");
+    }
+
+    const size_t tablesSize =
+        header.ComponentCount * sizeof(ComponentRecord) +
+        header.ArchetypeCount * sizeof(ArchetypeRecord) +
+        header.BlockCount * sizeof(BlockRecord);
+    if (m_File.GetSize() < sizeof(Header) + tablesSize) {
+        return fail("truncated tables");
+    }
+    if (HashBytes(m_File.GetData() + sizeof(Header), tablesSize) !=
+        header.TablesHash) {
+        return fail("corrupt tables");
+    }
+
+    // Only the tables are checked here; block contents are paged in by use.
+    const bool         delta  = header.Flags & kDeltaFlag;
+    const BlockRecord *blocks = GetBlockRecords();
+    for (uint32_t i = 0; i < header.BlockCount; i++) {
+        const BlockRecord &block = blocks[i];
+        if (block.StoredSize > m_File.GetSize() ||
+            block.Offset > m_File.GetSize() - block.StoredSize ||
+            block.Offset % kBlockAlign != 0 ||
+            (delta ? GetPageIndexBytes(block.PageCount) > block.StoredSize
+                   : block.StoredSize != block.Size) ||
+            (block.Component != kNoComponent &&
+             block.Component >= header.ComponentCount)) {
+            return fail("block out of range");
+        }
+    }
+    if (header.BlockCount == 0 || blocks[0].Name != kSlotBlock ||
+        blocks[0].Size != header.SlotCount * sizeof(uint32_t)) {
+        return fail("missing entity slots");
+    }
+
+    const ArchetypeRecord *archetypes = GetArchetypeRecords();
+    for (uint32_t i = 0; i < header.ArchetypeCount; i++) {
+        const ArchetypeRecord &archetype = archetypes[i];
+        if (archetype.BlockCount == 0 ||
+            archetype.FirstBlock + archetype.BlockCount > header.BlockCount ||
+            blocks[archetype.FirstBlock].Name != kEntityBlock ||
+            blocks[archetype.FirstBlock].Size !=
+                archetype.EntityCount * sizeof(Entity)) {
+            return fail("archetype out of range");
+        }
+    }
+    return true;
+}
+
+void Snapshot::Close() { m_File.Close(); }
+
+bool Snapshot::IsDelta() const {
+    return IsOpen() && (GetHeader().Flags & kDeltaFlag);
+}
+
+uint64_t Snapshot::GetContentHash() const {
+    return IsOpen() ? GetHeader().ContentHash : 0;
+}
+
+uint64_t Snapshot::GetStoredBytes() const {
+    return IsOpen() ? GetHeader().StoredBytes : 0;
+}
+
+bool Snapshot::Restore(World &world, const Snapshot *base) const {
+    if (!IsOpen()) {
+        return false;
+    }
+    const Header &header = GetHeader();
+    if (IsDelta() &&
+        (!base || base->IsDelta() ||
+         base->GetContentHash() != header.BaseHash)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Snapshot: delta restored without the base it was "
+                     "written against");
+        return false;
+    }
+    world.AssertNotIterating();
+    m_File.Prefetch(); // every block is read front to back
+
+    // Match components by name; types never used by this run are unknown.
+    std::vector<ComponentId> componentIds(header.ComponentCount, kMissing);
+    const ComponentRecord   *records = GetComponentRecords();
+    for (ComponentId id = 0; id < ComponentRegistry::GetCount(); id++) {
+        const uint64_t name = GetComponentName(id);
+        for (uint32_t i = 0; i < header.ComponentCount; i++) {
+            if (records[i].Name == name &&
+                records[i].Size == ComponentRegistry::GetInfo(id).Size) {
+                componentIds[i] = id;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < header.ComponentCount; i++) {
+        if (componentIds[i] == kMissing) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                        "Snapshot: dropping unknown component %016llx",
+                        static_cast<unsigned long long>(records[i].Name));
+        } else if (!ComponentRegistry::GetInfo(componentIds[i]).Trivial) {
+            // The type changed since the file was written; bytes would
+            // not make a valid object of it.
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "Snapshot: dropping %s, it is no longer trivially "
+                         "copyable",
+                         ComponentRegistry::GetInfo(componentIds[i]).Name);
+            componentIds[i] = kMissing;
+        }
+    }
+
+    /*
+     * Everything is read and checked before the world is touched, so a
+     * corrupt file or a delta against the wrong base leaves it as it
+     * was. Blocks of a full snapshot are read in place; a delta's are
+     * patched into buffers of their own, which costs a copy of the
+     * world for the duration.
+     */
+    struct Column {
+        ComponentId                Component;
+        std::span<const std::byte> Bytes;
+    };
+    struct Table {
+        std::vector<ComponentId> Components;
+        std::span<const Entity>  Entities;
+        std::vector<Column>      Columns;
+    };
+
+    auto fail = [](const char *reason) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Snapshot: %s", reason);
+        return false;
+    };
+
+    std::vector<std::vector<std::byte>> buffers;
+    auto read = [&](const BlockRecord &block, std::span<const std::byte> &out) {
+        return ReadBlock(block, base, buffers.emplace_back(), out);
+    };
+
+    std::span<const std::byte> slots;
+    if (!read(GetBlockRecords()[0], slots)) {
+        return false;
+    }
+
+    const ArchetypeRecord *archetypes = GetArchetypeRecords();
+    const BlockRecord     *blocks     = GetBlockRecords();
+    std::vector<Table>     tables(header.ArchetypeCount);
+    std::vector<uint8_t>   used(header.SlotCount, 0);
+    for (uint32_t i = 0; i < header.ArchetypeCount; i++) {
+        const ArchetypeRecord &record = archetypes[i];
+        const BlockRecord     *first  = blocks + record.FirstBlock;
+        Table                 &table  = tables[i];
+
+        std::span<const std::byte> bytes;
+        if (!read(first[0], bytes)) {
+            return false;
+        }
+        table.Entities = {reinterpret_cast<const Entity *>(bytes.data()),
+                          record.EntityCount};
+        for (const Entity entity : table.Entities) {
+            if (entity.Index >= header.SlotCount || used[entity.Index]) {
+                return fail("entity out of range");
+            }
+            used[entity.Index] = 1;
+        }
+
+        for (uint32_t b = 1; b < record.BlockCount; b++) {
+            if (first[b].Component >= header.ComponentCount) {
+                return fail("component block without a component");
+            }
+            const ComponentId component = componentIds[first[b].Component];
+            if (component == kMissing) {
+                continue;
+            }
+            table.Components.push_back(component);
+
+            const size_t size = ComponentRegistry::GetInfo(component).Size;
+            if (size == 0) {
+                continue;
+            }
+            if (first[b].Size != record.EntityCount * size) {
+                return fail("component block of the wrong size");
+            }
+            if (!read(first[b], bytes)) {
+                return false;
+            }
+            table.Columns.push_back({component, bytes});
+        }
+    }
+
+    // Nothing below can fail.
+    for (const auto &archetype : world.m_Archetypes) {
+        archetype->Clear();
+    }
+    world.m_FreeList.clear();
+    world.m_AliveCount = 0;
+
+    world.m_Records.assign(header.SlotCount, {});
+    for (uint32_t slot = 0; slot < header.SlotCount; slot++) {
+        std::memcpy(&world.m_Records[slot].Generation,
+                    slots.data() + slot * sizeof(uint32_t),
+                    sizeof(uint32_t));
+    }
+
+    for (const Table &source : tables) {
+        Archetype     *table = world.GetOrCreateArchetype(source.Components);
+        const uint32_t count = static_cast<uint32_t>(source.Entities.size());
+        const uint32_t row   = table->PushRows(source.Entities.data(), count);
+        for (uint32_t e = 0; e < count; e++) {
+            World::EntityRecord &entity =
+                world.m_Records[source.Entities[e].Index];
+            entity.Table = table;
+            entity.Row   = row + e;
+        }
+        world.m_AliveCount += count;
+
+        for (const Column &column : source.Columns) {
+            ScatterColumn(*table,
+                          table->GetColumn(column.Component),
+                          ComponentRegistry::GetInfo(column.Component).Size,
+                          row,
+                          column.Bytes.data(),
+                          count);
+        }
+    }
+
+    // Reuse the lowest free slots first, like a world that was never saved.
+    for (uint32_t slot = header.SlotCount; slot > 0; slot--) {
+        if (!world.m_Records[slot - 1].Table) {
+            world.m_FreeList.push_back(slot - 1);
+        }
+    }
+    world.m_NextIndex = header.SlotCount;
+    return true;
+}
+
+uint32_t Snapshot::GetArchetypeCount() const {
+    return IsOpen() ? GetHeader().ArchetypeCount : 0;
+}
+
+std::span<const Entity> Snapshot::GetEntities(uint32_t archetype) const {
+    if (IsDelta() || archetype >= GetArchetypeCount()) {
+        return {};
+    }
+    const ArchetypeRecord &record = GetArchetypeRecords()[archetype];
+    const BlockRecord     &block  = GetBlockRecords()[record.FirstBlock];
+    return {reinterpret_cast<const Entity *>(m_File.GetData() + block.Offset),
+            record.EntityCount};
+}
+
+const void *Snapshot::GetColumn(uint32_t    archetype,
+                                ComponentId component) const {
+    if (IsDelta() || archetype >= GetArchetypeCount()) {
+        return nullptr;
+    }
+    const ArchetypeRecord &record = GetArchetypeRecords()[archetype];
+    const BlockRecord     *blocks = GetBlockRecords() + record.FirstBlock;
+    const uint64_t         name   = GetComponentName(component);
+    for (uint32_t b = 1; b < record.BlockCount; b++) {
+        if (blocks[b].Name == name) {
+            return m_File.GetData() + blocks[b].Offset;
+        }
+    }
+    return nullptr;
+}
+
+const Snapshot::Header &Snapshot::GetHeader() const {
+    return *reinterpret_cast<const Header *>(m_File.GetData());
+}
+
+const Snapshot::ComponentRecord *Snapshot::GetComponentRecords() const {
+    return reinterpret_cast<const ComponentRecord *>(m_File.GetData() +
+                                                     sizeof(Header));
+}
+
+const Snapshot::ArchetypeRecord *Snapshot::GetArchetypeRecords() const {
+    return reinterpret_cast<const ArchetypeRecord *>(
+        GetComponentRecords() + GetHeader().ComponentCount);
+}
+
+const Snapshot::BlockRecord *Snapshot::GetBlockRecords() const {
+    return reinterpret_cast<const BlockRecord *>(GetArchetypeRecords() +
+                                                 GetHeader().ArchetypeCount);
+}
+
+const Snapshot::BlockRecord *Snapshot::FindBlock(uint64_t signature,
+                                                 uint64_t name) const {
+    const BlockRecord *blocks = GetBlockRecords();
+    for (uint32_t i = 0; i < GetHeader().BlockCount; i++) {
+        if (blocks[i].Signature == signature && blocks[i].Name == name) {
+            return &blocks[i];
+        }
+    }
+    return nullptr;
+}
+
+bool Snapshot::ReadBlock(const BlockRecord          &block,
+                         const Snapshot             *base,
+                         std::vector<std::byte>     &scratch,
+                         std::span<const std::byte> &out) const {
+    if (!IsDelta()) {
+        out = {m_File.GetData() + block.Offset, block.Size};
+        return true;
+    }
+
+    // Start from the base block and patch the pages that changed.
+    scratch.assign(block.Size, std::byte{0});
+    if (const BlockRecord *baseBlock =
+            base->FindBlock(block.Signature, block.Name)) {
+        std::memcpy(scratch.data(),
+                    base->m_File.GetData() + baseBlock->Offset,
+                    std::min(block.Size, baseBlock->Size));
+    }
+
+    // Open checked that the page indices fit; each page is checked here.
+    const std::byte *stored     = m_File.GetData() + block.Offset;
+    const size_t     indexBytes = GetPageIndexBytes(block.PageCount);
+    for (uint32_t i = 0; i < block.PageCount; i++) {
+        uint32_t page;
+        std::memcpy(&page, stored + i * sizeof(uint32_t), sizeof(page));
+
+        const size_t offset   = size_t(page) * kPageSize;
+        const size_t position = indexBytes + kPageSize * i;
+        // The last page of a block is stored short.
+        const size_t size =
+            offset < block.Size ? std::min(kPageSize, block.Size - offset) : 0;
+        if (offset >= block.Size || position + size > block.StoredSize) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "Snapshot: corrupt delta block");
+            return false;
+        }
+        std::memcpy(scratch.data() + offset, stored + position, size);
+    }
+
+    if (HashBytes(scratch.data(), scratch.size()) != block.Hash) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Snapshot: delta does not match its base");
+        return false;
+    }
+    out = scratch;
+    return true;
+}
+
+} // namespace brnCore
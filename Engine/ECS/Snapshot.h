@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Engine/Core/MappedFile.h"
+#include "Engine/ECS/Component.h"
+#include "Engine/ECS/Entity.h"
+
+namespace brnCore {
+
+class World;
+
+/*
+ * Binary snapshot of a World's entities and components.
+ *
+ * Every archetype is written as contiguous blocks, one for its entity
+ * handles and one per component column, found through an offset table at
+ * the front of the file. Opening a snapshot maps the file and checks the
+ * tables; the blocks are only touched when they are read, so a full
+ * snapshot can be used in place (GetEntities/GetColumn) and restoring one
+ * is a memcpy per chunk, bounded by how fast the pages come in.
+ *
+ * Nothing in the file is a pointer. Component types are matched to the
+ * running program by name, and entity slots are restored with their
+ * generations, so Entity handles stored in components stay valid. Only
+ * trivially copyable components are written; keep references to other
+ * entities as Entity handles, not pointers.
+ *
+ * A delta snapshot stores only the pages of each block that differ from
+ * a base snapshot, for frequent autosaves and rollback: keep one full
+ * snapshot and write deltas against it.
+ */
+class Snapshot {
+  public:
+    static constexpr uint32_t kMagic    = 0x534e5242; // "BRNS"
+    static constexpr uint16_t kVersion  = 1;
+    static constexpr size_t   kPageSize = 4096; // delta granularity
+
+    Snapshot() = default;
+
+    /*
+     * Writes `world` to `path`. With a base, writes a delta against it;
+     * the base must be a full snapshot and stay available for Restore().
+     */
+    static bool Write(const World    &world,
+                      const char     *path,
+                      const Snapshot *base = nullptr);
+
+    // Maps the file and validates its header and tables.
+    bool Open(const char *path);
+    void Close();
+
+    /*
+     * Replaces every entity in `world` with the snapshot's. A delta needs
+     * the base it was written against. On failure `world` is unchanged.
+     */
+    bool Restore(World &world, const Snapshot *base = nullptr) const;
+
+    bool IsOpen() const { return m_File.IsOpen(); }
+    bool IsDelta() const;
+
+    uint64_t GetContentHash() const;
+    size_t   GetFileSize() const { return m_File.GetSize(); }
+    // Bytes of block data stored in the file (changed pages for a delta).
+    uint64_t GetStoredBytes() const;
+
+    // In-place access to a full snapshot, without restoring it.
+    uint32_t                GetArchetypeCount() const;
+    std::span<const Entity> GetEntities(uint32_t archetype) const;
+    // nullptr if the archetype has no such column (or this is a delta).
+    const void *GetColumn(uint32_t archetype, ComponentId component) const;
+
+  private:
+    struct Header;
+    struct ComponentRecord;
+    struct ArchetypeRecord;
+    struct BlockRecord;
+
+    const Header          &GetHeader() const;
+    const ComponentRecord *GetComponentRecords() const;
+    const ArchetypeRecord *GetArchetypeRecords() const;
+    const BlockRecord     *GetBlockRecords() const;
+
+    const BlockRecord *FindBlock(uint64_t signature,
+                                 uint64_t componentName) const;
+
+    /*
+     * Points `out` at the block's bytes: straight into the mapping for a
+     * full snapshot, or into `scratch` after patching the base for a delta.
+     */
+    bool ReadBlock(const BlockRecord          &block,
+                   const Snapshot             *base,
+                   std::vector<std::byte>     &scratch,
+                   std::span<const std::byte> &out) const;
+
+    MappedFile m_File;
+};
+
+} // namespace brnCore
@@ -0,0 +1,236 @@
+#include "World.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace brnCore {
+
+World::World() { m_RootArchetype = GetOrCreateArchetype({}); }
+
+World::~World() = default;
+
+Entity World::CreateEntity() {
+    AssertNotIterating();
+    const Entity entity = ReserveEntity();
+    AdoptReserved(entity);
+    return entity;
+}
+
+Entity World::ReserveEntity() {
+    std::scoped_lock lock(m_ReserveMutex);
+
+    Entity entity;
+    if (!m_FreeList.empty()) {
+        entity.Index = m_FreeList.back();
+        m_FreeList.pop_back();
+        entity.Generation = m_Records[entity.Index].Generation;
+    } else {
+        entity.Index      = m_NextIndex++;
+        entity.Generation = 0;
+    }
+    return entity;
+}
+
+void World::AdoptReserved(Entity entity) {
+    AssertNotIterating();
+    if (entity.Index >= m_Records.size()) {
+        m_Records.resize(entity.Index + 1);
+    }
+
+    EntityRecord &record = m_Records[entity.Index];
+    assert(!record.Table && record.Generation == entity.Generation);
+
+    record.Table = m_RootArchetype;
+    record.Row   = m_RootArchetype->PushRow(entity);
+    m_AliveCount++;
+}
+
+void World::DestroyEntity(Entity entity) {
+    AssertNotIterating();
+    if (!IsAlive(entity)) {
+        return;
+    }
+
+    EntityRecord &record = m_Records[entity.Index];
+    const Entity  moved  = record.Table->RemoveRow(record.Row, true);
+    if (moved.IsValid()) {
+        m_Records[moved.Index].Row = record.Row;
+    }
+
+    record.Table = nullptr;
+    record.Generation++;
+    m_AliveCount--;
+
+    std::scoped_lock lock(m_ReserveMutex);
+    m_FreeList.push_back(entity.Index);
+}
+
+bool World::IsAlive(Entity entity) const {
+    return entity.Index < m_Records.size() &&
+           m_Records[entity.Index].Table &&
+           m_Records[entity.Index].Generation == entity.Generation;
+}
+
+void *World::AddComponentRaw(Entity entity, ComponentId component) {
+    AssertNotIterating();
+    assert(IsAlive(entity));
+
+    EntityRecord &record = m_Records[entity.Index];
+    if (record.Table->Has(component)) {
+        const ComponentInfo &info = ComponentRegistry::GetInfo(component);
+        void *storage = info.Size ? record.Table->GetComponent(
+                                        record.Row, component)
+                                  : nullptr;
+        if (storage && !info.Trivial) {
+            info.Destroy(storage);
+        }
+        return storage;
+    }
+
+    MoveEntity(entity, GetAddTarget(record.Table, component));
+    return GetComponentRaw(entity, component);
+}
+
+void World::RemoveComponentRaw(Entity entity, ComponentId component) {
+    AssertNotIterating();
+    assert(IsAlive(entity));
+
+    EntityRecord &record = m_Records[entity.Index];
+    if (!record.Table->Has(component)) {
+        return;
+    }
+    MoveEntity(entity, GetRemoveTarget(record.Table, component));
+}
+
+void *World::GetComponentRaw(Entity entity, ComponentId component) const {
+    if (!IsAlive(entity)) {
+        return nullptr;
+    }
+
+    const EntityRecord &record = m_Records[entity.Index];
+    if (!record.Table->Has(component) ||
+        !ComponentRegistry::GetInfo(component).Size) {
+        return nullptr;
+    }
+    return record.Table->GetComponent(record.Row, component);
+}
+
+Archetype *World::GetOrCreateArchetype(std::vector<ComponentId> components) {
+    ComponentMask mask;
+    for (ComponentId component : components) {
+        mask.set(component);
+    }
+
+    if (auto it = m_ArchetypeLookup.find(mask); it != m_ArchetypeLookup.end()) {
+        return it->second;
+    }
+
+    auto archetype = std::make_unique<Archetype>(
+        static_cast<uint32_t>(m_Archetypes.size()), std::move(components));
+    Archetype *result = archetype.get();
+    m_Archetypes.push_back(std::move(archetype));
+    m_ArchetypeLookup.emplace(mask, result);
+
+    // Keep cached queries current instead of re-matching on every iteration.
+    for (const auto &query : m_Queries) {
+        if (query->Matches(*result)) {
+            query->Append(result);
+        }
+    }
+    return result;
+}
+
+Archetype *World::GetAddTarget(Archetype *from, ComponentId component) {
+    if (auto it = from->AddEdges.find(component); it != from->AddEdges.end()) {
+        return it->second;
+    }
+
+    std::vector<ComponentId> components = from->GetComponents();
+    components.push_back(component);
+
+    Archetype *to = GetOrCreateArchetype(std::move(components));
+    from->AddEdges.emplace(component, to);
+    to->RemoveEdges.emplace(component, from);
+    return to;
+}
+
+Archetype *World::GetRemoveTarget(Archetype *from, ComponentId component) {
+    if (auto it = from->RemoveEdges.find(component);
+        it != from->RemoveEdges.end()) {
+        return it->second;
+    }
+
+    std::vector<ComponentId> components = from->GetComponents();
+    std::erase(components, component);
+
+    Archetype *to = GetOrCreateArchetype(std::move(components));
+    from->RemoveEdges.emplace(component, to);
+    to->AddEdges.emplace(component, from);
+    return to;
+}
+
+void World::MoveEntity(Entity entity, Archetype *to) {
+    EntityRecord &record = m_Records[entity.Index];
+    Archetype    *from   = record.Table;
+    if (from == to) {
+        return;
+    }
+
+    const uint32_t fromRow = record.Row;
+    const uint32_t toRow   = to->PushRow(entity);
+
+    // Relocate shared components; ones only in `to` stay uninitialized for
+    // the caller, ones only in `from` are destroyed.
+    for (ComponentId component : from->GetComponents()) {
+        const ComponentInfo &info = ComponentRegistry::GetInfo(component);
+        if (!info.Size) {
+            continue;
+        }
+
+        void *src = from->GetComponent(fromRow, component);
+        if (to->Has(component)) {
+            void *dst = to->GetComponent(toRow, component);
+            if (info.Trivial) {
+                std::memcpy(dst, src, info.Size);
+            } else {
+                info.Relocate(dst, src);
+            }
+        } else if (!info.Trivial) {
+            info.Destroy(src);
+        }
+    }
+
+    const Entity moved = from->RemoveRow(fromRow, false);
+    if (moved.IsValid()) {
+        m_Records[moved.Index].Row = fromRow;
+    }
+
+    record.Table = to;
+    record.Row   = toRow;
+}
+
+QueryState *World::GetOrCreateQueryState(std::vector<ComponentId> components) {
+    std::scoped_lock lock(m_QueryMutex);
+    if (auto it = m_QueryLookup.find(components); it != m_QueryLookup.end()) {
+        return it->second;
+    }
+
+    auto state            = std::make_unique<QueryState>();
+    state->Components     = components;
+    state->IterationDepth = &m_IterationDepth;
+    for (ComponentId component : components) {
+        state->Required.set(component);
+    }
+    for (const auto &archetype : m_Archetypes) {
+        if (state->Matches(*archetype)) {
+            state->Append(archetype.get());
+        }
+    }
+
+    QueryState *result = state.get();
+    m_Queries.push_back(std::move(state));
+    m_QueryLookup.emplace(std::move(components), result);
+    return result;
+}
+
+} // namespace brnCore
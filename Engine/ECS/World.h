@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/ECS/Archetype.h"
+#include "Engine/ECS/Component.h"
+#include "Engine/ECS/Entity.h"
+#include "Engine/ECS/Query.h"
+
+namespace brnCore {
+
+/*
+ * Owns all entities, their archetype tables and the cached queries.
+ *
+ * Structural changes (create/destroy, add/remove component) move rows
+ * between archetypes and are therefore not allowed while a query is being
+ * iterated; use a CommandBuffer and flush it afterwards.
+ */
+class World {
+  public:
+    World();
+    ~World();
+
+    World(const World &)            = delete;
+    World &operator=(const World &) = delete;
+
+    Entity CreateEntity();
+
+    template <typename... Ts>
+    Entity CreateEntity(Ts &&...components) {
+        static_assert(sizeof...(Ts) > 0);
+        Entity entity = CreateEntity();
+        Archetype *archetype = GetOrCreateArchetype(
+            {ComponentRegistry::GetId<std::remove_cvref_t<Ts>>()...});
+        MoveEntity(entity, archetype);
+        (ConstructInPlace<std::remove_cvref_t<Ts>>(
+             entity, std::forward<Ts>(components)),
+         ...);
+        return entity;
+    }
+
+    void DestroyEntity(Entity entity);
+    bool IsAlive(Entity entity) const;
+
+    /*
+     * Hands out an entity id without touching archetype storage, so it is
+     * safe during iteration and from worker threads. The entity becomes
+     * alive once AdoptReserved() is called for it (CommandBuffer::Flush).
+     */
+    Entity ReserveEntity();
+    void   AdoptReserved(Entity entity);
+
+    // Replaces the component if the entity already has one.
+    template <ComponentType T, typename... Args>
+    T &AddComponent(Entity entity, Args &&...args) {
+        void *storage = AddComponentRaw(entity, ComponentRegistry::GetId<T>());
+        if constexpr (std::is_empty_v<T>) {
+            // Tags have no per-entity storage.
+            static T tag;
+            return tag;
+        } else {
+            return *::new (storage) T(std::forward<Args>(args)...);
+        }
+    }
+
+    template <ComponentType T>
+    void RemoveComponent(Entity entity) {
+        RemoveComponentRaw(entity, ComponentRegistry::GetId<T>());
+    }
+
+    template <ComponentType T>
+    T *GetComponent(Entity entity) const {
+        return static_cast<T *>(
+            GetComponentRaw(entity, ComponentRegistry::GetId<T>()));
+    }
+
+    template <ComponentType T>
+    bool HasComponent(Entity entity) const {
+        assert(IsAlive(entity));
+        const EntityRecord &record = m_Records[entity.Index];
+        return record.Table->Has(ComponentRegistry::GetId<T>());
+    }
+
+    // Returns the cached query for this component set, creating it once.
+    template <typename... Ts>
+    Query<Ts...> CreateQuery() {
+        return Query<Ts...>(GetOrCreateQueryState(
+            {ComponentRegistry::GetId<std::remove_const_t<Ts>>()...}));
+    }
+
+    // Convenience for one-off iteration; hot paths should keep the Query.
+    template <typename... Ts, typename Fn>
+    void Each(Fn &&fn) {
+        CreateQuery<Ts...>().Each(std::forward<Fn>(fn));
+    }
+
+    // Creates or replaces the world's instance of resource T.
+    template <typename T, typename... Args>
+    T &SetResource(Args &&...args) {
+        const ResourceId id = ResourceRegistry::GetId<T>();
+        if (id >= m_Resources.size()) {
+            m_Resources.resize(id + 1);
+        }
+        auto resource   = std::make_shared<T>(std::forward<Args>(args)...);
+        T   *result     = resource.get();
+        m_Resources[id] = std::move(resource);
+        return *result;
+    }
+
+    template <typename T>
+    T *GetResource() const {
+        const ResourceId id = ResourceRegistry::GetId<T>();
+        return id < m_Resources.size()
+                   ? static_cast<T *>(m_Resources[id].get())
+                   : nullptr;
+    }
+
+    // Type-erased variants used by CommandBuffer and serialization.
+    void *AddComponentRaw(Entity entity, ComponentId component);
+    void  RemoveComponentRaw(Entity entity, ComponentId component);
+    void *GetComponentRaw(Entity entity, ComponentId component) const;
+
+    bool IsIterating() const {
+        return m_IterationDepth.load(std::memory_order_relaxed) > 0;
+    }
+
+    size_t GetEntityCount() const { return m_AliveCount; }
+    size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+
+    const std::vector<std::unique_ptr<Archetype>> &GetArchetypes() const {
+        return m_Archetypes;
+    }
+
+  private:
+    // Reads and rebuilds the entity table and archetypes in bulk.
+    friend class Snapshot;
+
+    struct EntityRecord {
+        Archetype *Table      = nullptr;
+        uint32_t   Row        = 0;
+        uint32_t   Generation = 0;
+    };
+
+    template <typename T, typename Arg>
+    void ConstructInPlace(Entity entity, Arg &&arg) {
+        if constexpr (!std::is_empty_v<T>) {
+            ::new (GetComponentRaw(entity, ComponentRegistry::GetId<T>()))
+                T(std::forward<Arg>(arg));
+        }
+    }
+
+    Archetype  *GetOrCreateArchetype(std::vector<ComponentId> components);
+    Archetype  *GetAddTarget(Archetype *from, ComponentId component);
+    Archetype  *GetRemoveTarget(Archetype *from, ComponentId component);
+    void        MoveEntity(Entity entity, Archetype *to);
+    QueryState *GetOrCreateQueryState(std::vector<ComponentId> components);
+
+    void AssertNotIterating() const {
+        assert(!IsIterating() &&
+               "Structural change during iteration; use a CommandBuffer");
+    }
+
+    std::vector<EntityRecord> m_Records;
+    std::vector<uint32_t>     m_FreeList;
+    size_t                    m_AliveCount = 0;
+
+    // Guards id reservation only; records are created at AdoptReserved.
+    std::mutex m_ReserveMutex;
+    uint32_t   m_NextIndex = 0;
+
+    std::vector<std::unique_ptr<Archetype>>        m_Archetypes;
+    std::unordered_map<ComponentMask, Archetype *> m_ArchetypeLookup;
+    Archetype                                     *m_RootArchetype = nullptr;
+
+    // Keyed by the ordered component list: column order follows the query.
+    // Systems running in parallel may look queries up concurrently.
+    std::mutex                                        m_QueryMutex;
+    std::vector<std::unique_ptr<QueryState>>          m_Queries;
+    std::map<std::vector<ComponentId>, QueryState *> m_QueryLookup;
+
+    std::vector<std::shared_ptr<void>> m_Resources;
+
+    mutable std::atomic<int> m_IterationDepth{0};
+};
+
+} // namespace brnCore
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace brnCore {
+
+// Axis-aligned box; 2D users keep z at 0 on both corners.
+struct Aabb {
+    glm::vec3 Min = glm::vec3(0.0f);
+    glm::vec3 Max = glm::vec3(0.0f);
+
+    static Aabb FromCenter(const glm::vec3 &center,
+                           const glm::vec3 &halfExtent) {
+        return {center - halfExtent, center + halfExtent};
+    }
+
+    glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+    glm::vec3 GetExtent() const { return Max - Min; }
+
+    // SAH cost metric; flat (2D) boxes degrade to twice their area.
+    float GetSurfaceArea() const {
+        const glm::vec3 e = Max - Min;
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+
+    Aabb Expanded(const glm::vec3 &margin) const {
+        return {Min - margin, Max + margin};
+    }
+
+    bool Overlaps(const Aabb &other) const {
+        return Min.x <= other.Max.x && Max.x >= other.Min.x &&
+               Min.y <= other.Max.y && Max.y >= other.Min.y &&
+               Min.z <= other.Max.z && Max.z >= other.Min.z;
+    }
+
+    bool Contains(const Aabb &other) const {
+        return Min.x <= other.Min.x && Min.y <= other.Min.y &&
+               Min.z <= other.Min.z && Max.x >= other.Max.x &&
+               Max.y >= other.Max.y && Max.z >= other.Max.z;
+    }
+
+    // Squared distance from a point to the box, 0 if inside.
+    float DistanceSquared(const glm::vec3 &point) const {
+        const glm::vec3 delta =
+            glm::max(glm::max(Min - point, point - Max), glm::vec3(0.0f));
+        return glm::dot(delta, delta);
+    }
+
+    static Aabb Union(const Aabb &a, const Aabb &b) {
+        return {glm::min(a.Min, b.Min), glm::max(a.Max, b.Max)};
+    }
+};
+
+} // namespace brnCore
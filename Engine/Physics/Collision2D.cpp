@@ -0,0 +1,302 @@
+#include "Collision2D.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtc/constants.hpp>
+
+namespace brnCore {
+
+namespace {
+// A box as a world-space polygon; edge i runs from vertex i to i + 1.
+struct BoxPolygon {
+    glm::vec2 Vertices[4];
+    glm::vec2 Normals[4];
+};
+
+struct ClipVertex {
+    glm::vec2 Point;
+    uint32_t  Id;
+};
+
+BoxPolygon MakePolygon(const glm::vec2 &h, const Transform2D &transform) {
+    const glm::vec2 vertices[4] = {
+        {-h.x, -h.y}, {h.x, -h.y}, {h.x, h.y}, {-h.x, h.y}};
+    const glm::vec2 normals[4] = {
+        {0.0f, -1.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {-1.0f, 0.0f}};
+
+    BoxPolygon polygon;
+    for (int i = 0; i < 4; i++) {
+        polygon.Vertices[i] = transform.Apply(vertices[i]);
+        polygon.Normals[i]  = transform.Rotation.Rotate(normals[i]);
+    }
+    return polygon;
+}
+
+// Largest distance of `b` in front of one of `a`'s edges; > 0 = separated.
+float FindMaxSeparation(const BoxPolygon &a, const BoxPolygon &b, int &edge) {
+    float best = -std::numeric_limits<float>::max();
+    for (int i = 0; i < 4; i++) {
+        float separation = std::numeric_limits<float>::max();
+        for (const glm::vec2 &vertex : b.Vertices) {
+            separation = std::min(
+                separation, glm::dot(a.Normals[i], vertex - a.Vertices[i]));
+        }
+        if (separation > best) {
+            best = separation;
+            edge = i;
+        }
+    }
+    return best;
+}
+
+/*
+ * Keeps the part of the segment with dot(normal, p) <= offset. A clipped
+ * point keeps the id of the vertex it replaces: boxes of the same size
+ * stacked on each other have their corners right on the side planes, and
+ * a new id whenever one drifts across would throw away the warm start.
+ */
+int ClipSegment(ClipVertex       out[2],
+                const ClipVertex in[2],
+                const glm::vec2 &normal,
+                float            offset) {
+    const float distance0 = glm::dot(normal, in[0].Point) - offset;
+    const float distance1 = glm::dot(normal, in[1].Point) - offset;
+
+    int count = 0;
+    if (distance0 <= 0.0f) {
+        out[count++] = in[0];
+    }
+    if (distance1 <= 0.0f) {
+        out[count++] = in[1];
+    }
+    if (distance0 * distance1 < 0.0f) {
+        const float t = distance0 / (distance0 - distance1);
+        out[count++]  = {in[0].Point + t * (in[1].Point - in[0].Point),
+                         distance0 > 0.0f ? in[0].Id : in[1].Id};
+    }
+    return count;
+}
+
+void CollideCircles(float              radiusA,
+                    const Transform2D &transformA,
+                    float              radiusB,
+                    const Transform2D &transformB,
+                    float              speculativeDistance,
+                    Manifold2D        &manifold) {
+    const glm::vec2 delta      = transformB.Position - transformA.Position;
+    const float     distance   = glm::length(delta);
+    const float     separation = distance - radiusA - radiusB;
+    if (separation > speculativeDistance) {
+        return;
+    }
+
+    const glm::vec2 normal =
+        distance > 1e-6f ? delta / distance : glm::vec2(0.0f, 1.0f);
+    const glm::vec2 surfaceA = transformA.Position + radiusA * normal;
+    const glm::vec2 surfaceB = transformB.Position - radiusB * normal;
+
+    manifold.Normal               = normal;
+    manifold.Points[0].Point      = 0.5f * (surfaceA + surfaceB);
+    manifold.Points[0].Separation = separation;
+    manifold.PointCount           = 1;
+}
+
+void CollideBoxCircle(const glm::vec2   &halfExtent,
+                      const Transform2D &transformA,
+                      float              radius,
+                      const Transform2D &transformB,
+                      float              speculativeDistance,
+                      Manifold2D        &manifold) {
+    const glm::vec2 center  = transformA.ApplyInverse(transformB.Position);
+    const glm::vec2 clamped = glm::clamp(center, -halfExtent, halfExtent);
+
+    glm::vec2 normal;
+    glm::vec2 surface;
+    float     separation;
+    if (clamped == center) {
+        // Centre inside the box: push out through the nearest face.
+        const float faceX = std::abs(center.x) - halfExtent.x;
+        const float faceY = std::abs(center.y) - halfExtent.y;
+        surface           = center;
+        if (faceX > faceY) {
+            normal     = glm::vec2(center.x < 0.0f ? -1.0f : 1.0f, 0.0f);
+            surface.x  = normal.x * halfExtent.x;
+            separation = faceX - radius;
+        } else {
+            normal     = glm::vec2(0.0f, center.y < 0.0f ? -1.0f : 1.0f);
+            surface.y  = normal.y * halfExtent.y;
+            separation = faceY - radius;
+        }
+    } else {
+        const glm::vec2 delta    = center - clamped;
+        const float     distance = glm::length(delta);
+        normal                   = delta / distance;
+        surface                  = clamped;
+        separation               = distance - radius;
+    }
+    if (separation > speculativeDistance) {
+        return;
+    }
+
+    const glm::vec2 worldNormal = transformA.Rotation.Rotate(normal);
+    const glm::vec2 surfaceA    = transformA.Apply(surface);
+    const glm::vec2 surfaceB    = transformB.Position - radius * worldNormal;
+
+    manifold.Normal               = worldNormal;
+    manifold.Points[0].Point      = 0.5f * (surfaceA + surfaceB);
+    manifold.Points[0].Separation = separation;
+    manifold.PointCount           = 1;
+}
+
+/*
+ * Separating axis test over both boxes' face normals, then the incident
+ * edge of the other box is clipped against the reference face's side
+ * planes. Point ids encode the reference edge and the incident vertex so
+ * they stay stable while the boxes rest on each other.
+ */
+void CollideBoxes(const glm::vec2   &halfExtentA,
+                  const Transform2D &transformA,
+                  const glm::vec2   &halfExtentB,
+                  const Transform2D &transformB,
+                  float              speculativeDistance,
+                  Manifold2D        &manifold) {
+    const BoxPolygon polygonA = MakePolygon(halfExtentA, transformA);
+    const BoxPolygon polygonB = MakePolygon(halfExtentB, transformB);
+
+    int         edgeA       = 0;
+    const float separationA = FindMaxSeparation(polygonA, polygonB, edgeA);
+    if (separationA > speculativeDistance) {
+        return;
+    }
+    int         edgeB       = 0;
+    const float separationB = FindMaxSeparation(polygonB, polygonA, edgeB);
+    if (separationB > speculativeDistance) {
+        return;
+    }
+
+    // Prefer A as the reference so the choice does not flicker.
+    constexpr float kTolerance = 0.005f;
+    const bool      flip       = separationB > separationA + kTolerance;
+
+    const BoxPolygon &reference = flip ? polygonB : polygonA;
+    const BoxPolygon &incident  = flip ? polygonA : polygonB;
+    const int         edge      = flip ? edgeB : edgeA;
+    const glm::vec2   normal    = reference.Normals[edge];
+
+    // The incident edge is the one facing the reference face the most.
+    int   incidentEdge = 0;
+    float minDot       = std::numeric_limits<float>::max();
+    for (int i = 0; i < 4; i++) {
+        const float d = glm::dot(normal, incident.Normals[i]);
+        if (d < minDot) {
+            minDot       = d;
+            incidentEdge = i;
+        }
+    }
+
+    const uint32_t idBase = (flip ? 1u << 16 : 0u) | (uint32_t(edge) << 8);
+    const int      next   = (incidentEdge + 1) % 4;
+    const ClipVertex segment[2] = {
+        {incident.Vertices[incidentEdge], idBase | uint32_t(incidentEdge)},
+        {incident.Vertices[next], idBase | uint32_t(next)},
+    };
+
+    const glm::vec2 &v1      = reference.Vertices[edge];
+    const glm::vec2 &v2      = reference.Vertices[(edge + 1) % 4];
+    const glm::vec2  tangent = glm::normalize(v2 - v1);
+
+    ClipVertex clipped1[2];
+    ClipVertex clipped2[2];
+    if (ClipSegment(clipped1, segment, -tangent, -glm::dot(tangent, v1)) <
+        2) {
+        return;
+    }
+    if (ClipSegment(clipped2, clipped1, tangent, glm::dot(tangent, v2)) < 2) {
+        return;
+    }
+
+    manifold.Normal = flip ? -normal : normal;
+    for (const ClipVertex &vertex : clipped2) {
+        const float separation = glm::dot(normal, vertex.Point - v1);
+        if (separation > speculativeDistance) {
+            continue;
+        }
+        ManifoldPoint2D &point = manifold.Points[manifold.PointCount++];
+        point.Point            = vertex.Point - 0.5f * separation * normal;
+        point.Separation       = separation;
+        point.Id               = vertex.Id;
+    }
+}
+} // namespace
+
+float Shape2D::GetArea() const {
+    if (Type == ShapeType2D::Circle) {
+        return glm::pi<float>() * Radius * Radius;
+    }
+    return 4.0f * HalfExtent.x * HalfExtent.y;
+}
+
+float Shape2D::GetInertia(float mass) const {
+    if (Type == ShapeType2D::Circle) {
+        return 0.5f * mass * Radius * Radius;
+    }
+    return mass * glm::dot(HalfExtent, HalfExtent) / 3.0f;
+}
+
+Aabb Shape2D::ComputeBounds(const Transform2D &transform) const {
+    glm::vec2 extent(Radius);
+    if (Type == ShapeType2D::Box) {
+        const float c = std::abs(transform.Rotation.Cos);
+        const float s = std::abs(transform.Rotation.Sin);
+        extent        = glm::vec2(c * HalfExtent.x + s * HalfExtent.y,
+                           s * HalfExtent.x + c * HalfExtent.y);
+    }
+    return Aabb::FromCenter(glm::vec3(transform.Position, 0.0f),
+                            glm::vec3(extent, 0.0f));
+}
+
+void Collide(const Shape2D     &shapeA,
+             const Transform2D &transformA,
+             const Shape2D     &shapeB,
+             const Transform2D &transformB,
+             float              speculativeDistance,
+             Manifold2D        &manifold) {
+    manifold = Manifold2D();
+
+    const bool boxA = shapeA.Type == ShapeType2D::Box;
+    const bool boxB = shapeB.Type == ShapeType2D::Box;
+    if (boxA && boxB) {
+        CollideBoxes(shapeA.HalfExtent,
+                     transformA,
+                     shapeB.HalfExtent,
+                     transformB,
+                     speculativeDistance,
+                     manifold);
+    } else if (boxA) {
+        CollideBoxCircle(shapeA.HalfExtent,
+                         transformA,
+                         shapeB.Radius,
+                         transformB,
+                         speculativeDistance,
+                         manifold);
+    } else if (boxB) {
+        // Collide as box vs. circle, then point the normal from A to B.
+        CollideBoxCircle(shapeB.HalfExtent,
+                         transformB,
+                         shapeA.Radius,
+                         transformA,
+                         speculativeDistance,
+                         manifold);
+        manifold.Normal = -manifold.Normal;
+    } else {
+        CollideCircles(shapeA.Radius,
+                       transformA,
+                       shapeB.Radius,
+                       transformB,
+                       speculativeDistance,
+                       manifold);
+    }
+}
+
+} // namespace brnCore
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Physics/Aabb.h"
+
+namespace brnCore {
+
+// Rotation kept as cosine/sine so applying it needs no trig.
+struct Rotation2D {
+    float Cos = 1.0f;
+    float Sin = 0.0f;
+
+    static Rotation2D FromAngle(float angle) {
+        return {std::cos(angle), std::sin(angle)};
+    }
+
+    glm::vec2 Rotate(const glm::vec2 &v) const {
+        return {Cos * v.x - Sin * v.y, Sin * v.x + Cos * v.y};
+    }
+    glm::vec2 InverseRotate(const glm::vec2 &v) const {
+        return {Cos * v.x + Sin * v.y, -Sin * v.x + Cos * v.y};
+    }
+};
+
+struct Transform2D {
+    glm::vec2  Position = glm::vec2(0.0f);
+    Rotation2D Rotation;
+
+    glm::vec2 Apply(const glm::vec2 &local) const {
+        return Position + Rotation.Rotate(local);
+    }
+    glm::vec2 ApplyInverse(const glm::vec2 &world) const {
+        return Rotation.InverseRotate(world - Position);
+    }
+};
+
+enum class ShapeType2D : uint8_t { Circle, Box };
+
+struct Shape2D {
+    ShapeType2D Type       = ShapeType2D::Box;
+    glm::vec2   HalfExtent = glm::vec2(0.5f); // boxes
+    float       Radius     = 0.5f;            // circles
+
+    static Shape2D MakeCircle(float radius) {
+        Shape2D shape;
+        shape.Type   = ShapeType2D::Circle;
+        shape.Radius = radius;
+        return shape;
+    }
+    static Shape2D MakeBox(const glm::vec2 &halfExtent) {
+        Shape2D shape;
+        shape.Type       = ShapeType2D::Box;
+        shape.HalfExtent = halfExtent;
+        return shape;
+    }
+
+    float GetArea() const;
+    // Moment of inertia about the centre for the given mass.
+    float GetInertia(float mass) const;
+    // z is 0 on both corners.
+    Aabb ComputeBounds(const Transform2D &transform) const;
+};
+
+struct ManifoldPoint2D {
+    glm::vec2 Point      = glm::vec2(0.0f); // midway between the surfaces
+    float     Separation = 0.0f;            // negative while overlapping
+    uint32_t  Id         = 0; // feature pair; matches the point next step
+
+    // Accumulated by the solver, carried over for warm starting.
+    float NormalImpulse  = 0.0f;
+    float TangentImpulse = 0.0f;
+};
+
+struct Manifold2D {
+    glm::vec2       Normal = glm::vec2(0.0f, 1.0f); // from A to B
+    ManifoldPoint2D Points[2];
+    uint32_t        PointCount     = 0;
+    float           RollingImpulse = 0.0f; // solver state, like the points'
+};
+
+/*
+ * Fills `manifold` with up to two contact points between the shapes.
+ * Points further apart than `speculativeDistance` are dropped, so a pair
+ * that is about to touch already gets a (non-penetrating) contact and the
+ * solver can stop it before it overlaps. Impulses are reset to 0.
+ */
+void Collide(const Shape2D     &shapeA,
+             const Transform2D &transformA,
+             const Shape2D     &shapeB,
+             const Transform2D &transformB,
+             float              speculativeDistance,
+             Manifold2D        &manifold);
+
+} // namespace brnCore
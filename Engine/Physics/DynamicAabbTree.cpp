@@ -0,0 +1,334 @@
+#include "DynamicAabbTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+namespace brnCore {
+
+DynamicAabbTree::DynamicAabbTree(
+    const DynamicAabbTreeSpecification &specification)
+    : m_Specification(specification) {
+    m_Nodes.reserve(specification.InitialNodeCapacity);
+}
+
+ProxyId DynamicAabbTree::CreateProxy(const Aabb &bounds, uint64_t userData) {
+    const uint32_t leaf = AllocateNode();
+
+    Node &node    = m_Nodes[leaf];
+    node.Bounds   = bounds.Expanded(glm::vec3(m_Specification.Margin));
+    node.UserData = userData;
+    node.Height   = 0;
+
+    InsertLeaf(leaf);
+    m_ProxyCount++;
+    return leaf;
+}
+
+void DynamicAabbTree::DestroyProxy(ProxyId proxy) {
+    assert(proxy < m_Nodes.size() && m_Nodes[proxy].IsLeaf());
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    m_ProxyCount--;
+}
+
+bool DynamicAabbTree::MoveProxy(ProxyId          proxy,
+                                const Aabb      &bounds,
+                                const glm::vec3 &displacement) {
+    assert(proxy < m_Nodes.size() && m_Nodes[proxy].IsLeaf());
+
+    const glm::vec3 margin(m_Specification.Margin);
+    const Aabb     &current = m_Nodes[proxy].Bounds;
+
+    Aabb fat = bounds.Expanded(margin);
+
+    // Stretch along the motion so the next frames likely fit again.
+    const glm::vec3 stretch = displacement * m_Specification.DisplacementScale;
+    fat.Min += glm::min(stretch, glm::vec3(0.0f));
+    fat.Max += glm::max(stretch, glm::vec3(0.0f));
+
+    /*
+     * Keep the leaf while its fat box still holds the body, unless it has
+     * grown far larger than the box we would build now (e.g. after a fast
+     * move followed by a stop), which would report too many overlaps. The
+     * slack is measured from the stretched box and also allows the trail
+     * a moving body leaves behind, so bodies moving faster than the margin
+     * are not re-inserted every frame.
+     */
+    const Aabb loose = fat.Expanded(margin * 4.0f + glm::abs(stretch));
+    if (current.Contains(bounds) && loose.Contains(current)) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+    m_Nodes[proxy].Bounds = fat;
+    InsertLeaf(proxy);
+    return true;
+}
+
+int32_t DynamicAabbTree::GetHeight() const {
+    return m_Root == kNull ? 0 : m_Nodes[m_Root].Height;
+}
+
+float DynamicAabbTree::GetAreaRatio() const {
+    if (m_Root == kNull) {
+        return 0.0f;
+    }
+
+    const float rootArea = m_Nodes[m_Root].Bounds.GetSurfaceArea();
+    float       total    = 0.0f;
+    for (const Node &node : m_Nodes) {
+        if (node.Height >= 0) {
+            total += node.Bounds.GetSurfaceArea();
+        }
+    }
+    return rootArea > 0.0f ? total / rootArea : 0.0f;
+}
+
+void DynamicAabbTree::Validate() const {
+    if (m_Root != kNull) {
+        assert(m_Nodes[m_Root].Parent == kNull);
+        ValidateNode(m_Root);
+    }
+
+    uint32_t freeCount = 0;
+    for (uint32_t i = m_FreeList; i != kNull; i = m_Nodes[i].Parent) {
+        freeCount++;
+    }
+    const uint32_t leafCount = m_ProxyCount;
+    const uint32_t nodeCount = leafCount ? 2 * leafCount - 1 : 0;
+    assert(nodeCount + freeCount == m_Nodes.size());
+    (void)freeCount;
+    (void)nodeCount;
+}
+
+uint32_t DynamicAabbTree::AllocateNode() {
+    if (m_FreeList == kNull) {
+        m_Nodes.emplace_back();
+        return static_cast<uint32_t>(m_Nodes.size() - 1);
+    }
+
+    const uint32_t index = m_FreeList;
+    m_FreeList           = m_Nodes[index].Parent;
+    m_Nodes[index]       = Node();
+    return index;
+}
+
+void DynamicAabbTree::FreeNode(uint32_t node) {
+    m_Nodes[node]        = Node();
+    m_Nodes[node].Parent = m_FreeList;
+    m_FreeList           = node;
+}
+
+uint32_t DynamicAabbTree::FindBestSibling(const Aabb &bounds) const {
+    /*
+     * Descend towards the child whose enlargement costs least. The cost of
+     * pairing with a node is the area of the new parent plus the area
+     * every ancestor grows by ("inherited" cost); stop when creating a new
+     * parent here is cheaper than pushing the leaf further down.
+     */
+    uint32_t index = m_Root;
+    while (!m_Nodes[index].IsLeaf()) {
+        const Node &node = m_Nodes[index];
+
+        const float area         = node.Bounds.GetSurfaceArea();
+        const float combinedArea = Aabb::Union(node.Bounds, bounds)
+                                       .GetSurfaceArea();
+
+        const float cost          = 2.0f * combinedArea;
+        const float inheritedCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](uint32_t child) {
+            const Node &childNode = m_Nodes[child];
+            const float enlarged =
+                Aabb::Union(childNode.Bounds, bounds).GetSurfaceArea();
+            if (childNode.IsLeaf()) {
+                return enlarged + inheritedCost;
+            }
+            return enlarged - childNode.Bounds.GetSurfaceArea() +
+                   inheritedCost;
+        };
+
+        const float cost1 = descendCost(node.Child1);
+        const float cost2 = descendCost(node.Child2);
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.Child1 : node.Child2;
+    }
+    return index;
+}
+
+void DynamicAabbTree::InsertLeaf(uint32_t leaf) {
+    if (m_Root == kNull) {
+        m_Root               = leaf;
+        m_Nodes[leaf].Parent = kNull;
+        return;
+    }
+
+    const uint32_t sibling   = FindBestSibling(m_Nodes[leaf].Bounds);
+    const uint32_t oldParent = m_Nodes[sibling].Parent;
+    const uint32_t newParent = AllocateNode();
+
+    Node &parent  = m_Nodes[newParent];
+    parent.Parent = oldParent;
+    parent.Bounds =
+        Aabb::Union(m_Nodes[leaf].Bounds, m_Nodes[sibling].Bounds);
+    parent.Height = m_Nodes[sibling].Height + 1;
+    parent.Child1 = sibling;
+    parent.Child2 = leaf;
+
+    if (oldParent != kNull) {
+        Node &grandParent = m_Nodes[oldParent];
+        if (grandParent.Child1 == sibling) {
+            grandParent.Child1 = newParent;
+        } else {
+            grandParent.Child2 = newParent;
+        }
+    } else {
+        m_Root = newParent;
+    }
+    m_Nodes[sibling].Parent = newParent;
+    m_Nodes[leaf].Parent    = newParent;
+
+    Refit(m_Nodes[leaf].Parent);
+}
+
+void DynamicAabbTree::RemoveLeaf(uint32_t leaf) {
+    if (leaf == m_Root) {
+        m_Root = kNull;
+        return;
+    }
+
+    const uint32_t parent      = m_Nodes[leaf].Parent;
+    const uint32_t grandParent = m_Nodes[parent].Parent;
+    const uint32_t sibling     = m_Nodes[parent].Child1 == leaf
+                                     ? m_Nodes[parent].Child2
+                                     : m_Nodes[parent].Child1;
+
+    if (grandParent != kNull) {
+        Node &node = m_Nodes[grandParent];
+        if (node.Child1 == parent) {
+            node.Child1 = sibling;
+        } else {
+            node.Child2 = sibling;
+        }
+        m_Nodes[sibling].Parent = grandParent;
+        FreeNode(parent);
+        Refit(grandParent);
+    } else {
+        m_Root                  = sibling;
+        m_Nodes[sibling].Parent = kNull;
+        FreeNode(parent);
+    }
+    m_Nodes[leaf].Parent = kNull;
+}
+
+void DynamicAabbTree::Refit(uint32_t index) {
+    while (index != kNull) {
+        index = Balance(index);
+
+        Node       &node   = m_Nodes[index];
+        const Node &child1 = m_Nodes[node.Child1];
+        const Node &child2 = m_Nodes[node.Child2];
+        node.Height = 1 + std::max(child1.Height, child2.Height);
+        node.Bounds = Aabb::Union(child1.Bounds, child2.Bounds);
+
+        index = node.Parent;
+    }
+}
+
+/*
+ * Rotates the taller grandchild up if the children's heights differ by
+ * more than one. Returns the index now at `a`'s position in the tree.
+ *
+ *       a              c
+ *      / \            / \
+ *     b   c    ->    a   f      (f = taller child of c)
+ *        / \        / \
+ *       f   g      b   g
+ */
+uint32_t DynamicAabbTree::Balance(uint32_t a) {
+    Node &nodeA = m_Nodes[a];
+    if (nodeA.IsLeaf() || nodeA.Height < 2) {
+        return a;
+    }
+
+    const int32_t balance =
+        m_Nodes[nodeA.Child2].Height - m_Nodes[nodeA.Child1].Height;
+    if (std::abs(balance) <= 1) {
+        return a;
+    }
+
+    // c is the taller child, b the other one.
+    const bool     rotateRight = balance > 0;
+    const uint32_t c           = rotateRight ? nodeA.Child2 : nodeA.Child1;
+    const uint32_t b           = rotateRight ? nodeA.Child1 : nodeA.Child2;
+    Node          &nodeB       = m_Nodes[b];
+    Node          &nodeC       = m_Nodes[c];
+
+    const uint32_t f = nodeC.Child1;
+    const uint32_t g = nodeC.Child2;
+    Node          &nodeF = m_Nodes[f];
+    Node          &nodeG = m_Nodes[g];
+
+    // Swap a and c.
+    nodeC.Child1 = a;
+    nodeC.Parent = nodeA.Parent;
+    nodeA.Parent = c;
+
+    if (nodeC.Parent != kNull) {
+        Node &parent = m_Nodes[nodeC.Parent];
+        if (parent.Child1 == a) {
+            parent.Child1 = c;
+        } else {
+            parent.Child2 = c;
+        }
+    } else {
+        m_Root = c;
+    }
+
+    // Keep the taller of c's children next to c, move the other below a.
+    const bool     keepF   = nodeF.Height > nodeG.Height;
+    const uint32_t kept    = keepF ? f : g;
+    const uint32_t moved   = keepF ? g : f;
+    Node          &nodeMov = m_Nodes[moved];
+
+    nodeC.Child2   = kept;
+    nodeMov.Parent = a;
+    if (rotateRight) {
+        nodeA.Child2 = moved;
+    } else {
+        nodeA.Child1 = moved;
+    }
+
+    nodeA.Bounds = Aabb::Union(nodeB.Bounds, nodeMov.Bounds);
+    nodeA.Height = 1 + std::max(nodeB.Height, nodeMov.Height);
+    nodeC.Bounds = Aabb::Union(nodeA.Bounds, m_Nodes[kept].Bounds);
+    nodeC.Height = 1 + std::max(nodeA.Height, m_Nodes[kept].Height);
+
+    return c;
+}
+
+void DynamicAabbTree::ValidateNode(uint32_t index) const {
+    const Node &node = m_Nodes[index];
+    if (node.IsLeaf()) {
+        assert(node.Child2 == kNull && node.Height == 0);
+        return;
+    }
+
+    const Node &child1 = m_Nodes[node.Child1];
+    const Node &child2 = m_Nodes[node.Child2];
+    assert(child1.Parent == index && child2.Parent == index);
+    assert(node.Height == 1 + std::max(child1.Height, child2.Height));
+    assert(node.Bounds.Contains(child1.Bounds) &&
+           node.Bounds.Contains(child2.Bounds));
+    (void)child1;
+    (void)child2;
+
+    ValidateNode(node.Child1);
+    ValidateNode(node.Child2);
+}
+
+} // namespace brnCore
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Physics/Aabb.h"
+#include "Engine/Physics/Frustum.h"
+#include "Engine/Physics/Proxy.h"
+#include "Engine/Physics/Ray.h"
+
+namespace brnCore {
+
+struct DynamicAabbTreeSpecification {
+    float    Margin              = 0.1f; // fattening on every axis
+    float    DisplacementScale   = 4.0f; // predictive fattening along motion
+    uint32_t InitialNodeCapacity = 256;
+};
+
+/*
+ * Bounding volume hierarchy over fattened boxes, for worlds too sparse or
+ * too large for a uniform grid. Leaves store the user's box grown by a
+ * margin (and along its motion), so MoveProxy() only touches the tree once
+ * a body leaves its fat box.
+ *
+ * Leaves are inserted where the SAH cost of the enlarged ancestors is
+ * lowest, and AVL-style rotations on the way back up keep the tree
+ * balanced. Nodes live in one flat array and link by index; a proxy id is its
+ * leaf's index and stays valid until DestroyProxy().
+ *
+ * Queries are const and may run concurrently; the *Batch variants split a
+ * batch of queries across the job system.
+ */
+class DynamicAabbTree {
+  public:
+    explicit DynamicAabbTree(const DynamicAabbTreeSpecification &specification =
+                                 DynamicAabbTreeSpecification());
+
+    ProxyId CreateProxy(const Aabb &bounds, uint64_t userData = 0);
+    void    DestroyProxy(ProxyId proxy);
+
+    /*
+     * Returns true if the proxy was re-inserted, i.e. its fat box changed
+     * and pairs involving it need to be re-checked.
+     */
+    bool MoveProxy(ProxyId          proxy,
+                   const Aabb      &bounds,
+                   const glm::vec3 &displacement = glm::vec3(0.0f));
+
+    const Aabb &GetFatBounds(ProxyId proxy) const {
+        return m_Nodes[proxy].Bounds;
+    }
+    uint64_t GetUserData(ProxyId proxy) const {
+        return m_Nodes[proxy].UserData;
+    }
+
+    // fn(ProxyId) -> bool; return false to stop the query.
+    template <typename Fn>
+    void QueryAabb(const Aabb &bounds, Fn &&fn) const {
+        Traverse([&](const Aabb &node) { return node.Overlaps(bounds); }, fn);
+    }
+
+    template <typename Fn>
+    void QueryFrustum(const Frustum &frustum, Fn &&fn) const {
+        Traverse([&](const Aabb &node) { return frustum.Intersects(node); },
+                 fn);
+    }
+
+    /*
+     * fn(ProxyId, float distance) -> float is called for every leaf whose
+     * fat box the ray enters, nearest subtrees first. Return the distance
+     * of an exact hit to clip the ray there, ray.MaxDistance (or more) to
+     * continue unchanged, or 0 to stop.
+     */
+    template <typename Fn>
+    void RayCast(const Ray &ray, Fn &&fn) const;
+
+    // fn(queryIndex, ProxyId) -> bool, called concurrently across queries.
+    template <typename Fn>
+    void QueryAabbBatch(std::span<const Aabb> queries,
+                        JobSystem            *jobs,
+                        Fn                  &&fn) const {
+        RunBatch(jobs, queries.size(), [&](uint32_t index) {
+            QueryAabb(queries[index],
+                      [&](ProxyId proxy) { return fn(index, proxy); });
+        });
+    }
+
+    template <typename Fn>
+    void QueryFrustumBatch(std::span<const Frustum> queries,
+                           JobSystem               *jobs,
+                           Fn                     &&fn) const {
+        RunBatch(jobs, queries.size(), [&](uint32_t index) {
+            QueryFrustum(queries[index],
+                         [&](ProxyId proxy) { return fn(index, proxy); });
+        });
+    }
+
+    // fn(rayIndex, ProxyId, float distance) -> float, as in RayCast().
+    template <typename Fn>
+    void RayCastBatch(std::span<const Ray> rays, JobSystem *jobs, Fn &&fn)
+        const {
+        RunBatch(jobs, rays.size(), [&](uint32_t index) {
+            RayCast(rays[index], [&](ProxyId proxy, float distance) {
+                return fn(index, proxy, distance);
+            });
+        });
+    }
+
+    uint32_t GetProxyCount() const { return m_ProxyCount; }
+    int32_t  GetHeight() const;
+    // Sum of node surface areas over the root's; lower is a better tree.
+    float GetAreaRatio() const;
+    // Asserts the structural invariants; for debugging.
+    void Validate() const;
+
+  private:
+    static constexpr uint32_t kNull = kInvalidProxy;
+
+    struct Node {
+        Aabb     Bounds;
+        uint64_t UserData = 0;
+        uint32_t Parent   = kNull; // next free node while on the free list
+        uint32_t Child1   = kNull;
+        uint32_t Child2   = kNull;
+        int32_t  Height   = -1; // 0 for leaves, -1 while free
+
+        bool IsLeaf() const { return Child1 == kNull; }
+    };
+
+    // Small inline stack for traversals; spills to the heap on deep trees.
+    class NodeStack {
+      public:
+        void Push(uint32_t node) {
+            if (m_Count < kInline) {
+                m_Inline[m_Count++] = node;
+            } else {
+                m_Overflow.push_back(node);
+                m_Count++;
+            }
+        }
+        uint32_t Pop() {
+            m_Count--;
+            if (m_Count < kInline) {
+                return m_Inline[m_Count];
+            }
+            const uint32_t node = m_Overflow.back();
+            m_Overflow.pop_back();
+            return node;
+        }
+        bool IsEmpty() const { return m_Count == 0; }
+
+      private:
+        static constexpr uint32_t kInline = 128;
+
+        uint32_t              m_Inline[kInline];
+        uint32_t              m_Count = 0;
+        std::vector<uint32_t> m_Overflow;
+    };
+
+    template <typename Test, typename Fn>
+    void Traverse(Test &&test, Fn &fn) const {
+        if (m_Root == kNull) {
+            return;
+        }
+        NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.IsEmpty()) {
+            const Node &node = m_Nodes[stack.Pop()];
+            if (!test(node.Bounds)) {
+                continue;
+            }
+            if (node.IsLeaf()) {
+                if (!fn(static_cast<ProxyId>(&node - m_Nodes.data()))) {
+                    return;
+                }
+            } else {
+                stack.Push(node.Child1);
+                stack.Push(node.Child2);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void RunBatch(JobSystem *jobs, size_t count, Fn &&fn) const {
+        auto run = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                fn(i);
+            }
+        };
+        const uint32_t total = static_cast<uint32_t>(count);
+        if (jobs) {
+            jobs->ParallelFor(total, kBatchGrain, run);
+        } else {
+            run(0, total);
+        }
+    }
+
+    static constexpr uint32_t kBatchGrain = 64;
+
+    uint32_t AllocateNode();
+    void     FreeNode(uint32_t node);
+    void     InsertLeaf(uint32_t leaf);
+    void     RemoveLeaf(uint32_t leaf);
+    uint32_t FindBestSibling(const Aabb &bounds) const;
+    uint32_t Balance(uint32_t node);
+    void     Refit(uint32_t node);
+    void     ValidateNode(uint32_t node) const;
+
+    DynamicAabbTreeSpecification m_Specification;
+
+    std::vector<Node> m_Nodes;
+    uint32_t          m_Root       = kNull;
+    uint32_t          m_FreeList   = kNull;
+    uint32_t          m_ProxyCount = 0;
+};
+
+template <typename Fn>
+void DynamicAabbTree::RayCast(const Ray &ray, Fn &&fn) const {
+    if (m_Root == kNull) {
+        return;
+    }
+
+    const glm::vec3 inverseDirection = 1.0f / ray.Direction;
+    float           maxDistance      = ray.MaxDistance;
+
+    NodeStack stack;
+    stack.Push(m_Root);
+    while (!stack.IsEmpty()) {
+        const uint32_t index = stack.Pop();
+        const Node    &node  = m_Nodes[index];
+        const float    enter =
+            IntersectRayAabb(ray, inverseDirection, node.Bounds, maxDistance);
+        if (enter < 0.0f) {
+            continue;
+        }
+
+        if (node.IsLeaf()) {
+            const float clip = fn(static_cast<ProxyId>(index), enter);
+            if (clip <= 0.0f) {
+                return;
+            }
+            maxDistance = std::min(maxDistance, clip);
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited first
+        // and clips the ray early.
+        const float enter1 = IntersectRayAabb(
+            ray, inverseDirection, m_Nodes[node.Child1].Bounds, maxDistance);
+        const float enter2 = IntersectRayAabb(
+            ray, inverseDirection, m_Nodes[node.Child2].Bounds, maxDistance);
+        if (enter1 >= 0.0f && enter2 >= 0.0f) {
+            const bool firstNearer = enter1 <= enter2;
+            stack.Push(firstNearer ? node.Child2 : node.Child1);
+            stack.Push(firstNearer ? node.Child1 : node.Child2);
+        } else if (enter1 >= 0.0f) {
+            stack.Push(node.Child1);
+        } else if (enter2 >= 0.0f) {
+            stack.Push(node.Child2);
+        }
+    }
+}
+
+} // namespace brnCore
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Physics/Aabb.h"
+
+namespace brnCore {
+
+// Six inward-facing planes (xyz = normal, w = distance).
+struct Frustum {
+    glm::vec4 Planes[6];
+
+    /*
+     * Gribb/Hartmann extraction from a view-projection matrix. The near
+     * plane uses the -1..1 depth convention, which is conservative for
+     * 0..1 depth (SDL_GPU) and exact for OpenGL.
+     */
+    static Frustum FromMatrix(const glm::mat4 &viewProjection) {
+        auto row = [&](int i) {
+            return glm::vec4(viewProjection[0][i],
+                             viewProjection[1][i],
+                             viewProjection[2][i],
+                             viewProjection[3][i]);
+        };
+
+        Frustum frustum;
+        frustum.Planes[0] = row(3) + row(0); // left
+        frustum.Planes[1] = row(3) - row(0); // right
+        frustum.Planes[2] = row(3) + row(1); // bottom
+        frustum.Planes[3] = row(3) - row(1); // top
+        frustum.Planes[4] = row(3) + row(2); // near
+        frustum.Planes[5] = row(3) - row(2); // far
+        for (glm::vec4 &plane : frustum.Planes) {
+            plane /= glm::length(glm::vec3(plane.x, plane.y, plane.z));
+        }
+        return frustum;
+    }
+
+    // Conservative: may accept boxes just outside a frustum corner.
+    bool Intersects(const Aabb &bounds) const {
+        for (const glm::vec4 &plane : Planes) {
+            // The box corner furthest along the plane normal.
+            const glm::vec3 corner(
+                plane.x >= 0.0f ? bounds.Max.x : bounds.Min.x,
+                plane.y >= 0.0f ? bounds.Max.y : bounds.Min.y,
+                plane.z >= 0.0f ? bounds.Max.z : bounds.Min.z);
+            const float distance = plane.x * corner.x + plane.y * corner.y +
+                                   plane.z * corner.z + plane.w;
+            if (distance < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace brnCore
@@ -0,0 +1,1071 @@
+#include "PhysicsWorld2D.h"
+
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+namespace brnCore {
+
+namespace {
+constexpr uint32_t kBodiesPerTask   = 512;
+constexpr uint32_t kContactsPerTask = 128;
+
+double ToMilliseconds(uint64_t ticks) {
+    return static_cast<double>(ticks) * 1e3 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+float Cross(const glm::vec2 &a, const glm::vec2 &b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+// Velocity of a point at `r` from the centre of a body spinning at `w`.
+glm::vec2 Cross(float w, const glm::vec2 &r) { return {-w * r.y, w * r.x}; }
+
+// Calls fn(begin, end) over [0, count), split across `jobs` if given.
+template <typename Fn>
+void ParallelRange(JobSystem *jobs, uint32_t count, uint32_t grain, Fn &&fn) {
+    if (jobs) {
+        jobs->ParallelFor(count, grain, fn);
+    } else if (count) {
+        fn(0u, count);
+    }
+}
+} // namespace
+
+PhysicsWorld2D::PhysicsWorld2D(
+    const PhysicsWorld2DSpecification &specification)
+    : m_Specification(specification) {}
+
+BodyId PhysicsWorld2D::CreateBody(const BodySpecification2D &specification) {
+    BodyId body;
+    if (!m_FreeBodies.empty()) {
+        body = m_FreeBodies.back();
+        m_FreeBodies.pop_back();
+    } else {
+        body = static_cast<BodyId>(m_Position.size());
+        ResizeBodies(body + 1);
+    }
+
+    const bool moves = specification.Type != BodyType2D::Static;
+
+    m_Position[body]       = specification.Position;
+    m_Angle[body]          = specification.Angle;
+    m_Rotation[body]       = Rotation2D::FromAngle(specification.Angle);
+    m_LinearVelocity[body] = moves ? specification.LinearVelocity
+                                   : glm::vec2(0.0f);
+    m_AngularVelocity[body] = moves ? specification.AngularVelocity : 0.0f;
+    m_BiasLinearVelocity[body]  = glm::vec2(0.0f);
+    m_BiasAngularVelocity[body] = 0.0f;
+    m_Force[body]               = glm::vec2(0.0f);
+    m_Friction[body]            = specification.Friction;
+    m_Restitution[body]         = specification.Restitution;
+    m_RollingResistance[body] =
+        specification.Shape.Type == ShapeType2D::Circle
+            ? specification.RollingResistance * specification.Shape.Radius
+            : 0.0f;
+    m_SleepTime[body]           = 0.0f;
+    m_Shape[body]               = specification.Shape;
+    m_Type[body]                = specification.Type;
+    m_SleepingIsland[body]      = kNoIsland;
+    m_UserData[body]            = specification.UserData;
+    m_Flags[body]               = kAlive;
+    UpdateMass(body, specification.Density, specification.FixedRotation);
+
+    // Kinematic bodies are awake while they move; see SetLinearVelocity().
+    if (specification.Type == BodyType2D::Dynamic ||
+        (specification.Type == BodyType2D::Kinematic &&
+         (m_LinearVelocity[body] != glm::vec2(0.0f) ||
+          m_AngularVelocity[body] != 0.0f))) {
+        m_Flags[body] |= kAwake;
+    }
+
+    m_Bounds[body]      = ComputeBounds(body);
+    const ProxyId proxy = m_Broadphase.Insert(m_Bounds[body]);
+    if (proxy >= m_ProxyBody.size()) {
+        m_ProxyBody.resize(proxy + 1, kInvalidBody);
+    }
+    m_Proxy[body]      = proxy;
+    m_ProxyBody[proxy] = body;
+
+    m_BodyCount++;
+    return body;
+}
+
+void PhysicsWorld2D::DestroyBody(BodyId body) {
+    assert(IsAlive(body));
+
+    // Dissolve its sleeping island and wake whatever rested on it.
+    WakeBody(body);
+    const Aabb bounds = m_Bounds[body];
+
+    m_Broadphase.Remove(m_Proxy[body]);
+    m_ProxyBody[m_Proxy[body]] = kInvalidBody;
+    m_Flags[body]              = 0;
+    m_FreeBodies.push_back(body);
+    m_BodyCount--;
+
+    QueryAabb(bounds, [&](BodyId other) { WakeBody(other); });
+}
+
+bool PhysicsWorld2D::IsAlive(BodyId body) const {
+    return body < m_Flags.size() && (m_Flags[body] & kAlive);
+}
+
+void PhysicsWorld2D::SetTransform(BodyId           body,
+                                  const glm::vec2 &position,
+                                  float            angle) {
+    assert(IsAlive(body));
+
+    m_Position[body] = position;
+    m_Angle[body]    = angle;
+    m_Rotation[body] = Rotation2D::FromAngle(angle);
+    m_Bounds[body]   = ComputeBounds(body);
+    m_Broadphase.Move(m_Proxy[body], m_Bounds[body]);
+    WakeBody(body);
+}
+
+void PhysicsWorld2D::SetLinearVelocity(BodyId           body,
+                                       const glm::vec2 &velocity) {
+    assert(IsAlive(body));
+    if (m_Type[body] == BodyType2D::Static) {
+        return;
+    }
+
+    m_LinearVelocity[body] = velocity;
+    if (m_Type[body] == BodyType2D::Kinematic) {
+        const bool moving =
+            velocity != glm::vec2(0.0f) || m_AngularVelocity[body] != 0.0f;
+        m_Flags[body] = moving ? m_Flags[body] | kAwake
+                               : m_Flags[body] & ~kAwake;
+    } else if (velocity != glm::vec2(0.0f)) {
+        WakeBody(body);
+    }
+}
+
+void PhysicsWorld2D::SetAngularVelocity(BodyId body, float velocity) {
+    assert(IsAlive(body));
+    if (m_Type[body] == BodyType2D::Static) {
+        return;
+    }
+
+    m_AngularVelocity[body] = velocity;
+    if (m_Type[body] == BodyType2D::Kinematic) {
+        const bool moving =
+            velocity != 0.0f || m_LinearVelocity[body] != glm::vec2(0.0f);
+        m_Flags[body] = moving ? m_Flags[body] | kAwake
+                               : m_Flags[body] & ~kAwake;
+    } else if (velocity != 0.0f) {
+        WakeBody(body);
+    }
+}
+
+void PhysicsWorld2D::ApplyForce(BodyId body, const glm::vec2 &force) {
+    assert(IsAlive(body));
+    if (IsDynamic(body)) {
+        m_Force[body] += force;
+        WakeBody(body);
+    }
+}
+
+void PhysicsWorld2D::ApplyLinearImpulse(BodyId           body,
+                                        const glm::vec2 &impulse,
+                                        const glm::vec2 &point) {
+    assert(IsAlive(body));
+    if (IsDynamic(body)) {
+        m_LinearVelocity[body] += m_InverseMass[body] * impulse;
+        m_AngularVelocity[body] +=
+            m_InverseInertia[body] * Cross(point - m_Position[body], impulse);
+        WakeBody(body);
+    }
+}
+
+void PhysicsWorld2D::WakeBody(BodyId body) {
+    if (!IsDynamic(body)) {
+        return;
+    }
+    if (m_Flags[body] & kAwake) {
+        m_SleepTime[body] = 0.0f;
+        return;
+    }
+
+    const uint32_t island = m_SleepingIsland[body];
+    assert(island != kNoIsland);
+    for (BodyId member : m_SleepingIslands[island]) {
+        m_SleepTime[member]      = 0.0f;
+        m_SleepingIsland[member] = kNoIsland;
+        m_Flags[member] |= kAwake;
+    }
+    m_SleepingIslands[island].clear();
+    m_FreeIslands.push_back(island);
+}
+
+void PhysicsWorld2D::Step(float dt, JobSystem *jobs) {
+    if (dt <= 0.0f) {
+        return;
+    }
+
+    const uint64_t start = SDL_GetPerformanceCounter();
+    m_Stats              = PhysicsStats2D();
+    m_Stats.BodyCount    = m_BodyCount;
+
+    UpdateContacts(jobs);
+    WakeTouchedIslands();
+    BuildAwakeList();
+
+    const uint64_t solveStart = SDL_GetPerformanceCounter();
+    m_Stats.CollideMs         = ToMilliseconds(solveStart - start);
+
+    IntegrateVelocities(dt, jobs);
+    PrepareConstraints(jobs);
+    SolveConstraints(dt, jobs);
+    IntegratePositions(dt, jobs);
+
+    const uint64_t sleepStart = SDL_GetPerformanceCounter();
+    m_Stats.SolveMs           = ToMilliseconds(sleepStart - solveStart);
+
+    UpdateSleep();
+
+    m_Stats.SleepingIslandCount = static_cast<uint32_t>(
+        m_SleepingIslands.size() - m_FreeIslands.size());
+    m_Stats.StepMs = ToMilliseconds(SDL_GetPerformanceCounter() - start);
+}
+
+/*
+ * Merges this step's broadphase pairs into the contact list. Both are
+ * sorted by proxy pair, so surviving contacts are found with one linear
+ * walk and keep their manifold (and impulses). Narrowphase only runs for
+ * contacts with an awake body; between sleeping bodies nothing moved.
+ */
+void PhysicsWorld2D::UpdateContacts(JobSystem *jobs) {
+    m_Broadphase.FindPairs(m_Pairs, jobs);
+
+    m_NextContacts.clear();
+    m_ContactsToUpdate.clear();
+
+    size_t previous = 0;
+    for (const ProxyPair &pair : m_Pairs) {
+        const BodyId a = m_ProxyBody[pair.A];
+        const BodyId b = m_ProxyBody[pair.B];
+        if (!IsDynamic(a) && !IsDynamic(b)) {
+            continue;
+        }
+
+        const uint64_t key = uint64_t(pair.A) << 32 | pair.B;
+        while (previous < m_Contacts.size() && m_Contacts[previous].Key < key) {
+            previous++;
+        }
+
+        // A proxy id may have been reused by another body since last step.
+        if (previous < m_Contacts.size() && m_Contacts[previous].Key == key &&
+            m_Contacts[previous].BodyA == a &&
+            m_Contacts[previous].BodyB == b) {
+            m_NextContacts.push_back(m_Contacts[previous]);
+        } else {
+            m_NextContacts.push_back(
+                {key,
+                 a,
+                 b,
+                 std::sqrt(m_Friction[a] * m_Friction[b]),
+                 std::max(m_Restitution[a], m_Restitution[b]),
+                 std::max(m_RollingResistance[a], m_RollingResistance[b]),
+                 Manifold2D()});
+        }
+
+        if ((m_Flags[a] | m_Flags[b]) & kAwake) {
+            m_ContactsToUpdate.push_back(
+                static_cast<uint32_t>(m_NextContacts.size() - 1));
+        }
+    }
+    std::swap(m_Contacts, m_NextContacts);
+    m_Stats.ContactCount = static_cast<uint32_t>(m_Contacts.size());
+
+    ParallelRange(
+        jobs,
+        static_cast<uint32_t>(m_ContactsToUpdate.size()),
+        kContactsPerTask,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                Contact         &contact  = m_Contacts[m_ContactsToUpdate[i]];
+                const BodyId     a        = contact.BodyA;
+                const BodyId     b        = contact.BodyB;
+                const Manifold2D previous = contact.Manifold;
+
+                Collide(m_Shape[a],
+                        {m_Position[a], m_Rotation[a]},
+                        m_Shape[b],
+                        {m_Position[b], m_Rotation[b]},
+                        m_Specification.SpeculativeDistance,
+                        contact.Manifold);
+                if (contact.Manifold.PointCount && previous.PointCount) {
+                    contact.Manifold.RollingImpulse = previous.RollingImpulse;
+                }
+
+                // Points that persist keep their impulses for warm starting.
+                for (uint32_t p = 0; p < contact.Manifold.PointCount; p++) {
+                    ManifoldPoint2D &point = contact.Manifold.Points[p];
+                    for (uint32_t q = 0; q < previous.PointCount; q++) {
+                        if (previous.Points[q].Id == point.Id) {
+                            const ManifoldPoint2D &old = previous.Points[q];
+                            point.NormalImpulse        = old.NormalImpulse;
+                            point.TangentImpulse       = old.TangentImpulse;
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+}
+
+// A touching contact between an awake and a sleeping body wakes the latter.
+void PhysicsWorld2D::WakeTouchedIslands() {
+    for (uint32_t index : m_ContactsToUpdate) {
+        const Contact &contact = m_Contacts[index];
+        if (contact.Manifold.PointCount == 0) {
+            continue;
+        }
+        if (!(m_Flags[contact.BodyA] & kAwake)) {
+            WakeBody(contact.BodyA);
+        }
+        if (!(m_Flags[contact.BodyB] & kAwake)) {
+            WakeBody(contact.BodyB);
+        }
+    }
+}
+
+void PhysicsWorld2D::BuildAwakeList() {
+    m_AwakeBodies.clear();
+    for (BodyId body = 0; body < m_Flags.size(); body++) {
+        if (m_Flags[body] & kAwake) {
+            m_AwakeBodies.push_back(body);
+        }
+    }
+    m_Stats.AwakeBodyCount = static_cast<uint32_t>(m_AwakeBodies.size());
+}
+
+void PhysicsWorld2D::IntegrateVelocities(float dt, JobSystem *jobs) {
+    const glm::vec2 gravity = m_Specification.Gravity;
+
+    ParallelRange(jobs,
+                  static_cast<uint32_t>(m_AwakeBodies.size()),
+                  kBodiesPerTask,
+                  [&](uint32_t begin, uint32_t end) {
+                      for (uint32_t i = begin; i < end; i++) {
+                          const BodyId body = m_AwakeBodies[i];
+                          if (!IsDynamic(body)) {
+                              continue;
+                          }
+                          m_LinearVelocity[body] +=
+                              dt * (gravity +
+                                    m_InverseMass[body] * m_Force[body]);
+                          m_Force[body] = glm::vec2(0.0f);
+                      }
+                  });
+}
+
+/*
+ * Colors the touching contacts so that no two contacts of one color share
+ * a dynamic body, then prepares them grouped by color. Static and
+ * kinematic bodies are only read by the solver, so they do not constrain
+ * the coloring. Coloring walks the contacts in list order on one thread,
+ * which keeps the result independent of the thread count.
+ */
+void PhysicsWorld2D::PrepareConstraints(JobSystem *jobs) {
+    for (BodyId body : m_AwakeBodies) {
+        m_ColorMask[body] = 0;
+    }
+
+    uint32_t counts[kMaxColors + 1] = {};
+    m_SolvedContacts.clear();
+    m_SolvedColors.clear();
+    for (uint32_t i = 0; i < m_Contacts.size(); i++) {
+        const Contact &contact = m_Contacts[i];
+        const BodyId   a       = contact.BodyA;
+        const BodyId   b       = contact.BodyB;
+        if (contact.Manifold.PointCount == 0 ||
+            !((m_Flags[a] | m_Flags[b]) & kAwake)) {
+            continue;
+        }
+
+        const bool dynamicA = IsDynamic(a);
+        const bool dynamicB = IsDynamic(b);
+        // Whatever a moving kinematic body pushes stays awake.
+        if (!dynamicA && (m_Flags[a] & kAwake)) {
+            m_SleepTime[b] = 0.0f;
+        }
+        if (!dynamicB && (m_Flags[b] & kAwake)) {
+            m_SleepTime[a] = 0.0f;
+        }
+
+        const uint32_t used =
+            (dynamicA ? m_ColorMask[a] : 0u) | (dynamicB ? m_ColorMask[b] : 0u);
+        uint32_t color = static_cast<uint32_t>(std::countr_one(used));
+        if (color < kMaxColors) {
+            if (dynamicA) {
+                m_ColorMask[a] |= 1u << color;
+            }
+            if (dynamicB) {
+                m_ColorMask[b] |= 1u << color;
+            }
+        } else {
+            color = kMaxColors;
+        }
+
+        m_SolvedContacts.push_back(i);
+        m_SolvedColors.push_back(static_cast<uint8_t>(color));
+        counts[color]++;
+    }
+
+    m_ColorOffsets[0] = 0;
+    for (uint32_t color = 0; color <= kMaxColors; color++) {
+        m_ColorOffsets[color + 1] = m_ColorOffsets[color] + counts[color];
+        if (color < kMaxColors && counts[color]) {
+            m_Stats.ColorCount++;
+        }
+    }
+    m_Stats.SolvedContacts = static_cast<uint32_t>(m_SolvedContacts.size());
+    m_Stats.OverflowCount  = counts[kMaxColors];
+
+    uint32_t cursor[kMaxColors + 1];
+    std::copy_n(m_ColorOffsets, kMaxColors + 1, cursor);
+    m_Constraints.resize(m_SolvedContacts.size());
+    for (size_t i = 0; i < m_SolvedContacts.size(); i++) {
+        m_Constraints[cursor[m_SolvedColors[i]]++].Contact =
+            m_SolvedContacts[i];
+    }
+
+    ParallelRange(
+        jobs,
+        static_cast<uint32_t>(m_Constraints.size()),
+        kContactsPerTask,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                Constraint       &constraint = m_Constraints[i];
+                const Contact    &contact    = m_Contacts[constraint.Contact];
+                const Manifold2D &manifold   = contact.Manifold;
+                const BodyId      a          = contact.BodyA;
+                const BodyId      b          = contact.BodyB;
+
+                constraint.BodyA           = a;
+                constraint.BodyB           = b;
+                constraint.Normal          = manifold.Normal;
+                constraint.InverseMassA    = m_InverseMass[a];
+                constraint.InverseInertiaA = m_InverseInertia[a];
+                constraint.InverseMassB    = m_InverseMass[b];
+                constraint.InverseInertiaB = m_InverseInertia[b];
+                constraint.Friction        = contact.Friction;
+                constraint.Restitution     = contact.Restitution;
+                constraint.RollingImpulse  = manifold.RollingImpulse;
+                constraint.PointCount      = manifold.PointCount;
+
+                const float     mA = constraint.InverseMassA;
+                const float     iA = constraint.InverseInertiaA;
+                const float     mB = constraint.InverseMassB;
+                const float     iB = constraint.InverseInertiaB;
+
+                const float iSum = iA + iB;
+                constraint.RollingResistance = contact.RollingResistance;
+                constraint.RollingMass = iSum > 0.0f ? 1.0f / iSum : 0.0f;
+
+                const glm::vec2 normal  = manifold.Normal;
+                const glm::vec2 tangent = glm::vec2(normal.y, -normal.x);
+
+                for (uint32_t p = 0; p < manifold.PointCount; p++) {
+                    const ManifoldPoint2D &source = manifold.Points[p];
+                    ConstraintPoint       &point  = constraint.Points[p];
+
+                    const glm::vec2 rA = source.Point - m_Position[a];
+                    const glm::vec2 rB = source.Point - m_Position[b];
+                    point.AnchorA      = rA;
+                    point.AnchorB      = rB;
+
+                    const float rnA = Cross(rA, normal);
+                    const float rnB = Cross(rB, normal);
+                    const float kNormal =
+                        mA + mB + iA * rnA * rnA + iB * rnB * rnB;
+                    point.NormalMass = kNormal > 0.0f ? 1.0f / kNormal : 0.0f;
+
+                    const float rtA = Cross(rA, tangent);
+                    const float rtB = Cross(rB, tangent);
+                    const float kTangent =
+                        mA + mB + iA * rtA * rtA + iB * rtB * rtB;
+                    point.TangentMass =
+                        kTangent > 0.0f ? 1.0f / kTangent : 0.0f;
+
+                    const glm::vec2 dv =
+                        m_LinearVelocity[b] +
+                        Cross(m_AngularVelocity[b], rB) -
+                        m_LinearVelocity[a] - Cross(m_AngularVelocity[a], rA);
+                    point.RelativeVelocity = glm::dot(dv, normal);
+                    point.Separation       = source.Separation;
+                    point.NormalImpulse    = source.NormalImpulse;
+                    point.TangentImpulse   = source.TangentImpulse;
+                    point.MaxNormalImpulse = 0.0f;
+                    point.BiasImpulse      = 0.0f;
+                }
+
+                // Block solving needs a well conditioned matrix; two
+                // nearly coincident points fall back to one at a time.
+                constraint.BlockSolve = false;
+                if (manifold.PointCount == 2) {
+                    const ConstraintPoint &p1  = constraint.Points[0];
+                    const ConstraintPoint &p2  = constraint.Points[1];
+                    const float rn1A = Cross(p1.AnchorA, normal);
+                    const float rn1B = Cross(p1.AnchorB, normal);
+                    const float rn2A = Cross(p2.AnchorA, normal);
+                    const float rn2B = Cross(p2.AnchorB, normal);
+
+                    const float k11 =
+                        mA + mB + iA * rn1A * rn1A + iB * rn1B * rn1B;
+                    const float k22 =
+                        mA + mB + iA * rn2A * rn2A + iB * rn2B * rn2B;
+                    const float k12 =
+                        mA + mB + iA * rn1A * rn2A + iB * rn1B * rn2B;
+
+                    constexpr float kMaxCondition = 1000.0f;
+                    if (k11 * k11 < kMaxCondition * (k11 * k22 - k12 * k12)) {
+                        constraint.BlockSolve = true;
+                        constraint.K11        = k11;
+                        constraint.K12        = k12;
+                        constraint.K22        = k22;
+                    }
+                }
+            }
+        });
+}
+
+// Colors run one after another; the contacts within a color in parallel.
+template <typename Fn>
+void PhysicsWorld2D::ForEachColor(JobSystem *jobs, Fn &&fn) {
+    for (uint32_t color = 0; color < kMaxColors; color++) {
+        const uint32_t offset = m_ColorOffsets[color];
+        ParallelRange(jobs,
+                      m_ColorOffsets[color + 1] - offset,
+                      kContactsPerTask,
+                      [&](uint32_t begin, uint32_t end) {
+                          for (uint32_t i = begin; i < end; i++) {
+                              fn(m_Constraints[offset + i]);
+                          }
+                      });
+    }
+    for (uint32_t i = m_ColorOffsets[kMaxColors];
+         i < m_ColorOffsets[kMaxColors + 1];
+         i++) {
+        fn(m_Constraints[i]);
+    }
+}
+
+void PhysicsWorld2D::SolveConstraints(float dt, JobSystem *jobs) {
+    const float invDt = 1.0f / dt;
+
+    ForEachColor(jobs, [&](Constraint &constraint) { WarmStart(constraint); });
+    for (uint32_t i = 0; i < m_Specification.VelocityIterations; i++) {
+        ForEachColor(jobs, [&](Constraint &constraint) {
+            SolveConstraint(constraint, invDt);
+            SolveOverlap(constraint, invDt);
+        });
+    }
+    ForEachColor(jobs,
+                 [&](Constraint &constraint) { ApplyRestitution(constraint); });
+
+    // Keep the impulses for warm starting the next step.
+    ParallelRange(jobs,
+                  static_cast<uint32_t>(m_Constraints.size()),
+                  kContactsPerTask,
+                  [&](uint32_t begin, uint32_t end) {
+                      for (uint32_t i = begin; i < end; i++) {
+                          const Constraint &constraint = m_Constraints[i];
+                          Manifold2D       &manifold =
+                              m_Contacts[constraint.Contact].Manifold;
+                          manifold.RollingImpulse = constraint.RollingImpulse;
+                          for (uint32_t p = 0; p < constraint.PointCount; p++) {
+                              manifold.Points[p].NormalImpulse =
+                                  constraint.Points[p].NormalImpulse;
+                              manifold.Points[p].TangentImpulse =
+                                  constraint.Points[p].TangentImpulse;
+                          }
+                      }
+                  });
+}
+
+void PhysicsWorld2D::WarmStart(Constraint &constraint) {
+    const BodyId a = constraint.BodyA;
+    const BodyId b = constraint.BodyB;
+
+    glm::vec2 vA = m_LinearVelocity[a];
+    float     wA = m_AngularVelocity[a];
+    glm::vec2 vB = m_LinearVelocity[b];
+    float     wB = m_AngularVelocity[b];
+
+    const glm::vec2 normal  = constraint.Normal;
+    const glm::vec2 tangent = glm::vec2(normal.y, -normal.x);
+    for (uint32_t p = 0; p < constraint.PointCount; p++) {
+        const ConstraintPoint &point = constraint.Points[p];
+        const glm::vec2        impulse =
+            point.NormalImpulse * normal + point.TangentImpulse * tangent;
+
+        vA -= constraint.InverseMassA * impulse;
+        wA -= constraint.InverseInertiaA * Cross(point.AnchorA, impulse);
+        vB += constraint.InverseMassB * impulse;
+        wB += constraint.InverseInertiaB * Cross(point.AnchorB, impulse);
+    }
+    wA -= constraint.InverseInertiaA * constraint.RollingImpulse;
+    wB += constraint.InverseInertiaB * constraint.RollingImpulse;
+    StoreVelocities(
+        constraint, m_LinearVelocity, m_AngularVelocity, vA, wA, vB, wB);
+}
+
+/*
+ * One Gauss-Seidel pass over the contact's points, friction first so the
+ * non-penetration impulses get the last word. A speculative (still
+ * separated) point only stops the bodies from closing more than the gap
+ * this step.
+ */
+void PhysicsWorld2D::SolveConstraint(Constraint &constraint, float invDt) {
+    const BodyId a = constraint.BodyA;
+    const BodyId b = constraint.BodyB;
+
+    glm::vec2 vA = m_LinearVelocity[a];
+    float     wA = m_AngularVelocity[a];
+    glm::vec2 vB = m_LinearVelocity[b];
+    float     wB = m_AngularVelocity[b];
+
+    const float     mA      = constraint.InverseMassA;
+    const float     iA      = constraint.InverseInertiaA;
+    const float     mB      = constraint.InverseMassB;
+    const float     iB      = constraint.InverseInertiaB;
+    const glm::vec2 normal  = constraint.Normal;
+    const glm::vec2 tangent = glm::vec2(normal.y, -normal.x);
+
+    // Rolling resistance: a torque opposing the relative spin, limited
+    // like friction by how hard the bodies press together.
+    if (constraint.RollingResistance > 0.0f) {
+        float normalImpulse = 0.0f;
+        for (uint32_t p = 0; p < constraint.PointCount; p++) {
+            normalImpulse += constraint.Points[p].NormalImpulse;
+        }
+        const float maxImpulse = constraint.RollingResistance * normalImpulse;
+        const float total =
+            std::clamp(constraint.RollingImpulse -
+                           constraint.RollingMass * (wB - wA),
+                       -maxImpulse,
+                       maxImpulse);
+        const float impulse       = total - constraint.RollingImpulse;
+        constraint.RollingImpulse = total;
+
+        wA -= iA * impulse;
+        wB += iB * impulse;
+    }
+
+    for (uint32_t p = 0; p < constraint.PointCount; p++) {
+        ConstraintPoint &point = constraint.Points[p];
+        const glm::vec2  rA    = point.AnchorA;
+        const glm::vec2  rB    = point.AnchorB;
+
+        const glm::vec2 dv = vB + Cross(wB, rB) - vA - Cross(wA, rA);
+        const float     vt = glm::dot(dv, tangent);
+
+        const float maxFriction = constraint.Friction * point.NormalImpulse;
+        const float total       = std::clamp(point.TangentImpulse -
+                                           point.TangentMass * vt,
+                                       -maxFriction,
+                                       maxFriction);
+        const glm::vec2 impulse = (total - point.TangentImpulse) * tangent;
+        point.TangentImpulse    = total;
+
+        vA -= mA * impulse;
+        wA -= iA * Cross(rA, impulse);
+        vB += mB * impulse;
+        wB += iB * Cross(rB, impulse);
+    }
+
+    if (constraint.BlockSolve) {
+        SolveBlock(constraint, vA, wA, vB, wB, invDt);
+        StoreVelocities(
+            constraint, m_LinearVelocity, m_AngularVelocity, vA, wA, vB, wB);
+        return;
+    }
+
+    for (uint32_t p = 0; p < constraint.PointCount; p++) {
+        ConstraintPoint &point = constraint.Points[p];
+        const glm::vec2  rA    = point.AnchorA;
+        const glm::vec2  rB    = point.AnchorB;
+
+        // Overlap is left to SolveOverlap().
+        const float bias = std::max(point.Separation, 0.0f) * invDt;
+
+        const glm::vec2 dv = vB + Cross(wB, rB) - vA - Cross(wA, rA);
+        const float     vn = glm::dot(dv, normal);
+
+        const float total = std::max(
+            point.NormalImpulse - point.NormalMass * (vn + bias), 0.0f);
+        const glm::vec2 impulse = (total - point.NormalImpulse) * normal;
+        point.NormalImpulse     = total;
+        point.MaxNormalImpulse  = std::max(point.MaxNormalImpulse, total);
+
+        vA -= mA * impulse;
+        wA -= iA * Cross(rA, impulse);
+        vB += mB * impulse;
+        wB += iB * Cross(rB, impulse);
+    }
+    StoreVelocities(
+        constraint, m_LinearVelocity, m_AngularVelocity, vA, wA, vB, wB);
+}
+
+/*
+ * Solves both normal impulses of a two point contact at once, as a 2x2
+ * linear complementarity problem: find x >= 0 with K x + b >= 0 and
+ * x . (K x + b) = 0, by trying which points are active. Solving the points
+ * one after the other lets a resting box rock between its two corners,
+ * which tall stacks amplify until they topple.
+ */
+void PhysicsWorld2D::SolveBlock(Constraint &constraint,
+                                glm::vec2  &linearA,
+                                float      &angularA,
+                                glm::vec2  &linearB,
+                                float      &angularB,
+                                float       invDt) {
+    ConstraintPoint &p1     = constraint.Points[0];
+    ConstraintPoint &p2     = constraint.Points[1];
+    const glm::vec2  normal = constraint.Normal;
+
+    const glm::vec2 dv1 = linearB + Cross(angularB, p1.AnchorB) - linearA -
+                          Cross(angularA, p1.AnchorA);
+    const glm::vec2 dv2 = linearB + Cross(angularB, p2.AnchorB) - linearA -
+                          Cross(angularA, p2.AnchorA);
+
+    // Velocities the impulses have to cancel, less what they already do.
+    const float k11 = constraint.K11;
+    const float k12 = constraint.K12;
+    const float k22 = constraint.K22;
+    const float a1  = p1.NormalImpulse;
+    const float a2  = p2.NormalImpulse;
+    const float b1  = glm::dot(dv1, normal) +
+                     std::max(p1.Separation, 0.0f) * invDt - k11 * a1 -
+                     k12 * a2;
+    const float b2 = glm::dot(dv2, normal) +
+                     std::max(p2.Separation, 0.0f) * invDt - k12 * a1 -
+                     k22 * a2;
+
+    // Both points pushing.
+    const float invDet = 1.0f / (k11 * k22 - k12 * k12);
+    float       x1     = -invDet * (k22 * b1 - k12 * b2);
+    float       x2     = -invDet * (k11 * b2 - k12 * b1);
+    if (x1 < 0.0f || x2 < 0.0f) {
+        // Only the first, the second separating.
+        x1 = -p1.NormalMass * b1;
+        x2 = 0.0f;
+        if (x1 < 0.0f || k12 * x1 + b2 < 0.0f) {
+            // Only the second.
+            x1 = 0.0f;
+            x2 = -p2.NormalMass * b2;
+            if (x2 < 0.0f || k12 * x2 + b1 < 0.0f) {
+                // Neither; the velocities already separate (b >= 0), or
+                // no case fits and the impulses stay as they were.
+                x1 = 0.0f;
+                x2 = 0.0f;
+                if (b1 < 0.0f || b2 < 0.0f) {
+                    return;
+                }
+            }
+        }
+    }
+
+    const glm::vec2 impulse1 = (x1 - a1) * normal;
+    const glm::vec2 impulse2 = (x2 - a2) * normal;
+    p1.NormalImpulse         = x1;
+    p2.NormalImpulse         = x2;
+    p1.MaxNormalImpulse      = std::max(p1.MaxNormalImpulse, x1);
+    p2.MaxNormalImpulse      = std::max(p2.MaxNormalImpulse, x2);
+
+    linearA -= constraint.InverseMassA * (impulse1 + impulse2);
+    angularA -= constraint.InverseInertiaA * (Cross(p1.AnchorA, impulse1) +
+                                              Cross(p2.AnchorA, impulse2));
+    linearB += constraint.InverseMassB * (impulse1 + impulse2);
+    angularB += constraint.InverseInertiaB * (Cross(p1.AnchorB, impulse1) +
+                                              Cross(p2.AnchorB, impulse2));
+}
+
+/*
+ * Baumgarte-style push out of the overlap beyond LinearSlop, applied to
+ * the bias velocities only (split impulse): the bodies separate this step
+ * without gaining momentum from it.
+ */
+void PhysicsWorld2D::SolveOverlap(Constraint &constraint, float invDt) {
+    const BodyId a = constraint.BodyA;
+    const BodyId b = constraint.BodyB;
+
+    glm::vec2 vA = m_BiasLinearVelocity[a];
+    float     wA = m_BiasAngularVelocity[a];
+    glm::vec2 vB = m_BiasLinearVelocity[b];
+    float     wB = m_BiasAngularVelocity[b];
+
+    const glm::vec2 normal = constraint.Normal;
+    for (uint32_t p = 0; p < constraint.PointCount; p++) {
+        ConstraintPoint &point = constraint.Points[p];
+        const float      overlap =
+            -(point.Separation + m_Specification.LinearSlop);
+        if (overlap <= 0.0f) {
+            continue;
+        }
+
+        const glm::vec2 rA = point.AnchorA;
+        const glm::vec2 rB = point.AnchorB;
+        const glm::vec2 dv = vB + Cross(wB, rB) - vA - Cross(wA, rA);
+        const float     vn = glm::dot(dv, normal);
+
+        const float target =
+            std::min(m_Specification.BaumgarteFactor * invDt * overlap,
+                     m_Specification.MaxCorrectionSpeed);
+        const float total = std::max(
+            point.BiasImpulse - point.NormalMass * (vn - target), 0.0f);
+        const glm::vec2 impulse = (total - point.BiasImpulse) * normal;
+        point.BiasImpulse       = total;
+
+        vA -= constraint.InverseMassA * impulse;
+        wA -= constraint.InverseInertiaA * Cross(rA, impulse);
+        vB += constraint.InverseMassB * impulse;
+        wB += constraint.InverseInertiaB * Cross(rB, impulse);
+    }
+    StoreVelocities(constraint,
+                    m_BiasLinearVelocity,
+                    m_BiasAngularVelocity,
+                    vA,
+                    wA,
+                    vB,
+                    wB);
+}
+
+// Bounces points that hit faster than the threshold and actually pushed.
+void PhysicsWorld2D::ApplyRestitution(Constraint &constraint) {
+    if (constraint.Restitution == 0.0f) {
+        return;
+    }
+
+    const BodyId a = constraint.BodyA;
+    const BodyId b = constraint.BodyB;
+
+    glm::vec2 vA = m_LinearVelocity[a];
+    float     wA = m_AngularVelocity[a];
+    glm::vec2 vB = m_LinearVelocity[b];
+    float     wB = m_AngularVelocity[b];
+
+    const glm::vec2 normal = constraint.Normal;
+    for (uint32_t p = 0; p < constraint.PointCount; p++) {
+        ConstraintPoint &point = constraint.Points[p];
+        if (point.RelativeVelocity > -m_Specification.RestitutionThreshold ||
+            point.MaxNormalImpulse == 0.0f) {
+            continue;
+        }
+
+        const glm::vec2 rA = point.AnchorA;
+        const glm::vec2 rB = point.AnchorB;
+        const glm::vec2 dv = vB + Cross(wB, rB) - vA - Cross(wA, rA);
+        const float     vn = glm::dot(dv, normal);
+
+        const float target = -constraint.Restitution * point.RelativeVelocity;
+        const float total  = std::max(
+            point.NormalImpulse - point.NormalMass * (vn - target), 0.0f);
+        const glm::vec2 impulse = (total - point.NormalImpulse) * normal;
+        point.NormalImpulse     = total;
+
+        vA -= constraint.InverseMassA * impulse;
+        wA -= constraint.InverseInertiaA * Cross(rA, impulse);
+        vB += constraint.InverseMassB * impulse;
+        wB += constraint.InverseInertiaB * Cross(rB, impulse);
+    }
+    StoreVelocities(
+        constraint, m_LinearVelocity, m_AngularVelocity, vA, wA, vB, wB);
+}
+
+/*
+ * Only dynamic bodies are written: a static or kinematic body may appear
+ * in many contacts of the same color, which are solved concurrently.
+ */
+void PhysicsWorld2D::StoreVelocities(const Constraint       &constraint,
+                                     std::vector<glm::vec2> &linear,
+                                     std::vector<float>     &angular,
+                                     const glm::vec2        &linearA,
+                                     float                   angularA,
+                                     const glm::vec2        &linearB,
+                                     float                   angularB) {
+    if (constraint.InverseMassA > 0.0f) {
+        linear[constraint.BodyA]  = linearA;
+        angular[constraint.BodyA] = angularA;
+    }
+    if (constraint.InverseMassB > 0.0f) {
+        linear[constraint.BodyB]  = linearB;
+        angular[constraint.BodyB] = angularB;
+    }
+}
+
+void PhysicsWorld2D::IntegratePositions(float dt, JobSystem *jobs) {
+    const float linearTolerance =
+        m_Specification.SleepLinearVelocity *
+        m_Specification.SleepLinearVelocity;
+    const float angularTolerance = m_Specification.SleepAngularVelocity;
+
+    ParallelRange(
+        jobs,
+        static_cast<uint32_t>(m_AwakeBodies.size()),
+        kBodiesPerTask,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const BodyId     body = m_AwakeBodies[i];
+                const glm::vec2 &v    = m_LinearVelocity[body];
+                const float      w    = m_AngularVelocity[body];
+
+                m_Position[body] += dt * (v + m_BiasLinearVelocity[body]);
+                m_Angle[body] += dt * (w + m_BiasAngularVelocity[body]);
+                m_Rotation[body] = Rotation2D::FromAngle(m_Angle[body]);
+                m_Bounds[body]   = ComputeBounds(body);
+
+                m_BiasLinearVelocity[body]  = glm::vec2(0.0f);
+                m_BiasAngularVelocity[body] = 0.0f;
+
+                if (glm::dot(v, v) > linearTolerance ||
+                    std::abs(w) > angularTolerance) {
+                    m_SleepTime[body] = 0.0f;
+                } else {
+                    m_SleepTime[body] += dt;
+                }
+            }
+        });
+
+    // The broadphase is not thread-safe; Move() is cheap when the cell
+    // range did not change, which is the common case.
+    for (BodyId body : m_AwakeBodies) {
+        m_Broadphase.Move(m_Proxy[body], m_Bounds[body]);
+    }
+}
+
+/*
+ * Groups the awake dynamic bodies into islands (union-find over the solved
+ * contacts) and puts every island whose bodies have all rested for
+ * SleepTime to sleep. Static and kinematic bodies do not join islands,
+ * so a floor does not connect everything standing on it.
+ */
+void PhysicsWorld2D::UpdateSleep() {
+    auto find = [&](uint32_t body) {
+        while (m_IslandParent[body] != body) {
+            m_IslandParent[body] = m_IslandParent[m_IslandParent[body]];
+            body                 = m_IslandParent[body];
+        }
+        return body;
+    };
+
+    for (BodyId body : m_AwakeBodies) {
+        m_IslandParent[body]    = body;
+        m_IslandSleepTime[body] = m_Specification.SleepTime;
+        m_IslandSlot[body]      = kNoIsland;
+    }
+    for (const Constraint &constraint : m_Constraints) {
+        if (IsDynamic(constraint.BodyA) && IsDynamic(constraint.BodyB)) {
+            const uint32_t rootA = find(constraint.BodyA);
+            const uint32_t rootB = find(constraint.BodyB);
+            if (rootA != rootB) {
+                m_IslandParent[std::max(rootA, rootB)] =
+                    std::min(rootA, rootB);
+            }
+        }
+    }
+
+    for (BodyId body : m_AwakeBodies) {
+        if (IsDynamic(body)) {
+            const uint32_t root = find(body);
+            m_IslandSleepTime[root] =
+                std::min(m_IslandSleepTime[root], m_SleepTime[body]);
+            m_Stats.IslandCount += root == body;
+        }
+    }
+
+    for (BodyId body : m_AwakeBodies) {
+        if (!IsDynamic(body)) {
+            continue;
+        }
+        const uint32_t root = find(body);
+        if (m_IslandSleepTime[root] < m_Specification.SleepTime) {
+            continue;
+        }
+
+        if (m_IslandSlot[root] == kNoIsland) {
+            if (m_FreeIslands.empty()) {
+                m_IslandSlot[root] =
+                    static_cast<uint32_t>(m_SleepingIslands.size());
+                m_SleepingIslands.emplace_back();
+            } else {
+                m_IslandSlot[root] = m_FreeIslands.back();
+                m_FreeIslands.pop_back();
+            }
+        }
+
+        m_SleepingIslands[m_IslandSlot[root]].push_back(body);
+        m_SleepingIsland[body]  = m_IslandSlot[root];
+        m_LinearVelocity[body]  = glm::vec2(0.0f);
+        m_AngularVelocity[body] = 0.0f;
+        m_Flags[body] &= ~kAwake;
+    }
+}
+
+void PhysicsWorld2D::ResizeBodies(size_t count) {
+    m_Position.resize(count);
+    m_Angle.resize(count);
+    m_Rotation.resize(count);
+    m_LinearVelocity.resize(count);
+    m_AngularVelocity.resize(count);
+    m_BiasLinearVelocity.resize(count);
+    m_BiasAngularVelocity.resize(count);
+    m_Force.resize(count);
+    m_InverseMass.resize(count);
+    m_InverseInertia.resize(count);
+    m_Friction.resize(count);
+    m_Restitution.resize(count);
+    m_RollingResistance.resize(count);
+    m_SleepTime.resize(count);
+    m_Shape.resize(count);
+    m_Bounds.resize(count);
+    m_Type.resize(count);
+    m_Flags.resize(count);
+    m_Proxy.resize(count);
+    m_SleepingIsland.resize(count);
+    m_UserData.resize(count);
+
+    m_ColorMask.resize(count);
+    m_IslandParent.resize(count);
+    m_IslandSleepTime.resize(count);
+    m_IslandSlot.resize(count);
+}
+
+void PhysicsWorld2D::UpdateMass(BodyId body,
+                                float  density,
+                                bool   fixedRotation) {
+    if (!IsDynamic(body)) {
+        m_InverseMass[body]    = 0.0f;
+        m_InverseInertia[body] = 0.0f;
+        return;
+    }
+
+    // Dynamic bodies always get some mass so the solver can move them.
+    float mass = density * m_Shape[body].GetArea();
+    if (mass <= 0.0f) {
+        mass = 1.0f;
+    }
+    const float inertia = m_Shape[body].GetInertia(mass);
+
+    m_InverseMass[body] = 1.0f / mass;
+    m_InverseInertia[body] =
+        fixedRotation || inertia <= 0.0f ? 0.0f : 1.0f / inertia;
+}
+
+// Grown by the speculative distance so pairs are found before they touch.
+Aabb PhysicsWorld2D::ComputeBounds(BodyId body) const {
+    const float margin = m_Specification.SpeculativeDistance;
+    return m_Shape[body]
+        .ComputeBounds({m_Position[body], m_Rotation[body]})
+        .Expanded(glm::vec3(margin, margin, 0.0f));
+}
+
+} // namespace brnCore
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Physics/Collision2D.h"
+#include "Engine/Physics/SpatialHash.h"
+
+namespace brnCore {
+
+using BodyId = uint32_t;
+
+inline constexpr BodyId kInvalidBody = std::numeric_limits<BodyId>::max();
+
+enum class BodyType2D : uint8_t {
+    Static,    // never moves
+    Kinematic, // moved by its velocity, unaffected by contacts
+    Dynamic,
+};
+
+struct BodySpecification2D {
+    BodyType2D Type            = BodyType2D::Dynamic;
+    Shape2D    Shape           = Shape2D();
+    glm::vec2  Position        = glm::vec2(0.0f);
+    float      Angle           = 0.0f;
+    glm::vec2  LinearVelocity  = glm::vec2(0.0f);
+    float      AngularVelocity = 0.0f;
+    float      Density         = 1.0f;
+    float      Friction        = 0.6f;
+    float      Restitution     = 0.0f;
+    // Circles: resisting torque as a fraction of radius x normal force, so
+    // a ball does not roll (or rock in a gap) forever.
+    float    RollingResistance = 0.02f;
+    bool     FixedRotation     = false;
+    uint64_t UserData          = 0;
+};
+
+struct PhysicsWorld2DSpecification {
+    glm::vec2 Gravity            = glm::vec2(0.0f, -10.0f);
+    uint32_t  VelocityIterations = 8;
+
+    float LinearSlop           = 0.005f; // allowed overlap
+    float SpeculativeDistance  = 0.02f;  // contacts start this far apart
+    float BaumgarteFactor      = 0.2f;   // overlap removed per step
+    float MaxCorrectionSpeed   = 1.0f;   // m/s
+    float RestitutionThreshold = 1.0f;   // slower impacts do not bounce
+
+    float SleepTime            = 0.5f; // seconds at rest before sleeping
+    float SleepLinearVelocity  = 0.05f;
+    float SleepAngularVelocity = 0.035f; // ~2 degrees per second
+};
+
+struct PhysicsStats2D {
+    uint32_t BodyCount           = 0;
+    uint32_t AwakeBodyCount      = 0;
+    uint32_t ContactCount        = 0; // broadphase pairs kept as contacts
+    uint32_t SolvedContacts      = 0; // touching contacts with an awake body
+    uint32_t ColorCount          = 0;
+    uint32_t OverflowCount       = 0; // contacts solved serially
+    uint32_t IslandCount         = 0; // awake islands
+    uint32_t SleepingIslandCount = 0;
+
+    double CollideMs = 0.0;
+    double SolveMs   = 0.0;
+    double StepMs    = 0.0;
+};
+
+/*
+ * 2D rigid bodies (circles and boxes) with a sequential impulse solver.
+ *
+ * Body state lives in parallel arrays indexed by BodyId, so every solver
+ * pass streams over only the fields it touches. Contacts are found by a
+ * SpatialHash, kept in a list sorted by proxy pair and matched by feature
+ * id across steps, so their accumulated impulses warm start the next step.
+ * The two points of a box resting on a face are solved together as one
+ * block, which is what keeps tall stacks from rocking themselves over.
+ *
+ * Overlap is pushed apart with split impulses: a separate set of bias
+ * velocities that move the bodies this step but are then dropped, so
+ * resolving penetration does not add energy that makes deep piles boil.
+ *
+ * To solve on several threads the touching contacts are greedily colored
+ * so that no two contacts of one color share a dynamic body; each color
+ * is then solved with ParallelFor. Contacts that do not fit in the fixed
+ * number of colors are solved serially after the colors.
+ *
+ * Bodies connected by contacts form islands. When every body of an island
+ * has been at rest for SleepTime the island goes to sleep: its bodies are
+ * skipped by integration, narrowphase and solver until something touches
+ * them, which wakes the whole island.
+ *
+ * Step() is meant to be called with a fixed dt from Layer::OnFixedUpdate.
+ */
+class PhysicsWorld2D {
+  public:
+    explicit PhysicsWorld2D(const PhysicsWorld2DSpecification &specification =
+                                PhysicsWorld2DSpecification());
+
+    BodyId CreateBody(const BodySpecification2D &specification);
+    void   DestroyBody(BodyId body);
+    bool   IsAlive(BodyId body) const;
+
+    void Step(float dt, JobSystem *jobs = nullptr);
+
+    glm::vec2 GetPosition(BodyId body) const { return m_Position[body]; }
+    float     GetAngle(BodyId body) const { return m_Angle[body]; }
+    // Teleports the body and wakes it.
+    void SetTransform(BodyId body, const glm::vec2 &position, float angle);
+
+    glm::vec2 GetLinearVelocity(BodyId body) const {
+        return m_LinearVelocity[body];
+    }
+    float GetAngularVelocity(BodyId body) const {
+        return m_AngularVelocity[body];
+    }
+    void SetLinearVelocity(BodyId body, const glm::vec2 &velocity);
+    void SetAngularVelocity(BodyId body, float velocity);
+
+    // Forces are cleared after every step.
+    void ApplyForce(BodyId body, const glm::vec2 &force);
+    void ApplyLinearImpulse(BodyId           body,
+                            const glm::vec2 &impulse,
+                            const glm::vec2 &point);
+
+    BodyType2D     GetType(BodyId body) const { return m_Type[body]; }
+    const Shape2D &GetShape(BodyId body) const { return m_Shape[body]; }
+    uint64_t       GetUserData(BodyId body) const { return m_UserData[body]; }
+
+    bool IsAwake(BodyId body) const { return m_Flags[body] & kAwake; }
+    void WakeBody(BodyId body);
+
+    // Calls fn(BodyId) for every body whose bounds overlap `bounds`.
+    template <typename Fn>
+    void QueryAabb(const Aabb &bounds, Fn &&fn) const {
+        m_Broadphase.QueryAabb(
+            bounds, [&](ProxyId proxy) { fn(m_ProxyBody[proxy]); });
+    }
+
+    const PhysicsStats2D &GetStats() const { return m_Stats; }
+
+  private:
+    static constexpr uint8_t  kAlive     = 1 << 0;
+    static constexpr uint8_t  kAwake     = 1 << 1;
+    static constexpr uint32_t kMaxColors = 24;
+    static constexpr uint32_t kNoIsland  = ~0u;
+
+    struct Contact {
+        uint64_t   Key; // proxy pair, the order FindPairs() reports
+        BodyId     BodyA;
+        BodyId     BodyB;
+        float      Friction;
+        float      Restitution;
+        float      RollingResistance; // lever arm, 0 without a circle
+        Manifold2D Manifold;
+    };
+
+    struct ConstraintPoint {
+        glm::vec2 AnchorA; // contact point relative to the body centres
+        glm::vec2 AnchorB;
+        float     NormalMass;
+        float     TangentMass;
+        float     Separation;
+        float     RelativeVelocity; // normal velocity before solving
+        float     NormalImpulse;
+        float     TangentImpulse;
+        float     MaxNormalImpulse;
+        float     BiasImpulse; // split impulse pushing overlap apart
+    };
+
+    struct Constraint {
+        uint32_t        Contact;
+        BodyId          BodyA;
+        BodyId          BodyB;
+        glm::vec2       Normal;
+        float           InverseMassA;
+        float           InverseInertiaA;
+        float           InverseMassB;
+        float           InverseInertiaB;
+        float           Friction;
+        float           Restitution;
+        float           RollingResistance;
+        float           RollingMass;
+        float           RollingImpulse;
+        uint32_t        PointCount;
+        ConstraintPoint Points[2];
+        // Normal mass matrix of a two point contact, solved as one block.
+        bool  BlockSolve;
+        float K11;
+        float K12;
+        float K22;
+    };
+
+    void UpdateContacts(JobSystem *jobs);
+    void WakeTouchedIslands();
+    void BuildAwakeList();
+    void IntegrateVelocities(float dt, JobSystem *jobs);
+    void PrepareConstraints(JobSystem *jobs);
+    void SolveConstraints(float dt, JobSystem *jobs);
+    void IntegratePositions(float dt, JobSystem *jobs);
+    void UpdateSleep();
+
+    void WarmStart(Constraint &constraint);
+    void SolveConstraint(Constraint &constraint, float invDt);
+    static void SolveBlock(Constraint &constraint,
+                           glm::vec2  &linearA,
+                           float      &angularA,
+                           glm::vec2  &linearB,
+                           float      &angularB,
+                           float       invDt);
+    void SolveOverlap(Constraint &constraint, float invDt);
+    void ApplyRestitution(Constraint &constraint);
+
+    static void StoreVelocities(const Constraint       &constraint,
+                                std::vector<glm::vec2> &linear,
+                                std::vector<float>     &angular,
+                                const glm::vec2        &linearA,
+                                float                   angularA,
+                                const glm::vec2        &linearB,
+                                float                   angularB);
+
+    template <typename Fn>
+    void ForEachColor(JobSystem *jobs, Fn &&fn);
+    void ResizeBodies(size_t count);
+    void UpdateMass(BodyId body, float density, bool fixedRotation);
+    Aabb ComputeBounds(BodyId body) const;
+    bool IsDynamic(BodyId body) const {
+        return m_Type[body] == BodyType2D::Dynamic;
+    }
+
+    PhysicsWorld2DSpecification m_Specification;
+    SpatialHash                 m_Broadphase;
+
+    // Body state, indexed by BodyId.
+    std::vector<glm::vec2>  m_Position;
+    std::vector<float>      m_Angle;
+    std::vector<Rotation2D> m_Rotation;
+    std::vector<glm::vec2>  m_LinearVelocity;
+    std::vector<float>      m_AngularVelocity;
+    std::vector<glm::vec2>  m_BiasLinearVelocity; // overlap push, this step
+    std::vector<float>      m_BiasAngularVelocity;
+    std::vector<glm::vec2>  m_Force;
+    std::vector<float>      m_InverseMass;
+    std::vector<float>      m_InverseInertia;
+    std::vector<float>      m_Friction;
+    std::vector<float>      m_Restitution;
+    std::vector<float>      m_RollingResistance; // lever arm
+    std::vector<float>      m_SleepTime;
+    std::vector<Shape2D>    m_Shape;
+    std::vector<Aabb>       m_Bounds;
+    std::vector<BodyType2D> m_Type;
+    std::vector<uint8_t>    m_Flags;
+    std::vector<ProxyId>    m_Proxy;
+    std::vector<uint32_t>   m_SleepingIsland;
+    std::vector<uint64_t>   m_UserData;
+    std::vector<BodyId>     m_FreeBodies;
+    std::vector<BodyId>     m_ProxyBody;
+    uint32_t                m_BodyCount = 0;
+
+    // Per-step scratch, indexed by BodyId.
+    std::vector<uint32_t> m_ColorMask;
+    std::vector<uint32_t> m_IslandParent;
+    std::vector<float>    m_IslandSleepTime;
+    std::vector<uint32_t> m_IslandSlot;
+
+    std::vector<Contact>   m_Contacts;
+    std::vector<Contact>   m_NextContacts;
+    std::vector<ProxyPair> m_Pairs;
+    std::vector<uint32_t>  m_ContactsToUpdate;
+
+    std::vector<BodyId>     m_AwakeBodies;
+    std::vector<uint32_t>   m_SolvedContacts;
+    std::vector<uint8_t>    m_SolvedColors;
+    std::vector<Constraint> m_Constraints; // grouped by color
+    // Start of every color, then of the overflow, then the end.
+    uint32_t m_ColorOffsets[kMaxColors + 2] = {};
+
+    std::vector<std::vector<BodyId>> m_SleepingIslands;
+    std::vector<uint32_t>            m_FreeIslands;
+
+    PhysicsStats2D m_Stats;
+};
+
+} // namespace brnCore
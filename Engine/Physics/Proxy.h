@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace brnCore {
+
+// Handle of a box registered with a broadphase structure.
+using ProxyId = uint32_t;
+
+inline constexpr ProxyId kInvalidProxy = std::numeric_limits<ProxyId>::max();
+
+struct ProxyPair {
+    ProxyId A; // A < B
+    ProxyId B;
+
+    bool operator==(const ProxyPair &) const = default;
+};
+
+} // namespace brnCore
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Physics/Aabb.h"
+
+namespace brnCore {
+
+struct Ray {
+    glm::vec3 Origin      = glm::vec3(0.0f);
+    glm::vec3 Direction   = glm::vec3(0.0f, 0.0f, 1.0f); // need not be unit
+    float     MaxDistance = std::numeric_limits<float>::max();
+};
+
+/*
+ * Slab test against a box, with the reciprocal direction precomputed by
+ * the caller since it is shared by every box of a traversal. Returns the
+ * entry distance in units of Direction, or a negative value on a miss.
+ */
+inline float IntersectRayAabb(const Ray       &ray,
+                              const glm::vec3 &inverseDirection,
+                              const Aabb      &bounds,
+                              float            maxDistance) {
+    const glm::vec3 t0   = (bounds.Min - ray.Origin) * inverseDirection;
+    const glm::vec3 t1   = (bounds.Max - ray.Origin) * inverseDirection;
+    const glm::vec3 near = glm::min(t0, t1);
+    const glm::vec3 far  = glm::max(t0, t1);
+
+    const float enter =
+        std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+    const float exit =
+        std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+    return enter <= exit ? enter : -1.0f;
+}
+
+} // namespace brnCore
@@ -0,0 +1,336 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace brnCore {
+
+namespace {
+// Cell coordinates are packed into 21 bits per axis.
+constexpr int kCoordLimit = (1 << 20) - 1;
+
+constexpr uint32_t kCellsPerTask = 256;
+
+uint64_t HashKey(uint64_t key) {
+    key ^= key >> 31;
+    key *= 0x9E3779B97F4A7C15ull;
+    return key ^ (key >> 29);
+}
+
+float GetMaxExtent(const Aabb &bounds) {
+    const glm::vec3 extent = bounds.GetExtent();
+    return std::max(extent.x, std::max(extent.y, extent.z));
+}
+} // namespace
+
+SpatialHash::SpatialHash(const SpatialHashSpecification &specification)
+    : m_Specification(specification) {
+    if (m_Specification.CellSize > 0.0f) {
+        m_CellSize        = m_Specification.CellSize;
+        m_InverseCellSize = 1.0f / m_CellSize;
+    }
+}
+
+ProxyId SpatialHash::Insert(const Aabb &bounds) {
+    ProxyId proxy;
+    if (!m_FreeProxies.empty()) {
+        proxy = m_FreeProxies.back();
+        m_FreeProxies.pop_back();
+    } else {
+        proxy = static_cast<ProxyId>(m_Proxies.size());
+        m_Proxies.emplace_back();
+    }
+
+    Proxy &entry = m_Proxies[proxy];
+    entry.Bounds = bounds;
+    entry.Range  = GetCellRange(bounds);
+    entry.Alive  = true;
+    AddToCells(proxy);
+
+    m_ProxyCount++;
+    m_ExtentSum += GetMaxExtent(bounds);
+    return proxy;
+}
+
+void SpatialHash::Remove(ProxyId proxy) {
+    assert(proxy < m_Proxies.size() && m_Proxies[proxy].Alive);
+
+    RemoveFromCells(proxy);
+    m_ExtentSum -= GetMaxExtent(m_Proxies[proxy].Bounds);
+    m_Proxies[proxy].Alive = false;
+    m_FreeProxies.push_back(proxy);
+    m_ProxyCount--;
+}
+
+void SpatialHash::Move(ProxyId proxy, const Aabb &bounds) {
+    Proxy &entry = m_Proxies[proxy];
+    assert(entry.Alive);
+
+    m_ExtentSum += GetMaxExtent(bounds) - GetMaxExtent(entry.Bounds);
+    entry.Bounds = bounds;
+
+    // Most moves stay within the same cells and cost nothing else.
+    const CellRange range = GetCellRange(bounds);
+    if (range == entry.Range) {
+        return;
+    }
+    RemoveFromCells(proxy);
+    entry.Range = range;
+    AddToCells(proxy);
+}
+
+void SpatialHash::FindPairs(std::vector<ProxyPair> &out, JobSystem *jobs) {
+    out.clear();
+    if (m_Specification.CellSize <= 0.0f) {
+        AutoTune();
+    }
+
+    const uint32_t cellCount = static_cast<uint32_t>(m_Cells.size());
+    if (!jobs || cellCount <= kCellsPerTask) {
+        CollectPairs(0, cellCount, out);
+    } else {
+        m_ThreadPairs.resize(jobs->GetThreadCount());
+        for (std::vector<ProxyPair> &pairs : m_ThreadPairs) {
+            pairs.clear();
+        }
+        jobs->ParallelFor(
+            cellCount, kCellsPerTask, [this](uint32_t begin, uint32_t end) {
+                CollectPairs(
+                    begin, end, m_ThreadPairs[JobSystem::GetThreadIndex()]);
+            });
+        for (const std::vector<ProxyPair> &pairs : m_ThreadPairs) {
+            out.insert(out.end(), pairs.begin(), pairs.end());
+        }
+    }
+
+    std::ranges::sort(out, [](const ProxyPair &a, const ProxyPair &b) {
+        return a.A != b.A ? a.A < b.A : a.B < b.B;
+    });
+}
+
+void SpatialHash::SetCellSize(float cellSize) {
+    m_Specification.CellSize = cellSize;
+    if (cellSize <= 0.0f) {
+        m_TunedExtent = 0.0f;
+        AutoTune();
+        return;
+    }
+    m_CellSize        = cellSize;
+    m_InverseCellSize = 1.0f / cellSize;
+    RebinAll();
+}
+
+uint64_t SpatialHash::PackKey(const glm::ivec3 &coord) {
+    constexpr uint64_t kMask = (1ull << 21) - 1;
+    return (static_cast<uint64_t>(coord.x) & kMask) << 42 |
+           (static_cast<uint64_t>(coord.y) & kMask) << 21 |
+           (static_cast<uint64_t>(coord.z) & kMask);
+}
+
+const SpatialHash::Cell *SpatialHash::FindCell(const glm::ivec3 &coord) const {
+    if (m_Lookup.empty()) {
+        return nullptr;
+    }
+
+    const uint64_t key  = PackKey(coord);
+    const size_t   mask = m_Lookup.size() - 1;
+    for (size_t i = HashKey(key) & mask;; i = (i + 1) & mask) {
+        const LookupSlot &slot = m_Lookup[i];
+        if (slot.Key == key) {
+            return &m_Cells[slot.Cell];
+        }
+        if (slot.Key == LookupSlot::kEmpty) {
+            return nullptr;
+        }
+    }
+}
+
+SpatialHash::Cell &SpatialHash::FindOrCreateCell(const glm::ivec3 &coord) {
+    // Keep the load factor at or below one half.
+    if ((m_CellCount + 1) * 2 > m_Lookup.size()) {
+        GrowLookup();
+    }
+
+    const uint64_t key  = PackKey(coord);
+    const size_t   mask = m_Lookup.size() - 1;
+    size_t         i    = HashKey(key) & mask;
+    for (; m_Lookup[i].Key != LookupSlot::kEmpty; i = (i + 1) & mask) {
+        if (m_Lookup[i].Key == key) {
+            return m_Cells[m_Lookup[i].Cell];
+        }
+    }
+
+    uint32_t cell;
+    if (!m_FreeCells.empty()) {
+        cell = m_FreeCells.back();
+        m_FreeCells.pop_back();
+    } else {
+        cell = static_cast<uint32_t>(m_Cells.size());
+        m_Cells.emplace_back();
+    }
+    m_Cells[cell].Coord = coord;
+    m_Lookup[i]         = {key, cell};
+    m_CellCount++;
+    return m_Cells[cell];
+}
+
+void SpatialHash::EraseCell(const glm::ivec3 &coord) {
+    const uint64_t key  = PackKey(coord);
+    const size_t   mask = m_Lookup.size() - 1;
+
+    size_t i = HashKey(key) & mask;
+    while (m_Lookup[i].Key != key) {
+        i = (i + 1) & mask;
+    }
+    m_FreeCells.push_back(m_Lookup[i].Cell);
+    m_CellCount--;
+
+    // Backward-shift deletion keeps probe chains intact without tombstones.
+    for (size_t j = (i + 1) & mask; m_Lookup[j].Key != LookupSlot::kEmpty;
+         j        = (j + 1) & mask) {
+        const size_t home = HashKey(m_Lookup[j].Key) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            m_Lookup[i] = m_Lookup[j];
+            i           = j;
+        }
+    }
+    m_Lookup[i] = LookupSlot();
+}
+
+void SpatialHash::GrowLookup() {
+    std::vector<LookupSlot> previous = std::move(m_Lookup);
+    m_Lookup.assign(std::max<size_t>(previous.size() * 2, 1024), LookupSlot());
+
+    const size_t mask = m_Lookup.size() - 1;
+    for (const LookupSlot &slot : previous) {
+        if (slot.Key == LookupSlot::kEmpty) {
+            continue;
+        }
+        size_t i = HashKey(slot.Key) & mask;
+        while (m_Lookup[i].Key != LookupSlot::kEmpty) {
+            i = (i + 1) & mask;
+        }
+        m_Lookup[i] = slot;
+    }
+}
+
+SpatialHash::CellRange SpatialHash::GetCellRange(const Aabb &bounds) const {
+    auto toCell = [this](float value) {
+        const float cell = std::floor(value * m_InverseCellSize);
+        return static_cast<int>(std::clamp(cell,
+                                           static_cast<float>(-kCoordLimit),
+                                           static_cast<float>(kCoordLimit)));
+    };
+    const glm::ivec3 min(
+        toCell(bounds.Min.x), toCell(bounds.Min.y), toCell(bounds.Min.z));
+    const glm::ivec3 max(
+        toCell(bounds.Max.x), toCell(bounds.Max.y), toCell(bounds.Max.z));
+    return {min, max};
+}
+
+void SpatialHash::AddToCells(ProxyId proxy) {
+    const CellRange &range = m_Proxies[proxy].Range;
+
+    glm::ivec3 coord;
+    for (coord.z = range.Min.z; coord.z <= range.Max.z; coord.z++) {
+        for (coord.y = range.Min.y; coord.y <= range.Max.y; coord.y++) {
+            for (coord.x = range.Min.x; coord.x <= range.Max.x; coord.x++) {
+                FindOrCreateCell(coord).Proxies.push_back(proxy);
+            }
+        }
+    }
+}
+
+void SpatialHash::RemoveFromCells(ProxyId proxy) {
+    const CellRange &range = m_Proxies[proxy].Range;
+
+    glm::ivec3 coord;
+    for (coord.z = range.Min.z; coord.z <= range.Max.z; coord.z++) {
+        for (coord.y = range.Min.y; coord.y <= range.Max.y; coord.y++) {
+            for (coord.x = range.Min.x; coord.x <= range.Max.x; coord.x++) {
+                Cell *cell = FindCell(coord);
+                assert(cell);
+
+                std::vector<ProxyId> &proxies = cell->Proxies;
+                auto found = std::ranges::find(proxies, proxy);
+                *found     = proxies.back();
+                proxies.pop_back();
+
+                if (proxies.empty()) {
+                    EraseCell(coord);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::RebinAll() {
+    for (LookupSlot &slot : m_Lookup) {
+        if (slot.Key != LookupSlot::kEmpty) {
+            m_Cells[slot.Cell].Proxies.clear();
+            m_FreeCells.push_back(slot.Cell);
+            slot.Key = LookupSlot::kEmpty;
+        }
+    }
+    m_CellCount = 0;
+
+    for (ProxyId proxy = 0; proxy < m_Proxies.size(); proxy++) {
+        Proxy &entry = m_Proxies[proxy];
+        if (entry.Alive) {
+            entry.Range = GetCellRange(entry.Bounds);
+            AddToCells(proxy);
+        }
+    }
+}
+
+void SpatialHash::AutoTune() {
+    if (m_ProxyCount == 0) {
+        return;
+    }
+
+    const float extent =
+        static_cast<float>(m_ExtentSum / static_cast<double>(m_ProxyCount));
+    if (extent <= 0.0f) {
+        return;
+    }
+
+    const float threshold = m_Specification.RetuneThreshold;
+    if (m_TunedExtent > 0.0f && extent < m_TunedExtent * threshold &&
+        extent * threshold > m_TunedExtent) {
+        return;
+    }
+
+    // Twice the average size: a typical box then touches 1-2 cells per axis.
+    m_TunedExtent     = extent;
+    m_CellSize        = extent * 2.0f;
+    m_InverseCellSize = 1.0f / m_CellSize;
+    RebinAll();
+}
+
+void SpatialHash::CollectPairs(uint32_t                begin,
+                               uint32_t                end,
+                               std::vector<ProxyPair> &out) const {
+    for (uint32_t c = begin; c < end; c++) {
+        const Cell                 &cell    = m_Cells[c];
+        const std::vector<ProxyId> &proxies = cell.Proxies;
+        const size_t                count   = proxies.size();
+
+        for (size_t i = 0; i + 1 < count; i++) {
+            const Proxy &a = m_Proxies[proxies[i]];
+            for (size_t j = i + 1; j < count; j++) {
+                const Proxy &b = m_Proxies[proxies[j]];
+                if (!a.Bounds.Overlaps(b.Bounds) ||
+                    FirstSharedCell(a.Range, b.Range) != cell.Coord) {
+                    continue;
+                }
+                const ProxyId first  = proxies[i];
+                const ProxyId second = proxies[j];
+                out.push_back({std::min(first, second),
+                               std::max(first, second)});
+            }
+        }
+    }
+}
+
+} // namespace brnCore
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Physics/Aabb.h"
+#include "Engine/Physics/Proxy.h"
+
+namespace brnCore {
+
+struct SpatialHashSpecification {
+    float CellSize = 0.0f; // 0 = auto-tune from the bodies' average size
+    // Auto-tuning re-bins everything once the average size drifts further
+    // than this factor away from what the cell size was chosen for.
+    float RetuneThreshold = 1.5f;
+};
+
+/*
+ * Uniform grid over hashed cells, so the world needs no bounds. Each proxy
+ * is registered in every cell its box touches; Move() only re-bins a proxy
+ * when that cell range changes, which for small per-frame motion is rare.
+ *
+ * A pair (or a query hit) spanning several shared cells is reported only
+ * from the first one, the cell at max(minA, minB), so there is no "seen"
+ * set to clear or allocate. Pair buffers are kept between frames.
+ *
+ * For 2D, keep z at 0: every proxy then lives in a single z layer.
+ */
+class SpatialHash {
+  public:
+    explicit SpatialHash(const SpatialHashSpecification &specification =
+                             SpatialHashSpecification());
+
+    ProxyId Insert(const Aabb &bounds);
+    void    Remove(ProxyId proxy);
+    void    Move(ProxyId proxy, const Aabb &bounds);
+
+    const Aabb &GetBounds(ProxyId proxy) const {
+        return m_Proxies[proxy].Bounds;
+    }
+
+    /*
+     * Overlapping pairs sorted by (A, B), so the result does not depend on
+     * the number of threads. `out` is cleared but keeps its capacity.
+     */
+    void FindPairs(std::vector<ProxyPair> &out, JobSystem *jobs = nullptr);
+
+    // Calls fn(ProxyId) once per proxy whose box overlaps `bounds`.
+    template <typename Fn>
+    void QueryAabb(const Aabb &bounds, Fn &&fn) const {
+        const CellRange range = GetCellRange(bounds);
+        ForEachCell(range, [&](const glm::ivec3 &coord, const Cell &cell) {
+            for (ProxyId proxy : cell.Proxies) {
+                const Proxy &entry = m_Proxies[proxy];
+                if (entry.Bounds.Overlaps(bounds) &&
+                    FirstSharedCell(range, entry.Range) == coord) {
+                    fn(proxy);
+                }
+            }
+        });
+    }
+
+    // Calls fn(ProxyId) once per proxy whose box intersects the sphere.
+    template <typename Fn>
+    void QueryRadius(const glm::vec3 &center, float radius, Fn &&fn) const {
+        const float radiusSquared = radius * radius;
+        QueryAabb(Aabb::FromCenter(center, glm::vec3(radius)),
+                  [&](ProxyId proxy) {
+                      if (m_Proxies[proxy].Bounds.DistanceSquared(center) <=
+                          radiusSquared) {
+                          fn(proxy);
+                      }
+                  });
+    }
+
+    // Re-bins every proxy; 0 picks a size from the current bodies.
+    void  SetCellSize(float cellSize);
+    float GetCellSize() const { return m_CellSize; }
+
+    size_t GetProxyCount() const { return m_ProxyCount; }
+    size_t GetCellCount() const { return m_CellCount; }
+
+  private:
+    struct CellRange {
+        glm::ivec3 Min;
+        glm::ivec3 Max;
+
+        bool operator==(const CellRange &) const = default;
+    };
+
+    struct Proxy {
+        Aabb      Bounds;
+        CellRange Range;
+        bool      Alive = false;
+    };
+
+    struct Cell {
+        glm::ivec3           Coord;
+        std::vector<ProxyId> Proxies;
+    };
+
+    // Open-addressing slot of the cell lookup; bit 63 of a packed key is
+    // never set, so all ones marks an empty slot.
+    struct LookupSlot {
+        static constexpr uint64_t kEmpty = ~0ull;
+
+        uint64_t Key  = kEmpty;
+        uint32_t Cell = 0;
+    };
+
+    static uint64_t PackKey(const glm::ivec3 &coord);
+
+    const Cell *FindCell(const glm::ivec3 &coord) const;
+    Cell       *FindCell(const glm::ivec3 &coord) {
+        return const_cast<Cell *>(std::as_const(*this).FindCell(coord));
+    }
+    Cell       &FindOrCreateCell(const glm::ivec3 &coord);
+    void        EraseCell(const glm::ivec3 &coord);
+    void        GrowLookup();
+
+    static glm::ivec3 FirstSharedCell(const CellRange &a, const CellRange &b) {
+        return glm::max(a.Min, b.Min);
+    }
+
+    CellRange GetCellRange(const Aabb &bounds) const;
+
+    template <typename Fn>
+    void ForEachCell(const CellRange &range, Fn &&fn) const {
+        glm::ivec3 coord;
+        for (coord.z = range.Min.z; coord.z <= range.Max.z; coord.z++) {
+            for (coord.y = range.Min.y; coord.y <= range.Max.y; coord.y++) {
+                for (coord.x = range.Min.x; coord.x <= range.Max.x;
+                     coord.x++) {
+                    if (const Cell *cell = FindCell(coord)) {
+                        fn(coord, *cell);
+                    }
+                }
+            }
+        }
+    }
+
+    void AddToCells(ProxyId proxy);
+    void RemoveFromCells(ProxyId proxy);
+    void RebinAll();
+    void AutoTune();
+    void CollectPairs(uint32_t                begin,
+                      uint32_t                end,
+                      std::vector<ProxyPair> &out) const;
+
+    SpatialHashSpecification m_Specification;
+    float                    m_CellSize        = 1.0f;
+    float                    m_InverseCellSize = 1.0f;
+    float                    m_TunedExtent     = 0.0f;
+
+    std::vector<Proxy>   m_Proxies;
+    std::vector<ProxyId> m_FreeProxies;
+    size_t               m_ProxyCount = 0;
+    double               m_ExtentSum  = 0.0; // for auto-tuning
+
+    // Cells are recycled rather than freed so their proxy lists keep their
+    // capacity; after warm-up, moving proxies allocates nothing.
+    std::vector<Cell>       m_Cells;
+    std::vector<uint32_t>   m_FreeCells;
+    std::vector<LookupSlot> m_Lookup;
+    size_t                  m_CellCount = 0;
+
+    // One pair buffer per job system thread, reused every frame.
+    std::vector<std::vector<ProxyPair>> m_ThreadPairs;
+};
+
+} // namespace brnCore
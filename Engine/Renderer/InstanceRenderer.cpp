@@ -0,0 +1,611 @@
+#include "InstanceRenderer.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+#include "Engine/Physics/Frustum.h"
+#include "Engine/Renderer/Shader.h"
+
+namespace brnCore {
+
+namespace {
+// Threads per group of InstanceCull.comp, and the most groups a dispatch
+// may have along x.
+constexpr uint32_t kCullGroupSize = 64;
+constexpr uint32_t kMaxCullGroups = 65535;
+
+constexpr uint32_t kDrawBytes   = sizeof(SDL_GPUIndexedIndirectDrawCommand);
+constexpr uint32_t kBoundsBytes = 2 * sizeof(glm::vec4); // per mesh
+
+// std140 layouts of the shaders' uniform blocks.
+struct CullUniforms {
+    glm::vec4 Planes[6];
+    uint32_t  InstanceCount;
+};
+
+struct ViewUniforms {
+    glm::mat4 ViewProjection;
+    glm::vec4 LightDirection;
+};
+
+// A run of consecutive instance slots, uploaded with one copy.
+struct InstanceRun {
+    uint32_t Slot;
+    uint32_t Count;
+    uint32_t StagingIndex; // of its first instance
+};
+
+InstanceRendererSpecification
+Validate(InstanceRendererSpecification specification) {
+    specification.MaxInstances = std::clamp(
+        specification.MaxInstances, 1u, kCullGroupSize * kMaxCullGroups);
+    specification.MaxMeshes   = std::max(specification.MaxMeshes, 1u);
+    specification.MaxVertices = std::max(specification.MaxVertices, 1u);
+    specification.MaxIndices  = std::max(specification.MaxIndices, 1u);
+    specification.MaxInstanceUploads = std::clamp(
+        specification.MaxInstanceUploads, 1u, specification.MaxInstances);
+    return specification;
+}
+
+SDL_GPUBuffer *CreateBuffer(SDL_GPUDevice          *device,
+                            SDL_GPUBufferUsageFlags usage,
+                            size_t                  size) {
+    const SDL_GPUBufferCreateInfo bufferInfo{
+        .usage = usage,
+        .size  = static_cast<Uint32>(size),
+    };
+    SDL_GPUBuffer *buffer = SDL_CreateGPUBuffer(device, &bufferInfo);
+    if (!buffer) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "InstanceRenderer: cannot create buffer: %s",
+                     SDL_GetError());
+    }
+    return buffer;
+}
+
+// A transfer buffer made to measure and holding `data`; the caller
+// releases it once its copies are recorded.
+SDL_GPUTransferBuffer *
+CreateStagingBuffer(SDL_GPUDevice *device, const void *data, size_t size) {
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size  = static_cast<Uint32>(size),
+    };
+    SDL_GPUTransferBuffer *buffer =
+        SDL_CreateGPUTransferBuffer(device, &transferInfo);
+    void *mapped =
+        buffer ? SDL_MapGPUTransferBuffer(device, buffer, false) : nullptr;
+    if (!mapped) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "InstanceRenderer: cannot create upload buffer: %s",
+                     SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(device, buffer);
+        return nullptr;
+    }
+    std::memcpy(mapped, data, size);
+    SDL_UnmapGPUTransferBuffer(device, buffer);
+    return buffer;
+}
+} // namespace
+
+InstanceRenderer::InstanceRenderer(
+    SDL_GPUDevice                       *device,
+    std::shared_ptr<VirtualFileSystem>   fileSystem,
+    const InstanceRendererSpecification &specification)
+    : m_Device(device), m_FileSystem(std::move(fileSystem)),
+      m_Specification(Validate(specification)) {
+    m_CullPipeline =
+        LoadComputePipeline(m_Device,
+                            *m_FileSystem,
+                            "Shaders/InstanceCull.comp",
+                            {.ReadOnlyStorageBuffers  = 2,
+                             .ReadWriteStorageBuffers = 2,
+                             .UniformBuffers          = 1,
+                             .ThreadCountX            = kCullGroupSize});
+
+    SDL_GPUShader *vertexShader =
+        LoadShader(m_Device,
+                   *m_FileSystem,
+                   "Shaders/Instance.vert",
+                   {.Stage          = SDL_GPU_SHADERSTAGE_VERTEX,
+                    .StorageBuffers = 1,
+                    .UniformBuffers = 1});
+    SDL_GPUShader *fragmentShader =
+        LoadShader(m_Device,
+                   *m_FileSystem,
+                   "Shaders/Instance.frag",
+                   {.Stage = SDL_GPU_SHADERSTAGE_FRAGMENT});
+
+    if (vertexShader && fragmentShader) {
+        static constexpr VertexInput kInput(
+            MakeVertexLayout<MeshVertex>(
+                SDL_GPU_VERTEXINPUTRATE_VERTEX,
+                BRN_VERTEX_ATTRIBUTE(MeshVertex, Position),
+                BRN_VERTEX_ATTRIBUTE(MeshVertex, Normal)),
+            MakeVertexLayout<VisibleInstance>(
+                SDL_GPU_VERTEXINPUTRATE_INSTANCE,
+                BRN_VERTEX_ATTRIBUTE(VisibleInstance, Index)));
+        const bool depth =
+            m_Specification.DepthFormat != SDL_GPU_TEXTUREFORMAT_INVALID;
+        const SDL_GPUColorTargetDescription target{
+            .format = m_Specification.TargetFormat,
+        };
+        const SDL_GPUGraphicsPipelineCreateInfo pipelineInfo{
+            .vertex_shader      = vertexShader,
+            .fragment_shader    = fragmentShader,
+            .vertex_input_state = kInput.GetState(),
+            .primitive_type     = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+            .rasterizer_state =
+                {
+                    .cull_mode  = SDL_GPU_CULLMODE_BACK,
+                    .front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE,
+                },
+            .depth_stencil_state =
+                {
+                    .compare_op         = SDL_GPU_COMPAREOP_LESS,
+                    .enable_depth_test  = depth,
+                    .enable_depth_write = depth,
+                },
+            .target_info =
+                {
+                    .color_target_descriptions = &target,
+                    .num_color_targets         = 1,
+                    .depth_stencil_format      = m_Specification.DepthFormat,
+                    .has_depth_stencil_target  = depth,
+                },
+        };
+        m_Pipeline = SDL_CreateGPUGraphicsPipeline(m_Device, &pipelineInfo);
+        if (!m_Pipeline) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "InstanceRenderer: cannot create pipeline: %s",
+                         SDL_GetError());
+        }
+    }
+    if (vertexShader) {
+        SDL_ReleaseGPUShader(m_Device, vertexShader);
+    }
+    if (fragmentShader) {
+        SDL_ReleaseGPUShader(m_Device, fragmentShader);
+    }
+
+    const size_t instances = m_Specification.MaxInstances;
+    const size_t meshes    = m_Specification.MaxMeshes;
+    m_VertexBuffer =
+        CreateBuffer(m_Device,
+                     SDL_GPU_BUFFERUSAGE_VERTEX,
+                     m_Specification.MaxVertices * sizeof(MeshVertex));
+    m_IndexBuffer =
+        CreateBuffer(m_Device,
+                     SDL_GPU_BUFFERUSAGE_INDEX,
+                     m_Specification.MaxIndices * sizeof(uint32_t));
+    m_InstanceBuffer =
+        CreateBuffer(m_Device,
+                     SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ |
+                         SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ,
+                     instances * sizeof(GpuInstance));
+    m_BoundsBuffer = CreateBuffer(m_Device,
+                                  SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ,
+                                  meshes * kBoundsBytes);
+    m_VisibleBuffer =
+        CreateBuffer(m_Device,
+                     SDL_GPU_BUFFERUSAGE_VERTEX |
+                         SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+                     instances * sizeof(VisibleInstance));
+    m_DrawTemplate = CreateBuffer(
+        m_Device, SDL_GPU_BUFFERUSAGE_INDIRECT, meshes * kDrawBytes);
+    m_DrawBuffer = CreateBuffer(m_Device,
+                                SDL_GPU_BUFFERUSAGE_INDIRECT |
+                                    SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+                                meshes * kDrawBytes);
+
+    // A frame's changed instances, then the draws and bounds of every
+    // mesh.
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size  = static_cast<Uint32>(
+            m_Specification.MaxInstanceUploads * sizeof(GpuInstance) +
+            meshes * (kDrawBytes + kBoundsBytes)),
+    };
+    m_TransferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+}
+
+InstanceRenderer::~InstanceRenderer() {
+    SDL_ReleaseGPUTransferBuffer(m_Device, m_TransferBuffer);
+    for (SDL_GPUBuffer *buffer : {m_VertexBuffer,
+                                  m_IndexBuffer,
+                                  m_InstanceBuffer,
+                                  m_BoundsBuffer,
+                                  m_VisibleBuffer,
+                                  m_DrawTemplate,
+                                  m_DrawBuffer}) {
+        SDL_ReleaseGPUBuffer(m_Device, buffer);
+    }
+    if (m_Pipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(m_Device, m_Pipeline);
+    }
+    if (m_CullPipeline) {
+        SDL_ReleaseGPUComputePipeline(m_Device, m_CullPipeline);
+    }
+}
+
+uint32_t InstanceRenderer::AddMesh(std::span<const MeshVertex> vertices,
+                                   std::span<const uint32_t>   indices) {
+    if (vertices.empty() || indices.empty() ||
+        m_Meshes.size() == m_Specification.MaxMeshes ||
+        vertices.size() > m_Specification.MaxVertices - m_VertexCount ||
+        indices.size() > m_Specification.MaxIndices - m_IndexCount) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "InstanceRenderer: no room for a mesh of %zu vertices "
+                     "and %zu indices",
+                     vertices.size(),
+                     indices.size());
+        return kInvalidMesh;
+    }
+
+    glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+    for (const MeshVertex &vertex : vertices) {
+        low  = glm::min(low, vertex.Position);
+        high = glm::max(high, vertex.Position);
+    }
+
+    auto stage = [this](SDL_GPUBuffer *buffer,
+                        uint32_t       offset,
+                        const void    *data,
+                        size_t         size) {
+        const auto stagingOffset = static_cast<uint32_t>(m_MeshStaging.size());
+        m_MeshStaging.resize(stagingOffset + size);
+        std::memcpy(m_MeshStaging.data() + stagingOffset, data, size);
+        m_MeshUploads.push_back(
+            {buffer, offset, static_cast<uint32_t>(size), stagingOffset});
+    };
+    stage(m_VertexBuffer,
+          m_VertexCount * sizeof(MeshVertex),
+          vertices.data(),
+          vertices.size_bytes());
+    stage(m_IndexBuffer,
+          m_IndexCount * sizeof(uint32_t),
+          indices.data(),
+          indices.size_bytes());
+
+    m_Meshes.push_back({
+        .IndexCount   = static_cast<uint32_t>(indices.size()),
+        .FirstIndex   = m_IndexCount,
+        .VertexOffset = m_VertexCount,
+        .Center       = (low + high) * 0.5f,
+        .Extent       = (high - low) * 0.5f,
+    });
+    m_VertexCount += static_cast<uint32_t>(vertices.size());
+    m_IndexCount += static_cast<uint32_t>(indices.size());
+    m_MeshesDirty = true;
+    return static_cast<uint32_t>(m_Meshes.size() - 1);
+}
+
+InstanceHandle InstanceRenderer::AddInstance(uint32_t         mesh,
+                                             const glm::mat4 &transform,
+                                             SDL_Color        color) {
+    if (mesh >= m_Meshes.size() ||
+        m_Instances.size() == m_Specification.MaxInstances) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "InstanceRenderer: cannot add an instance of mesh %u",
+                     mesh);
+        return {};
+    }
+
+    uint32_t record;
+    if (!m_FreeRecords.empty()) {
+        record = m_FreeRecords.back();
+        m_FreeRecords.pop_back();
+    } else {
+        record = static_cast<uint32_t>(m_Records.size());
+        m_Records.emplace_back();
+    }
+
+    const auto slot = static_cast<uint32_t>(m_Instances.size());
+    m_Instances.push_back({transform, mesh, color, {}});
+    m_Owners.push_back(record);
+    m_Dirty.push_back(0);
+    MarkDirty(slot);
+
+    m_Records[record].Slot  = slot;
+    m_Records[record].Alive = true;
+    m_Meshes[mesh].InstanceCount++;
+    m_MeshesDirty = true;
+    return {record, m_Records[record].Generation};
+}
+
+void InstanceRenderer::RemoveInstance(InstanceHandle instance) {
+    if (!IsAlive(instance)) {
+        return;
+    }
+
+    const uint32_t slot = GetSlot(instance);
+    const auto     last = static_cast<uint32_t>(m_Instances.size() - 1);
+    m_Meshes[m_Instances[slot].Mesh].InstanceCount--;
+    m_MeshesDirty = true;
+    if (slot != last) {
+        m_Instances[slot]              = m_Instances[last];
+        m_Owners[slot]                 = m_Owners[last];
+        m_Records[m_Owners[slot]].Slot = slot;
+        MarkDirty(slot);
+    }
+    // A listed last slot is skipped by the next upload.
+    m_Instances.pop_back();
+    m_Owners.pop_back();
+    m_Dirty.pop_back();
+
+    InstanceRecord &record = m_Records[instance.Index];
+    record.Alive           = false;
+    record.Generation++;
+    m_FreeRecords.push_back(instance.Index);
+}
+
+bool InstanceRenderer::IsAlive(InstanceHandle instance) const {
+    return instance.Index < m_Records.size() &&
+           m_Records[instance.Index].Alive &&
+           m_Records[instance.Index].Generation == instance.Generation;
+}
+
+void InstanceRenderer::SetTransform(InstanceHandle   instance,
+                                    const glm::mat4 &transform) {
+    if (IsAlive(instance)) {
+        const uint32_t slot         = GetSlot(instance);
+        m_Instances[slot].Transform = transform;
+        MarkDirty(slot);
+    }
+}
+
+void InstanceRenderer::SetColor(InstanceHandle instance, SDL_Color color) {
+    if (IsAlive(instance)) {
+        const uint32_t slot     = GetSlot(instance);
+        m_Instances[slot].Color = color;
+        MarkDirty(slot);
+    }
+}
+
+void InstanceRenderer::Prepare(SDL_GPUCommandBuffer *commandBuffer,
+                               const glm::mat4      &viewProjection) {
+    m_ViewProjection = viewProjection;
+    m_UploadCount    = 0;
+    if (!m_CullPipeline || !m_Pipeline || m_Meshes.empty()) {
+        return;
+    }
+
+    // Mapped before the copy pass: buffers are unmapped when it uses them.
+    SDL_GPUTransferBuffer *meshBuffer = nullptr;
+    if (!m_MeshUploads.empty()) {
+        meshBuffer = CreateStagingBuffer(
+            m_Device, m_MeshStaging.data(), m_MeshStaging.size());
+        if (!meshBuffer) {
+            return;
+        }
+    }
+
+    // Changed slots, in order and coalesced into runs of neighbors.
+    std::ranges::sort(m_DirtySlots);
+    const auto duplicates = std::ranges::unique(m_DirtySlots);
+    m_DirtySlots.erase(duplicates.begin(), duplicates.end());
+    std::vector<GpuInstance> staging;
+    std::vector<InstanceRun> runs;
+    for (const uint32_t slot : m_DirtySlots) {
+        if (slot >= m_Instances.size()) {
+            break; // removed since
+        }
+        if (!runs.empty() && runs.back().Slot + runs.back().Count == slot) {
+            runs.back().Count++;
+        } else {
+            runs.push_back({slot, 1, static_cast<uint32_t>(staging.size())});
+        }
+        staging.push_back(m_Instances[slot]);
+    }
+
+    const size_t instanceBytes = staging.size() * sizeof(GpuInstance);
+    const bool   persistent =
+        staging.size() <= m_Specification.MaxInstanceUploads;
+    SDL_GPUTransferBuffer *instanceBuffer = m_TransferBuffer;
+    if (!persistent) {
+        instanceBuffer =
+            CreateStagingBuffer(m_Device, staging.data(), instanceBytes);
+        if (!instanceBuffer) {
+            SDL_ReleaseGPUTransferBuffer(m_Device, meshBuffer);
+            return;
+        }
+    }
+
+    const size_t meshOffset =
+        m_Specification.MaxInstanceUploads * sizeof(GpuInstance);
+    const auto meshCount = static_cast<uint32_t>(m_Meshes.size());
+    if ((persistent && !staging.empty()) || m_MeshesDirty) {
+        // Cycling hands back a fresh buffer if last frame's copies still
+        // read this one.
+        auto *mapped = static_cast<std::byte *>(
+            SDL_MapGPUTransferBuffer(m_Device, m_TransferBuffer, true));
+        if (!mapped) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "InstanceRenderer: cannot upload instances: %s",
+                         SDL_GetError());
+            SDL_ReleaseGPUTransferBuffer(m_Device, meshBuffer);
+            if (!persistent) {
+                SDL_ReleaseGPUTransferBuffer(m_Device, instanceBuffer);
+            }
+            return;
+        }
+        if (persistent) {
+            std::memcpy(mapped, staging.data(), instanceBytes);
+        }
+        // Each mesh's visible instances go after those of the meshes
+        // before it, in a range as large as its instance count.
+        auto *draws = reinterpret_cast<SDL_GPUIndexedIndirectDrawCommand *>(
+            mapped + meshOffset);
+        auto *bounds = reinterpret_cast<glm::vec4 *>(
+            mapped + meshOffset + size_t(meshCount) * kDrawBytes);
+        uint32_t firstInstance = 0;
+        for (uint32_t mesh = 0; mesh < meshCount; mesh++) {
+            const Mesh                             &info = m_Meshes[mesh];
+            const SDL_GPUIndexedIndirectDrawCommand draw{
+                .num_indices    = info.IndexCount,
+                .num_instances  = 0,
+                .first_index    = info.FirstIndex,
+                .vertex_offset  = static_cast<Sint32>(info.VertexOffset),
+                .first_instance = firstInstance,
+            };
+            draws[mesh]          = draw;
+            bounds[2 * mesh]     = glm::vec4(info.Center, 0.0f);
+            bounds[2 * mesh + 1] = glm::vec4(info.Extent, 0.0f);
+            firstInstance += info.InstanceCount;
+        }
+        SDL_UnmapGPUTransferBuffer(m_Device, m_TransferBuffer);
+    }
+
+    for (const uint32_t slot : m_DirtySlots) {
+        if (slot < m_Dirty.size()) {
+            m_Dirty[slot] = 0;
+        }
+    }
+    m_DirtySlots.clear();
+    m_UploadCount = static_cast<uint32_t>(staging.size());
+
+    SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    for (const MeshUpload &upload : m_MeshUploads) {
+        const SDL_GPUTransferBufferLocation source{
+            .transfer_buffer = meshBuffer,
+            .offset          = upload.StagingOffset,
+        };
+        const SDL_GPUBufferRegion destination{
+            .buffer = upload.Buffer,
+            .offset = upload.Offset,
+            .size   = upload.Size,
+        };
+        SDL_UploadToGPUBuffer(copyPass, &source, &destination, false);
+    }
+    for (const InstanceRun &run : runs) {
+        const SDL_GPUTransferBufferLocation source{
+            .transfer_buffer = instanceBuffer,
+            .offset          = static_cast<Uint32>(run.StagingIndex *
+                                          sizeof(GpuInstance)),
+        };
+        const SDL_GPUBufferRegion destination{
+            .buffer = m_InstanceBuffer,
+            .offset = static_cast<Uint32>(run.Slot * sizeof(GpuInstance)),
+            .size   = static_cast<Uint32>(run.Count * sizeof(GpuInstance)),
+        };
+        SDL_UploadToGPUBuffer(copyPass, &source, &destination, false);
+    }
+    if (m_MeshesDirty) {
+        const SDL_GPUTransferBufferLocation drawSource{
+            .transfer_buffer = m_TransferBuffer,
+            .offset          = static_cast<Uint32>(meshOffset),
+        };
+        const SDL_GPUBufferRegion drawDestination{
+            .buffer = m_DrawTemplate,
+            .size   = meshCount * kDrawBytes,
+        };
+        SDL_UploadToGPUBuffer(copyPass, &drawSource, &drawDestination, false);
+        const SDL_GPUTransferBufferLocation boundsSource{
+            .transfer_buffer = m_TransferBuffer,
+            .offset = static_cast<Uint32>(meshOffset + meshCount * kDrawBytes),
+        };
+        const SDL_GPUBufferRegion boundsDestination{
+            .buffer = m_BoundsBuffer,
+            .size   = meshCount * kBoundsBytes,
+        };
+        SDL_UploadToGPUBuffer(
+            copyPass, &boundsSource, &boundsDestination, false);
+        m_MeshesDirty = false;
+    }
+    // The cull counts from zero every frame.
+    const SDL_GPUBufferLocation templateSource{.buffer = m_DrawTemplate};
+    const SDL_GPUBufferLocation drawTarget{.buffer = m_DrawBuffer};
+    SDL_CopyGPUBufferToBuffer(
+        copyPass, &templateSource, &drawTarget, meshCount * kDrawBytes, true);
+    SDL_EndGPUCopyPass(copyPass);
+
+    if (meshBuffer) {
+        SDL_ReleaseGPUTransferBuffer(m_Device, meshBuffer);
+        m_MeshUploads.clear();
+        m_MeshStaging.clear();
+    }
+    if (!persistent) {
+        SDL_ReleaseGPUTransferBuffer(m_Device, instanceBuffer);
+    }
+
+    if (m_Instances.empty()) {
+        return;
+    }
+    CullUniforms  cull;
+    const Frustum frustum = Frustum::FromMatrix(viewProjection);
+    std::ranges::copy(frustum.Planes, cull.Planes);
+    cull.InstanceCount = static_cast<uint32_t>(m_Instances.size());
+
+    // The draws keep the zeroed counts copied in above. Only the visible
+    // slots this cull writes are read, so that list may cycle away from
+    // last frame's draws.
+    const SDL_GPUStorageBufferReadWriteBinding outputs[] = {
+        {.buffer = m_DrawBuffer},
+        {.buffer = m_VisibleBuffer, .cycle = true},
+    };
+    SDL_GPUBuffer *const inputs[] = {m_InstanceBuffer, m_BoundsBuffer};
+    SDL_GPUComputePass  *computePass =
+        SDL_BeginGPUComputePass(commandBuffer, nullptr, 0, outputs, 2);
+    SDL_BindGPUComputePipeline(computePass, m_CullPipeline);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, inputs, 2);
+    SDL_PushGPUComputeUniformData(commandBuffer, 0, &cull, sizeof(cull));
+    SDL_DispatchGPUCompute(computePass,
+                           (cull.InstanceCount + kCullGroupSize - 1) /
+                               kCullGroupSize,
+                           1,
+                           1);
+    SDL_EndGPUComputePass(computePass);
+}
+
+void InstanceRenderer::Render(SDL_GPUCommandBuffer *commandBuffer,
+                              SDL_GPURenderPass    *renderPass) {
+    m_DrawCount = 0;
+    if (!m_CullPipeline || !m_Pipeline || m_Instances.empty()) {
+        return;
+    }
+
+    SDL_BindGPUGraphicsPipeline(renderPass, m_Pipeline);
+    const SDL_GPUBufferBinding vertexBuffers[] = {
+        {.buffer = m_VertexBuffer},
+        {.buffer = m_VisibleBuffer},
+    };
+    SDL_BindGPUVertexBuffers(renderPass, 0, vertexBuffers, 2);
+    const SDL_GPUBufferBinding indexBuffer{.buffer = m_IndexBuffer};
+    SDL_BindGPUIndexBuffer(
+        renderPass, &indexBuffer, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+    SDL_BindGPUVertexStorageBuffers(renderPass, 0, &m_InstanceBuffer, 1);
+
+    const ViewUniforms view{
+        .ViewProjection = m_ViewProjection,
+        .LightDirection =
+            glm::vec4(glm::normalize(m_Specification.LightDirection), 0.0f),
+    };
+    SDL_PushGPUVertexUniformData(commandBuffer, 0, &view, sizeof(view));
+
+    // The visible list is read through the draws' first instance, as an
+    // instance-rate vertex buffer, which every backend offsets the same
+    // way (gl_InstanceIndex and SV_InstanceID don't agree).
+    for (uint32_t mesh = 0; mesh < m_Meshes.size(); mesh++) {
+        if (m_Meshes[mesh].InstanceCount > 0) {
+            SDL_DrawGPUIndexedPrimitivesIndirect(
+                renderPass, m_DrawBuffer, mesh * kDrawBytes, 1);
+            m_DrawCount++;
+        }
+    }
+}
+
+uint32_t InstanceRenderer::GetSlot(InstanceHandle instance) const {
+    return m_Records[instance.Index].Slot;
+}
+
+void InstanceRenderer::MarkDirty(uint32_t slot) {
+    if (!m_Dirty[slot]) {
+        m_Dirty[slot] = 1;
+        m_DirtySlots.push_back(slot);
+    }
+}
+
+} // namespace brnCore
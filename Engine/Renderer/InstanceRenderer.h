@@ -0,0 +1,206 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_pixels.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Engine/Assets/FileSystem.h"
+#include "Engine/Renderer/VertexLayout.h"
+
+namespace brnCore {
+
+struct InstanceRendererSpecification {
+    // Formats of the targets Render() draws into; an invalid depth format
+    // draws without depth testing.
+    SDL_GPUTextureFormat TargetFormat = SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
+    SDL_GPUTextureFormat DepthFormat  = SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
+    // Up to 4M instances: the cull is one 64 thread group per 64.
+    uint32_t MaxInstances = 1 << 20;
+    uint32_t MaxMeshes    = 256;
+    uint32_t MaxVertices  = 1 << 20; // of all meshes together
+    uint32_t MaxIndices   = 1 << 22;
+    // Changed instances the persistent upload buffer holds. Frames that
+    // change more, such as the one a level loads in, upload through a
+    // buffer made for them.
+    uint32_t MaxInstanceUploads = 1 << 16;
+    // Toward the light, in world space.
+    glm::vec3 LightDirection = glm::vec3(0.3f, 0.9f, 0.3f);
+};
+
+struct MeshVertex {
+    glm::vec3 Position;
+    Snorm8x4  Normal; // PackSnorm8x4(glm::vec4(normal, 0.0f))
+};
+
+struct InstanceHandle {
+    static constexpr uint32_t kInvalidIndex =
+        std::numeric_limits<uint32_t>::max();
+
+    uint32_t Index      = kInvalidIndex;
+    uint32_t Generation = 0;
+
+    bool IsValid() const { return Index != kInvalidIndex; }
+
+    bool operator==(const InstanceHandle &) const = default;
+};
+
+/*
+ * Draws many instances of a few meshes with the CPU out of the per
+ * instance work.
+ *
+ * Instances live in a GPU storage buffer; the CPU only uploads the ones
+ * that changed. Each frame Prepare() runs a compute pass that tests every
+ * instance's world bounds against the frustum and appends the visible
+ * ones to their mesh's range of a visible list, counting them in that
+ * mesh's SDL_GPUIndexedIndirectDrawCommand. Render() then issues one
+ * indirect draw per mesh, so its cost depends on the number of meshes,
+ * not of instances. Instances carry their own transform and color, so
+ * materials that only differ in color share a mesh's draw.
+ *
+ * Meshes are added once and kept: their vertices and indices go into
+ * buffers shared by all of them.
+ *
+ *   const uint32_t cube = instances.AddMesh(vertices, indices);
+ *   InstanceHandle box  = instances.AddInstance(cube, transform, color);
+ *   instances.Prepare(commandBuffer, viewProjection); // outside any pass
+ *   instances.Render(commandBuffer, renderPass);
+ */
+class InstanceRenderer {
+  public:
+    static constexpr uint32_t kInvalidMesh =
+        std::numeric_limits<uint32_t>::max();
+
+    InstanceRenderer(SDL_GPUDevice                       *device,
+                     std::shared_ptr<VirtualFileSystem>   fileSystem,
+                     const InstanceRendererSpecification &specification =
+                         InstanceRendererSpecification());
+    ~InstanceRenderer();
+
+    InstanceRenderer(const InstanceRenderer &)            = delete;
+    InstanceRenderer &operator=(const InstanceRenderer &) = delete;
+
+    // The mesh's index, or kInvalidMesh when the buffers are full.
+    uint32_t AddMesh(std::span<const MeshVertex> vertices,
+                     std::span<const uint32_t>   indices);
+
+    // Invalid when MaxInstances are alive or `mesh` doesn't exist.
+    InstanceHandle AddInstance(uint32_t         mesh,
+                               const glm::mat4 &transform,
+                               SDL_Color        color = {255, 255, 255, 255});
+    void           RemoveInstance(InstanceHandle instance);
+    bool           IsAlive(InstanceHandle instance) const;
+
+    void SetTransform(InstanceHandle instance, const glm::mat4 &transform);
+    void SetColor(InstanceHandle instance, SDL_Color color);
+
+    // Uploads what changed, then culls against `viewProjection` on the
+    // GPU.
+    void Prepare(SDL_GPUCommandBuffer *commandBuffer,
+                 const glm::mat4      &viewProjection);
+
+    // Draws what Prepare() culled, through the same matrix.
+    void Render(SDL_GPUCommandBuffer *commandBuffer,
+                SDL_GPURenderPass    *renderPass);
+
+    uint32_t GetInstanceCount() const {
+        return static_cast<uint32_t>(m_Instances.size());
+    }
+    uint32_t GetMeshCount() const {
+        return static_cast<uint32_t>(m_Meshes.size());
+    }
+    uint32_t GetUploadCount() const { return m_UploadCount; } // last frame
+    uint32_t GetDrawCount() const { return m_DrawCount; }
+
+    // The indirect draws the last cull wrote, one per mesh in order, for
+    // tools and tests that read back how many instances it kept.
+    SDL_GPUBuffer *GetDrawBuffer() const { return m_DrawBuffer; }
+
+  private:
+    // std430 layout of the shaders' Instance, 80 bytes.
+    struct GpuInstance {
+        glm::mat4 Transform;
+        uint32_t  Mesh;
+        SDL_Color Color;
+        uint32_t  Padding[2];
+    };
+
+    // An instance-rate vertex: the index the vertex shader reads the
+    // instance at.
+    struct VisibleInstance {
+        uint32_t Index;
+    };
+
+    struct Mesh {
+        uint32_t  IndexCount;
+        uint32_t  FirstIndex;
+        uint32_t  VertexOffset;
+        uint32_t  InstanceCount = 0;
+        glm::vec3 Center; // local bounds
+        glm::vec3 Extent;
+    };
+
+    struct InstanceRecord {
+        uint32_t Slot       = 0; // into m_Instances
+        uint32_t Generation = 0;
+        bool     Alive      = false;
+    };
+
+    // Mesh data in m_MeshStaging, for Prepare() to upload.
+    struct MeshUpload {
+        SDL_GPUBuffer *Buffer;
+        uint32_t       Offset; // in the buffer
+        uint32_t       Size;
+        uint32_t       StagingOffset;
+    };
+
+    uint32_t GetSlot(InstanceHandle instance) const;
+    void     MarkDirty(uint32_t slot);
+
+    SDL_GPUDevice                     *m_Device;
+    std::shared_ptr<VirtualFileSystem> m_FileSystem;
+    InstanceRendererSpecification      m_Specification;
+
+    SDL_GPUComputePipeline  *m_CullPipeline   = nullptr;
+    SDL_GPUGraphicsPipeline *m_Pipeline       = nullptr;
+    SDL_GPUBuffer           *m_VertexBuffer   = nullptr;
+    SDL_GPUBuffer           *m_IndexBuffer    = nullptr;
+    SDL_GPUBuffer           *m_InstanceBuffer = nullptr;
+    SDL_GPUBuffer           *m_BoundsBuffer   = nullptr; // per mesh
+    SDL_GPUBuffer           *m_VisibleBuffer  = nullptr;
+    // The draws with no instances counted yet, copied over m_DrawBuffer
+    // before every cull.
+    SDL_GPUBuffer         *m_DrawTemplate   = nullptr;
+    SDL_GPUBuffer         *m_DrawBuffer     = nullptr;
+    SDL_GPUTransferBuffer *m_TransferBuffer = nullptr;
+
+    std::vector<Mesh>       m_Meshes;
+    uint32_t                m_VertexCount = 0;
+    uint32_t                m_IndexCount  = 0;
+    std::vector<std::byte>  m_MeshStaging;
+    std::vector<MeshUpload> m_MeshUploads;
+    // Bounds, or the instance ranges of the draws, changed.
+    bool m_MeshesDirty = false;
+
+    // Alive instances, dense; removal moves the last one into the hole.
+    std::vector<GpuInstance>    m_Instances;
+    std::vector<uint32_t>       m_Owners; // record of each slot
+    std::vector<InstanceRecord> m_Records;
+    std::vector<uint32_t>       m_FreeRecords;
+    // Slots changed since their last upload, each listed once.
+    std::vector<uint32_t> m_DirtySlots;
+    std::vector<uint8_t>  m_Dirty;
+
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+    uint32_t  m_UploadCount    = 0;
+    uint32_t  m_DrawCount      = 0;
+};
+
+} // namespace brnCore
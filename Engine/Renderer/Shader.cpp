@@ -0,0 +1,119 @@
+#include "Shader.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <string>
+
+namespace brnCore {
+
+namespace {
+// Shader code for `path` in the best format the device takes.
+struct ShaderCode {
+    std::string         File;
+    SDL_GPUShaderFormat Format     = SDL_GPU_SHADERFORMAT_INVALID;
+    const char         *EntryPoint = "main";
+    FileData            Data;
+};
+
+bool ReadShaderCode(SDL_GPUDevice           *device,
+                    const VirtualFileSystem &fileSystem,
+                    std::string_view         path,
+                    ShaderCode              &code) {
+    const SDL_GPUShaderFormat formats = SDL_GetGPUShaderFormats(device);
+
+    code.File = path;
+    if (formats & SDL_GPU_SHADERFORMAT_SPIRV) {
+        code.Format = SDL_GPU_SHADERFORMAT_SPIRV;
+        code.File += ".spv";
+    } else if (formats & SDL_GPU_SHADERFORMAT_MSL) {
+        code.Format     = SDL_GPU_SHADERFORMAT_MSL;
+        code.EntryPoint = "main0"; // what SPIRV-Cross renames main to
+        code.File += ".msl";
+    } else if (formats & SDL_GPU_SHADERFORMAT_DXIL) {
+        code.Format = SDL_GPU_SHADERFORMAT_DXIL;
+        code.File += ".dxil";
+    }
+
+    if (code.Format == SDL_GPU_SHADERFORMAT_INVALID ||
+        !fileSystem.Read(code.File, code.Data)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Shader: cannot read %s",
+                     code.File.c_str());
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+SDL_GPUShader *LoadShader(SDL_GPUDevice             *device,
+                          const VirtualFileSystem   &fileSystem,
+                          std::string_view           path,
+                          const ShaderSpecification &specification) {
+    ShaderCode code;
+    if (!ReadShaderCode(device, fileSystem, path, code)) {
+        return nullptr;
+    }
+
+    const auto *bytes = reinterpret_cast<const Uint8 *>(code.Data.Bytes.data());
+    const SDL_GPUShaderCreateInfo shaderInfo{
+        .code_size            = code.Data.Bytes.size(),
+        .code                 = bytes,
+        .entrypoint           = code.EntryPoint,
+        .format               = code.Format,
+        .stage                = specification.Stage,
+        .num_samplers         = specification.Samplers,
+        .num_storage_textures = specification.StorageTextures,
+        .num_storage_buffers  = specification.StorageBuffers,
+        .num_uniform_buffers  = specification.UniformBuffers,
+    };
+    SDL_GPUShader *shader = SDL_CreateGPUShader(device, &shaderInfo);
+    if (!shader) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Shader: cannot create %s: %s",
+                     code.File.c_str(),
+                     SDL_GetError());
+    }
+    return shader;
+}
+
+SDL_GPUComputePipeline *
+LoadComputePipeline(SDL_GPUDevice                      *device,
+                    const VirtualFileSystem            &fileSystem,
+                    std::string_view                    path,
+                    const ComputePipelineSpecification &specification) {
+    ShaderCode code;
+    if (!ReadShaderCode(device, fileSystem, path, code)) {
+        return nullptr;
+    }
+
+    const auto *bytes = reinterpret_cast<const Uint8 *>(code.Data.Bytes.data());
+    const SDL_GPUComputePipelineCreateInfo pipelineInfo{
+        .code_size    = code.Data.Bytes.size(),
+        .code         = bytes,
+        .entrypoint   = code.EntryPoint,
+        .format       = code.Format,
+        .num_samplers = specification.Samplers,
+        .num_readonly_storage_textures =
+            specification.ReadOnlyStorageTextures,
+        .num_readonly_storage_buffers = specification.ReadOnlyStorageBuffers,
+        .num_readwrite_storage_textures =
+            specification.ReadWriteStorageTextures,
+        .num_readwrite_storage_buffers =
+            specification.ReadWriteStorageBuffers,
+        .num_uniform_buffers = specification.UniformBuffers,
+        .threadcount_x       = specification.ThreadCountX,
+        .threadcount_y       = specification.ThreadCountY,
+        .threadcount_z       = specification.ThreadCountZ,
+    };
+    SDL_GPUComputePipeline *pipeline =
+        SDL_CreateGPUComputePipeline(device, &pipelineInfo);
+    if (!pipeline) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "Shader: cannot create %s: %s",
+                     code.File.c_str(),
+                     SDL_GetError());
+    }
+    return pipeline;
+}
+
+} // namespace brnCore
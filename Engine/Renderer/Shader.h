@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+
+#include <cstdint>
+#include <string_view>
+
+#include "Engine/Assets/FileSystem.h"
+
+namespace brnCore {
+
+// Resources the shader declares, per SDL_GPUShaderCreateInfo.
+struct ShaderSpecification {
+    SDL_GPUShaderStage Stage           = SDL_GPU_SHADERSTAGE_VERTEX;
+    uint32_t           Samplers        = 0;
+    uint32_t           StorageTextures = 0;
+    uint32_t           StorageBuffers  = 0;
+    uint32_t           UniformBuffers  = 0;
+};
+
+// Resources and workgroup size the compute shader declares, per
+// SDL_GPUComputePipelineCreateInfo.
+struct ComputePipelineSpecification {
+    uint32_t Samplers                 = 0;
+    uint32_t ReadOnlyStorageTextures  = 0;
+    uint32_t ReadOnlyStorageBuffers   = 0;
+    uint32_t ReadWriteStorageTextures = 0;
+    uint32_t ReadWriteStorageBuffers  = 0;
+    uint32_t UniformBuffers           = 0;
+    uint32_t ThreadCountX             = 1;
+    uint32_t ThreadCountY             = 1;
+    uint32_t ThreadCountZ             = 1;
+};
+
+/*
+ * Loads `path` + ".spv", ".msl" or ".dxil", whichever the device takes,
+ * from the file system. The build compiles Engine/Shaders to SPIR-V;
+ * the other formats come from running those through SDL_shadercross.
+ * Logs and returns nullptr on failure.
+ */
+SDL_GPUShader *LoadShader(SDL_GPUDevice             *device,
+                          const VirtualFileSystem   &fileSystem,
+                          std::string_view           path,
+                          const ShaderSpecification &specification);
+
+// The same for a compute shader, which SDL_GPU takes as a whole pipeline.
+SDL_GPUComputePipeline *
+LoadComputePipeline(SDL_GPUDevice                      *device,
+                    const VirtualFileSystem            &fileSystem,
+                    std::string_view                    path,
+                    const ComputePipelineSpecification &specification);
+
+} // namespace brnCore
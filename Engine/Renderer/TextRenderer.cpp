@@ -0,0 +1,585 @@
+#include "TextRenderer.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_surface.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+#include "Engine/Core/Hash.h"
+#include "Engine/Renderer/Shader.h"
+
+namespace brnCore {
+
+namespace {
+// Clear texels around every glyph, so filtering never reads a neighbor.
+constexpr uint32_t kPadding = 1;
+} // namespace
+
+TextRenderer::TextRenderer(SDL_GPUDevice                     *device,
+                           std::shared_ptr<VirtualFileSystem> fileSystem,
+                           const TextRendererSpecification   &specification)
+    : m_Device(device), m_FileSystem(std::move(fileSystem)),
+      m_Specification(specification) {
+    m_Instances.resize(m_Specification.MaxPages);
+    m_PageCounts.resize(m_Specification.MaxPages);
+
+    SDL_GPUShader *vertexShader =
+        LoadShader(m_Device,
+                   *m_FileSystem,
+                   "Shaders/Text.vert",
+                   {.Stage = SDL_GPU_SHADERSTAGE_VERTEX, .UniformBuffers = 1});
+    SDL_GPUShader *fragmentShader =
+        LoadShader(m_Device,
+                   *m_FileSystem,
+                   "Shaders/Text.frag",
+                   {.Stage          = SDL_GPU_SHADERSTAGE_FRAGMENT,
+                    .Samplers       = 1,
+                    .UniformBuffers = 1});
+
+    if (vertexShader && fragmentShader) {
+        static constexpr VertexInput kInput(MakeVertexLayout<GlyphInstance>(
+            SDL_GPU_VERTEXINPUTRATE_INSTANCE,
+            BRN_VERTEX_ATTRIBUTE(GlyphInstance, Rect),
+            BRN_VERTEX_ATTRIBUTE(GlyphInstance, Uv),
+            BRN_VERTEX_ATTRIBUTE(GlyphInstance, Color)));
+        const SDL_GPUColorTargetDescription target{
+            .format = m_Specification.TargetFormat,
+            .blend_state =
+                {
+                    .src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
+                    .dst_color_blendfactor =
+                        SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                    .color_blend_op        = SDL_GPU_BLENDOP_ADD,
+                    .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+                    .dst_alpha_blendfactor =
+                        SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                    .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
+                    .enable_blend   = true,
+                },
+        };
+        const SDL_GPUGraphicsPipelineCreateInfo pipelineInfo{
+            .vertex_shader      = vertexShader,
+            .fragment_shader    = fragmentShader,
+            .vertex_input_state = kInput.GetState(),
+            .primitive_type     = SDL_GPU_PRIMITIVETYPE_TRIANGLESTRIP,
+            .target_info =
+                {
+                    .color_target_descriptions = &target,
+                    .num_color_targets         = 1,
+                },
+        };
+        m_Pipeline = SDL_CreateGPUGraphicsPipeline(m_Device, &pipelineInfo);
+        if (!m_Pipeline) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TextRenderer: cannot create pipeline: %s",
+                         SDL_GetError());
+        }
+    }
+    if (vertexShader) {
+        SDL_ReleaseGPUShader(m_Device, vertexShader);
+    }
+    if (fragmentShader) {
+        SDL_ReleaseGPUShader(m_Device, fragmentShader);
+    }
+
+    const SDL_GPUSamplerCreateInfo samplerInfo{
+        .min_filter     = SDL_GPU_FILTER_LINEAR,
+        .mag_filter     = SDL_GPU_FILTER_LINEAR,
+        .mipmap_mode    = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST,
+        .address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+    };
+    m_Sampler = SDL_CreateGPUSampler(m_Device, &samplerInfo);
+
+    const auto instanceBytes =
+        static_cast<Uint32>(m_Specification.MaxGlyphs * sizeof(GlyphInstance));
+    const SDL_GPUBufferCreateInfo bufferInfo{
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
+        .size  = instanceBytes,
+    };
+    m_InstanceBuffer = SDL_CreateGPUBuffer(m_Device, &bufferInfo);
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size  = instanceBytes,
+    };
+    m_TransferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+}
+
+TextRenderer::~TextRenderer() {
+    for (const Page &page : m_Pages) {
+        SDL_ReleaseGPUTexture(m_Device, page.Texture);
+    }
+    SDL_ReleaseGPUTransferBuffer(m_Device, m_TransferBuffer);
+    SDL_ReleaseGPUBuffer(m_Device, m_InstanceBuffer);
+    SDL_ReleaseGPUSampler(m_Device, m_Sampler);
+    if (m_Pipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(m_Device, m_Pipeline);
+    }
+}
+
+void TextRenderer::DrawText(const Font      &font,
+                            std::string_view text,
+                            glm::vec2        position,
+                            SDL_Color        color,
+                            float            scale) {
+    if (!font.Handle) {
+        return;
+    }
+    if (font.Sdf != m_Specification.Sdf) {
+        if (m_WrongFont != font.Id) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TextRenderer: skipping a font loaded with sdf = "
+                         "%s, the renderer draws %s",
+                         font.Sdf ? "true" : "false",
+                         m_Specification.Sdf ? "distance fields"
+                                             : "coverage");
+            m_WrongFont = font.Id;
+        }
+        return;
+    }
+
+    const TextRun &run = GetRun(font, text);
+    for (const ShapedGlyph &shaped : run.Glyphs) {
+        if (m_Queued == m_Specification.MaxGlyphs) {
+            if (!m_Full) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                            "TextRenderer: more than %u glyphs this frame",
+                            m_Specification.MaxGlyphs);
+                m_Full = true;
+            }
+            return;
+        }
+
+        Glyph &glyph = m_Glyphs[shaped.Glyph];
+        if (glyph.Empty || (!glyph.Resident && !Rasterize(glyph))) {
+            continue;
+        }
+        m_Pages[glyph.Page].UsedFrame = m_Frame;
+        m_Instances[glyph.Page].push_back(
+            {glm::vec4(position + (shaped.Pen + glyph.Offset) * scale,
+                       glyph.Size * scale),
+             PackUnorm16x4(glyph.Uv),
+             color});
+        m_Queued++;
+    }
+}
+
+glm::vec2 TextRenderer::MeasureText(const Font      &font,
+                                    std::string_view text,
+                                    float            scale) {
+    return font.Handle ? GetRun(font, text).Size * scale : glm::vec2(0.0f);
+}
+
+void TextRenderer::Prepare(SDL_GPUCommandBuffer *commandBuffer) {
+    if (m_Queued == 0 && m_Uploads.empty()) {
+        return;
+    }
+
+    // Glyphs are few after the first frames; their buffer is made to
+    // measure and released once the copy has executed.
+    SDL_GPUTransferBuffer *glyphBuffer = nullptr;
+    if (!m_Uploads.empty()) {
+        const SDL_GPUTransferBufferCreateInfo transferInfo{
+            .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+            .size  = static_cast<Uint32>(m_Staging.size()),
+        };
+        glyphBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+        void *mapped =
+            glyphBuffer ? SDL_MapGPUTransferBuffer(m_Device, glyphBuffer, false)
+                        : nullptr;
+        if (!mapped) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TextRenderer: cannot upload glyphs: %s",
+                         SDL_GetError());
+            SDL_ReleaseGPUTransferBuffer(m_Device, glyphBuffer);
+            return;
+        }
+        std::memcpy(mapped, m_Staging.data(), m_Staging.size());
+        SDL_UnmapGPUTransferBuffer(m_Device, glyphBuffer);
+    }
+
+    // Cycling hands back a fresh buffer if last frame's draws still read
+    // this one.
+    auto *instances = static_cast<GlyphInstance *>(
+        SDL_MapGPUTransferBuffer(m_Device, m_TransferBuffer, true));
+    if (!instances) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TextRenderer: cannot upload glyph quads: %s",
+                     SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(m_Device, glyphBuffer);
+        return;
+    }
+    uint32_t count = 0;
+    for (uint32_t page = 0; page < m_Instances.size(); page++) {
+        std::ranges::copy(m_Instances[page], instances + count);
+        m_PageCounts[page] = static_cast<uint32_t>(m_Instances[page].size());
+        count += m_PageCounts[page];
+    }
+    SDL_UnmapGPUTransferBuffer(m_Device, m_TransferBuffer);
+
+    SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    for (const GlyphUpload &upload : m_Uploads) {
+        const SDL_GPUTextureTransferInfo source{
+            .transfer_buffer = glyphBuffer,
+            .offset          = upload.Offset,
+            .pixels_per_row  = upload.Width,
+            .rows_per_layer  = upload.Height,
+        };
+        const SDL_GPUTextureRegion destination{
+            .texture = m_Pages[upload.Page].Texture,
+            .x       = upload.X,
+            .y       = upload.Y,
+            .w       = upload.Width,
+            .h       = upload.Height,
+            .d       = 1,
+        };
+        SDL_UploadToGPUTexture(copyPass, &source, &destination, false);
+    }
+    if (count > 0) {
+        const SDL_GPUTransferBufferLocation source{
+            .transfer_buffer = m_TransferBuffer,
+        };
+        const SDL_GPUBufferRegion destination{
+            .buffer = m_InstanceBuffer,
+            .size   = static_cast<Uint32>(count * sizeof(GlyphInstance)),
+        };
+        SDL_UploadToGPUBuffer(copyPass, &source, &destination, true);
+    }
+    SDL_EndGPUCopyPass(copyPass);
+
+    if (glyphBuffer) {
+        SDL_ReleaseGPUTransferBuffer(m_Device, glyphBuffer);
+    }
+    m_Uploads.clear();
+    m_Staging.clear();
+}
+
+void TextRenderer::Render(SDL_GPUCommandBuffer *commandBuffer,
+                          SDL_GPURenderPass    *renderPass,
+                          uint32_t              targetWidth,
+                          uint32_t              targetHeight) {
+    m_GlyphCount = 0;
+    m_DrawCount  = 0;
+    for (const uint32_t count : m_PageCounts) {
+        m_GlyphCount += count;
+    }
+
+    if (m_Pipeline && m_GlyphCount > 0) {
+        SDL_BindGPUGraphicsPipeline(renderPass, m_Pipeline);
+        const SDL_GPUBufferBinding binding{.buffer = m_InstanceBuffer};
+        SDL_BindGPUVertexBuffers(renderPass, 0, &binding, 1);
+
+        const glm::vec2 targetSize(targetWidth, targetHeight);
+        const float     sdf = m_Specification.Sdf ? 1.0f : 0.0f;
+        SDL_PushGPUVertexUniformData(
+            commandBuffer, 0, &targetSize, sizeof(targetSize));
+        SDL_PushGPUFragmentUniformData(commandBuffer, 0, &sdf, sizeof(sdf));
+
+        uint32_t first = 0;
+        for (uint32_t page = 0; page < m_PageCounts.size(); page++) {
+            const uint32_t count = m_PageCounts[page];
+            if (count == 0) {
+                continue;
+            }
+            const SDL_GPUTextureSamplerBinding atlas{
+                .texture = m_Pages[page].Texture,
+                .sampler = m_Sampler,
+            };
+            SDL_BindGPUFragmentSamplers(renderPass, 0, &atlas, 1);
+            SDL_DrawGPUPrimitives(renderPass, 4, count, 0, first);
+            first += count;
+            m_DrawCount++;
+        }
+    }
+
+    for (std::vector<GlyphInstance> &instances : m_Instances) {
+        instances.clear();
+    }
+    std::ranges::fill(m_PageCounts, 0u);
+    m_Queued = 0;
+    m_Full   = false;
+
+    // Now and then, rather than every frame: there may be thousands.
+    if (m_Frame % 64 == 0) {
+        const size_t expired = std::erase_if(m_Runs, [this](const auto &entry) {
+            return m_Frame - entry.second.UsedFrame >
+                   m_Specification.RunCacheFrames;
+        });
+        if (expired > 0) {
+            PruneGlyphs();
+        }
+    }
+    m_Frame++;
+}
+
+const TextRenderer::TextRun &TextRenderer::GetRun(const Font      &font,
+                                                  std::string_view text) {
+    TTF_Font      *handle = font.Handle;
+    const uint64_t key =
+        HashCombine(HashBytes(text.data(), text.size()), font.Id);
+
+    TextRun &run  = m_Runs[key];
+    run.UsedFrame = m_Frame;
+    if (run.FontId == font.Id && run.Text == text) {
+        return run;
+    }
+
+    // New, or another string with the same hash: lay it out (again).
+    run.Text   = text;
+    run.FontId = font.Id;
+    run.Glyphs.clear();
+
+    const auto lineSkip = static_cast<float>(TTF_GetFontLineSkip(handle));
+    glm::vec2  pen(0.0f);
+    float      width    = 0.0f;
+    uint32_t   previous = 0;
+
+    const char *next      = text.data();
+    size_t      remaining = text.size();
+    while (remaining > 0) {
+        const uint32_t codepoint = SDL_StepUTF8(&next, &remaining);
+        if (codepoint == '\n') {
+            width    = std::max(width, pen.x);
+            pen      = glm::vec2(0.0f, pen.y + lineSkip);
+            previous = 0;
+            continue;
+        }
+
+        int kerning = 0;
+        if (previous &&
+            TTF_GetGlyphKerning(handle, previous, codepoint, &kerning)) {
+            pen.x += static_cast<float>(kerning);
+        }
+        const uint32_t index = GetGlyph(font, codepoint);
+        if (!m_Glyphs[index].Empty) {
+            run.Glyphs.push_back({index, pen});
+        }
+        pen.x += m_Glyphs[index].Advance;
+        previous = codepoint;
+    }
+    run.Size = glm::vec2(std::max(width, pen.x),
+                         pen.y + static_cast<float>(TTF_GetFontHeight(handle)));
+    return run;
+}
+
+uint32_t TextRenderer::GetGlyph(const Font &font, uint32_t codepoint) {
+    const uint64_t key = HashCombine(font.Id, codepoint);
+    const auto [it, added] =
+        m_GlyphIndex.try_emplace(key, static_cast<uint32_t>(m_Glyphs.size()));
+    if (!added) {
+        return it->second;
+    }
+
+    int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+    TTF_GetGlyphMetrics(
+        font.Handle, codepoint, &minX, &maxX, &minY, &maxY, &advance);
+
+    Glyph &glyph    = m_Glyphs.emplace_back();
+    glyph.Font      = font.Handle;
+    glyph.FontId    = font.Id;
+    glyph.Codepoint = codepoint;
+    glyph.Advance   = static_cast<float>(advance);
+    glyph.Empty     = maxX <= minX || maxY <= minY;
+    // y grows down from the top of the line.
+    glyph.BoxOffset = glm::vec2(minX, TTF_GetFontAscent(font.Handle) - maxY);
+    glyph.BoxSize   = glm::vec2(maxX - minX, maxY - minY);
+    return it->second;
+}
+
+/*
+ * Forgets the glyphs of fonts no cached run uses anymore. Every reload
+ * gets a new Font::Id, so otherwise each one would leave a full set of
+ * glyphs behind, pointing at a freed TTF_Font. Their atlas space comes
+ * back when their page is evicted, or now if nothing else is on it.
+ */
+void TextRenderer::PruneGlyphs() {
+    std::unordered_set<uint64_t> fonts;
+    for (const auto &[key, run] : m_Runs) {
+        fonts.insert(run.FontId);
+    }
+
+    std::vector<uint32_t> remap(m_Glyphs.size());
+    std::vector<uint32_t> resident(m_Pages.size(), 0);
+    uint32_t              kept = 0;
+    for (uint32_t i = 0; i < m_Glyphs.size(); i++) {
+        const Glyph &glyph = m_Glyphs[i];
+        if (!fonts.contains(glyph.FontId)) {
+            m_GlyphIndex.erase(HashCombine(glyph.FontId, glyph.Codepoint));
+            continue;
+        }
+        if (glyph.Resident) {
+            resident[glyph.Page]++;
+        }
+        remap[i]         = kept;
+        m_Glyphs[kept++] = glyph;
+    }
+    if (kept == m_Glyphs.size()) {
+        return;
+    }
+    m_Glyphs.resize(kept);
+
+    // Only glyphs of the fonts kept are referenced from here on.
+    for (auto &[key, index] : m_GlyphIndex) {
+        index = remap[index];
+    }
+    for (auto &[key, run] : m_Runs) {
+        for (ShapedGlyph &shaped : run.Glyphs) {
+            shaped.Glyph = remap[shaped.Glyph];
+        }
+    }
+
+    for (size_t page = 0; page < m_Pages.size(); page++) {
+        if (resident[page] == 0) {
+            m_Pages[page].Shelves.clear();
+            m_Pages[page].Top = 0;
+        }
+    }
+}
+
+bool TextRenderer::Rasterize(Glyph &glyph) {
+    TTF_ImageType type;
+    SDL_Surface  *surface =
+        TTF_GetGlyphImage(glyph.Font, glyph.Codepoint, &type);
+    if (surface && surface->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface *converted =
+            SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+        SDL_DestroySurface(surface);
+        surface = converted;
+    }
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TextRenderer: cannot rasterize U+%04X: %s",
+                     glyph.Codepoint,
+                     SDL_GetError());
+        glyph.Empty = true; // don't try every frame
+        return false;
+    }
+
+    const auto width  = static_cast<uint32_t>(surface->w);
+    const auto height = static_cast<uint32_t>(surface->h);
+    uint32_t   page, x, y;
+    if (!Allocate(width + 2 * kPadding, height + 2 * kPadding, page, x, y)) {
+        SDL_DestroySurface(surface);
+        if (!m_Full) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                        "TextRenderer: atlas full, glyphs dropped");
+            m_Full = true;
+        }
+        return false;
+    }
+
+    // Coverage (or distance) is in alpha; the padding stays zero. Copy
+    // offsets stay 4 byte aligned, as some backends require.
+    const uint32_t paddedWidth  = width + 2 * kPadding;
+    const uint32_t paddedHeight = height + 2 * kPadding;
+    const auto     offset       = static_cast<uint32_t>(m_Staging.size());
+    m_Staging.resize((offset + paddedWidth * paddedHeight + 3) & ~3u);
+    for (uint32_t row = 0; row < height; row++) {
+        const auto *source = reinterpret_cast<const uint32_t *>(
+            static_cast<const std::byte *>(surface->pixels) +
+            size_t(row) * surface->pitch);
+        std::byte *destination = m_Staging.data() + offset +
+                                 (row + kPadding) * paddedWidth + kPadding;
+        for (uint32_t column = 0; column < width; column++) {
+            destination[column] = static_cast<std::byte>(source[column] >> 24);
+        }
+    }
+    SDL_DestroySurface(surface);
+    m_Uploads.push_back({page, x, y, paddedWidth, paddedHeight, offset});
+
+    // The bitmap may be larger than the box (SDF spread); keep it centered.
+    const glm::vec2 size(width, height);
+    const float     pageSize = static_cast<float>(m_Specification.PageSize);
+    glyph.Resident           = true;
+    glyph.Page               = page;
+    glyph.Offset             = glyph.BoxOffset - (size - glyph.BoxSize) * 0.5f;
+    glyph.Size               = size;
+    glyph.Uv = glm::vec4(x + kPadding, y + kPadding, x + kPadding + width,
+                         y + kPadding + height) /
+               pageSize;
+    return true;
+}
+
+bool TextRenderer::Allocate(uint32_t  width,
+                            uint32_t  height,
+                            uint32_t &page,
+                            uint32_t &x,
+                            uint32_t &y) {
+    const uint32_t size = m_Specification.PageSize;
+
+    auto place = [&](Page &candidate) {
+        // The lowest shelf it fits on wastes the least space.
+        Shelf *best = nullptr;
+        for (Shelf &shelf : candidate.Shelves) {
+            if (shelf.Height >= height && shelf.X + width <= size &&
+                (!best || shelf.Height < best->Height)) {
+                best = &shelf;
+            }
+        }
+        if (!best && candidate.Top + height <= size && width <= size) {
+            // Rounded up, so glyphs of similar heights share it.
+            const uint32_t shelfHeight =
+                std::min((height + 7) & ~7u, size - candidate.Top);
+            best = &candidate.Shelves.emplace_back(
+                Shelf{candidate.Top, shelfHeight, 0});
+            candidate.Top += shelfHeight;
+        }
+        if (!best) {
+            return false;
+        }
+        x = best->X;
+        y = best->Y;
+        best->X += width;
+        return true;
+    };
+
+    for (page = 0; page < m_Pages.size(); page++) {
+        if (place(m_Pages[page])) {
+            return true;
+        }
+    }
+
+    if (m_Pages.size() < m_Specification.MaxPages) {
+        const SDL_GPUTextureCreateInfo textureInfo{
+            .type                 = SDL_GPU_TEXTURETYPE_2D,
+            .format               = SDL_GPU_TEXTUREFORMAT_R8_UNORM,
+            .usage                = SDL_GPU_TEXTUREUSAGE_SAMPLER,
+            .width                = size,
+            .height               = size,
+            .layer_count_or_depth = 1,
+            .num_levels           = 1,
+        };
+        SDL_GPUTexture *texture = SDL_CreateGPUTexture(m_Device, &textureInfo);
+        if (!texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TextRenderer: cannot create atlas page: %s",
+                         SDL_GetError());
+            return false;
+        }
+        page = static_cast<uint32_t>(m_Pages.size());
+        m_Pages.push_back({texture});
+        return place(m_Pages.back());
+    }
+
+    // Evict the least recently used page, unless this frame drew from it.
+    auto lru = std::ranges::min_element(m_Pages, {}, &Page::UsedFrame);
+    if (lru->UsedFrame == m_Frame) {
+        return false;
+    }
+    page = static_cast<uint32_t>(lru - m_Pages.begin());
+    lru->Shelves.clear();
+    lru->Top = 0;
+    for (Glyph &glyph : m_Glyphs) {
+        if (glyph.Resident && glyph.Page == page) {
+            glyph.Resident = false;
+        }
+    }
+    return place(*lru);
+}
+
+} // namespace brnCore
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_pixels.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Assets/AssetHandle.h"
+#include "Engine/Assets/FileSystem.h"
+#include "Engine/Renderer/VertexLayout.h"
+
+namespace brnCore {
+
+struct TextRendererSpecification {
+    // Format of the color target Render() draws into.
+    SDL_GPUTextureFormat TargetFormat = SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
+    // Atlas pages are PageSize squared, one byte per texel. When all are
+    // full, the page used least recently is cleared for new glyphs.
+    uint32_t PageSize = 1024;
+    uint32_t MaxPages = 4;
+    uint32_t MaxGlyphs = 1 << 16; // quads per frame
+    // Rasterize glyphs as signed distance fields, so one rasterization
+    // stays sharp at every scale (corners get slightly rounded). Fonts
+    // must be loaded to match: LoadFont(path, size, sdf).
+    bool Sdf = false;
+    // Laid out strings not drawn for this many frames are forgotten, and
+    // so are the glyphs of fonts none of the remaining strings use.
+    uint32_t RunCacheFrames = 600;
+};
+
+/*
+ * Draws text from fonts loaded by the AssetManager without creating a
+ * texture per string.
+ *
+ * Glyphs are rasterized once by SDL_ttf into atlas pages, packed in
+ * shelves. Laid out strings (glyphs, positions, kerning) are cached by
+ * Font::Id and string hash, so a label drawn every frame costs a lookup and
+ * a quad per glyph. Every glyph of the frame is an instance of one quad,
+ * grouped by page: Render() makes one draw call per page in use. Text
+ * on different pages may therefore overlap in a different order than it
+ * was queued in.
+ *
+ * Per frame, on the render thread:
+ *
+ *   text.DrawText(font, "Score: 10", {16, 16}, {255, 255, 255, 255});
+ *   text.Prepare(commandBuffer);           // outside any pass
+ *   text.Render(commandBuffer, renderPass, width, height);
+ */
+class TextRenderer {
+  public:
+    TextRenderer(SDL_GPUDevice                     *device,
+                 std::shared_ptr<VirtualFileSystem> fileSystem,
+                 const TextRendererSpecification   &specification =
+                     TextRendererSpecification());
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer &)            = delete;
+    TextRenderer &operator=(const TextRenderer &) = delete;
+
+    // Queues UTF-8 `text` ('\n' breaks lines) with the top left of its
+    // first line at `position`, in pixels.
+    void DrawText(const Font      &font,
+                  std::string_view text,
+                  glm::vec2        position,
+                  SDL_Color        color,
+                  float            scale = 1.0f);
+
+    // The size DrawText() would cover.
+    glm::vec2 MeasureText(const Font      &font,
+                          std::string_view text,
+                          float            scale = 1.0f);
+
+    // Uploads new glyphs and the queued quads.
+    void Prepare(SDL_GPUCommandBuffer *commandBuffer);
+
+    // Draws what Prepare() uploaded into a target of the given size, and
+    // starts the next frame.
+    void Render(SDL_GPUCommandBuffer *commandBuffer,
+                SDL_GPURenderPass    *renderPass,
+                uint32_t              targetWidth,
+                uint32_t              targetHeight);
+
+    uint32_t GetGlyphCount() const { return m_GlyphCount; } // last frame
+    uint32_t GetDrawCount() const { return m_DrawCount; }
+
+  private:
+    struct Glyph {
+        TTF_Font *Font      = nullptr;
+        uint64_t  FontId    = 0;
+        uint32_t  Codepoint = 0;
+        float     Advance   = 0.0f;
+        bool      Empty     = false; // nothing to draw, e.g. a space
+        // Bounding box relative to the pen, y down from the line's top.
+        glm::vec2 BoxOffset = glm::vec2(0.0f);
+        glm::vec2 BoxSize   = glm::vec2(0.0f);
+        // Where it is in the atlas, and its bitmap relative to the pen.
+        bool      Resident = false;
+        uint32_t  Page     = 0;
+        glm::vec4 Uv       = glm::vec4(0.0f);
+        glm::vec2 Offset   = glm::vec2(0.0f);
+        glm::vec2 Size     = glm::vec2(0.0f);
+    };
+
+    struct ShapedGlyph {
+        uint32_t  Glyph; // into m_Glyphs
+        glm::vec2 Pen;
+    };
+
+    struct TextRun {
+        std::string              Text;
+        uint64_t                 FontId = 0;
+        std::vector<ShapedGlyph> Glyphs;
+        glm::vec2                Size      = glm::vec2(0.0f);
+        uint64_t                 UsedFrame = 0;
+    };
+
+    struct Shelf {
+        uint32_t Y;
+        uint32_t Height;
+        uint32_t X; // next free column
+    };
+
+    struct Page {
+        SDL_GPUTexture    *Texture = nullptr;
+        std::vector<Shelf> Shelves;
+        uint32_t           Top       = 0; // next free row for a shelf
+        uint64_t           UsedFrame = 0;
+    };
+
+    // 28 bytes; 16 bit atlas coordinates are within 1/64 texel on 1024
+    // texel pages.
+    struct GlyphInstance {
+        glm::vec4 Rect;
+        Unorm16x4 Uv;
+        SDL_Color Color;
+    };
+
+    // A glyph bitmap in m_Staging, for Prepare() to upload.
+    struct GlyphUpload {
+        uint32_t Page;
+        uint32_t X;
+        uint32_t Y;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Offset;
+    };
+
+    const TextRun &GetRun(const Font &font, std::string_view text);
+    uint32_t       GetGlyph(const Font &font, uint32_t codepoint);
+    void           PruneGlyphs();
+    bool           Rasterize(Glyph &glyph);
+    bool           Allocate(uint32_t  width,
+                            uint32_t  height,
+                            uint32_t &page,
+                            uint32_t &x,
+                            uint32_t &y);
+
+    SDL_GPUDevice                     *m_Device;
+    std::shared_ptr<VirtualFileSystem> m_FileSystem;
+    TextRendererSpecification          m_Specification;
+
+    SDL_GPUGraphicsPipeline *m_Pipeline       = nullptr;
+    SDL_GPUSampler          *m_Sampler        = nullptr;
+    SDL_GPUBuffer           *m_InstanceBuffer = nullptr;
+    SDL_GPUTransferBuffer   *m_TransferBuffer = nullptr;
+
+    std::vector<Glyph>                     m_Glyphs;
+    // Keyed on Font::Id: a reloaded font may get a freed one's address.
+    std::unordered_map<uint64_t, uint32_t> m_GlyphIndex; // font, codepoint
+    std::unordered_map<uint64_t, TextRun>  m_Runs;       // font, string hash
+    std::vector<Page>                      m_Pages;
+
+    // This frame's quads by page, and the glyphs waiting for an upload.
+    std::vector<std::vector<GlyphInstance>> m_Instances;
+    std::vector<uint32_t>                   m_PageCounts; // as uploaded
+    std::vector<std::byte>                  m_Staging;
+    std::vector<GlyphUpload>                m_Uploads;
+
+    uint64_t m_Frame      = 1;
+    uint32_t m_Queued     = 0;
+    uint32_t m_GlyphCount = 0;
+    uint32_t m_DrawCount  = 0;
+    bool     m_Full       = false; // warned this frame
+    uint64_t m_WrongFont  = 0;     // last font warned about, by Id
+};
+
+} // namespace brnCore
@@ -0,0 +1,579 @@
+#include "TilemapRenderer.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "Engine/Renderer/Shader.h"
+
+namespace brnCore {
+
+namespace {
+// Every tileset tile but the last can be animated: tile values are 16
+// bit, and 0 is empty.
+constexpr uint32_t kAnimationCount = 65535;
+constexpr size_t   kAnimationBytes = kAnimationCount * sizeof(uint32_t);
+
+// std140 layouts of the shaders' uniform blocks.
+struct ViewUniforms {
+    glm::mat4  ViewProjection;
+    glm::uvec2 FirstChunk;
+    uint32_t   ChunksPerRow;
+    uint32_t   ChunkSize;
+    glm::vec2  TileSize;
+    glm::uvec2 MapSize;
+};
+
+struct LayerUniforms {
+    glm::vec4 Tint;
+    uint32_t  TimeMs;
+    uint32_t  Columns;
+    glm::vec2 TileUv;
+    glm::vec2 Inset;
+};
+
+// Bytes of a chunk in the transfer buffer; copy offsets stay 4 byte
+// aligned, as some backends require.
+uint32_t GetChunkBytes(uint32_t chunkSize) {
+    return (chunkSize * chunkSize * sizeof(uint16_t) + 3) & ~3u;
+}
+
+TilemapSpecification Validate(TilemapSpecification specification) {
+    specification.Width      = std::clamp(specification.Width, 1u, 16384u);
+    specification.Height     = std::clamp(specification.Height, 1u, 16384u);
+    specification.LayerCount = std::max(specification.LayerCount, 1u);
+    specification.ChunkSize =
+        std::clamp(specification.ChunkSize,
+                   1u,
+                   std::max(specification.Width, specification.Height));
+
+    // No more than the map has, and a frame's chunks must fit next to the
+    // animations in one transfer buffer, whose size is 32 bit.
+    const uint32_t chunkSize = specification.ChunkSize;
+    const size_t   chunks =
+        size_t((specification.Width + chunkSize - 1) / chunkSize) *
+        ((specification.Height + chunkSize - 1) / chunkSize) *
+        specification.LayerCount;
+    const size_t fitting =
+        (UINT32_MAX - kAnimationBytes) / GetChunkBytes(chunkSize);
+    specification.MaxChunkUploads =
+        static_cast<uint32_t>(std::clamp<size_t>(
+            specification.MaxChunkUploads, 1, std::min(chunks, fitting)));
+    return specification;
+}
+
+/*
+ * The part of the z = 0 plane `viewProjection` shows, bounded by a
+ * rectangle. When the plane crosses all four side edges of the frustum
+ * the section is the quad of the crossings; otherwise the whole frustum
+ * bounds it.
+ */
+void GetVisibleRect(const glm::mat4 &viewProjection,
+                    glm::vec2       &low,
+                    glm::vec2       &high) {
+    const glm::mat4 inverse = glm::inverse(viewProjection);
+    glm::vec2       crossLow(FLT_MAX), crossHigh(-FLT_MAX);
+    glm::vec2       frustumLow(FLT_MAX), frustumHigh(-FLT_MAX);
+    bool            crosses = true;
+
+    for (const glm::vec2 corner : {glm::vec2(-1.0f, -1.0f),
+                                   glm::vec2(1.0f, -1.0f),
+                                   glm::vec2(-1.0f, 1.0f),
+                                   glm::vec2(1.0f, 1.0f)}) {
+        // SDL_GPU depth runs from 0 at the near plane to 1 at the far one.
+        const glm::vec4 nearPoint =
+            inverse * glm::vec4(corner.x, corner.y, 0.0f, 1.0f);
+        const glm::vec4 farPoint =
+            inverse * glm::vec4(corner.x, corner.y, 1.0f, 1.0f);
+        const glm::vec3 a = glm::vec3(nearPoint) / nearPoint.w;
+        const glm::vec3 b = glm::vec3(farPoint) / farPoint.w;
+
+        frustumLow  = glm::min(frustumLow, glm::vec2(a));
+        frustumLow  = glm::min(frustumLow, glm::vec2(b));
+        frustumHigh = glm::max(frustumHigh, glm::vec2(a));
+        frustumHigh = glm::max(frustumHigh, glm::vec2(b));
+
+        const float dz = b.z - a.z;
+        const float t  = std::abs(dz) > FLT_EPSILON ? -a.z / dz : -1.0f;
+        if (t < 0.0f || t > 1.0f) {
+            crosses = false;
+            continue;
+        }
+        const glm::vec2 point = glm::vec2(glm::mix(a, b, t));
+        crossLow              = glm::min(crossLow, point);
+        crossHigh             = glm::max(crossHigh, point);
+    }
+    low  = crosses ? crossLow : frustumLow;
+    high = crosses ? crossHigh : frustumHigh;
+}
+} // namespace
+
+TilemapRenderer::TilemapRenderer(SDL_GPUDevice                     *device,
+                                 std::shared_ptr<VirtualFileSystem> fileSystem,
+                                 const TilemapSpecification &specification)
+    : m_Device(device), m_FileSystem(std::move(fileSystem)),
+      m_Specification(Validate(specification)),
+      m_ChunksX((m_Specification.Width + m_Specification.ChunkSize - 1) /
+                m_Specification.ChunkSize),
+      m_ChunksY((m_Specification.Height + m_Specification.ChunkSize - 1) /
+                m_Specification.ChunkSize),
+      m_Animations(kAnimationCount, 0) {
+    SDL_GPUShader *vertexShader =
+        LoadShader(m_Device,
+                   *m_FileSystem,
+                   "Shaders/Tilemap.vert",
+                   {.Stage = SDL_GPU_SHADERSTAGE_VERTEX, .UniformBuffers = 1});
+    SDL_GPUShader *fragmentShader =
+        LoadShader(m_Device,
+                   *m_FileSystem,
+                   "Shaders/Tilemap.frag",
+                   {.Stage          = SDL_GPU_SHADERSTAGE_FRAGMENT,
+                    .Samplers       = 2,
+                    .StorageBuffers = 1,
+                    .UniformBuffers = 1});
+
+    if (vertexShader && fragmentShader) {
+        const SDL_GPUColorTargetDescription target{
+            .format = m_Specification.TargetFormat,
+            .blend_state =
+                {
+                    .src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
+                    .dst_color_blendfactor =
+                        SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                    .color_blend_op        = SDL_GPU_BLENDOP_ADD,
+                    .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+                    .dst_alpha_blendfactor =
+                        SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                    .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
+                    .enable_blend   = true,
+                },
+        };
+        // Chunk corners come from the vertex and instance indices.
+        const SDL_GPUGraphicsPipelineCreateInfo pipelineInfo{
+            .vertex_shader   = vertexShader,
+            .fragment_shader = fragmentShader,
+            .primitive_type  = SDL_GPU_PRIMITIVETYPE_TRIANGLESTRIP,
+            .target_info =
+                {
+                    .color_target_descriptions = &target,
+                    .num_color_targets         = 1,
+                },
+        };
+        m_Pipeline = SDL_CreateGPUGraphicsPipeline(m_Device, &pipelineInfo);
+        if (!m_Pipeline) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TilemapRenderer: cannot create pipeline: %s",
+                         SDL_GetError());
+        }
+    }
+    if (vertexShader) {
+        SDL_ReleaseGPUShader(m_Device, vertexShader);
+    }
+    if (fragmentShader) {
+        SDL_ReleaseGPUShader(m_Device, fragmentShader);
+    }
+
+    SDL_GPUSamplerCreateInfo samplerInfo{
+        .min_filter     = SDL_GPU_FILTER_NEAREST,
+        .mag_filter     = SDL_GPU_FILTER_NEAREST,
+        .mipmap_mode    = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST,
+        .address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+    };
+    m_IndexSampler         = SDL_CreateGPUSampler(m_Device, &samplerInfo);
+    samplerInfo.min_filter = m_Specification.Filter;
+    samplerInfo.mag_filter = m_Specification.Filter;
+    m_AtlasSampler         = SDL_CreateGPUSampler(m_Device, &samplerInfo);
+
+    const SDL_GPUBufferCreateInfo bufferInfo{
+        .usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+        .size  = static_cast<Uint32>(kAnimationBytes),
+    };
+    m_AnimationBuffer = SDL_CreateGPUBuffer(m_Device, &bufferInfo);
+    // A frame's chunks, then the animations.
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size  = static_cast<Uint32>(
+            size_t(m_Specification.MaxChunkUploads) *
+                GetChunkBytes(m_Specification.ChunkSize) +
+            kAnimationBytes),
+    };
+    m_TransferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+
+    const SDL_GPUTextureCreateInfo textureInfo{
+        .type                 = SDL_GPU_TEXTURETYPE_2D,
+        .format               = SDL_GPU_TEXTUREFORMAT_R16_UINT,
+        .usage                = SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width                = m_Specification.Width,
+        .height               = m_Specification.Height,
+        .layer_count_or_depth = 1,
+        .num_levels           = 1,
+    };
+    m_Layers.resize(m_Specification.LayerCount);
+    for (Layer &layer : m_Layers) {
+        layer.Tiles.resize(
+            size_t(m_Specification.Width) * m_Specification.Height, 0);
+        layer.Dirty.resize(size_t(m_ChunksX) * m_ChunksY, 0);
+        layer.Texture = SDL_CreateGPUTexture(m_Device, &textureInfo);
+        if (!layer.Texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TilemapRenderer: cannot create layer texture: %s",
+                         SDL_GetError());
+        }
+    }
+}
+
+TilemapRenderer::~TilemapRenderer() {
+    for (const Layer &layer : m_Layers) {
+        SDL_ReleaseGPUTexture(m_Device, layer.Texture);
+    }
+    SDL_ReleaseGPUTransferBuffer(m_Device, m_TransferBuffer);
+    SDL_ReleaseGPUBuffer(m_Device, m_AnimationBuffer);
+    SDL_ReleaseGPUSampler(m_Device, m_AtlasSampler);
+    SDL_ReleaseGPUSampler(m_Device, m_IndexSampler);
+    if (m_Pipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(m_Device, m_Pipeline);
+    }
+}
+
+void TilemapRenderer::SetTileset(SDL_GPUTexture *atlas,
+                                 uint32_t        atlasWidth,
+                                 uint32_t        atlasHeight,
+                                 uint32_t        tileWidth,
+                                 uint32_t        tileHeight) {
+    if (tileWidth == 0 || tileHeight == 0 || tileWidth > atlasWidth ||
+        tileHeight > atlasHeight) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TilemapRenderer: %ux%u tiles don't fit a %ux%u tileset",
+                     tileWidth,
+                     tileHeight,
+                     atlasWidth,
+                     atlasHeight);
+        return;
+    }
+    m_Atlas   = atlas;
+    m_Columns = atlasWidth / tileWidth;
+    m_TileUv  = glm::vec2(tileWidth, tileHeight) /
+               glm::vec2(atlasWidth, atlasHeight);
+    m_Inset   = 0.5f / glm::vec2(tileWidth, tileHeight);
+}
+
+void TilemapRenderer::SetAnimation(uint16_t tile,
+                                   uint32_t frameCount,
+                                   uint32_t frameMs) {
+    if (tile == 0) {
+        return;
+    }
+    const uint32_t animation =
+        frameCount < 2 ? 0
+                       : std::min(frameCount, 0xffffu) |
+                             std::clamp(frameMs, 1u, 0xffffu) << 16;
+    if (m_Animations[tile - 1] != animation) {
+        m_Animations[tile - 1] = animation;
+        m_AnimationsDirty      = true;
+    }
+}
+
+uint16_t TilemapRenderer::GetTile(uint32_t layer,
+                                  uint32_t x,
+                                  uint32_t y) const {
+    if (layer >= m_Layers.size() || x >= m_Specification.Width ||
+        y >= m_Specification.Height) {
+        return 0;
+    }
+    return m_Layers[layer].Tiles[size_t(y) * m_Specification.Width + x];
+}
+
+void TilemapRenderer::SetTile(uint32_t layer,
+                              uint32_t x,
+                              uint32_t y,
+                              uint16_t tile) {
+    FillTiles(layer, x, y, 1, 1, tile);
+}
+
+void TilemapRenderer::FillTiles(uint32_t layer,
+                                uint32_t x,
+                                uint32_t y,
+                                uint32_t width,
+                                uint32_t height,
+                                uint16_t tile) {
+    const uint32_t mapWidth  = m_Specification.Width;
+    const uint32_t mapHeight = m_Specification.Height;
+    if (layer >= m_Layers.size() || x >= mapWidth || y >= mapHeight) {
+        return;
+    }
+    width  = std::min(width, mapWidth - x);
+    height = std::min(height, mapHeight - y);
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    Layer         &target    = m_Layers[layer];
+    const uint32_t chunkSize = m_Specification.ChunkSize;
+    for (uint32_t chunkY = y / chunkSize;
+         chunkY <= (y + height - 1) / chunkSize;
+         chunkY++) {
+        for (uint32_t chunkX = x / chunkSize;
+             chunkX <= (x + width - 1) / chunkSize;
+             chunkX++) {
+            // Only chunks that actually change go back to the GPU.
+            const uint32_t left  = std::max(x, chunkX * chunkSize);
+            const uint32_t top   = std::max(y, chunkY * chunkSize);
+            const uint32_t right =
+                std::min(x + width, (chunkX + 1) * chunkSize);
+            const uint32_t bottom =
+                std::min(y + height, (chunkY + 1) * chunkSize);
+            bool changed = false;
+            for (uint32_t row = top; row < bottom; row++) {
+                uint16_t *tiles = target.Tiles.data() + size_t(row) * mapWidth;
+                for (uint32_t column = left; column < right; column++) {
+                    changed       = changed || tiles[column] != tile;
+                    tiles[column] = tile;
+                }
+            }
+            if (changed) {
+                MarkDirty(target, chunkX, chunkY);
+            }
+        }
+    }
+}
+
+void TilemapRenderer::SetLayerVisible(uint32_t layer, bool visible) {
+    if (layer < m_Layers.size()) {
+        m_Layers[layer].Visible = visible;
+    }
+}
+
+void TilemapRenderer::SetLayerTint(uint32_t layer, glm::vec4 tint) {
+    if (layer < m_Layers.size()) {
+        m_Layers[layer].Tint = tint;
+    }
+}
+
+void TilemapRenderer::SetLayerAnimationSpeed(uint32_t layer, float speed) {
+    if (layer < m_Layers.size()) {
+        m_Layers[layer].Speed = std::max(speed, 0.0f);
+    }
+}
+
+void TilemapRenderer::Update(float deltaTime) {
+    // The shader gets whole milliseconds in 32 bits; wrapping is a jump
+    // of a frame every 49 days.
+    constexpr double kWrap = 4294967296.0;
+    for (Layer &layer : m_Layers) {
+        layer.TimeMs =
+            std::fmod(layer.TimeMs + deltaTime * 1000.0 * layer.Speed, kWrap);
+    }
+}
+
+void TilemapRenderer::Prepare(SDL_GPUCommandBuffer *commandBuffer) {
+    m_UploadCount = 0;
+
+    bool pending = m_AnimationsDirty;
+    for (const Layer &layer : m_Layers) {
+        pending = pending || (layer.Texture && (!layer.Uploaded ||
+                                                !layer.DirtyChunks.empty()));
+    }
+    if (!pending) {
+        return;
+    }
+
+    // Cycling hands back a fresh buffer if last frame's copies still read
+    // this one.
+    auto *mapped = static_cast<std::byte *>(
+        SDL_MapGPUTransferBuffer(m_Device, m_TransferBuffer, true));
+    if (!mapped) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TilemapRenderer: cannot upload tiles: %s",
+                     SDL_GetError());
+        return;
+    }
+
+    SDL_GPUCopyPass *copyPass  = SDL_BeginGPUCopyPass(commandBuffer);
+    const uint32_t   chunkSize = m_Specification.ChunkSize;
+    const uint32_t   mapWidth  = m_Specification.Width;
+    const uint32_t   chunkBytes = GetChunkBytes(chunkSize);
+    for (Layer &layer : m_Layers) {
+        if (!layer.Texture) {
+            continue;
+        }
+        if (!layer.Uploaded) {
+            UploadLayer(copyPass, layer);
+            continue;
+        }
+
+        // Over budget, the rest wait in the list for the next frames.
+        while (!layer.DirtyChunks.empty() &&
+               m_UploadCount < m_Specification.MaxChunkUploads) {
+            const uint32_t chunk = layer.DirtyChunks.back();
+            layer.DirtyChunks.pop_back();
+            layer.Dirty[chunk] = 0;
+
+            const uint32_t x      = chunk % m_ChunksX * chunkSize;
+            const uint32_t y      = chunk / m_ChunksX * chunkSize;
+            const uint32_t width  = std::min(chunkSize, mapWidth - x);
+            const uint32_t height =
+                std::min(chunkSize, m_Specification.Height - y);
+            const uint32_t offset = m_UploadCount * chunkBytes;
+            for (uint32_t row = 0; row < height; row++) {
+                std::memcpy(mapped + offset + row * width * sizeof(uint16_t),
+                            layer.Tiles.data() + size_t(y + row) * mapWidth +
+                                x,
+                            width * sizeof(uint16_t));
+            }
+
+            const SDL_GPUTextureTransferInfo source{
+                .transfer_buffer = m_TransferBuffer,
+                .offset          = offset,
+                .pixels_per_row  = width,
+                .rows_per_layer  = height,
+            };
+            const SDL_GPUTextureRegion destination{
+                .texture = layer.Texture,
+                .x       = x,
+                .y       = y,
+                .w       = width,
+                .h       = height,
+                .d       = 1,
+            };
+            SDL_UploadToGPUTexture(copyPass, &source, &destination, false);
+            m_UploadCount++;
+        }
+    }
+
+    if (m_AnimationsDirty) {
+        const auto offset = static_cast<Uint32>(
+            m_Specification.MaxChunkUploads * chunkBytes);
+        std::memcpy(mapped + offset, m_Animations.data(), kAnimationBytes);
+        const SDL_GPUTransferBufferLocation source{
+            .transfer_buffer = m_TransferBuffer,
+            .offset          = offset,
+        };
+        const SDL_GPUBufferRegion destination{
+            .buffer = m_AnimationBuffer,
+            .size   = static_cast<Uint32>(kAnimationBytes),
+        };
+        SDL_UploadToGPUBuffer(copyPass, &source, &destination, true);
+        m_AnimationsDirty = false;
+    }
+    SDL_UnmapGPUTransferBuffer(m_Device, m_TransferBuffer);
+    SDL_EndGPUCopyPass(copyPass);
+}
+
+void TilemapRenderer::Render(SDL_GPUCommandBuffer *commandBuffer,
+                             SDL_GPURenderPass    *renderPass,
+                             const glm::mat4      &viewProjection) {
+    m_ChunkCount = 0;
+    m_DrawCount  = 0;
+    if (!m_Pipeline || !m_Atlas) {
+        return;
+    }
+
+    glm::vec2 low, high;
+    GetVisibleRect(viewProjection, low, high);
+    const glm::vec2 chunkExtent =
+        m_Specification.TileSize *
+        static_cast<float>(m_Specification.ChunkSize);
+    const glm::vec2 chunks(m_ChunksX, m_ChunksY);
+    const glm::vec2 first =
+        glm::clamp(glm::floor(low / chunkExtent), glm::vec2(0.0f), chunks);
+    const glm::vec2 last =
+        glm::clamp(glm::ceil(high / chunkExtent), glm::vec2(0.0f), chunks);
+    if (first.x >= last.x || first.y >= last.y) {
+        return;
+    }
+
+    const ViewUniforms view{
+        .ViewProjection = viewProjection,
+        .FirstChunk     = glm::uvec2(first),
+        .ChunksPerRow   = static_cast<uint32_t>(last.x - first.x),
+        .ChunkSize      = m_Specification.ChunkSize,
+        .TileSize       = m_Specification.TileSize,
+        .MapSize =
+            glm::uvec2(m_Specification.Width, m_Specification.Height),
+    };
+    const auto count =
+        view.ChunksPerRow * static_cast<uint32_t>(last.y - first.y);
+
+    SDL_BindGPUGraphicsPipeline(renderPass, m_Pipeline);
+    SDL_BindGPUFragmentStorageBuffers(renderPass, 0, &m_AnimationBuffer, 1);
+    SDL_PushGPUVertexUniformData(commandBuffer, 0, &view, sizeof(view));
+    for (const Layer &layer : m_Layers) {
+        if (!layer.Visible || !layer.Uploaded) {
+            continue;
+        }
+        const SDL_GPUTextureSamplerBinding samplers[] = {
+            {.texture = layer.Texture, .sampler = m_IndexSampler},
+            {.texture = m_Atlas, .sampler = m_AtlasSampler},
+        };
+        const LayerUniforms uniforms{
+            .Tint    = layer.Tint,
+            .TimeMs  = static_cast<uint32_t>(layer.TimeMs),
+            .Columns = m_Columns,
+            .TileUv  = m_TileUv,
+            .Inset   = m_Inset,
+        };
+        SDL_BindGPUFragmentSamplers(renderPass, 0, samplers, 2);
+        SDL_PushGPUFragmentUniformData(
+            commandBuffer, 0, &uniforms, sizeof(uniforms));
+        SDL_DrawGPUPrimitives(renderPass, 4, count, 0, 0);
+        m_ChunkCount += count;
+        m_DrawCount++;
+    }
+}
+
+void TilemapRenderer::MarkDirty(Layer   &layer,
+                                uint32_t chunkX,
+                                uint32_t chunkY) {
+    // A layer never uploaded goes up whole anyway.
+    const uint32_t chunk = chunkY * m_ChunksX + chunkX;
+    if (layer.Uploaded && !layer.Dirty[chunk]) {
+        layer.Dirty[chunk] = 1;
+        layer.DirtyChunks.push_back(chunk);
+    }
+}
+
+void TilemapRenderer::UploadLayer(SDL_GPUCopyPass *copyPass, Layer &layer) {
+    // Once per layer: its buffer is made to measure and released once the
+    // copy has executed.
+    const auto bytes =
+        static_cast<Uint32>(layer.Tiles.size() * sizeof(uint16_t));
+    const SDL_GPUTransferBufferCreateInfo transferInfo{
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size  = bytes,
+    };
+    SDL_GPUTransferBuffer *buffer =
+        SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+    void *mapped =
+        buffer ? SDL_MapGPUTransferBuffer(m_Device, buffer, false) : nullptr;
+    if (!mapped) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TilemapRenderer: cannot upload layer: %s",
+                     SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(m_Device, buffer);
+        return;
+    }
+    std::memcpy(mapped, layer.Tiles.data(), bytes);
+    SDL_UnmapGPUTransferBuffer(m_Device, buffer);
+
+    const SDL_GPUTextureTransferInfo source{
+        .transfer_buffer = buffer,
+        .pixels_per_row  = m_Specification.Width,
+        .rows_per_layer  = m_Specification.Height,
+    };
+    const SDL_GPUTextureRegion destination{
+        .texture = layer.Texture,
+        .w       = m_Specification.Width,
+        .h       = m_Specification.Height,
+        .d       = 1,
+    };
+    SDL_UploadToGPUTexture(copyPass, &source, &destination, false);
+    SDL_ReleaseGPUTransferBuffer(m_Device, buffer);
+    layer.Uploaded = true;
+}
+
+} // namespace brnCore
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Engine/Assets/FileSystem.h"
+
+namespace brnCore {
+
+struct TilemapSpecification {
+    // Format of the color target Render() draws into.
+    SDL_GPUTextureFormat TargetFormat = SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
+    // In tiles, up to 16384 on a side (the largest texture every backend
+    // takes).
+    uint32_t Width      = 4096;
+    uint32_t Height     = 4096;
+    uint32_t LayerCount = 1;
+    // Edits are uploaded, and the map culled, a ChunkSize squared block
+    // of tiles at a time.
+    uint32_t ChunkSize = 64;
+    // Edited chunks past this many wait for the next frames. At most the
+    // map's chunk count, and as many as fit a 4 GB transfer buffer.
+    uint32_t MaxChunkUploads = 256;
+    // World units per tile; tile (0, 0) has its corner at the origin.
+    glm::vec2 TileSize = glm::vec2(1.0f);
+    // How the tileset is sampled: nearest keeps pixel art crisp.
+    SDL_GPUFilter Filter = SDL_GPU_FILTER_NEAREST;
+};
+
+/*
+ * Draws large layered tile maps with next to no CPU work per frame.
+ *
+ * Every layer keeps its tile indices on the GPU, one 16 bit texel per
+ * tile; the CPU copy is only written by edits. Edits mark the chunks
+ * they touch, and Prepare() uploads just those. Render() culls chunks
+ * against the camera and draws each visible layer as one instanced
+ * quad per chunk in view: the fragment shader looks up the tile and
+ * samples the tileset. Animated tiles step through frames from each
+ * layer's clock on the GPU, so they never cause an upload.
+ *
+ * Tile 0 is empty; tile n is the nth of the tileset, counted left to
+ * right then top to bottom from 1. Layers draw in order, blended over
+ * what is below.
+ *
+ *   tilemap.SetTileset(atlas, 512, 512, 16, 16);
+ *   tilemap.SetTile(0, x, y, 5);
+ *   tilemap.Update(deltaTime);
+ *   tilemap.Prepare(commandBuffer);           // outside any pass
+ *   tilemap.Render(commandBuffer, renderPass, viewProjection);
+ */
+class TilemapRenderer {
+  public:
+    TilemapRenderer(SDL_GPUDevice                     *device,
+                    std::shared_ptr<VirtualFileSystem> fileSystem,
+                    const TilemapSpecification        &specification =
+                        TilemapSpecification());
+    ~TilemapRenderer();
+
+    TilemapRenderer(const TilemapRenderer &)            = delete;
+    TilemapRenderer &operator=(const TilemapRenderer &) = delete;
+
+    // The tiles are tileWidth by tileHeight pixels of an atlas of the
+    // given size, which must outlive the renderer (or the next call).
+    void SetTileset(SDL_GPUTexture *atlas,
+                    uint32_t        atlasWidth,
+                    uint32_t        atlasHeight,
+                    uint32_t        tileWidth,
+                    uint32_t        tileHeight);
+
+    // Draws `tile` as it and the next frameCount - 1 tiles of the
+    // tileset in turn, frameMs (up to 65535) each; a count below 2 stops
+    // it.
+    void SetAnimation(uint16_t tile, uint32_t frameCount, uint32_t frameMs);
+
+    // 0 outside the map.
+    uint16_t GetTile(uint32_t layer, uint32_t x, uint32_t y) const;
+    void     SetTile(uint32_t layer, uint32_t x, uint32_t y, uint16_t tile);
+    // Sets a rectangle of tiles, clipped to the map.
+    void FillTiles(uint32_t layer,
+                   uint32_t x,
+                   uint32_t y,
+                   uint32_t width,
+                   uint32_t height,
+                   uint16_t tile);
+
+    void SetLayerVisible(uint32_t layer, bool visible);
+    void SetLayerTint(uint32_t layer, glm::vec4 tint);
+    // How fast the layer's animations run; 0 pauses them.
+    void SetLayerAnimationSpeed(uint32_t layer, float speed);
+
+    // Advances the animation clocks by `deltaTime` seconds.
+    void Update(float deltaTime);
+
+    // Uploads edited chunks and animations.
+    void Prepare(SDL_GPUCommandBuffer *commandBuffer);
+
+    // Draws the visible layers, seen through `viewProjection`, which
+    // maps the map's plane (z = 0) to the target.
+    void Render(SDL_GPUCommandBuffer *commandBuffer,
+                SDL_GPURenderPass    *renderPass,
+                const glm::mat4      &viewProjection);
+
+    // Last frame's.
+    uint32_t GetUploadCount() const { return m_UploadCount; } // chunks
+    uint32_t GetChunkCount() const { return m_ChunkCount; }   // drawn
+    uint32_t GetDrawCount() const { return m_DrawCount; }
+
+  private:
+    struct Layer {
+        std::vector<uint16_t> Tiles; // row major, Width * Height
+        SDL_GPUTexture       *Texture = nullptr;
+        // Chunks edited since their last upload, and a flag per chunk so
+        // each is listed once.
+        std::vector<uint32_t> DirtyChunks;
+        std::vector<uint8_t>  Dirty;
+        bool                  Uploaded = false; // ever, as a whole
+        bool                  Visible  = true;
+        glm::vec4             Tint     = glm::vec4(1.0f);
+        float                 Speed    = 1.0f;
+        double                TimeMs   = 0.0;
+    };
+
+    void MarkDirty(Layer &layer, uint32_t chunkX, uint32_t chunkY);
+    void UploadLayer(SDL_GPUCopyPass *copyPass, Layer &layer);
+
+    SDL_GPUDevice                     *m_Device;
+    std::shared_ptr<VirtualFileSystem> m_FileSystem;
+    TilemapSpecification               m_Specification;
+    uint32_t                           m_ChunksX;
+    uint32_t                           m_ChunksY;
+
+    SDL_GPUGraphicsPipeline *m_Pipeline        = nullptr;
+    SDL_GPUSampler          *m_IndexSampler    = nullptr;
+    SDL_GPUSampler          *m_AtlasSampler    = nullptr;
+    SDL_GPUBuffer           *m_AnimationBuffer = nullptr;
+    SDL_GPUTransferBuffer   *m_TransferBuffer  = nullptr;
+
+    std::vector<Layer> m_Layers;
+
+    SDL_GPUTexture *m_Atlas   = nullptr;
+    uint32_t        m_Columns = 1;
+    glm::vec2       m_TileUv  = glm::vec2(1.0f);
+    glm::vec2       m_Inset   = glm::vec2(0.0f);
+
+    // Frame count and milliseconds per frame packed per tileset tile, as
+    // the fragment shader reads them.
+    std::vector<uint32_t> m_Animations;
+    bool                  m_AnimationsDirty = true;
+
+    uint32_t m_UploadCount = 0;
+    uint32_t m_ChunkCount  = 0;
+    uint32_t m_DrawCount   = 0;
+};
+
+} // namespace brnCore
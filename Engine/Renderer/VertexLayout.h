@@ -0,0 +1,381 @@
+#pragma once
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_pixels.h>
+
+#include <glm/glm.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Engine/Core/Hash.h"
+
+namespace brnCore {
+
+/*
+ * Packed attribute types, for vertex members that don't need 32 bits a
+ * component. The shader still reads floats: halves as themselves, UNORM
+ * as [0, 1] and SNORM as [-1, 1]. Fill them with the Pack functions.
+ */
+struct Half2 {
+    uint16_t Value[2];
+};
+struct Half4 {
+    uint16_t Value[4];
+};
+struct Unorm8x4 {
+    uint8_t Value[4];
+};
+struct Snorm8x4 {
+    int8_t Value[4];
+};
+struct Unorm16x2 {
+    uint16_t Value[2];
+};
+struct Unorm16x4 {
+    uint16_t Value[4];
+};
+struct Snorm16x2 {
+    int16_t Value[2];
+};
+struct Snorm16x4 {
+    int16_t Value[4];
+};
+
+// IEEE half, rounded to nearest even; out of range values become
+// infinity, as the GPU's own conversions do.
+constexpr uint16_t PackHalf(float value) {
+    const uint32_t bits      = std::bit_cast<uint32_t>(value);
+    const auto     sign      = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7fffffff;
+    if (magnitude > 0x7f800000) {
+        return static_cast<uint16_t>(sign | 0x7e00); // NaN
+    }
+    if (magnitude >= 0x477ff000) {
+        return static_cast<uint16_t>(sign | 0x7c00); // rounds past 65504
+    }
+    if (magnitude < 0x38800000) {
+        // Below 2^-14: a subnormal half, the implicit bit shifted in.
+        const uint32_t shift = 126 - (magnitude >> 23);
+        if (shift > 24) {
+            return sign;
+        }
+        const uint32_t mantissa  = (magnitude & 0x7fffff) | 0x800000;
+        const uint32_t halfway   = 1u << (shift - 1);
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t       result    = mantissa >> shift;
+        if (remainder > halfway || (remainder == halfway && (result & 1))) {
+            result++;
+        }
+        return static_cast<uint16_t>(sign | result);
+    }
+    const uint32_t rounded = magnitude + 0xfff + ((magnitude >> 13) & 1);
+    return static_cast<uint16_t>(sign | ((rounded - 0x38000000) >> 13));
+}
+
+namespace detail {
+template <typename T> constexpr T PackUnorm(float value) {
+    constexpr float kMax = static_cast<float>((1u << (8 * sizeof(T))) - 1);
+    value                = value < 0.0f ? 0.0f : value > 1.0f ? 1.0f : value;
+    return static_cast<T>(value * kMax + 0.5f);
+}
+
+template <typename T> constexpr T PackSnorm(float value) {
+    constexpr float kMax = static_cast<float>((1u << (8 * sizeof(T) - 1)) - 1);
+    value                = value < -1.0f ? -1.0f : value > 1.0f ? 1.0f : value;
+    const float scaled   = value * kMax;
+    return static_cast<T>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+} // namespace detail
+
+constexpr Half2 PackHalf2(const glm::vec2 &v) {
+    return {{PackHalf(v.x), PackHalf(v.y)}};
+}
+constexpr Half4 PackHalf4(const glm::vec4 &v) {
+    return {{PackHalf(v.x), PackHalf(v.y), PackHalf(v.z), PackHalf(v.w)}};
+}
+constexpr Unorm8x4 PackUnorm8x4(const glm::vec4 &v) {
+    using detail::PackUnorm;
+    return {{PackUnorm<uint8_t>(v.x),
+             PackUnorm<uint8_t>(v.y),
+             PackUnorm<uint8_t>(v.z),
+             PackUnorm<uint8_t>(v.w)}};
+}
+constexpr Snorm8x4 PackSnorm8x4(const glm::vec4 &v) {
+    using detail::PackSnorm;
+    return {{PackSnorm<int8_t>(v.x),
+             PackSnorm<int8_t>(v.y),
+             PackSnorm<int8_t>(v.z),
+             PackSnorm<int8_t>(v.w)}};
+}
+constexpr Unorm16x2 PackUnorm16x2(const glm::vec2 &v) {
+    using detail::PackUnorm;
+    return {{PackUnorm<uint16_t>(v.x), PackUnorm<uint16_t>(v.y)}};
+}
+constexpr Unorm16x4 PackUnorm16x4(const glm::vec4 &v) {
+    using detail::PackUnorm;
+    return {{PackUnorm<uint16_t>(v.x),
+             PackUnorm<uint16_t>(v.y),
+             PackUnorm<uint16_t>(v.z),
+             PackUnorm<uint16_t>(v.w)}};
+}
+constexpr Snorm16x2 PackSnorm16x2(const glm::vec2 &v) {
+    using detail::PackSnorm;
+    return {{PackSnorm<int16_t>(v.x), PackSnorm<int16_t>(v.y)}};
+}
+constexpr Snorm16x4 PackSnorm16x4(const glm::vec4 &v) {
+    using detail::PackSnorm;
+    return {{PackSnorm<int16_t>(v.x),
+             PackSnorm<int16_t>(v.y),
+             PackSnorm<int16_t>(v.z),
+             PackSnorm<int16_t>(v.w)}};
+}
+
+// Bytes one element of `format` takes in the vertex buffer.
+constexpr uint32_t GetVertexFormatSize(SDL_GPUVertexElementFormat format) {
+    switch (format) {
+    case SDL_GPU_VERTEXELEMENTFORMAT_BYTE2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_BYTE2_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE2_NORM:
+        return 2;
+    case SDL_GPU_VERTEXELEMENTFORMAT_INT:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UINT:
+    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT:
+    case SDL_GPU_VERTEXELEMENTFORMAT_BYTE4:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4:
+    case SDL_GPU_VERTEXELEMENTFORMAT_BYTE4_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_SHORT2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_USHORT2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_USHORT2_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_HALF2:
+        return 4;
+    case SDL_GPU_VERTEXELEMENTFORMAT_INT2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UINT2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2:
+    case SDL_GPU_VERTEXELEMENTFORMAT_SHORT4:
+    case SDL_GPU_VERTEXELEMENTFORMAT_USHORT4:
+    case SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM:
+    case SDL_GPU_VERTEXELEMENTFORMAT_HALF4:
+        return 8;
+    case SDL_GPU_VERTEXELEMENTFORMAT_INT3:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UINT3:
+    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3:
+        return 12;
+    case SDL_GPU_VERTEXELEMENTFORMAT_INT4:
+    case SDL_GPU_VERTEXELEMENTFORMAT_UINT4:
+    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+// The format a member of type T is read as; fails to compile for types
+// without one.
+template <typename T> consteval SDL_GPUVertexElementFormat GetVertexFormat() {
+    if constexpr (std::is_same_v<T, float>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_FLOAT;
+    } else if constexpr (std::is_same_v<T, glm::vec2>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
+    } else if constexpr (std::is_same_v<T, glm::vec3>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
+    } else if constexpr (std::is_same_v<T, glm::vec4>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_INT;
+    } else if constexpr (std::is_same_v<T, glm::ivec2>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_INT2;
+    } else if constexpr (std::is_same_v<T, glm::ivec3>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_INT3;
+    } else if constexpr (std::is_same_v<T, glm::ivec4>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_INT4;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_UINT;
+    } else if constexpr (std::is_same_v<T, glm::uvec2>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_UINT2;
+    } else if constexpr (std::is_same_v<T, glm::uvec3>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_UINT3;
+    } else if constexpr (std::is_same_v<T, glm::uvec4>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_UINT4;
+    } else if constexpr (std::is_same_v<T, Half2>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_HALF2;
+    } else if constexpr (std::is_same_v<T, Half4>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_HALF4;
+    } else if constexpr (std::is_same_v<T, Unorm8x4> ||
+                         std::is_same_v<T, SDL_Color>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM;
+    } else if constexpr (std::is_same_v<T, Snorm8x4>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_BYTE4_NORM;
+    } else if constexpr (std::is_same_v<T, Unorm16x2>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_USHORT2_NORM;
+    } else if constexpr (std::is_same_v<T, Unorm16x4>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM;
+    } else if constexpr (std::is_same_v<T, Snorm16x2>) {
+        return SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM;
+    } else {
+        static_assert(std::is_same_v<T, Snorm16x4>,
+                      "no vertex format for this member type: use "
+                      "BRN_VERTEX_ATTRIBUTE_AS to name one");
+        return SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM;
+    }
+}
+
+// One member of a vertex struct, as the BRN_VERTEX_ATTRIBUTE macros
+// describe it.
+struct VertexMember {
+    SDL_GPUVertexElementFormat Format;
+    uint32_t                   Offset;
+    uint32_t                   Size; // sizeof the member
+};
+
+namespace detail {
+// Not constexpr: reaching it fails the compile, with the message in the
+// diagnostic.
+void VertexLayoutError(const char *message);
+} // namespace detail
+
+/*
+ * The attributes of one vertex buffer, derived from its C++ struct at
+ * compile time: formats from the member types, offsets from offsetof and
+ * the pitch from sizeof, in the order the shader's locations count.
+ *
+ *   struct MeshVertex {
+ *       glm::vec3 Position;
+ *       Snorm8x4  Normal;
+ *       Half2     Uv;
+ *   };
+ *
+ *   constexpr VertexLayout kMeshLayout = MakeVertexLayout<MeshVertex>(
+ *       SDL_GPU_VERTEXINPUTRATE_VERTEX,
+ *       BRN_VERTEX_ATTRIBUTE(MeshVertex, Position),  // location 0
+ *       BRN_VERTEX_ATTRIBUTE(MeshVertex, Normal),    // location 1
+ *       BRN_VERTEX_ATTRIBUTE(MeshVertex, Uv));       // location 2
+ *
+ * Members that overlap, fall outside the struct or sit off the 4 byte
+ * alignment Metal asks of offsets and pitches fail the compile. The
+ * hash covers everything the GPU sees of the layout, so it is the same
+ * constant wherever the layout is, for pipeline cache keys.
+ */
+template <size_t N> struct VertexLayout {
+    SDL_GPUVertexAttribute Attributes[N]{}; // slot and location set later
+    uint32_t               Pitch     = 0;
+    SDL_GPUVertexInputRate InputRate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
+    uint64_t               Hash      = 0;
+};
+
+template <typename Vertex, typename... Members>
+consteval VertexLayout<sizeof...(Members)>
+MakeVertexLayout(SDL_GPUVertexInputRate rate, Members... members) {
+    static_assert(std::is_standard_layout_v<Vertex>,
+                  "vertex structs need a standard layout for offsetof");
+    static_assert(sizeof...(Members) > 0);
+    static_assert((std::is_same_v<Members, VertexMember> && ...));
+
+    constexpr size_t                 kCount = sizeof...(Members);
+    const VertexMember               list[] = {members...};
+    VertexLayout<sizeof...(Members)> layout;
+    layout.Pitch     = sizeof(Vertex);
+    layout.InputRate = rate;
+    if (layout.Pitch % 4 != 0) {
+        detail::VertexLayoutError("vertex pitch is not a multiple of 4");
+    }
+
+    uint64_t hash = HashCombine(layout.Pitch, static_cast<uint64_t>(rate));
+    for (size_t i = 0; i < kCount; i++) {
+        const VertexMember &member = list[i];
+        if (GetVertexFormatSize(member.Format) != member.Size) {
+            detail::VertexLayoutError("format size differs from the member");
+        }
+        if (member.Offset % 4 != 0) {
+            detail::VertexLayoutError("attribute offset is not 4 byte aligned");
+        }
+        if (member.Offset + member.Size > layout.Pitch) {
+            detail::VertexLayoutError("attribute is outside the vertex");
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (member.Offset < list[j].Offset + list[j].Size &&
+                list[j].Offset < member.Offset + member.Size) {
+                detail::VertexLayoutError("attributes overlap");
+            }
+        }
+        layout.Attributes[i].format = member.Format;
+        layout.Attributes[i].offset = member.Offset;
+        hash = HashCombine(hash, static_cast<uint64_t>(member.Format));
+        hash = HashCombine(hash, member.Offset);
+    }
+    layout.Hash = hash;
+    return layout;
+}
+
+/*
+ * The SDL_GPUVertexInputState of a pipeline: one buffer slot per layout
+ * in order, and locations counting on across them, so an instance
+ * layout after a mesh layout starts where the mesh's attributes end.
+ * Keep it static constexpr: GetState() points into it.
+ *
+ *   static constexpr VertexInput kInput(kMeshLayout, kInstanceLayout);
+ *   info.vertex_input_state = kInput.GetState();
+ */
+template <size_t... Counts> class VertexInput {
+  public:
+    static constexpr size_t kBufferCount    = sizeof...(Counts);
+    static constexpr size_t kAttributeCount = (Counts + ... + 0);
+
+    consteval explicit VertexInput(const VertexLayout<Counts> &...layouts) {
+        uint32_t slot     = 0;
+        uint32_t location = 0;
+        m_Hash            = kBufferCount;
+        (Add(layouts, slot, location), ...);
+    }
+
+    SDL_GPUVertexInputState GetState() const {
+        return {m_Buffers,
+                static_cast<Uint32>(kBufferCount),
+                m_Attributes,
+                static_cast<Uint32>(kAttributeCount)};
+    }
+
+    constexpr uint64_t GetHash() const { return m_Hash; }
+
+  private:
+    template <size_t N>
+    consteval void Add(const VertexLayout<N> &layout,
+                       uint32_t              &slot,
+                       uint32_t              &location) {
+        m_Buffers[slot] = {slot, layout.Pitch, layout.InputRate, 0};
+        for (size_t i = 0; i < N; i++) {
+            SDL_GPUVertexAttribute &attribute = m_Attributes[location];
+            attribute                         = layout.Attributes[i];
+            attribute.location                = location++;
+            attribute.buffer_slot             = slot;
+        }
+        m_Hash = HashCombine(m_Hash, layout.Hash);
+        slot++;
+    }
+
+    SDL_GPUVertexBufferDescription m_Buffers[kBufferCount]{};
+    SDL_GPUVertexAttribute         m_Attributes[kAttributeCount]{};
+    uint64_t                       m_Hash = 0;
+};
+
+} // namespace brnCore
+
+// A member of `Vertex`, with the format its type maps to.
+#define BRN_VERTEX_ATTRIBUTE(Vertex, Member)                                   \
+    ::brnCore::VertexMember{                                                   \
+        ::brnCore::GetVertexFormat<decltype(Vertex::Member)>(),                \
+        static_cast<uint32_t>(offsetof(Vertex, Member)),                       \
+        static_cast<uint32_t>(sizeof(Vertex::Member))}
+
+// A member read as `Format`, for types with no mapping (uint8_t[4] as
+// UBYTE4, say); its size must be the format's.
+#define BRN_VERTEX_ATTRIBUTE_AS(Vertex, Member, Format)                        \
+    ::brnCore::VertexMember{Format,                                            \
+                            static_cast<uint32_t>(offsetof(Vertex, Member)),   \
+                            static_cast<uint32_t>(sizeof(Vertex::Member))}
@@ -0,0 +1,392 @@
+#include "TransformHierarchy.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace brnCore {
+
+namespace {
+// Below this many dirty nodes a level is cheaper to do on one thread.
+constexpr size_t   kParallelThreshold = 4096;
+constexpr uint32_t kParallelGrain     = 1024;
+
+glm::aligned_mat4 ComposeLocal(const Transform &local) {
+    glm::aligned_mat4 matrix(glm::mat4_cast(local.Rotation));
+    matrix[0] *= local.Scale.x;
+    matrix[1] *= local.Scale.y;
+    matrix[2] *= local.Scale.z;
+    matrix[3]  = glm::aligned_vec4(local.Position, 1.0f);
+    return matrix;
+}
+} // namespace
+
+TransformHandle TransformHierarchy::CreateNode(TransformHandle  parent,
+                                               const Transform &local) {
+    if (parent.IsValid() && !IsAlive(parent)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "TransformHierarchy: parent %u is not alive",
+                     parent.Index);
+        return {};
+    }
+
+    uint32_t index;
+    if (!m_FreeNodes.empty()) {
+        index = m_FreeNodes.back();
+        m_FreeNodes.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_Nodes.size());
+        m_Nodes.emplace_back();
+    }
+
+    NodeRecord &record = m_Nodes[index];
+    record.Alive       = true;
+    record.Slot        = static_cast<uint32_t>(m_Local.size());
+    Link(index, parent.IsValid() ? parent.Index : kNone);
+
+    // Appended for now; the next Update() moves it to its level.
+    m_Local.push_back(local);
+    m_World.push_back(glm::aligned_mat4(1.0f));
+    m_ParentSlot.push_back(kNone);
+    m_FirstChildSlot.push_back(kNone);
+    m_ChildCount.push_back(0);
+    m_Depth.push_back(0);
+    m_Handle.push_back(index);
+    m_Flags.push_back(FlagDirty);
+
+    m_AliveCount++;
+    m_LayoutDirty = true;
+    return {index, record.Generation};
+}
+
+void TransformHierarchy::DestroyNode(TransformHandle node) {
+    if (!IsAlive(node)) {
+        return;
+    }
+
+    Unlink(node.Index);
+    ForEachInSubtree(node.Index, [this](uint32_t index) {
+        NodeRecord &record = m_Nodes[index];
+        m_Flags[record.Slot] = FlagDead;
+
+        record = NodeRecord{.Generation = record.Generation + 1};
+        m_FreeNodes.push_back(index);
+        m_AliveCount--;
+    });
+    m_LayoutDirty = true;
+}
+
+bool TransformHierarchy::IsAlive(TransformHandle node) const {
+    return node.Index < m_Nodes.size() && m_Nodes[node.Index].Alive &&
+           m_Nodes[node.Index].Generation == node.Generation;
+}
+
+bool TransformHierarchy::SetParent(TransformHandle node,
+                                   TransformHandle parent) {
+    const uint32_t slot = GetSlot(node);
+    if (m_Flags[slot] & FlagFrozen) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "TransformHierarchy: cannot reparent frozen node %u",
+                    node.Index);
+        return false;
+    }
+
+    uint32_t newParent = kNone;
+    if (parent.IsValid()) {
+        if (!IsAlive(parent)) {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "TransformHierarchy: parent %u is not alive",
+                         parent.Index);
+            return false;
+        }
+        for (uint32_t i = parent.Index; i != kNone; i = m_Nodes[i].Parent) {
+            if (i == node.Index) {
+                SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                             "TransformHierarchy: parenting %u to %u would "
+                             "create a cycle",
+                             node.Index,
+                             parent.Index);
+                return false;
+            }
+        }
+        newParent = parent.Index;
+    }
+
+    if (m_Nodes[node.Index].Parent == newParent) {
+        return true;
+    }
+
+    Unlink(node.Index);
+    Link(node.Index, newParent);
+    MarkDirty(slot);
+    m_LayoutDirty = true;
+    return true;
+}
+
+TransformHandle TransformHierarchy::GetParent(TransformHandle node) const {
+    assert(IsAlive(node));
+    const uint32_t parent = m_Nodes[node.Index].Parent;
+    if (parent == kNone) {
+        return {};
+    }
+    return {parent, m_Nodes[parent].Generation};
+}
+
+void TransformHierarchy::SetLocal(TransformHandle  node,
+                                  const Transform &local) {
+    const uint32_t slot = GetSlot(node);
+    if (m_Flags[slot] & FlagFrozen) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "TransformHierarchy: ignoring SetLocal on frozen node %u",
+                    node.Index);
+        return;
+    }
+    m_Local[slot] = local;
+    MarkDirty(slot);
+}
+
+const Transform &TransformHierarchy::GetLocal(TransformHandle node) const {
+    return m_Local[GetSlot(node)];
+}
+
+const glm::aligned_mat4 &
+TransformHierarchy::GetWorldMatrix(TransformHandle node) const {
+    return m_World[GetSlot(node)];
+}
+
+bool TransformHierarchy::FreezeSubtree(TransformHandle node) {
+    assert(IsAlive(node));
+    const uint32_t parent = m_Nodes[node.Index].Parent;
+    if (parent != kNone && !(m_Flags[m_Nodes[parent].Slot] & FlagFrozen)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "TransformHierarchy: cannot freeze node %u below a "
+                    "moving parent",
+                    node.Index);
+        return false;
+    }
+
+    ForEachInSubtree(node.Index, [this](uint32_t index) {
+        m_Flags[m_Nodes[index].Slot] |= FlagFrozen;
+    });
+    m_LayoutDirty = true;
+    return true;
+}
+
+void TransformHierarchy::UnfreezeSubtree(TransformHandle node) {
+    assert(IsAlive(node));
+    ForEachInSubtree(node.Index, [this](uint32_t index) {
+        m_Flags[m_Nodes[index].Slot] &= ~FlagFrozen;
+    });
+    m_LayoutDirty = true;
+}
+
+bool TransformHierarchy::IsFrozen(TransformHandle node) const {
+    return m_Flags[GetSlot(node)] & FlagFrozen;
+}
+
+void TransformHierarchy::Update(JobSystem *jobs) {
+    if (m_LayoutDirty) {
+        RebuildLayout();
+        m_LayoutDirty = false;
+    }
+
+    m_LastUpdateCount = 0;
+    for (size_t depth = 0; depth < m_DirtyLevels.size(); depth++) {
+        std::vector<uint32_t> &slots = m_DirtyLevels[depth];
+        if (slots.empty()) {
+            continue;
+        }
+
+        // Slot order within a level is memory order.
+        std::ranges::sort(slots);
+        UpdateLevel(slots, jobs);
+
+        for (uint32_t slot : slots) {
+            m_Flags[slot] &= ~FlagDirty;
+
+            const uint32_t first = m_FirstChildSlot[slot];
+            const uint32_t last  = first + m_ChildCount[slot];
+            for (uint32_t child = first; child < last; child++) {
+                if (!(m_Flags[child] & FlagDirty)) {
+                    m_Flags[child] |= FlagDirty;
+                    m_DirtyLevels[depth + 1].push_back(child);
+                }
+            }
+        }
+
+        m_LastUpdateCount += slots.size();
+        slots.clear();
+    }
+}
+
+uint32_t TransformHierarchy::GetSlot(TransformHandle node) const {
+    assert(IsAlive(node));
+    return m_Nodes[node.Index].Slot;
+}
+
+template <typename Fn>
+void TransformHierarchy::ForEachInSubtree(uint32_t index, Fn &&fn) {
+    std::vector<uint32_t> stack{index};
+    while (!stack.empty()) {
+        const uint32_t current = stack.back();
+        stack.pop_back();
+        for (uint32_t child = m_Nodes[current].FirstChild; child != kNone;
+             child          = m_Nodes[child].NextSibling) {
+            stack.push_back(child);
+        }
+        fn(current);
+    }
+}
+
+void TransformHierarchy::Link(uint32_t index, uint32_t parent) {
+    NodeRecord &record = m_Nodes[index];
+    uint32_t   &head =
+        parent == kNone ? m_FirstRoot : m_Nodes[parent].FirstChild;
+
+    record.Parent      = parent;
+    record.PrevSibling = kNone;
+    record.NextSibling = head;
+    if (head != kNone) {
+        m_Nodes[head].PrevSibling = index;
+    }
+    head = index;
+}
+
+void TransformHierarchy::Unlink(uint32_t index) {
+    NodeRecord &record = m_Nodes[index];
+    if (record.PrevSibling != kNone) {
+        m_Nodes[record.PrevSibling].NextSibling = record.NextSibling;
+    } else if (record.Parent != kNone) {
+        m_Nodes[record.Parent].FirstChild = record.NextSibling;
+    } else {
+        m_FirstRoot = record.NextSibling;
+    }
+    if (record.NextSibling != kNone) {
+        m_Nodes[record.NextSibling].PrevSibling = record.PrevSibling;
+    }
+
+    record.Parent      = kNone;
+    record.PrevSibling = kNone;
+    record.NextSibling = kNone;
+}
+
+void TransformHierarchy::MarkDirty(uint32_t slot) {
+    if (m_Flags[slot] & FlagDirty) {
+        return;
+    }
+    m_Flags[slot] |= FlagDirty;
+    // A pending rebuild re-collects dirty nodes from the flags.
+    if (!m_LayoutDirty) {
+        m_DirtyLevels[m_Depth[slot]].push_back(slot);
+    }
+}
+
+void TransformHierarchy::RebuildLayout() {
+    const size_t count = m_AliveCount;
+
+    std::vector<uint32_t> order; // handle index per new slot
+    std::vector<uint32_t> depth;
+    std::vector<uint32_t> firstChild;
+    std::vector<uint32_t> childCount;
+    order.reserve(count);
+    depth.reserve(count);
+    firstChild.reserve(count);
+    childCount.reserve(count);
+
+    auto isFrozen = [this](uint32_t index) {
+        return (m_Flags[m_Nodes[index].Slot] & FlagFrozen) != 0;
+    };
+
+    // Moving roots first, so frozen subtrees end up behind them per level.
+    for (bool frozen : {false, true}) {
+        for (uint32_t root = m_FirstRoot; root != kNone;
+             root          = m_Nodes[root].NextSibling) {
+            if (isFrozen(root) == frozen) {
+                order.push_back(root);
+                depth.push_back(0);
+            }
+        }
+    }
+
+    // Breadth-first: each parent's children are appended as one range.
+    for (size_t i = 0; i < order.size(); i++) {
+        const uint32_t first = static_cast<uint32_t>(order.size());
+        for (bool frozen : {false, true}) {
+            for (uint32_t child = m_Nodes[order[i]].FirstChild;
+                 child != kNone;
+                 child = m_Nodes[child].NextSibling) {
+                if (isFrozen(child) == frozen) {
+                    order.push_back(child);
+                    depth.push_back(depth[i] + 1);
+                }
+            }
+        }
+        firstChild.push_back(first);
+        childCount.push_back(static_cast<uint32_t>(order.size()) - first);
+    }
+    assert(order.size() == count);
+
+    std::vector<Transform>         local(count);
+    std::vector<glm::aligned_mat4> world(count);
+    std::vector<uint8_t>           flags(count);
+    for (size_t slot = 0; slot < count; slot++) {
+        const uint32_t old = m_Nodes[order[slot]].Slot;
+        local[slot]        = m_Local[old];
+        world[slot]        = m_World[old];
+        flags[slot]        = m_Flags[old];
+    }
+    for (size_t slot = 0; slot < count; slot++) {
+        m_Nodes[order[slot]].Slot = static_cast<uint32_t>(slot);
+    }
+
+    std::vector<uint32_t> parentSlot(count, kNone);
+    for (size_t slot = 0; slot < count; slot++) {
+        const uint32_t parent = m_Nodes[order[slot]].Parent;
+        if (parent != kNone) {
+            parentSlot[slot] = m_Nodes[parent].Slot;
+        }
+    }
+
+    m_Local          = std::move(local);
+    m_World          = std::move(world);
+    m_Flags          = std::move(flags);
+    m_ParentSlot     = std::move(parentSlot);
+    m_FirstChildSlot = std::move(firstChild);
+    m_ChildCount     = std::move(childCount);
+    m_Depth          = std::move(depth);
+    m_Handle         = std::move(order);
+
+    const size_t levels = count ? m_Depth.back() + 1 : 0;
+    m_DirtyLevels.resize(levels);
+    for (std::vector<uint32_t> &level : m_DirtyLevels) {
+        level.clear();
+    }
+    for (uint32_t slot = 0; slot < count; slot++) {
+        if (m_Flags[slot] & FlagDirty) {
+            m_DirtyLevels[m_Depth[slot]].push_back(slot);
+        }
+    }
+}
+
+void TransformHierarchy::UpdateLevel(const std::vector<uint32_t> &slots,
+                                     JobSystem                   *jobs) {
+    auto compute = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            const uint32_t          slot   = slots[i];
+            const uint32_t          parent = m_ParentSlot[slot];
+            const glm::aligned_mat4 local  = ComposeLocal(m_Local[slot]);
+            m_World[slot] =
+                parent == kNone ? local : m_World[parent] * local;
+        }
+    };
+
+    const uint32_t count = static_cast<uint32_t>(slots.size());
+    if (jobs && count >= kParallelThreshold) {
+        jobs->ParallelFor(count, kParallelGrain, compute);
+    } else {
+        compute(0, count);
+    }
+}
+
+} // namespace brnCore
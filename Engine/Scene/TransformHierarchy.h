@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_aligned.hpp>
+
+#include "Engine/Core/JobSystem.h"
+
+namespace brnCore {
+
+struct TransformHandle {
+    static constexpr uint32_t kInvalidIndex =
+        std::numeric_limits<uint32_t>::max();
+
+    uint32_t Index      = kInvalidIndex;
+    uint32_t Generation = 0;
+
+    bool IsValid() const { return Index != kInvalidIndex; }
+
+    bool operator==(const TransformHandle &) const = default;
+};
+
+struct Transform {
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::quat Rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 Scale    = glm::vec3(1.0f);
+};
+
+/*
+ * Parent/child transforms stored breadth-first: every depth level is one
+ * contiguous range of slots and the children of a node are adjacent, so
+ * parents always precede their children in memory.
+ *
+ * SetLocal() only records the node in its level's dirty list. Update()
+ * walks the levels top-down, recomputes the dirty nodes in slot order (one
+ * forward pass over the arrays) and pushes their children into the next
+ * level, so its cost is the number of moved nodes plus their descendants,
+ * independent of the scene size. World matrices use glm's aligned types,
+ * which take the SSE/NEON paths with GLM_FORCE_INTRINSICS.
+ *
+ * Structural changes (create, destroy, reparent, freeze) only mark the
+ * layout stale; it is rebuilt in O(n) on the next Update(). Handles stay
+ * valid across rebuilds, slots do not.
+ */
+class TransformHierarchy {
+  public:
+    TransformHandle CreateNode(TransformHandle  parent = {},
+                               const Transform &local  = Transform());
+    // Destroys the node and its whole subtree.
+    void DestroyNode(TransformHandle node);
+    bool IsAlive(TransformHandle node) const;
+
+    // Pass an invalid handle to make the node a root.
+    bool            SetParent(TransformHandle node, TransformHandle parent);
+    TransformHandle GetParent(TransformHandle node) const;
+
+    void             SetLocal(TransformHandle node, const Transform &local);
+    const Transform &GetLocal(TransformHandle node) const;
+
+    // Valid after the Update() following the last change to the node.
+    const glm::aligned_mat4 &GetWorldMatrix(TransformHandle node) const;
+
+    /*
+     * Marks a subtree as static: SetLocal/SetParent on it are rejected and
+     * it is laid out after the moving nodes of each level, keeping those
+     * dense. A node can only be frozen if it is a root or its parent is
+     * frozen, since a moving ancestor would invalidate its world matrix.
+     */
+    bool FreezeSubtree(TransformHandle node);
+    void UnfreezeSubtree(TransformHandle node);
+    bool IsFrozen(TransformHandle node) const;
+
+    // Levels with enough dirty nodes are split across the job system.
+    void Update(JobSystem *jobs = nullptr);
+
+    size_t   GetNodeCount() const { return m_AliveCount; }
+    uint32_t GetLevelCount() const {
+        return static_cast<uint32_t>(m_DirtyLevels.size());
+    }
+    // Nodes recomputed by the last Update().
+    size_t GetLastUpdateCount() const { return m_LastUpdateCount; }
+
+  private:
+    static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+    enum Flags : uint8_t {
+        FlagDirty  = 1 << 0,
+        FlagFrozen = 1 << 1,
+        FlagDead   = 1 << 2,
+    };
+
+    // Cold, handle-indexed structure; only walked on layout rebuilds.
+    struct NodeRecord {
+        uint32_t Parent      = kNone;
+        uint32_t FirstChild  = kNone;
+        uint32_t NextSibling = kNone;
+        uint32_t PrevSibling = kNone;
+        uint32_t Slot        = kNone;
+        uint32_t Generation  = 0;
+        bool     Alive       = false;
+    };
+
+    uint32_t GetSlot(TransformHandle node) const;
+    template <typename Fn>
+    void     ForEachInSubtree(uint32_t index, Fn &&fn);
+    void     Link(uint32_t index, uint32_t parent);
+    void     Unlink(uint32_t index);
+    void     MarkDirty(uint32_t slot);
+    void     RebuildLayout();
+    void     UpdateLevel(const std::vector<uint32_t> &slots, JobSystem *jobs);
+
+    std::vector<NodeRecord> m_Nodes;
+    std::vector<uint32_t>   m_FreeNodes;
+    uint32_t                m_FirstRoot  = kNone;
+    size_t                  m_AliveCount = 0;
+
+    // Hot, slot-indexed arrays in breadth-first order.
+    std::vector<Transform>         m_Local;
+    std::vector<glm::aligned_mat4> m_World;
+    std::vector<uint32_t>          m_ParentSlot;
+    std::vector<uint32_t>          m_FirstChildSlot;
+    std::vector<uint32_t>          m_ChildCount;
+    std::vector<uint32_t>          m_Depth;
+    std::vector<uint32_t>          m_Handle;
+    std::vector<uint8_t>           m_Flags;
+
+    std::vector<std::vector<uint32_t>> m_DirtyLevels;
+    bool                               m_LayoutDirty     = false;
+    size_t                             m_LastUpdateCount = 0;
+};
+
+} // namespace brnCore
@@ -0,0 +1,37 @@
+#version 450
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Normal;
+// From the visible list the cull pass wrote, one per instance.
+layout(location = 2) in uint a_Instance;
+
+layout(location = 0) out vec4 v_Color;
+
+struct Instance {
+    mat4 Transform;
+    uint Mesh;
+    uint Color;
+    uint Padding0;
+    uint Padding1;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances {
+    Instance u_Instances[];
+};
+
+layout(set = 1, binding = 0) uniform View {
+    mat4 u_ViewProjection;
+    vec4 u_LightDirection; // toward the light
+};
+
+void main() {
+    Instance instance = u_Instances[a_Instance];
+    vec4     world    = instance.Transform * vec4(a_Position, 1.0);
+    // Fine for the uniform scales instances are expected to have.
+    vec3  normal  = normalize(mat3(instance.Transform) * a_Normal.xyz);
+    float diffuse = max(dot(normal, u_LightDirection.xyz), 0.0);
+    vec4  color   = unpackUnorm4x8(instance.Color);
+
+    v_Color     = vec4(color.rgb * (0.25 + 0.75 * diffuse), color.a);
+    gl_Position = u_ViewProjection * world;
+}
@@ -0,0 +1,23 @@
+#version 450
+
+layout(location = 0) in vec2 v_Uv;
+layout(location = 1) in vec4 v_Color;
+
+layout(location = 0) out vec4 o_Color;
+
+layout(set = 2, binding = 0) uniform sampler2D u_Atlas;
+
+layout(set = 3, binding = 0) uniform Text {
+    float u_Sdf; // 1 when the atlas holds distance fields
+};
+
+void main() {
+    float value = texture(u_Atlas, v_Uv).r;
+    float alpha = value;
+    if (u_Sdf > 0.5) {
+        // The edge is at 0.5; antialias over about a pixel at any scale.
+        float width = max(fwidth(value) * 0.5, 1e-4);
+        alpha       = smoothstep(0.5 - width, 0.5 + width, value);
+    }
+    o_Color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
@@ -0,0 +1,26 @@
+#version 450
+
+// One instance per glyph, drawn as a four vertex strip.
+layout(location = 0) in vec4 a_Rect; // x, y, width, height in pixels
+layout(location = 1) in vec4 a_Uv;   // u0, v0, u1, v1
+layout(location = 2) in vec4 a_Color;
+
+layout(location = 0) out vec2 v_Uv;
+layout(location = 1) out vec4 v_Color;
+
+layout(set = 1, binding = 0) uniform Target {
+    vec2 u_TargetSize;
+};
+
+void main() {
+    vec2 corner   = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    vec2 position = a_Rect.xy + corner * a_Rect.zw;
+
+    // Pixels, y down, to clip space.
+    gl_Position = vec4(position / u_TargetSize * vec2(2.0, -2.0) +
+                           vec2(-1.0, 1.0),
+                       0.0,
+                       1.0);
+    v_Uv    = mix(a_Uv.xy, a_Uv.zw, corner);
+    v_Color = a_Color;
+}
@@ -0,0 +1,46 @@
+#version 450
+
+// Position in tiles: the integer part picks the cell, the fraction the
+// texel inside its tile.
+layout(location = 0) in vec2 v_Tile;
+
+layout(location = 0) out vec4 o_Color;
+
+layout(set = 2, binding = 0) uniform usampler2D u_Tiles; // 0 is empty
+layout(set = 2, binding = 1) uniform sampler2D u_Atlas;
+// Per tile of the atlas: frame count in the low 16 bits, milliseconds
+// per frame in the high ones; 0 when it isn't animated.
+layout(std430, set = 2, binding = 2) readonly buffer Animations {
+    uint u_Animations[];
+};
+
+layout(set = 3, binding = 0) uniform Layer {
+    vec4 u_Tint;
+    uint u_TimeMs;  // the layer's animation clock
+    uint u_Columns; // tiles per atlas row
+    vec2 u_TileUv;  // size of a tile in the atlas
+    vec2 u_Inset;   // half a texel, in tiles, so filtering stays inside
+};
+
+void main() {
+    uint tile = texelFetch(u_Tiles, ivec2(v_Tile), 0).r;
+    if (tile == 0u) {
+        discard;
+    }
+    tile -= 1u;
+
+    uint animation = u_Animations[tile];
+    if (animation != 0u) {
+        uint frames = animation & 0xffffu;
+        tile += (u_TimeMs / max(animation >> 16, 1u)) % max(frames, 1u);
+    }
+
+    vec2 inside = clamp(fract(v_Tile), u_Inset, 1.0 - u_Inset);
+    vec2 uv     = (vec2(tile % u_Columns, tile / u_Columns) + inside) *
+              u_TileUv;
+    // Gradients from the continuous position: the atlas coordinates jump
+    // between tiles, which would pick the smallest mip at every edge.
+    o_Color = textureGrad(u_Atlas, uv, dFdx(v_Tile) * u_TileUv,
+                          dFdy(v_Tile) * u_TileUv) *
+              u_Tint;
+}
@@ -0,0 +1,27 @@
+#version 450
+
+// One instance per chunk in the visible range, drawn as a four vertex
+// strip; no vertex buffers.
+layout(location = 0) out vec2 v_Tile;
+
+layout(set = 1, binding = 0) uniform View {
+    mat4  u_ViewProjection;
+    uvec2 u_FirstChunk;
+    uint  u_ChunksPerRow; // of the visible range
+    uint  u_ChunkSize;    // in tiles
+    vec2  u_TileSize;     // in world units
+    uvec2 u_MapSize;      // in tiles
+};
+
+void main() {
+    uint  instance = uint(gl_InstanceIndex);
+    uvec2 chunk    = u_FirstChunk +
+                  uvec2(instance % u_ChunksPerRow, instance / u_ChunksPerRow);
+    vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    // Chunks on the far edges stop where the map does.
+    vec2 tile = min(vec2(chunk * u_ChunkSize) + corner * float(u_ChunkSize),
+                    vec2(u_MapSize));
+
+    v_Tile      = tile;
+    gl_Position = u_ViewProjection * vec4(tile * u_TileSize, 0.0, 1.0);
+}
@@ -0,0 +1,302 @@
+#include "CookCache.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <charconv>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+
+#include "Engine/Core/FileWriter.h"
+#include "Engine/Core/Hash.h"
+
+namespace {
+constexpr uint32_t kCacheMagic   = 0x434e5242; // "BRNC"
+constexpr uint32_t kCacheVersion = 1;
+
+constexpr std::string_view kDatabaseHeader = "braincook 1";
+
+struct CacheHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t OutputCount;
+    uint32_t Reserved;
+    uint64_t Hash; // of the sizes and the data
+};
+
+// Parses "<field> " off the front of `line`.
+template <typename T>
+bool ParseField(std::string_view &line, T &value, int base = 10) {
+    const auto [end, error] =
+        std::from_chars(line.data(), line.data() + line.size(), value, base);
+    if (error != std::errc() || end == line.data() + line.size() ||
+        *end != ' ') {
+        return false;
+    }
+    line.remove_prefix(static_cast<size_t>(end - line.data()) + 1);
+    return true;
+}
+} // namespace
+
+bool ReadFile(const std::string &path, std::vector<std::byte> &bytes) {
+    SDL_IOStream *stream = SDL_IOFromFile(path.c_str(), "rb");
+    const Sint64  size   = stream ? SDL_GetIOSize(stream) : -1;
+    bool          ok     = size >= 0;
+    if (ok) {
+        bytes.resize(static_cast<size_t>(size));
+        ok = SDL_ReadIO(stream, bytes.data(), bytes.size()) == bytes.size();
+    }
+    if (stream) {
+        SDL_CloseIO(stream);
+    }
+    return ok;
+}
+
+bool WriteFile(const std::string &path, const std::vector<std::byte> &bytes) {
+    std::error_code error;
+    std::filesystem::create_directories(
+        std::filesystem::path(path).parent_path(), error);
+
+    brnCore::FileWriter writer;
+    return writer.Open(path.c_str()) &&
+           writer.Write(bytes.data(), bytes.size()) && writer.Commit();
+}
+
+bool CookCache::Open(std::string directory) {
+    m_Directory = std::move(directory);
+    std::error_code error;
+    std::filesystem::create_directories(m_Directory, error);
+    if (error) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainCook: cannot create cache %s: %s",
+                     m_Directory.c_str(),
+                     error.message().c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string CookCache::GetPath(uint64_t key) const {
+    // Fanned out over 256 directories to keep each one small.
+    char name[32];
+    SDL_snprintf(name,
+                 sizeof(name),
+                 "%02x/%016" PRIx64,
+                 static_cast<unsigned>(key >> 56),
+                 key);
+    return m_Directory + "/" + name;
+}
+
+bool CookCache::Load(uint64_t key, CookOutputs &outputs) const {
+    std::vector<std::byte> bytes;
+    if (!ReadFile(GetPath(key), bytes) || bytes.size() < sizeof(CacheHeader)) {
+        return false;
+    }
+
+    CacheHeader header;
+    SDL_memcpy(&header, bytes.data(), sizeof(header));
+    const size_t tableSize = header.OutputCount * sizeof(uint64_t);
+    if (header.Magic != kCacheMagic || header.Version != kCacheVersion ||
+        bytes.size() < sizeof(header) + tableSize ||
+        brnCore::HashBytes(bytes.data() + sizeof(header),
+                           bytes.size() - sizeof(header)) != header.Hash) {
+        return false;
+    }
+
+    size_t offset = sizeof(header) + tableSize;
+    outputs.assign(header.OutputCount, {});
+    for (uint32_t i = 0; i < header.OutputCount; i++) {
+        uint64_t size;
+        SDL_memcpy(&size,
+                   bytes.data() + sizeof(header) + i * sizeof(uint64_t),
+                   sizeof(size));
+        if (size > bytes.size() - offset) {
+            return false;
+        }
+        outputs[i].assign(bytes.data() + offset, bytes.data() + offset + size);
+        offset += size;
+    }
+    return offset == bytes.size();
+}
+
+bool CookCache::Store(uint64_t key, const CookOutputs &outputs) const {
+    std::vector<std::byte> bytes(sizeof(CacheHeader));
+    for (const std::vector<std::byte> &output : outputs) {
+        const uint64_t size = output.size();
+        const auto    *data = reinterpret_cast<const std::byte *>(&size);
+        bytes.insert(bytes.end(), data, data + sizeof(size));
+    }
+    for (const std::vector<std::byte> &output : outputs) {
+        bytes.insert(bytes.end(), output.begin(), output.end());
+    }
+
+    const std::byte *payload     = bytes.data() + sizeof(CacheHeader);
+    const size_t     payloadSize = bytes.size() - sizeof(CacheHeader);
+
+    const CacheHeader header{
+        .Magic       = kCacheMagic,
+        .Version     = kCacheVersion,
+        .OutputCount = static_cast<uint32_t>(outputs.size()),
+        .Reserved    = 0,
+        .Hash        = brnCore::HashBytes(payload, payloadSize),
+    };
+    SDL_memcpy(bytes.data(), &header, sizeof(header));
+    return WriteFile(GetPath(key), bytes);
+}
+
+bool CookDatabase::Load(const std::string &path) {
+    std::vector<std::byte> bytes;
+    if (!ReadFile(path, bytes)) {
+        return false; // first cook
+    }
+
+    const std::string_view text(reinterpret_cast<const char *>(bytes.data()),
+                                bytes.size());
+    if (!text.starts_with(kDatabaseHeader)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_CUSTOM,
+                    "BrainCook: ignoring %s from another version",
+                    path.c_str());
+        return false;
+    }
+
+    std::scoped_lock lock(m_Mutex);
+    size_t           begin = kDatabaseHeader.size() + 1;
+    while (begin < text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::string_view line = text.substr(begin, end - begin);
+        begin                 = end + 1;
+        if (line.size() < 2) {
+            continue;
+        }
+
+        const char kind = line[0];
+        line.remove_prefix(2);
+        uint64_t hash, size;
+        int64_t  time = 0;
+        if (!ParseField(line, hash, 16) || !ParseField(line, size) ||
+            (kind == 'I' && !ParseField(line, time))) {
+            continue;
+        }
+        if (kind == 'I') {
+            m_Inputs[std::string(line)] = {size, time, hash};
+        } else if (kind == 'O') {
+            m_Outputs[std::string(line)] = {hash, size};
+        }
+    }
+    return true;
+}
+
+bool CookDatabase::Save(const std::string &path) const {
+    std::scoped_lock lock(m_Mutex);
+    std::string      text(kDatabaseHeader);
+    text += '\n';
+
+    char fields[64];
+    for (const auto &[name, input] : m_Inputs) {
+        if (!input.Used) {
+            continue; // a source that is gone
+        }
+        SDL_snprintf(fields,
+                     sizeof(fields),
+                     "I %016" PRIx64 " %" PRIu64 " %" PRId64 " ",
+                     input.Hash,
+                     input.Size,
+                     input.Time);
+        text += fields;
+        text += name;
+        text += '\n';
+    }
+    for (const auto &[name, output] : m_Outputs) {
+        SDL_snprintf(fields,
+                     sizeof(fields),
+                     "O %016" PRIx64 " %" PRIu64 " ",
+                     output.Key,
+                     output.Size);
+        text += fields;
+        text += name;
+        text += '\n';
+    }
+
+    const auto *data = reinterpret_cast<const std::byte *>(text.data());
+    return WriteFile(path, std::vector<std::byte>(data, data + text.size()));
+}
+
+bool CookDatabase::GetContentHash(const std::string      &path,
+                                  uint64_t               &hash,
+                                  std::vector<std::byte> &bytes) {
+    std::error_code sizeError, timeError;
+    const auto      size = std::filesystem::file_size(path, sizeError);
+    const auto      time = std::filesystem::last_write_time(path, timeError)
+                          .time_since_epoch()
+                          .count();
+    if (sizeError || timeError) {
+        const std::error_code &error = sizeError ? sizeError : timeError;
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainCook: cannot read %s: %s",
+                     path.c_str(),
+                     error.message().c_str());
+        return false;
+    }
+
+    {
+        std::scoped_lock lock(m_Mutex);
+        const auto       it = m_Inputs.find(path);
+        if (it != m_Inputs.end() && it->second.Size == size &&
+            it->second.Time == time) {
+            it->second.Used = true;
+            hash            = it->second.Hash;
+            return true;
+        }
+    }
+
+    if (!ReadFile(path, bytes)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainCook: cannot read %s: %s",
+                     path.c_str(),
+                     SDL_GetError());
+        return false;
+    }
+    hash = brnCore::HashBytes(bytes.data(), bytes.size());
+
+    std::scoped_lock lock(m_Mutex);
+    m_Inputs[path] = {size, static_cast<int64_t>(time), hash, true};
+    return true;
+}
+
+bool CookDatabase::IsUpToDate(const std::string &output,
+                              const std::string &path,
+                              uint64_t           key) const {
+    std::error_code  error;
+    const auto       size = std::filesystem::file_size(path, error);
+    std::scoped_lock lock(m_Mutex);
+    const auto       it = m_Outputs.find(output);
+    return !error && it != m_Outputs.end() && it->second.Key == key &&
+           it->second.Size == size;
+}
+
+void CookDatabase::SetOutput(const std::string &output,
+                             uint64_t           key,
+                             uint64_t           size) {
+    std::scoped_lock lock(m_Mutex);
+    m_Outputs[output] = {key, size, true};
+}
+
+std::vector<std::string> CookDatabase::TakeStale() {
+    std::scoped_lock         lock(m_Mutex);
+    std::vector<std::string> stale;
+    for (auto it = m_Outputs.begin(); it != m_Outputs.end();) {
+        if (it->second.Made) {
+            ++it;
+        } else {
+            stale.push_back(it->first);
+            it = m_Outputs.erase(it);
+        }
+    }
+    return stale;
+}
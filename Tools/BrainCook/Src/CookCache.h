@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using CookOutputs = std::vector<std::vector<std::byte>>;
+
+/*
+ * Cooked outputs by cache key, one file per key under a directory that
+ * any number of cooks may share (a network drive, a CI volume). Keys are
+ * hashes of the cooker and the contents of its inputs, never of paths,
+ * so identical sources cook once wherever they live.
+ *
+ * Entries are written through a temporary and renamed, and carry a hash
+ * of their contents, so an entry torn by a crash or by two cooks storing
+ * the same key at once reads as a miss rather than as bad data.
+ */
+class CookCache {
+  public:
+    bool Open(std::string directory);
+
+    bool Load(uint64_t key, CookOutputs &outputs) const;
+    bool Store(uint64_t key, const CookOutputs &outputs) const;
+
+  private:
+    std::string GetPath(uint64_t key) const;
+
+    std::string m_Directory;
+};
+
+/*
+ * What the last cook into an output directory knew, kept next to it:
+ * content hashes of inputs by size and modification time, so unchanged
+ * sources aren't read at all, and the key each output was made with.
+ * Safe to use from several threads.
+ */
+class CookDatabase {
+  public:
+    bool Load(const std::string &path);
+    bool Save(const std::string &path) const;
+
+    // Hash of the file, reading it into `bytes` only if it changed.
+    bool GetContentHash(const std::string      &path,
+                        uint64_t               &hash,
+                        std::vector<std::byte> &bytes);
+
+    bool IsUpToDate(const std::string &output,
+                    const std::string &path,
+                    uint64_t           key) const;
+    void SetOutput(const std::string &output, uint64_t key, uint64_t size);
+    // Outputs recorded here that no step made this time.
+    std::vector<std::string> TakeStale();
+
+  private:
+    struct Input {
+        uint64_t Size;
+        int64_t  Time;
+        uint64_t Hash;
+        bool     Used = false; // this run
+    };
+    struct Output {
+        uint64_t Key;
+        uint64_t Size;
+        bool     Made = false; // this run
+    };
+
+    mutable std::mutex                      m_Mutex;
+    std::unordered_map<std::string, Input>  m_Inputs;
+    std::unordered_map<std::string, Output> m_Outputs;
+};
+
+bool ReadFile(const std::string &path, std::vector<std::byte> &bytes);
+bool WriteFile(const std::string &path, const std::vector<std::byte> &bytes);
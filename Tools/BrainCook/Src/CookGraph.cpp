@@ -0,0 +1,71 @@
+#include "CookGraph.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <unordered_map>
+
+uint32_t CookGraph::Add(CookStep step) {
+    m_Steps.push_back(std::move(step));
+    return static_cast<uint32_t>(m_Steps.size() - 1);
+}
+
+bool CookGraph::Build(const std::string &outputDirectory) {
+    std::unordered_map<std::string, uint32_t> producers;
+    for (uint32_t i = 0; i < m_Steps.size(); i++) {
+        for (const std::string &output : m_Steps[i].Outputs) {
+            const std::string path = outputDirectory + "/" + output;
+            if (!producers.emplace(path, i).second) {
+                SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                             "BrainCook: %s is written by two steps",
+                             path.c_str());
+                return false;
+            }
+        }
+    }
+
+    // Kahn's algorithm, one level at a time.
+    std::vector<uint32_t>              waiting(m_Steps.size(), 0);
+    std::vector<std::vector<uint32_t>> dependents(m_Steps.size());
+    for (uint32_t i = 0; i < m_Steps.size(); i++) {
+        CookStep &step = m_Steps[i];
+        step.Dependencies.clear();
+        for (const std::string &input : step.Inputs) {
+            const auto it = producers.find(input);
+            if (it != producers.end()) {
+                step.Dependencies.push_back(it->second);
+                dependents[it->second].push_back(i);
+                waiting[i]++;
+            }
+        }
+    }
+
+    m_Levels.clear();
+    std::vector<uint32_t> ready;
+    for (uint32_t i = 0; i < m_Steps.size(); i++) {
+        if (waiting[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    size_t placed = 0;
+    while (!ready.empty()) {
+        placed += ready.size();
+        std::vector<uint32_t> next;
+        for (uint32_t step : ready) {
+            for (uint32_t dependent : dependents[step]) {
+                if (--waiting[dependent] == 0) {
+                    next.push_back(dependent);
+                }
+            }
+        }
+        m_Levels.push_back(std::move(ready));
+        ready = std::move(next);
+    }
+
+    if (placed != m_Steps.size()) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainCook: %zu steps depend on each other in a cycle",
+                     m_Steps.size() - placed);
+        return false;
+    }
+    return true;
+}
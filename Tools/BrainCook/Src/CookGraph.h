@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Cooker;
+
+// One cook: a cooker turning some input files into some output files.
+struct CookStep {
+    const Cooker *Handler = nullptr;
+    // Cooker options; part of the cache key like the inputs' contents.
+    std::string Params;
+    // Paths on disk; may be outputs of other steps.
+    std::vector<std::string> Inputs;
+    // Relative to the output directory, which is also how they are named
+    // in the cache database and in archives.
+    std::vector<std::string> Outputs;
+
+    // Filled in by CookGraph::Build().
+    std::vector<uint32_t> Dependencies;
+};
+
+/*
+ * Source assets and the cooked files made from them. A step that reads
+ * another step's output depends on it; Build() sorts the steps into
+ * levels such that every step comes after everything it depends on, so
+ * all steps of a level can run in parallel.
+ */
+class CookGraph {
+  public:
+    uint32_t Add(CookStep step);
+
+    // False if two steps write the same output or the steps form a cycle.
+    bool Build(const std::string &outputDirectory);
+
+    uint32_t GetStepCount() const {
+        return static_cast<uint32_t>(m_Steps.size());
+    }
+    CookStep &GetStep(uint32_t step) { return m_Steps[step]; }
+
+    const std::vector<std::vector<uint32_t>> &GetLevels() const {
+        return m_Levels;
+    }
+
+  private:
+    std::vector<CookStep>              m_Steps;
+    std::vector<std::vector<uint32_t>> m_Levels;
+};
@@ -0,0 +1,169 @@
+#include "Cookers.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_surface.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+#include "Engine/Assets/CookedTexture.h"
+
+namespace {
+using brnCore::CookedTexture;
+
+float SrgbToLinear(uint8_t value) {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> result;
+        for (int i = 0; i < 256; i++) {
+            const float c = static_cast<float>(i) / 255.0f;
+            result[i]     = c <= 0.04045f
+                                ? c / 12.92f
+                                : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return result;
+    }();
+    return table[value];
+}
+
+uint8_t LinearToSrgb(float value) {
+    const float c = value <= 0.0031308f
+                        ? value * 12.92f
+                        : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    return static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+}
+
+// Averages 2x2 blocks; odd edges reuse their last row or column.
+void Downsample(const uint8_t *source,
+                uint32_t       width,
+                uint32_t       height,
+                uint8_t       *destination,
+                bool           srgb) {
+    const uint32_t outWidth  = std::max(width / 2, 1u);
+    const uint32_t outHeight = std::max(height / 2, 1u);
+    for (uint32_t y = 0; y < outHeight; y++) {
+        const uint32_t y0 = std::min(y * 2, height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+        for (uint32_t x = 0; x < outWidth; x++) {
+            const uint32_t x0 = std::min(x * 2, width - 1);
+            const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+
+            const uint8_t *texels[4] = {
+                source + (size_t(y0) * width + x0) * 4,
+                source + (size_t(y0) * width + x1) * 4,
+                source + (size_t(y1) * width + x0) * 4,
+                source + (size_t(y1) * width + x1) * 4,
+            };
+            uint8_t *out = destination + (size_t(y) * outWidth + x) * 4;
+            for (int channel = 0; channel < 4; channel++) {
+                // Alpha is coverage, not color.
+                const bool linear = !srgb || channel == 3;
+                float      sum    = 0.0f;
+                for (const uint8_t *texel : texels) {
+                    sum += linear ? texel[channel] / 255.0f
+                                  : SrgbToLinear(texel[channel]);
+                }
+                out[channel] =
+                    linear ? static_cast<uint8_t>(sum / 4.0f * 255.0f + 0.5f)
+                           : LinearToSrgb(sum / 4.0f);
+            }
+        }
+    }
+}
+} // namespace
+
+bool CopyCooker::Cook(const CookStep &,
+                      CookInputs      inputs,
+                      CookOutputs    &outputs) const {
+    outputs = {inputs[0]};
+    return true;
+}
+
+bool TextureCooker::Cook(const CookStep &step,
+                         CookInputs      inputs,
+                         CookOutputs    &outputs) const {
+    bool srgb = true;
+    bool mips = true;
+    if (inputs.size() > 1) {
+        const std::string_view options(
+            reinterpret_cast<const char *>(inputs[1].data()), inputs[1].size());
+        srgb = options.find("linear") == std::string_view::npos;
+        mips = options.find("nomips") == std::string_view::npos;
+    }
+
+    SDL_Surface *surface = IMG_Load_IO(
+        SDL_IOFromConstMem(inputs[0].data(), inputs[0].size()), true);
+    if (surface && surface->format != SDL_PIXELFORMAT_RGBA32) {
+        SDL_Surface *converted =
+            SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(surface);
+        surface = converted;
+    }
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainCook: cannot decode %s: %s",
+                     step.Inputs[0].c_str(),
+                     SDL_GetError());
+        return false;
+    }
+
+    const auto width      = static_cast<uint32_t>(surface->w);
+    const auto height     = static_cast<uint32_t>(surface->h);
+    uint32_t   levelCount = 1;
+    while (mips && levelCount < CookedTexture::kMaxLevels &&
+           (width >> levelCount || height >> levelCount)) {
+        levelCount++;
+    }
+
+    // Header, level table, then the levels on 16 byte boundaries.
+    std::vector<CookedTexture::Level> levels(levelCount);
+    uint64_t offset = sizeof(CookedTexture::Header) +
+                      levelCount * sizeof(CookedTexture::Level);
+    for (uint32_t i = 0; i < levelCount; i++) {
+        offset = (offset + CookedTexture::kAlignment - 1) &
+                 ~uint64_t(CookedTexture::kAlignment - 1);
+        levels[i] = {
+            offset, std::max(width >> i, 1u), std::max(height >> i, 1u)};
+        offset += CookedTexture::GetLevelSize(levels[i].Width,
+                                              levels[i].Height);
+    }
+
+    std::vector<std::byte> &out = outputs.emplace_back(offset);
+    const CookedTexture::Header header{
+        .Magic      = CookedTexture::kMagic,
+        .Version    = CookedTexture::kVersion,
+        .LevelCount = static_cast<uint16_t>(levelCount),
+        .Width      = width,
+        .Height     = height,
+        .Flags      = srgb ? CookedTexture::kSrgb : 0u,
+        .Reserved   = 0,
+    };
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header),
+                levels.data(),
+                levels.size() * sizeof(CookedTexture::Level));
+
+    // The surface's rows may be padded; levels are tightly packed.
+    auto *pixels = reinterpret_cast<uint8_t *>(out.data());
+    for (uint32_t y = 0; y < height; y++) {
+        std::memcpy(pixels + levels[0].Offset + size_t(y) * width * 4,
+                    static_cast<const uint8_t *>(surface->pixels) +
+                        size_t(y) * surface->pitch,
+                    size_t(width) * 4);
+    }
+    SDL_DestroySurface(surface);
+
+    for (uint32_t i = 1; i < levelCount; i++) {
+        const CookedTexture::Level &parent = levels[i - 1];
+        Downsample(pixels + parent.Offset,
+                   parent.Width,
+                   parent.Height,
+                   pixels + levels[i].Offset,
+                   srgb);
+    }
+    return true;
+}
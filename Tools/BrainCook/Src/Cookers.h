@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CookCache.h"
+#include "CookGraph.h"
+
+using CookInputs = std::span<const std::vector<std::byte>>;
+
+/*
+ * Turns the bytes of a step's inputs into the bytes of its outputs. Must
+ * be a pure function of them (and of Params) and safe to call from
+ * several threads at once: its results are cached by content.
+ */
+class Cooker {
+  public:
+    virtual ~Cooker() = default;
+
+    virtual const char *GetName() const = 0;
+    // Bump when the same inputs would cook differently, which invalidates
+    // every cached output of this cooker.
+    virtual uint32_t GetVersion() const = 0;
+    // Cooks that are cheaper than reading the cache stay out of it.
+    virtual bool IsCacheable() const { return true; }
+
+    virtual bool Cook(const CookStep &step,
+                      CookInputs      inputs,
+                      CookOutputs    &outputs) const = 0;
+};
+
+// Copies its input as-is: fonts, sounds, anything without a cooker.
+class CopyCooker : public Cooker {
+  public:
+    const char *GetName() const override { return "copy"; }
+    uint32_t    GetVersion() const override { return 1; }
+    bool        IsCacheable() const override { return false; }
+
+    bool Cook(const CookStep &step,
+              CookInputs      inputs,
+              CookOutputs    &outputs) const override;
+};
+
+/*
+ * Decodes an image with SDL_image into a CookedTexture with the whole mip
+ * chain, box filtered in linear space. An optional second input, the
+ * image's `.cook` sidecar, holds options one per line:
+ *
+ *   linear   the pixels aren't colors (normal maps, masks)
+ *   nomips   only the top level
+ */
+class TextureCooker : public Cooker {
+  public:
+    const char *GetName() const override { return "texture"; }
+    uint32_t    GetVersion() const override { return 1; }
+
+    bool Cook(const CookStep &step,
+              CookInputs      inputs,
+              CookOutputs    &outputs) const override;
+};
@@ -0,0 +1,298 @@
+#include "CookCache.h"
+#include "CookGraph.h"
+#include "Cookers.h"
+
+#include "Engine/Assets/Archive.h"
+#include "Engine/Assets/ArchiveWriter.h"
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/StringId.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+/*
+ * Cooks a source asset directory into runtime formats:
+ *
+ *   BrainCook <source dir> <output dir> [--cache <dir>] [--archive <file>]
+ *
+ * Images become CookedTextures with their mip chain; everything else is
+ * copied. Outputs keep the path of their source, so game code loads
+ * "hero.png" whether it was cooked or not. Every step is keyed by a hash
+ * of its cooker and of its inputs' contents: a step whose outputs were
+ * made with the same key is skipped, and one whose key is in the shared
+ * cache (--cache, or $BRAINCOOK_CACHE) is copied out of it. Only the
+ * rest actually cook, in parallel. --archive packs the outputs into a
+ * .brn archive, incrementally.
+ */
+
+namespace {
+constexpr std::array<std::string_view, 7> kImageExtensions = {
+    ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".qoi"};
+constexpr std::string_view kSidecarExtension = ".cook";
+constexpr const char      *kDatabaseName     = ".braincook";
+
+enum class CookResult { UpToDate, FromCache, Cooked, Failed };
+
+std::string GetExtension(const std::filesystem::path &path) {
+    std::string extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](char c) {
+        return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    });
+    return extension;
+}
+
+struct Cook {
+    std::string   OutputDirectory;
+    CookCache     Cache;
+    CookDatabase  Database;
+    CopyCooker    Copy;
+    TextureCooker Texture;
+
+    CookResult Run(const CookStep &step) {
+        const Cooker &cooker = *step.Handler;
+
+        uint64_t key = brnCore::HashFnv1a(cooker.GetName());
+        auto     mix = [&key](uint64_t value) {
+            key = brnCore::HashCombine(key, value);
+        };
+        mix(cooker.GetVersion());
+        mix(brnCore::HashFnv1a(step.Params));
+        mix(step.Outputs.size());
+
+        std::vector<std::vector<std::byte>> inputs(step.Inputs.size());
+        for (size_t i = 0; i < step.Inputs.size(); i++) {
+            uint64_t hash;
+            if (!Database.GetContentHash(step.Inputs[i], hash, inputs[i])) {
+                return CookResult::Failed;
+            }
+            mix(hash);
+        }
+
+        const bool upToDate =
+            std::ranges::all_of(step.Outputs, [&](const std::string &output) {
+                return Database.IsUpToDate(output, GetPath(output), key);
+            });
+        if (upToDate) {
+            for (const std::string &output : step.Outputs) {
+                // It may have gone since IsUpToDate() looked.
+                std::error_code error;
+                const auto      size =
+                    std::filesystem::file_size(GetPath(output), error);
+                if (error) {
+                    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                                 "BrainCook: cannot read %s: %s",
+                                 output.c_str(),
+                                 error.message().c_str());
+                    return CookResult::Failed;
+                }
+                Database.SetOutput(output, key, size);
+            }
+            return CookResult::UpToDate;
+        }
+
+        CookOutputs outputs;
+        CookResult  result = CookResult::FromCache;
+        if (!cooker.IsCacheable() || !Cache.Load(key, outputs) ||
+            outputs.size() != step.Outputs.size()) {
+            // Unchanged inputs weren't read while hashing.
+            for (size_t i = 0; i < step.Inputs.size(); i++) {
+                if (inputs[i].empty() && !ReadFile(step.Inputs[i], inputs[i])) {
+                    return CookResult::Failed;
+                }
+            }
+            outputs.clear();
+            if (!cooker.Cook(step, inputs, outputs) ||
+                outputs.size() != step.Outputs.size()) {
+                return CookResult::Failed;
+            }
+            if (cooker.IsCacheable()) {
+                Cache.Store(key, outputs);
+            }
+            result = CookResult::Cooked;
+        }
+
+        for (size_t i = 0; i < outputs.size(); i++) {
+            if (!WriteFile(GetPath(step.Outputs[i]), outputs[i])) {
+                return CookResult::Failed;
+            }
+            Database.SetOutput(step.Outputs[i], key, outputs[i].size());
+        }
+        return result;
+    }
+
+    std::string GetPath(const std::string &output) const {
+        return OutputDirectory + "/" + output;
+    }
+};
+
+// One step per source file; a `.cook` sidecar is an input of its image.
+bool AddSteps(const std::filesystem::path &source,
+              Cook                        &cook,
+              CookGraph                   &graph) {
+    std::error_code                 error;
+    std::unordered_set<std::string> files;
+    for (const auto &file :
+         std::filesystem::recursive_directory_iterator(source, error)) {
+        if (file.is_regular_file()) {
+            files.insert(file.path().generic_string());
+        }
+    }
+    if (error) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainCook: cannot list %s: %s",
+                     source.string().c_str(),
+                     error.message().c_str());
+        return false;
+    }
+
+    for (const std::string &file : files) {
+        const std::filesystem::path path(file);
+        const std::string           extension = GetExtension(path);
+        if (extension == kSidecarExtension) {
+            continue;
+        }
+
+        CookStep step;
+        step.Inputs.push_back(file);
+        step.Outputs.push_back(
+            path.lexically_relative(source).generic_string());
+        if (std::ranges::find(kImageExtensions, extension) !=
+            kImageExtensions.end()) {
+            step.Handler = &cook.Texture;
+            if (files.contains(file + std::string(kSidecarExtension))) {
+                step.Inputs.push_back(file + std::string(kSidecarExtension));
+            }
+        } else {
+            step.Handler = &cook.Copy;
+        }
+        graph.Add(std::move(step));
+    }
+    return true;
+}
+
+bool WriteArchive(const char         *path,
+                  Cook               &cook,
+                  CookGraph          &graph,
+                  brnCore::JobSystem &jobSystem) {
+    brnCore::ArchiveWriter writer;
+    for (uint32_t i = 0; i < graph.GetStepCount(); i++) {
+        for (const std::string &output : graph.GetStep(i).Outputs) {
+            writer.AddFile(output, cook.GetPath(output), true);
+        }
+    }
+
+    brnCore::Archive previous;
+    SDL_PathInfo     info;
+    if (SDL_GetPathInfo(path, &info)) {
+        previous.Open(path);
+    }
+    if (!writer.Write(path, &jobSystem, &previous)) {
+        return false;
+    }
+
+    const brnCore::ArchiveWriteStats &stats = writer.GetStats();
+    SDL_Log("%s: %s, %u entries, %.2f MB stored",
+            path,
+            stats.UpToDate ? "up to date" : "written",
+            stats.Entries,
+            static_cast<double>(stats.StoredSize) / (1 << 20));
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        SDL_Log("usage: BrainCook <source dir> <output dir> "
+                "[--cache <dir>] [--archive <file>]");
+        return 1;
+    }
+
+    const std::filesystem::path source(argv[1]);
+    Cook                        cook;
+    cook.OutputDirectory = argv[2];
+
+    std::string cacheDirectory = cook.OutputDirectory + ".cache";
+    if (const char *shared = SDL_getenv("BRAINCOOK_CACHE")) {
+        cacheDirectory = shared;
+    }
+    const char *archive = nullptr;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        if (option == "--cache") {
+            cacheDirectory = argv[i + 1];
+        } else if (option == "--archive") {
+            archive = argv[i + 1];
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                         "BrainCook: unknown option %s",
+                         argv[i]);
+            return 1;
+        }
+    }
+
+    const std::string database = cook.GetPath(kDatabaseName);
+    CookGraph         graph;
+    if (!cook.Cache.Open(cacheDirectory) || !AddSteps(source, cook, graph) ||
+        !graph.Build(cook.OutputDirectory)) {
+        return 1;
+    }
+    cook.Database.Load(database);
+
+    std::array<std::atomic<uint32_t>, 4> counts{};
+
+    brnCore::JobSystem jobSystem;
+    const Uint64       start = SDL_GetPerformanceCounter();
+    for (const std::vector<uint32_t> &level : graph.GetLevels()) {
+        jobSystem.ParallelFor(
+            static_cast<uint32_t>(level.size()),
+            1,
+            [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; i++) {
+                    const CookResult result = cook.Run(graph.GetStep(level[i]));
+                    counts[static_cast<size_t>(result)]++;
+                }
+            });
+    }
+
+    const uint32_t failed =
+        counts[static_cast<size_t>(CookResult::Failed)].load();
+    if (!failed) {
+        // Outputs whose sources were deleted.
+        for (const std::string &stale : cook.Database.TakeStale()) {
+            std::error_code error;
+            std::filesystem::remove(cook.GetPath(stale), error);
+        }
+    }
+    cook.Database.Save(database);
+
+    const double seconds =
+        static_cast<double>(SDL_GetPerformanceCounter() - start) /
+        static_cast<double>(SDL_GetPerformanceFrequency());
+    SDL_Log("%u steps: %u cooked, %u from cache, %u up to date, %u failed "
+            "in %.2f s",
+            graph.GetStepCount(),
+            counts[static_cast<size_t>(CookResult::Cooked)].load(),
+            counts[static_cast<size_t>(CookResult::FromCache)].load(),
+            counts[static_cast<size_t>(CookResult::UpToDate)].load(),
+            failed,
+            seconds);
+    if (failed) {
+        return 1;
+    }
+
+    if (archive && !WriteArchive(archive, cook, graph, jobSystem)) {
+        return 1;
+    }
+    return 0;
+}
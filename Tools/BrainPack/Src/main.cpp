@@ -0,0 +1,107 @@
+#include "Engine/Assets/Archive.h"
+#include "Engine/Assets/ArchiveWriter.h"
+#include "Engine/Core/JobSystem.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/*
+ * Packs a directory into an archive:
+ *
+ *   BrainPack Assets.brn Assets [--store]
+ *
+ * Paths inside the archive are relative to the directory and use '/'.
+ * Run again over the previous output, only changed files are compressed
+ * again, and an unchanged directory leaves the archive untouched.
+ */
+
+namespace {
+// Already compressed; LZ4 won't get anything out of these.
+constexpr std::array<std::string_view, 7> kStoredExtensions = {
+    ".png", ".jpg", ".jpeg", ".ogg", ".mp3", ".zip", ".brn"};
+
+bool ShouldCompress(const std::filesystem::path &path) {
+    std::string extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](char c) {
+        return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    });
+    return std::ranges::find(kStoredExtensions, extension) ==
+           kStoredExtensions.end();
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        SDL_Log("usage: BrainPack <output.brn> <input directory> [--store]");
+        return 1;
+    }
+    const char *output   = argv[1];
+    const auto  input    = std::filesystem::path(argv[2]);
+    const bool  storeAll = argc > 3 && std::string_view(argv[3]) == "--store";
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(input, error)) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainPack: %s is not a directory",
+                     argv[2]);
+        return 1;
+    }
+
+    brnCore::ArchiveWriter writer;
+    for (const auto &file :
+         std::filesystem::recursive_directory_iterator(input, error)) {
+        if (!file.is_regular_file()) {
+            continue;
+        }
+        const std::filesystem::path relative =
+            file.path().lexically_relative(input);
+        writer.AddFile(relative.generic_string(),
+                       file.path().string(),
+                       !storeAll && ShouldCompress(file.path()));
+    }
+    if (error) {
+        SDL_LogError(SDL_LOG_CATEGORY_CUSTOM,
+                     "BrainPack: cannot list %s: %s",
+                     argv[2],
+                     error.message().c_str());
+        return 1;
+    }
+
+    brnCore::Archive previous;
+    SDL_PathInfo     info;
+    if (SDL_GetPathInfo(output, &info)) {
+        previous.Open(output);
+    }
+
+    brnCore::JobSystem jobSystem;
+    const Uint64       start = SDL_GetPerformanceCounter();
+    if (!writer.Write(output, &jobSystem, &previous)) {
+        return 1;
+    }
+    const double seconds =
+        static_cast<double>(SDL_GetPerformanceCounter() - start) /
+        static_cast<double>(SDL_GetPerformanceFrequency());
+
+    const brnCore::ArchiveWriteStats &stats = writer.GetStats();
+    if (stats.UpToDate) {
+        SDL_Log("%s is up to date (%u entries)", output, stats.Entries);
+        return 0;
+    }
+    SDL_Log("%s: %u entries, %u compressed, %u reused, "
+            "%.2f MB -> %.2f MB in %.2f s",
+            output,
+            stats.Entries,
+            stats.Compressed,
+            stats.Reused,
+            static_cast<double>(stats.Size) / (1 << 20),
+            static_cast<double>(stats.StoredSize) / (1 << 20),
+            seconds);
+    return 0;
+}